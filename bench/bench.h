@@ -0,0 +1,37 @@
+//
+//  bench.h
+//  Aldo-Bench
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_bench_bench_h
+#define Aldo_bench_bench_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// A microbenchmark times a fixed number of iterations of run so results
+// are comparable across builds and against a stored baseline; setup and
+// teardown are optional and not timed.
+struct bench_case {
+    const char *name;
+    long iterations;
+    void (*setup)(void **);
+    void (*run)(void *, long);
+    void (*teardown)(void **);
+};
+
+struct bench_suite {
+    const struct bench_case *cases;
+    size_t count;
+};
+
+#define bench_makesuite(cases) \
+(struct bench_suite){cases, sizeof (cases) / sizeof (cases)[0]}
+
+// benchmark results are folded into this to keep the optimizer from
+// discarding the work being timed.
+extern volatile uint8_t BenchSink;
+
+#endif
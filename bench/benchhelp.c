@@ -0,0 +1,169 @@
+//
+//  benchhelp.c
+//  Aldo-Bench
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "benchhelp.h"
+
+#include "bus.h"
+#include "cpu.h"
+#include "ctrlsignal.h"
+#include "ppu.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static bool ram_read(void *restrict ctx, uint16_t addr, uint8_t *restrict d)
+{
+    *d = ((const uint8_t *)ctx)[addr & ALDO_ADDRMASK_2KB];
+    return true;
+}
+
+static bool ram_write(void *ctx, uint16_t addr, uint8_t d)
+{
+    ((uint8_t *)ctx)[addr & ALDO_ADDRMASK_2KB] = d;
+    return true;
+}
+
+static size_t ram_copy(const void *restrict ctx, uint16_t addr, size_t count,
+                       uint8_t dest[restrict count])
+{
+    return aldo_bytecopy_bank(ctx, ALDO_BITWIDTH_2KB, addr, count, dest);
+}
+
+static void fail(const char *msg)
+{
+    fprintf(stderr, "Bench setup failed: %s\n", msg);
+    exit(EXIT_FAILURE);
+}
+
+//
+// MARK: - Public Interface
+//
+
+void *bench_alloc(size_t size)
+{
+    auto p = calloc(1, size);
+    if (!p) {
+        perror("Bench allocation failed");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+void bench_fill(size_t size, uint8_t buf[static size], uint32_t seed)
+{
+    // xorshift32, seed must be nonzero
+    auto x = seed ? seed : 1;
+    for (size_t i = 0; i < size; ++i) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        buf[i] = (uint8_t)x;
+    }
+}
+
+aldo_cart *bench_cart(const uint8_t prg[static BenchPrgSize])
+{
+    static constexpr uint8_t header[16] = {
+        'N', 'E', 'S', 0x1a,
+        BenchPrgSize / ALDO_MEMBLOCK_16KB, 1,
+    };
+    uint8_t chr[ALDO_MEMBLOCK_8KB];
+    bench_fill(sizeof chr, chr, 0xc4a1);
+
+    auto f = tmpfile();
+    if (!f) {
+        perror("Bench cart file failed");
+        exit(EXIT_FAILURE);
+    }
+    if (fwrite(header, sizeof header, 1, f) != 1
+        || fwrite(prg, BenchPrgSize, 1, f) != 1
+        || fwrite(chr, sizeof chr, 1, f) != 1) {
+        perror("Bench cart write failed");
+        exit(EXIT_FAILURE);
+    }
+    rewind(f);
+
+    aldo_cart *c;
+    auto err = aldo_cart_create(&c, f);
+    fclose(f);
+    if (err < 0) fail(aldo_cart_errstr(err));
+    return c;
+}
+
+void bench_prg_repeat(uint8_t prg[static BenchPrgSize], size_t len,
+                      const uint8_t inst[static len])
+{
+    // JMP $8000 followed by the vectors
+    static constexpr size_t loop = BenchPrgSize - 0x10;
+
+    memset(prg, 0xea, BenchPrgSize);    // NOP padding
+    for (size_t i = 0; i + len <= loop; i += len) {
+        memcpy(prg + i, inst, len);
+    }
+    prg[loop] = 0x4c;
+    prg[loop + 1] = 0x0;
+    prg[loop + 2] = 0x80;
+    for (size_t v = BenchPrgSize - 6; v < BenchPrgSize; v += 2) {
+        prg[v] = 0x0;
+        prg[v + 1] = 0x80;
+    }
+}
+
+struct bench_console *bench_console_new(const uint8_t prg[static BenchPrgSize])
+{
+    struct bench_console *c = bench_alloc(sizeof *c);
+    c->cart = bench_cart(prg);
+    c->cpu.mbus = aldo_bus_new(ALDO_BITWIDTH_64KB, 5, ALDO_MEMBLOCK_8KB,
+                               ALDO_MEMBLOCK_16KB, AldoWramStartAddr,
+                               ALDO_MEMBLOCK_32KB);
+    c->ppu.vbus = aldo_bus_new(ALDO_BITWIDTH_16KB, 2, ALDO_MEMBLOCK_8KB);
+    if (!c->cpu.mbus || !c->ppu.vbus) fail("bus allocation");
+
+    auto r = aldo_bus_set(c->cpu.mbus, 0, (struct aldo_busdevice){
+        ram_read,
+        ram_write,
+        ram_copy,
+        c->ram,
+    });
+    r = r && aldo_bus_set(c->ppu.vbus, ALDO_MEMBLOCK_8KB,
+                          (struct aldo_busdevice){
+        ram_read,
+        ram_write,
+        ram_copy,
+        c->vram,
+    });
+    if (!r) fail("bus device");
+    aldo_ppu_connect(&c->ppu, c->cpu.mbus);
+    if (!aldo_cart_mbus_connect(c->cart, c->cpu.mbus)
+        || !aldo_cart_vbus_connect(c->cart, c->ppu.vbus)) fail("cart bus");
+    bench_fill(sizeof c->vram, c->vram, 0x5eed);
+
+    // run reset sequences and then force a known starting state, same as
+    // the unit test helpers; nes.c drives the PPU reset line every cycle
+    // so hold it high here too.
+    aldo_cpu_powerup(&c->cpu);
+    c->cpu.p.i = c->cpu.presync = true;
+    c->cpu.rst = ALDO_SIG_CLEAR;
+    c->cpu.pc = ALDO_MEMBLOCK_32KB;
+    aldo_ppu_powerup(&c->ppu);
+    c->ppu.signal.rst = true;
+    aldo_ppu_cycle(&c->ppu);
+    c->ppu.line = c->ppu.dot = 0;
+    c->ppu.rst = ALDO_SIG_CLEAR;
+    return c;
+}
+
+void bench_console_free(struct bench_console *c)
+{
+    aldo_cart_vbus_disconnect(c->cart, c->ppu.vbus);
+    aldo_cart_mbus_disconnect(c->cart, c->cpu.mbus);
+    aldo_bus_free(c->ppu.vbus);
+    aldo_bus_free(c->cpu.mbus);
+    aldo_cart_free(c->cart);
+    free(c);
+}
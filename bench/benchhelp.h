@@ -0,0 +1,47 @@
+//
+//  benchhelp.h
+//  Aldo-Bench
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_bench_benchhelp_h
+#define Aldo_bench_benchhelp_h
+
+#include "bytes.h"
+#include "cart.h"
+#include "cpu.h"
+#include "ppu.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+constexpr size_t BenchPrgSize = ALDO_MEMBLOCK_32KB;
+
+// Console wired up like nes.c without the APU or clock loop: 2KB RAM, PPU
+// registers, and an NROM cart on the main bus; CHR and 2KB VRAM on the
+// video bus.
+struct bench_console {
+    struct aldo_mos6502 cpu;
+    struct aldo_rp2c02 ppu;
+    aldo_cart *cart;
+    uint8_t ram[ALDO_MEMBLOCK_2KB], vram[ALDO_MEMBLOCK_2KB];
+};
+
+// benchmarks cannot run without their fixtures so all helpers exit the
+// process on failure.
+void *bench_alloc(size_t size);
+// deterministic filler so runs see identical data
+void bench_fill(size_t size, uint8_t buf[static size], uint32_t seed);
+// NROM cart with prg mapped to $8000 and pseudo-random CHR ROM
+aldo_cart *bench_cart(const uint8_t prg[static BenchPrgSize]);
+// fill prg with repeated copies of inst, looping back to $8000 at the end
+// of the bank and pointing all vectors at $8000.
+void bench_prg_repeat(uint8_t prg[static BenchPrgSize], size_t len,
+                      const uint8_t inst[static len]);
+// console is powered up and reset with the CPU about to fetch from $8000
+// and the PPU at the start of a frame.
+struct bench_console *bench_console_new(const uint8_t prg[static BenchPrgSize]);
+void bench_console_free(struct bench_console *c);
+
+#endif
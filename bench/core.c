@@ -0,0 +1,280 @@
+//
+//  core.c
+//  Aldo-Bench
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "bench.h"
+#include "benchhelp.h"
+
+#include "bus.h"
+#include "bytes.h"
+#include "cart.h"
+#include "cpu.h"
+#include "cycleclock.h"
+#include "debug.h"
+#include "nes.h"
+#include "ppu.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+static void console_setup(void **ctx)
+{
+    static constexpr uint8_t nop[] = {0xea};
+    uint8_t *prg = bench_alloc(BenchPrgSize);
+    bench_prg_repeat(prg, sizeof nop, nop);
+    *ctx = bench_console_new(prg);
+    free(prg);
+}
+
+static void console_teardown(void **ctx)
+{
+    bench_console_free(*ctx);
+}
+
+//
+// MARK: - Bus
+//
+
+// one device per main bus partition: RAM, PPU registers, unmapped, and cart;
+// the unmapped range stops short of cart WRAM at $6000.
+static void bus_read(struct bench_console *c, uint16_t base, uint16_t mask,
+                     long n)
+{
+    uint8_t acc = 0;
+    for (long i = 0; i < n; ++i) {
+        uint8_t d = 0;
+        acc ^= (uint8_t)(aldo_bus_read(c->cpu.mbus,
+                                       (uint16_t)(base + (i & mask)), &d)
+                         + d);
+    }
+    BenchSink = acc;
+}
+
+static void bus_write(struct bench_console *c, uint16_t base, uint16_t mask,
+                      long n)
+{
+    uint8_t acc = 0;
+    for (long i = 0; i < n; ++i) {
+        acc ^= aldo_bus_write(c->cpu.mbus, (uint16_t)(base + (i & mask)),
+                              (uint8_t)i);
+    }
+    BenchSink = acc;
+}
+
+static void bus_read_ram(void *ctx, long n)
+{
+    bus_read(ctx, 0x0, ALDO_ADDRMASK_8KB, n);
+}
+
+static void bus_read_ppu(void *ctx, long n)
+{
+    // PPUSTATUS and its mirrors; other registers have side-effects
+    bus_read(ctx, 0x2002, 0x1ff8, n);
+}
+
+static void bus_read_unmapped(void *ctx, long n)
+{
+    bus_read(ctx, ALDO_MEMBLOCK_16KB, ALDO_ADDRMASK_8KB, n);
+}
+
+static void bus_read_cart(void *ctx, long n)
+{
+    bus_read(ctx, ALDO_MEMBLOCK_32KB, ALDO_ADDRMASK_32KB, n);
+}
+
+static void bus_write_ram(void *ctx, long n)
+{
+    bus_write(ctx, 0x0, ALDO_ADDRMASK_8KB, n);
+}
+
+static void bus_write_ppu(void *ctx, long n)
+{
+    // OAMADDR and its mirrors
+    bus_write(ctx, 0x2003, 0x1ff8, n);
+}
+
+static void bus_write_unmapped(void *ctx, long n)
+{
+    bus_write(ctx, ALDO_MEMBLOCK_16KB, ALDO_ADDRMASK_8KB, n);
+}
+
+static void bus_write_cart(void *ctx, long n)
+{
+    // NROM has no PRG write device so this measures the rejected write
+    bus_write(ctx, ALDO_MEMBLOCK_32KB, ALDO_ADDRMASK_32KB, n);
+}
+
+//
+// MARK: - CPU
+//
+
+// X(addressing mode, instruction bytes...)
+#define BENCH_CPU_MODE_X \
+X(implied, 0xea)                /* NOP */ \
+X(immediate, 0xa9, 0x10)        /* LDA #$10 */ \
+X(zeropage, 0xa5, 0x10)         /* LDA $10 */ \
+X(zeropage_x, 0xb5, 0x10)       /* LDA $10,X */ \
+X(absolute, 0xad, 0x0, 0x2)     /* LDA $0200 */ \
+X(absolute_x, 0xbd, 0x0, 0x2)   /* LDA $0200,X */ \
+X(indirect_x, 0xa1, 0x10)       /* LDA ($10,X) */ \
+X(indirect_y, 0xb1, 0x10)       /* LDA ($10),Y */ \
+X(branch, 0x90, 0x0)            /* BCC +0, always taken */ \
+X(store, 0x8d, 0x0, 0x2)        /* STA $0200 */ \
+X(rmw, 0xe6, 0x10)              /* INC $10 */ \
+X(push, 0x48)                   /* PHA */
+
+static void cpu_setup(void **ctx, size_t len, const uint8_t inst[len])
+{
+    uint8_t *prg = bench_alloc(BenchPrgSize);
+    bench_prg_repeat(prg, len, inst);
+    *ctx = bench_console_new(prg);
+    free(prg);
+}
+
+#define X(mode, ...) \
+static void cpu_##mode##_setup(void **ctx) \
+{ \
+    static constexpr uint8_t inst[] = {__VA_ARGS__}; \
+    cpu_setup(ctx, sizeof inst, inst); \
+}
+BENCH_CPU_MODE_X
+#undef X
+
+// one iteration is one full instruction
+static void cpu_instruction(void *ctx, long n)
+{
+    struct bench_console *c = ctx;
+    for (long i = 0; i < n; ++i) {
+        do {
+            aldo_cpu_cycle(&c->cpu);
+        } while (!c->cpu.presync);
+    }
+    BenchSink = c->cpu.a;
+}
+
+//
+// MARK: - PPU
+//
+
+static void ppu_render_setup(void **ctx)
+{
+    console_setup(ctx);
+    struct bench_console *c = *ctx;
+    bench_fill(sizeof c->ppu.spr.oam, c->ppu.spr.oam, 0x0a4);
+    bench_fill(sizeof c->ppu.palette, c->ppu.palette, 0xc010);
+    c->ppu.mask.b = c->ppu.mask.s = c->ppu.mask.bm = c->ppu.mask.sm = true;
+}
+
+// one iteration is one full frame of dots
+static void ppu_frame(void *ctx, long n)
+{
+    struct bench_console *c = ctx;
+    for (long i = 0; i < n; ++i) {
+        while (!aldo_ppu_cycle(&c->ppu));
+    }
+    BenchSink = c->ppu.pxpl.px;
+}
+
+//
+// MARK: - Console
+//
+
+struct nes_context {
+    aldo_nes *nes;
+    aldo_debugger *dbg;
+    aldo_cart *cart;
+    struct aldo_clock clock;
+};
+
+static void nes_setup(void **ctx)
+{
+    // enable rendering and then spin on a RAM/register workload
+    static constexpr uint8_t prog[] = {
+        0xa9, 0x1e,         // LDA #$1E
+        0x8d, 0x1, 0x20,    // STA $2001
+        0xe8,               // INX
+        0x9d, 0x0, 0x2,     // STA $0200,X
+        0xad, 0x2, 0x20,    // LDA $2002
+        0x65, 0x10,         // ADC $10
+        0x85, 0x10,         // STA $10
+        0x4c, 0x5, 0x80,    // JMP $8005
+    };
+    uint8_t *prg = bench_alloc(BenchPrgSize);
+    bench_prg_repeat(prg, sizeof prog, prog);
+
+    struct nes_context *c = bench_alloc(sizeof *c);
+    c->cart = bench_cart(prg);
+    free(prg);
+    c->dbg = aldo_debug_new();
+    c->nes = c->dbg ? aldo_nes_new(c->dbg, false, nullptr) : nullptr;
+    if (!c->nes) {
+        perror("Bench console failed");
+        exit(EXIT_FAILURE);
+    }
+    aldo_nes_powerup(c->nes, c->cart, true);
+    aldo_nes_halt(c->nes, false);
+    *ctx = c;
+}
+
+static void nes_teardown(void **ctx)
+{
+    struct nes_context *c = *ctx;
+    aldo_nes_powerdown(c->nes);
+    aldo_nes_free(c->nes);
+    aldo_debug_free(c->dbg);
+    aldo_cart_free(c->cart);
+    free(c);
+}
+
+// one iteration is one full frame of cycles
+static void nes_frame(void *ctx, long n)
+{
+    struct nes_context *c = ctx;
+    for (long i = 0; i < n; ++i) {
+        c->clock.budget = aldo_nes_frame_factor();
+        aldo_nes_clock(c->nes, &c->clock);
+    }
+    BenchSink = (uint8_t)c->clock.cycles;
+}
+
+//
+// MARK: - Benchmark List
+//
+
+struct bench_suite core_benches()
+{
+    static const struct bench_case cases[] = {
+        {"bus_read_ram", 20000000, console_setup, bus_read_ram,
+            console_teardown},
+        {"bus_read_ppu", 20000000, console_setup, bus_read_ppu,
+            console_teardown},
+        {"bus_read_unmapped", 20000000, console_setup, bus_read_unmapped,
+            console_teardown},
+        {"bus_read_cart", 20000000, console_setup, bus_read_cart,
+            console_teardown},
+        {"bus_write_ram", 20000000, console_setup, bus_write_ram,
+            console_teardown},
+        {"bus_write_ppu", 20000000, console_setup, bus_write_ppu,
+            console_teardown},
+        {"bus_write_unmapped", 20000000, console_setup, bus_write_unmapped,
+            console_teardown},
+        {"bus_write_cart", 20000000, console_setup, bus_write_cart,
+            console_teardown},
+#define X(mode, ...) \
+        {"cpu_" #mode, 2000000, cpu_##mode##_setup, cpu_instruction, \
+            console_teardown},
+        BENCH_CPU_MODE_X
+#undef X
+        {"ppu_frame_render_off", 200, console_setup, ppu_frame,
+            console_teardown},
+        {"ppu_frame_render_on", 200, ppu_render_setup, ppu_frame,
+            console_teardown},
+        {"nes_frame", 100, nes_setup, nes_frame, nes_teardown},
+    };
+
+    return bench_makesuite(cases);
+}
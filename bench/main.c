@@ -0,0 +1,202 @@
+//
+//  main.c
+//  Aldo-Bench
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "bench.h"
+
+#include "tsutil.h"
+
+#include <errno.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// each case is timed this many times after an untimed warmup; the fastest
+// run is reported since noise only ever adds time.
+constexpr int BenchRepeats = 5;
+// flag changes from baseline larger than this
+constexpr double BenchThresholdPct = 10.0;
+constexpr size_t BenchNameSize = 32;
+
+volatile uint8_t BenchSink;
+
+//
+// MARK: - Benchmark Suites
+//
+
+struct bench_suite core_benches(),
+                   tools_benches();
+
+struct baseline_entry {
+    char name[BenchNameSize];
+    double nsop;
+};
+
+struct baseline {
+    struct baseline_entry *entries;
+    size_t count;
+};
+
+static double run_case(const struct bench_case *bc)
+{
+    void *ctx = nullptr;
+    if (bc->setup) {
+        bc->setup(&ctx);
+    }
+    bc->run(ctx, bc->iterations);
+    double best = INFINITY;
+    for (auto i = 0; i < BenchRepeats; ++i) {
+        struct timespec start;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        bc->run(ctx, bc->iterations);
+        auto elapsed = aldo_elapsed(&start);
+        auto ns = aldo_timespec_to_ms(&elapsed) * ALDO_NS_PER_MS;
+        if (ns < best) {
+            best = ns;
+        }
+    }
+    if (bc->teardown) {
+        bc->teardown(&ctx);
+    }
+    return best / (double)bc->iterations;
+}
+
+// a missing baseline is not an error, it just means nothing to compare
+static bool baseline_load(const char *restrict path, struct baseline *bl)
+{
+    *bl = (typeof(*bl)){};
+    auto f = fopen(path, "r");
+    if (!f) return errno == ENOENT;
+
+    size_t capacity = 0;
+    struct baseline_entry entry;
+    // NOTE: width must match BenchNameSize - 1
+    while (fscanf(f, "%31s %lf", entry.name, &entry.nsop) == 2) {
+        if (bl->count == capacity) {
+            capacity = capacity ? capacity * 2 : 32;
+            struct baseline_entry *entries = realloc(bl->entries,
+                                                     capacity
+                                                     * sizeof *entries);
+            if (!entries) {
+                fclose(f);
+                return false;
+            }
+            bl->entries = entries;
+        }
+        bl->entries[bl->count++] = entry;
+    }
+    auto ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+static const struct baseline_entry *baseline_find(const struct baseline *bl,
+                                                   const char *restrict name)
+{
+    for (size_t i = 0; i < bl->count; ++i) {
+        if (strcmp(bl->entries[i].name, name) == 0) return bl->entries + i;
+    }
+    return nullptr;
+}
+
+static void print_result(const struct bench_case *bc, double nsop,
+                         const struct baseline *bl, int *regressions)
+{
+    printf("%-24s%12ld%12.2f", bc->name, bc->iterations, nsop);
+    auto prev = baseline_find(bl, bc->name);
+    if (!prev || !isgreater(prev->nsop, 0.0)) {
+        puts("           -");
+        return;
+    }
+    auto pct = (nsop - prev->nsop) / prev->nsop * 100;
+    const char *flag = "";
+    if (pct > BenchThresholdPct) {
+        flag = "  SLOWER";
+        ++*regressions;
+    } else if (pct < -BenchThresholdPct) {
+        flag = "  faster";
+    }
+    printf("%12.2f%+9.1f%%%s\n", prev->nsop, pct, flag);
+}
+
+static void print_usage(const char *me)
+{
+    fprintf(stderr, "usage: %s [-s] [baseline]\n"
+            "  -s  save results as the new baseline\n", me);
+}
+
+//
+// MARK: - Public Interface
+//
+
+int main(int argc, char *argv[argc+1])
+{
+    auto save = false;
+    const char *path = nullptr;
+    for (auto i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-s") == 0) {
+            save = true;
+        } else if (argv[i][0] != '-' && !path) {
+            path = argv[i];
+        } else {
+            print_usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (save && !path) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    struct baseline bl = {};
+    if (path && !save && !baseline_load(path, &bl)) {
+        perror("Baseline read failure");
+        free(bl.entries);
+        return EXIT_FAILURE;
+    }
+
+    FILE *out = nullptr;
+    if (save && !(out = fopen(path, "w"))) {
+        perror("Baseline open failure");
+        return EXIT_FAILURE;
+    }
+
+    struct bench_suite suites[] = {
+        core_benches(),
+        tools_benches(),
+    };
+    printf("%-24s%12s%12s%12s%10s\n", "Benchmark", "Iterations", "ns/op",
+           "Baseline", "Change");
+    auto regressions = 0;
+    for (size_t s = 0; s < sizeof suites / sizeof suites[0]; ++s) {
+        for (size_t i = 0; i < suites[s].count; ++i) {
+            auto bc = suites[s].cases + i;
+            auto nsop = run_case(bc);
+            print_result(bc, nsop, &bl, &regressions);
+            fflush(stdout);
+            if (out) {
+                fprintf(out, "%s %.3f\n", bc->name, nsop);
+            }
+        }
+    }
+    free(bl.entries);
+
+    if (out) {
+        auto err = ferror(out);
+        if (fclose(out) != 0 || err) {
+            perror("Baseline write failure");
+            return EXIT_FAILURE;
+        }
+        printf("Baseline saved to %s\n", path);
+    } else if (bl.count > 0) {
+        printf("%d benchmark(s) more than %.0f%% slower than baseline\n",
+               regressions, BenchThresholdPct);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,223 @@
+//
+//  tools.c
+//  Aldo-Bench
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "bench.h"
+#include "benchhelp.h"
+
+#include "bytes.h"
+#include "cart.h"
+#include "cpu.h"
+#include "debug.h"
+#include "dis.h"
+#include "nes.h"
+#include "ppu.h"
+#include "snapshot.h"
+#include "trace.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+//
+// MARK: - Trace
+//
+
+struct trace_context {
+    struct bench_console *console;
+    aldo_debugger *dbg;
+    struct aldo_snapshot snp;
+};
+
+static void trace_setup(void **ctx)
+{
+    // indexed absolute read exercises both disassembly and operand peek
+    static constexpr uint8_t inst[] = {0xbd, 0x0, 0x2};    // LDA $0200,X
+    uint8_t *prg = bench_alloc(BenchPrgSize);
+    bench_prg_repeat(prg, sizeof inst, inst);
+
+    struct trace_context *c = bench_alloc(sizeof *c);
+    c->console = bench_console_new(prg);
+    free(prg);
+    c->dbg = aldo_debug_new();
+    if (!c->dbg) {
+        perror("Bench debugger failed");
+        exit(EXIT_FAILURE);
+    }
+    // run the first instruction to have a typical mid-program datapath
+    do {
+        aldo_cpu_cycle(&c->console->cpu);
+    } while (!c->console->cpu.presync);
+    aldo_cpu_snapshot(&c->console->cpu, &c->snp);
+    aldo_ppu_bus_snapshot(&c->console->ppu, &c->snp);
+    *ctx = c;
+}
+
+static void trace_teardown(void **ctx)
+{
+    struct trace_context *c = *ctx;
+    aldo_debug_free(c->dbg);
+    bench_console_free(c->console);
+    free(c);
+}
+
+static void trace_format(void *ctx, long n)
+{
+    struct trace_context *c = ctx;
+    char buf[AldoTraceLineSize];
+    auto acc = 0;
+    for (long i = 0; i < n; ++i) {
+        acc += aldo_trace_format(0, (uint64_t)i, &c->console->cpu,
+                                 &c->console->ppu, c->dbg, &c->snp, buf);
+    }
+    BenchSink = (uint8_t)(acc + buf[0]);
+}
+
+//
+// MARK: - Disassembly
+//
+
+// every opcode followed by the same 2-byte operand
+static uint8_t OpcodeMem[256 * 3];
+
+static void dis_setup(void **)
+{
+    for (size_t i = 0; i < 256; ++i) {
+        OpcodeMem[i * 3] = (uint8_t)i;
+        OpcodeMem[(i * 3) + 1] = 0x34;
+        OpcodeMem[(i * 3) + 2] = 0x12;
+    }
+}
+
+// one iteration is one parsed and formatted instruction
+static void dis_inst(void *, long n)
+{
+    char dis[AldoDisInstSize];
+    auto acc = 0;
+    for (long i = 0; i < n; ++i) {
+        struct aldo_dis_instruction inst;
+        auto at = (size_t)(i & 0xff) * 3;
+        auto result = aldo_dis_parsemem_inst(sizeof OpcodeMem, OpcodeMem, at,
+                                             &inst);
+        if (result > 0) {
+            result = aldo_dis_inst((uint16_t)(ALDO_MEMBLOCK_32KB + at), &inst,
+                                   dis);
+        }
+        acc += result;
+    }
+    BenchSink = (uint8_t)acc;
+}
+
+//
+// MARK: - CHR Decode
+//
+
+struct chr_context {
+    aldo_cart *cart;
+    FILE *out;
+};
+
+static void chr_setup(void **ctx)
+{
+    uint8_t *prg = bench_alloc(BenchPrgSize);
+    struct chr_context *c = bench_alloc(sizeof *c);
+    c->cart = bench_cart(prg);
+    free(prg);
+    // measure decoding rather than disk throughput
+    c->out = fopen("/dev/null", "wb");
+    if (!c->out) {
+        perror("Bench CHR output failed");
+        exit(EXIT_FAILURE);
+    }
+    *ctx = c;
+}
+
+static void chr_teardown(void **ctx)
+{
+    struct chr_context *c = *ctx;
+    fclose(c->out);
+    aldo_cart_free(c->cart);
+    free(c);
+}
+
+// one iteration is one 8KB CHR bank rendered to a bitmap
+static void chr_decode(void *ctx, long n)
+{
+    struct chr_context *c = ctx;
+    auto bv = aldo_cart_chrblock(c->cart, 0);
+    auto acc = 0;
+    for (long i = 0; i < n; ++i) {
+        acc += aldo_dis_cart_chrblock(&bv, Aldo_MinChrScale, c->out);
+    }
+    BenchSink = (uint8_t)acc;
+}
+
+//
+// MARK: - Screen Palette Conversion
+//
+
+// same per-pixel lookup as the GUI's VideoScreen::draw
+struct screen_context {
+    size_t length;
+    uint32_t colors[64], *pixels;
+    uint8_t *vbuf;
+};
+
+static void screen_setup(void **ctx)
+{
+    int width, height;
+    aldo_nes_screen_size(&width, &height);
+    struct screen_context *c = bench_alloc(sizeof *c);
+    c->length = (size_t)width * (size_t)height;
+    c->vbuf = bench_alloc(c->length);
+    c->pixels = bench_alloc(c->length * sizeof *c->pixels);
+    bench_fill(c->length, c->vbuf, 0xf00d);
+    for (size_t i = 0; i < c->length; ++i) {
+        c->vbuf[i] &= 0x3f;
+    }
+    for (size_t i = 0; i < aldo_arrsz(c->colors); ++i) {
+        c->colors[i] = 0xff000000 | (uint32_t)(i * 0x030507);
+    }
+    *ctx = c;
+}
+
+static void screen_teardown(void **ctx)
+{
+    struct screen_context *c = *ctx;
+    free(c->pixels);
+    free(c->vbuf);
+    free(c);
+}
+
+// one iteration is one full screen
+static void screen_convert(void *ctx, long n)
+{
+    struct screen_context *c = ctx;
+    for (long i = 0; i < n; ++i) {
+        for (size_t px = 0; px < c->length; ++px) {
+            c->pixels[px] = c->colors[c->vbuf[px]];
+        }
+        BenchSink = (uint8_t)c->pixels[(size_t)i % c->length];
+    }
+}
+
+//
+// MARK: - Benchmark List
+//
+
+struct bench_suite tools_benches()
+{
+    static const struct bench_case cases[] = {
+        {"trace_format", 500000, trace_setup, trace_format, trace_teardown},
+        {"dis_inst", 2000000, dis_setup, dis_inst, nullptr},
+        {"chr_decode", 200, chr_setup, chr_decode, chr_teardown},
+        {"screen_palette", 2000, screen_setup, screen_convert,
+            screen_teardown},
+    };
+
+    return bench_makesuite(cases);
+}
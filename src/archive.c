@@ -0,0 +1,236 @@
+//
+//  archive.c
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "archive.h"
+
+#include "bytes.h"
+#include "cart.h"
+#include "png.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// gzip details from: RFC 1952
+// zip details from: PKWARE APPNOTE.TXT
+
+// nothing bigger than this is an NES cart, so anything claiming to be is
+// corrupt or hostile
+constexpr size_t MaxImageSize = 16 * 1024 * 1024;
+constexpr uint16_t StoredMethod = 0;
+constexpr uint16_t DeflateMethod = 8;
+
+//
+// MARK: - Containers
+//
+
+enum {
+    GZIP_FLAG_HCRC = 0x2,
+    GZIP_FLAG_EXTRA = 0x4,
+    GZIP_FLAG_NAME = 0x8,
+    GZIP_FLAG_COMMENT = 0x10,
+};
+
+enum {
+    ZIP_FLAG_ENCRYPTED = 0x1,
+};
+
+constexpr uint32_t ZipLocalSig = 0x04034b50;
+constexpr uint32_t ZipCentralSig = 0x02014b50;
+constexpr uint32_t ZipEndSig = 0x06054b50;
+
+// decompress exactly size bytes into a new buffer and verify them
+static int unpack(size_t srclen, const uint8_t src[static srclen],
+                  uint16_t method, uint32_t crc, size_t size, uint8_t **img,
+                  size_t *imgsize)
+{
+    if (size == 0) return ALDO_CART_ERR_EOF;
+    if (size > MaxImageSize) return ALDO_CART_ERR_IMG_SIZE;
+
+    uint8_t *buf = malloc(size);
+    if (!buf) return ALDO_CART_ERR_ERNO;
+
+    bool ok;
+    if (method == StoredMethod) {
+        ok = srclen >= size;
+        if (ok) {
+            memcpy(buf, src, size);
+        }
+    } else {
+        ok = aldo_inflate(srclen, src, size, buf);
+    }
+    if (!ok || aldo_png_crc(0, size, buf) != crc) {
+        free(buf);
+        return ALDO_CART_ERR_INFLATE;
+    }
+    *img = buf;
+    *imgsize = size;
+    return 0;
+}
+
+// skip a zero-terminated header field, returning false if unterminated
+static bool skip_cstr(size_t end, const uint8_t mem[static end], size_t *pos)
+{
+    const uint8_t *nul = memchr(mem + *pos, 0, end - *pos);
+    if (!nul) return false;
+    *pos = (size_t)(nul - mem) + 1;
+    return true;
+}
+
+static int extract_gzip(size_t size, const uint8_t mem[static size],
+                        uint8_t **img, size_t *imgsize)
+{
+    static constexpr size_t headersize = 10;
+    static constexpr size_t trailersize = 8;
+
+    if (size < headersize + trailersize) return ALDO_CART_ERR_EOF;
+    if (mem[2] != DeflateMethod) return ALDO_CART_ERR_FORMAT;
+
+    auto flags = mem[3];
+    auto end = size - trailersize;
+    size_t pos = headersize;
+    if (flags & GZIP_FLAG_EXTRA) {
+        if (end - pos < 2) return ALDO_CART_ERR_EOF;
+        pos += 2 + (size_t)aldo_batowr(mem + pos);
+        if (pos > end) return ALDO_CART_ERR_EOF;
+    }
+    if ((flags & GZIP_FLAG_NAME) && !skip_cstr(end, mem, &pos)) {
+        return ALDO_CART_ERR_EOF;
+    }
+    if ((flags & GZIP_FLAG_COMMENT) && !skip_cstr(end, mem, &pos)) {
+        return ALDO_CART_ERR_EOF;
+    }
+    if (flags & GZIP_FLAG_HCRC) {
+        pos += 2;
+        if (pos > end) return ALDO_CART_ERR_EOF;
+    }
+
+    // ISIZE is the image size mod 4GB, exact for anything under
+    // MaxImageSize; only the first member of a multi-member file is read.
+    return unpack(end - pos, mem + pos, DeflateMethod,
+                  aldo_batodw(mem + end), aldo_batodw(mem + end + 4), img,
+                  imgsize);
+}
+
+static bool has_nes_ext(size_t len, const uint8_t name[static len])
+{
+    static constexpr char ext[] = ".nes";
+    static constexpr size_t extlen = sizeof ext - 1;
+
+    if (len <= extlen) return false;
+    for (size_t i = 0; i < extlen; ++i) {
+        if (tolower(name[len - extlen + i]) != ext[i]) return false;
+    }
+    return true;
+}
+
+static bool entry_match(const char *name, size_t len,
+                        const uint8_t entry[static len])
+{
+    if (name && name[0] != '\0') {
+        return strlen(name) == len && memcmp(name, entry, len) == 0;
+    }
+    return has_nes_ext(len, entry);
+}
+
+// entry is the entry's central directory header, which has reliable sizes
+// and CRC even when the local header defers them to a trailing descriptor.
+static int extract_entry(size_t size, const uint8_t mem[static size],
+                         const uint8_t *entry, uint8_t **img,
+                         size_t *imgsize)
+{
+    static constexpr size_t localsize = 30;
+
+    auto flags = aldo_batowr(entry + 8);
+    auto method = aldo_batowr(entry + 10);
+    // zip64 entries mark their sizes with 0xffffffff, which unpack rejects
+    // as too large.
+    if ((flags & ZIP_FLAG_ENCRYPTED)
+        || (method != StoredMethod && method != DeflateMethod)) {
+        return ALDO_CART_ERR_FORMAT;
+    }
+
+    size_t offset = aldo_batodw(entry + 42);
+    if (offset > size || size - offset < localsize
+        || aldo_batodw(mem + offset) != ZipLocalSig) {
+        return ALDO_CART_ERR_FORMAT;
+    }
+    // local name and extra field lengths can differ from the central ones
+    auto data = offset + localsize + aldo_batowr(mem + offset + 26)
+                + aldo_batowr(mem + offset + 28);
+    size_t csize = aldo_batodw(entry + 20);
+    if (data > size || size - data < csize) return ALDO_CART_ERR_EOF;
+
+    return unpack(csize, mem + data, method, aldo_batodw(entry + 16),
+                  aldo_batodw(entry + 24), img, imgsize);
+}
+
+static int extract_zip(size_t size, const uint8_t mem[static size],
+                       const char *name, uint8_t **img, size_t *imgsize)
+{
+    static constexpr size_t endsize = 22;
+    static constexpr size_t centralsize = 46;
+    static constexpr size_t maxcomment = 0xffff;
+
+    if (size < endsize) return ALDO_CART_ERR_EOF;
+
+    // the end record is followed by an archive comment of up to 64KB
+    auto endpos = size - endsize;
+    auto floor = endpos > maxcomment ? endpos - maxcomment : 0;
+    while (aldo_batodw(mem + endpos) != ZipEndSig) {
+        if (endpos == floor) return ALDO_CART_ERR_FORMAT;
+        --endpos;
+    }
+
+    auto count = aldo_batowr(mem + endpos + 10);
+    size_t pos = aldo_batodw(mem + endpos + 16);
+    for (size_t i = 0; i < count; ++i) {
+        if (pos > endpos || endpos - pos < centralsize
+            || aldo_batodw(mem + pos) != ZipCentralSig) {
+            return ALDO_CART_ERR_FORMAT;
+        }
+        auto entry = mem + pos;
+        size_t namelen = aldo_batowr(entry + 28);
+        auto next = pos + centralsize + namelen + aldo_batowr(entry + 30)
+                    + aldo_batowr(entry + 32);
+        if (next > endpos) return ALDO_CART_ERR_FORMAT;
+        if (entry_match(name, namelen, entry + centralsize)) {
+            return extract_entry(size, mem, entry, img, imgsize);
+        }
+        pos = next;
+    }
+    return ALDO_CART_ERR_ARCHIVE;
+}
+
+//
+// MARK: - Internal Interface
+//
+
+bool aldo_archive_detect(size_t size, const uint8_t mem[restrict size])
+{
+    assert(mem != nullptr);
+
+    return (size >= 2 && mem[0] == 0x1f && mem[1] == 0x8b)
+            || (size >= 4 && aldo_batodw(mem) == ZipLocalSig);
+}
+
+int aldo_archive_extract(size_t size, const uint8_t mem[restrict size],
+                         const char *restrict name, uint8_t **img,
+                         size_t *imgsize)
+{
+    assert(mem != nullptr);
+    assert(img != nullptr);
+    assert(imgsize != nullptr);
+    assert(aldo_archive_detect(size, mem));
+
+    return mem[0] == 0x1f
+            ? extract_gzip(size, mem, img, imgsize)
+            : extract_zip(size, mem, name, img, imgsize);
+}
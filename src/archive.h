@@ -0,0 +1,36 @@
+//
+//  archive.h
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_archive_h
+#define Aldo_archive_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "bridgeopen.h"
+//
+// MARK: - Internal
+//
+
+// Compressed cart containers: gzip files and zip archives holding stored or
+// deflated entries; decompression is done in-tree with no external
+// dependencies.
+
+// true if mem starts with a gzip or zip signature
+bool aldo_archive_detect(size_t size,
+                         const uint8_t mem[aldo_naz(size)]) aldo_nothrow;
+// decompress a ROM image out of the container in mem into a new heap buffer
+// returned in *img; zip archives use the entry called name, or the first
+// entry ending in .nes if name is null or empty; gzip ignores name.
+// Returns 0 or a cart error code, with *img unmodified on error.
+int aldo_archive_extract(size_t size, const uint8_t mem[aldo_naz(size)],
+                         const char *aldo_noalias name,
+                         uint8_t **img, size_t *imgsize) aldo_nothrow;
+
+#include "bridgeclose.h"
+
+#endif
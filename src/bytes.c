@@ -13,6 +13,7 @@
 extern inline uint16_t aldo_bytowr(uint8_t, uint8_t),
                        aldo_batowr(const uint8_t[static 2]),
                        aldo_byteshuffle(uint8_t, uint8_t);
+extern inline uint32_t aldo_batodw(const uint8_t[static 4]);
 extern inline void aldo_wrtoby(uint16_t, uint8_t *restrict, uint8_t *restrict),
                    aldo_wrtoba(uint16_t, uint8_t[static 2]),
                    aldo_dwtoba(uint32_t, uint8_t[static 4]);
@@ -37,3 +38,16 @@ size_t aldo_bytecopy_bank(const uint8_t *restrict bankmem, int bankwidth,
     memcpy(dest, bankmem + start, bytecount * sizeof *dest);
     return bytecount;
 }
+
+uint64_t aldo_bytehash(uint64_t h, size_t count,
+                       const uint8_t buf[restrict count])
+{
+    assert(buf != nullptr);
+
+    static constexpr uint64_t prime = 0x100000001b3;
+
+    for (size_t i = 0; i < count; ++i) {
+        h = (h ^ buf[i]) * prime;
+    }
+    return h;
+}
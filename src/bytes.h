@@ -106,6 +106,16 @@ inline void aldo_dwtoba(uint32_t dword, uint8_t bytes[aldo_cz(4)]) aldo_nothrow
     }
 }
 
+// Byte Array to DWord
+inline uint32_t aldo_batodw(const uint8_t bytes[aldo_cz(4)]) aldo_nothrow
+{
+    uint32_t dword = 0;
+    for (size_t i = 0; i < 4; ++i) {
+        dword |= (uint32_t)bytes[i] << (8 * i);
+    }
+    return dword;
+}
+
 // Interleave the bits of lo and hi bytes together;
 // Outer Perfect Shuffle algorithm taken from Hacker's Delight 2nd Edition §7-2
 // and adapted to 16-bits; I *think* this is related to Morton Codes but
@@ -128,6 +138,13 @@ inline uint16_t aldo_byteshuffle(uint8_t lo, uint8_t hi) aldo_nothrow
 size_t aldo_bytecopy_bank(const uint8_t *aldo_noalias bankmem, int bankwidth,
                           uint16_t addr, size_t count,
                           uint8_t dest[aldo_naz(count)]) aldo_nothrow;
+
+// 64-bit FNV-1a hash of buffer continuing from hash h; a new hash starts
+// from AldoFnvBasis. Not suitable for anything adversarial, only for cheaply
+// detecting changed memory.
+aldo_const uint64_t AldoFnvBasis = 0xcbf29ce484222325;
+uint64_t aldo_bytehash(uint64_t h, size_t count,
+                       const uint8_t buf[aldo_naz(count)]) aldo_nothrow;
 #include "bridgeclose.h"
 
 #endif
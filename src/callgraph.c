@@ -0,0 +1,431 @@
+//
+//  callgraph.c
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "callgraph.h"
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Calling-context tree node; a routine has one node per unique call path.
+struct cg_node {
+    uint64_t
+        inclusive,      // Computed on demand from exclusive cycles
+        exclusive,
+        calls,
+        maxcall,
+        framepeak,
+        framecycles,    // Exclusive cycles in the current frame
+        frame,          // Frame framecycles belongs to
+        overruns;
+    size_t parent, child, sibling;
+    enum aldo_cgkind kind;
+    uint16_t entry;
+};
+
+// Shadow call stack frame
+struct cg_frame {
+    uint64_t start;     // Total cycles at routine entry
+    size_t node;
+    uint8_t s;          // Stack pointer before entry
+};
+
+// Stack pointer range can hold at most 128 return addresses, leave
+// headroom for stale frames left by routines that discard their return.
+constexpr size_t MaxDepth = 256;
+constexpr size_t NoNode = SIZE_MAX;
+constexpr size_t InitialNodes = 256;
+
+struct aldo_callgraph_context {
+    struct cg_node *nodes;
+    size_t count, capacity, depth;
+    uint64_t frames, total;
+    enum aldo_cgevent pending;
+    uint8_t pendings;
+    struct cg_frame stack[MaxDepth];
+};
+
+static const char *kind_name(enum aldo_cgkind kind)
+{
+    static const char *const restrict names[] = {
+#define X(s, n) n,
+        ALDO_CGKIND_X
+#undef X
+    };
+    return names[kind];
+}
+
+static size_t add_node(struct aldo_callgraph_context *self, size_t parent,
+                       uint16_t entry, enum aldo_cgkind kind)
+{
+    if (self->count == self->capacity) {
+        auto capacity = self->capacity ? self->capacity * 2 : InitialNodes;
+        struct cg_node *nodes = realloc(self->nodes,
+                                        capacity * sizeof *nodes);
+        if (!nodes) return NoNode;
+        self->nodes = nodes;
+        self->capacity = capacity;
+    }
+    auto i = self->count++;
+    self->nodes[i] = (struct cg_node){
+        .parent = parent,
+        .child = NoNode,
+        .sibling = NoNode,
+        .kind = kind,
+        .entry = entry,
+    };
+    if (parent != NoNode) {
+        self->nodes[i].sibling = self->nodes[parent].child;
+        self->nodes[parent].child = i;
+    }
+    return i;
+}
+
+static size_t find_child(struct aldo_callgraph_context *self, size_t parent,
+                         uint16_t entry, enum aldo_cgkind kind)
+{
+    for (auto i = self->nodes[parent].child;
+         i != NoNode;
+         i = self->nodes[i].sibling) {
+        if (self->nodes[i].entry == entry && self->nodes[i].kind == kind) {
+            return i;
+        }
+    }
+    return add_node(self, parent, entry, kind);
+}
+
+static void push(struct aldo_callgraph_context *self, uint16_t entry,
+                 enum aldo_cgkind kind, uint8_t s)
+{
+    // on overflow or failed allocation keep attributing to current routine
+    if (self->depth == MaxDepth) return;
+
+    auto top = self->stack[self->depth - 1].node;
+    auto node = find_child(self, top, entry, kind);
+    if (node == NoNode) return;
+
+    ++self->nodes[node].calls;
+    self->stack[self->depth++] = (struct cg_frame){
+        .start = self->total, .node = node, .s = s,
+    };
+}
+
+static void pop_frame(struct aldo_callgraph_context *self)
+{
+    auto frame = self->stack + --self->depth;
+    auto n = self->nodes + frame->node;
+    auto cycles = self->total - frame->start;
+    if (cycles > n->maxcall) {
+        n->maxcall = cycles;
+    }
+    if (n->kind == ALDO_CGK_NMI && cycles > Aldo_VBlankCycles) {
+        ++n->overruns;
+    }
+}
+
+// A return pops every frame entered at or below the restored stack
+// pointer; this resyncs the shadow stack when a routine discards its
+// return address, and ignores RTS-as-jump tricks that push an address
+// without a matching JSR.
+static void pop(struct aldo_callgraph_context *self, uint8_t s)
+{
+    while (self->depth > 1 && self->stack[self->depth - 1].s <= s) {
+        pop_frame(self);
+    }
+}
+
+static void apply_event(struct aldo_callgraph_context *self, uint16_t addr,
+                        uint8_t s)
+{
+    switch (self->pending) {
+    case ALDO_CGE_CALL:
+        push(self, addr, ALDO_CGK_CALL, self->pendings);
+        break;
+    case ALDO_CGE_RETURN:
+        pop(self, s);
+        break;
+    case ALDO_CGE_BRK:
+        push(self, addr, ALDO_CGK_BRK, self->pendings);
+        break;
+    case ALDO_CGE_IRQ:
+        push(self, addr, ALDO_CGK_IRQ, self->pendings);
+        break;
+    case ALDO_CGE_NMI:
+        push(self, addr, ALDO_CGK_NMI, self->pendings);
+        break;
+    case ALDO_CGE_RESET:
+        while (self->depth > 1) {
+            pop_frame(self);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void compute_inclusive(struct aldo_callgraph_context *self)
+{
+    for (size_t i = 0; i < self->count; ++i) {
+        self->nodes[i].inclusive = self->nodes[i].exclusive;
+    }
+    // children are always added after their parents
+    for (auto i = self->count; i-- > 1;) {
+        auto n = self->nodes + i;
+        self->nodes[n->parent].inclusive += n->inclusive;
+    }
+}
+
+static uint64_t framepeak(const struct cg_node *n)
+{
+    return n->framecycles > n->framepeak ? n->framecycles : n->framepeak;
+}
+
+// a recursive call's cycles are already included in its outermost call
+static bool recursive(struct aldo_callgraph_context *self, size_t node)
+{
+    auto n = self->nodes + node;
+    for (auto p = n->parent; p != NoNode; p = self->nodes[p].parent) {
+        if (self->nodes[p].entry == n->entry
+            && self->nodes[p].kind == n->kind) return true;
+    }
+    return false;
+}
+
+static int routine_cmp(const void *a, const void *b)
+{
+    const struct aldo_cgroutine
+        *lhs = a,
+        *rhs = b;
+    if (lhs->inclusive != rhs->inclusive) {
+        return lhs->inclusive < rhs->inclusive ? 1 : -1;
+    }
+    if (lhs->entry != rhs->entry) return lhs->entry < rhs->entry ? -1 : 1;
+    return (lhs->kind > rhs->kind) - (lhs->kind < rhs->kind);
+}
+
+static int node_name(const struct cg_node *n, char buf[static 12])
+{
+    if (n->kind == ALDO_CGK_CALL) return sprintf(buf, "$%04X", n->entry);
+    return sprintf(buf, "%s:$%04X", kind_name(n->kind), n->entry);
+}
+
+// path is large enough to hold a name for every stack frame
+static bool write_folded(struct aldo_callgraph_context *self, size_t node,
+                         char *path, size_t len, FILE *f)
+{
+    auto n = self->nodes + node;
+    if (len > 0) {
+        path[len++] = ';';
+    }
+    auto written = node_name(n, path + len);
+    if (written < 0) return false;
+    len += (size_t)written;
+    if (n->exclusive > 0
+        && fprintf(f, "%.*s %" PRIu64 "\n", (int)len, path,
+                   n->exclusive) < 0) return false;
+    for (auto c = n->child; c != NoNode; c = self->nodes[c].sibling) {
+        if (!write_folded(self, c, path, len, f)) return false;
+    }
+    return true;
+}
+
+static bool write_json_node(struct aldo_callgraph_context *self, size_t node,
+                            int indent, FILE *f)
+{
+    auto n = self->nodes + node;
+    char name[12];
+    if (node_name(n, name) < 0) return false;
+    if (fprintf(f, "%*s{\"name\": \"%s\", \"kind\": \"%s\", "
+                "\"entry\": %" PRIu16 ", \"calls\": %" PRIu64 ", "
+                "\"inclusive\": %" PRIu64 ", \"exclusive\": %" PRIu64 ", "
+                "\"maxcall\": %" PRIu64 ", \"framepeak\": %" PRIu64,
+                indent, "", name, kind_name(n->kind), n->entry, n->calls,
+                n->inclusive, n->exclusive, n->maxcall,
+                framepeak(n)) < 0) return false;
+    if (n->kind == ALDO_CGK_NMI
+        && fprintf(f, ", \"overruns\": %" PRIu64, n->overruns) < 0) {
+        return false;
+    }
+    if (n->child == NoNode) return fputc('}', f) != EOF;
+
+    if (fputs(", \"children\": [\n", f) == EOF) return false;
+    for (auto c = n->child; c != NoNode; c = self->nodes[c].sibling) {
+        if (!write_json_node(self, c, indent + 2, f)) return false;
+        if (fputs(self->nodes[c].sibling == NoNode ? "\n" : ",\n", f) == EOF) {
+            return false;
+        }
+    }
+    return fprintf(f, "%*s]}", indent, "") >= 0;
+}
+
+//
+// MARK: - Public Interface
+//
+
+// 20 scanlines of 341 dots at 3 dots per CPU cycle
+const uint64_t Aldo_VBlankCycles = (20 * 341) / 3;
+
+aldo_callgraph *aldo_callgraph_new()
+{
+    struct aldo_callgraph_context *self = calloc(1, sizeof *self);
+    return self;
+}
+
+void aldo_callgraph_free(aldo_callgraph *self)
+{
+    assert(self != nullptr);
+
+    free(self->nodes);
+    free(self);
+}
+
+void aldo_callgraph_reset(aldo_callgraph *self)
+{
+    assert(self != nullptr);
+
+    self->count = self->depth = 0;
+    self->frames = self->total = 0;
+    self->pending = ALDO_CGE_NONE;
+}
+
+uint64_t aldo_callgraph_total(aldo_callgraph *self)
+{
+    assert(self != nullptr);
+
+    return self->total;
+}
+
+uint64_t aldo_callgraph_frames(aldo_callgraph *self)
+{
+    assert(self != nullptr);
+
+    return self->frames;
+}
+
+size_t aldo_callgraph_routines(aldo_callgraph *self, size_t n,
+                               struct aldo_cgroutine rs[restrict n])
+{
+    assert(self != nullptr);
+    assert(rs != nullptr);
+
+    if (n == 0 || self->count == 0) return 0;
+
+    struct aldo_cgroutine *all = malloc(self->count * sizeof *all);
+    if (!all) return 0;
+
+    compute_inclusive(self);
+    size_t count = 0;
+    for (size_t i = 0; i < self->count; ++i) {
+        auto node = self->nodes + i;
+        size_t r;
+        for (r = 0; r < count; ++r) {
+            if (all[r].entry == node->entry && all[r].kind == node->kind) break;
+        }
+        if (r == count) {
+            all[count++] = (struct aldo_cgroutine){
+                .kind = node->kind, .entry = node->entry,
+            };
+        }
+        auto routine = all + r;
+        if (!recursive(self, i)) {
+            routine->inclusive += node->inclusive;
+        }
+        routine->exclusive += node->exclusive;
+        routine->calls += node->calls;
+        routine->overruns += node->overruns;
+        if (node->maxcall > routine->maxcall) {
+            routine->maxcall = node->maxcall;
+        }
+        auto peak = framepeak(node);
+        if (peak > routine->framepeak) {
+            routine->framepeak = peak;
+        }
+    }
+    qsort(all, count, sizeof *all, routine_cmp);
+    if (count > n) {
+        count = n;
+    }
+    memcpy(rs, all, count * sizeof *rs);
+    free(all);
+    return count;
+}
+
+bool aldo_callgraph_write_folded(aldo_callgraph *self, FILE *f)
+{
+    assert(self != nullptr);
+    assert(f != nullptr);
+
+    if (self->count == 0) return true;
+
+    // kind prefix + address + separator for every possible frame
+    char path[(MaxDepth + 1) * 12];
+    return write_folded(self, 0, path, 0, f);
+}
+
+bool aldo_callgraph_write_json(aldo_callgraph *self, FILE *f)
+{
+    assert(self != nullptr);
+    assert(f != nullptr);
+
+    if (fprintf(f, "{\"cycles\": %" PRIu64 ", \"frames\": %" PRIu64 ", "
+                "\"vblank_cycles\": %" PRIu64 ", \"root\": ", self->total,
+                self->frames, Aldo_VBlankCycles) < 0) return false;
+    if (self->count == 0) return fputs("null}\n", f) != EOF;
+
+    compute_inclusive(self);
+    if (fputc('\n', f) == EOF || !write_json_node(self, 0, 2, f)) return false;
+    return fputs("\n}\n", f) != EOF;
+}
+
+//
+// MARK: - Internal Interface
+//
+
+void aldo_callgraph_exec(aldo_callgraph *self, uint16_t addr, uint8_t s,
+                         enum aldo_cgevent ev)
+{
+    assert(self != nullptr);
+
+    if (self->depth == 0) {
+        // first fetch after the RESET sequence is the root of the graph
+        if (ev == ALDO_CGE_RESET) return;
+        auto root = add_node(self, NoNode, addr, ALDO_CGK_RESET);
+        if (root == NoNode) return;
+        self->nodes[root].calls = 1;
+        self->stack[self->depth++] = (struct cg_frame){.node = root, .s = s};
+    } else {
+        apply_event(self, addr, s);
+    }
+    self->pending = ev;
+    self->pendings = s;
+}
+
+void aldo_callgraph_cycles(aldo_callgraph *self, int cycles)
+{
+    assert(self != nullptr);
+
+    // cycles before the first instruction fetch (e.g. RESET) are dropped
+    if (self->depth == 0) return;
+
+    auto n = self->nodes + self->stack[self->depth - 1].node;
+    if (n->frame != self->frames) {
+        n->framepeak = framepeak(n);
+        n->framecycles = 0;
+        n->frame = self->frames;
+    }
+    n->exclusive += (uint64_t)cycles;
+    n->framecycles += (uint64_t)cycles;
+    self->total += (uint64_t)cycles;
+}
+
+void aldo_callgraph_frame(aldo_callgraph *self)
+{
+    assert(self != nullptr);
+
+    ++self->frames;
+}
@@ -0,0 +1,102 @@
+//
+//  callgraph.h
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_callgraph_h
+#define Aldo_callgraph_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#define ALDO_CGKIND_X \
+X(CGK_RESET, "RESET") \
+X(CGK_CALL, "JSR") \
+X(CGK_BRK, "BRK") \
+X(CGK_IRQ, "IRQ") \
+X(CGK_NMI, "NMI")
+
+// How a routine was entered
+enum aldo_cgkind {
+#define X(s, n) ALDO_##s,
+    ALDO_CGKIND_X
+#undef X
+};
+
+// Control-flow effect of an instruction as it is fetched
+enum aldo_cgevent {
+    ALDO_CGE_NONE,
+    ALDO_CGE_CALL,      // JSR
+    ALDO_CGE_RETURN,    // RTS, RTI
+    ALDO_CGE_BRK,
+    ALDO_CGE_IRQ,
+    ALDO_CGE_NMI,
+    ALDO_CGE_RESET,
+};
+
+// Cycles attributed to a routine across all of its call sites
+struct aldo_cgroutine {
+    uint64_t
+        inclusive,      // Cycles in routine and its callees
+        exclusive,      // Cycles in routine alone
+        calls,          // Times entered
+        maxcall,        // Most inclusive cycles of a single completed call
+        framepeak,      // Most exclusive cycles within a single frame
+        overruns;       // NMI calls that ran past the end of vblank
+    enum aldo_cgkind kind;
+    uint16_t entry;     // Address of routine's first instruction
+};
+
+typedef struct aldo_callgraph_context aldo_callgraph;
+
+#include "bridgeopen.h"
+//
+// MARK: - Export
+//
+
+// CPU cycles from start of vblank to pre-render line
+aldo_export
+extern const uint64_t Aldo_VBlankCycles;
+
+// if returns null then errno is set due to failed allocation
+aldo_export aldo_ownresult
+aldo_callgraph *aldo_callgraph_new() aldo_nothrow;
+aldo_export
+void aldo_callgraph_free(aldo_callgraph *self) aldo_nothrow;
+
+aldo_export
+void aldo_callgraph_reset(aldo_callgraph *self) aldo_nothrow;
+aldo_export
+uint64_t aldo_callgraph_total(aldo_callgraph *self) aldo_nothrow;
+aldo_export
+uint64_t aldo_callgraph_frames(aldo_callgraph *self) aldo_nothrow;
+// fill rs with up to n routines sorted by most inclusive cycles; returns
+// number of routines filled or 0 if memory could not be allocated.
+aldo_export
+size_t aldo_callgraph_routines(aldo_callgraph *self, size_t n,
+                               struct aldo_cgroutine
+                               rs[aldo_naz(n)]) aldo_nothrow;
+// folded-stack format, one line per call path with its exclusive cycles,
+// suitable for flamegraph tools; returns false on I/O error.
+aldo_export aldo_checkerr
+bool aldo_callgraph_write_folded(aldo_callgraph *self, FILE *f) aldo_nothrow;
+// JSON call tree; returns false on I/O error.
+aldo_export aldo_checkerr
+bool aldo_callgraph_write_json(aldo_callgraph *self, FILE *f) aldo_nothrow;
+
+//
+// MARK: - Internal
+//
+
+// instruction fetched at addr with stack pointer s; the event takes effect
+// on the following fetch once the instruction has completed.
+void aldo_callgraph_exec(aldo_callgraph *self, uint16_t addr, uint8_t s,
+                         enum aldo_cgevent ev) aldo_nothrow;
+void aldo_callgraph_cycles(aldo_callgraph *self, int cycles) aldo_nothrow;
+void aldo_callgraph_frame(aldo_callgraph *self) aldo_nothrow;
+#include "bridgeclose.h"
+
+#endif
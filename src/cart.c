@@ -7,62 +7,63 @@
 
 #include "cart.h"
 
+#include "archive.h"
 #include "bus.h"
 #include "bytes.h"
 #include "mappers.h"
+#include "romcache.h"
 #include "snapshot.h"
 
 #include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #define as_nesmap(cart) ((const struct aldo_nesmapper *)((cart)->mapper))
 
 struct aldo_cartridge {
     struct aldo_mapper *mapper;
     struct aldo_cartinfo info;
+    struct aldo_romimage img;               // Cart ROM points into the image
+    const struct aldo_romimage *shared;     // Cached image, null if
+                                            // caller-owned
 };
 
-static int detect_format(struct aldo_cartridge *self, FILE *f)
+static void detect_format(struct aldo_cartridge *self)
 {
     static const char
         *const restrict nesmagic = "NES\x1a",
         *const restrict nsfmagic = "NESM\x1a";
 
-    // grab first 8 bytes as a string to check file format
-    char format[9];
-
-    if (!fgets(format, sizeof format, f)) {
-        if (feof(f)) return ALDO_CART_ERR_EOF;
-        if (ferror(f)) return ALDO_CART_ERR_IO;
-        return ALDO_CART_ERR_UNKNOWN;
-    }
-
-    if (strncmp(nsfmagic, format, strlen(nsfmagic)) == 0) {
+    auto img = self->img.mem;
+    auto size = self->img.size;
+    if (size >= strlen(nsfmagic)
+        && memcmp(nsfmagic, img, strlen(nsfmagic)) == 0) {
         self->info.format = ALDO_CRTF_NSF;
-    } else if (strncmp(nesmagic, format, strlen(nesmagic)) == 0) {
+    } else if (size >= strlen(nesmagic)
+               && memcmp(nesmagic, img, strlen(nesmagic)) == 0) {
         // NES 2.0 byte 7 matches pattern 0bxxxx10xx
-        self->info.format = ((unsigned char)format[7] & 0xc) == 0x8
+        self->info.format = size > 7 && (img[7] & 0xc) == 0x8
                                 ? ALDO_CRTF_NES20
                                 : ALDO_CRTF_INES;
     } else {
         self->info.format = ALDO_CRTF_RAW;
     }
-
-    // reset back to beginning of file to fully parse detected format
-    return fseek(f, 0, SEEK_SET) == 0 ? 0 : ALDO_CART_ERR_IO;
 }
 
-static int parse_ines(struct aldo_cartridge *self, FILE *f)
+static int parse_ines(struct aldo_cartridge *self)
 {
-    unsigned char header[16];
+    static constexpr size_t headersize = 16;
 
-    if (fread(header, sizeof header[0], sizeof header, f) < sizeof header) {
-        if (feof(f)) return ALDO_CART_ERR_EOF;
-        if (ferror(f)) return ALDO_CART_ERR_IO;
-        return ALDO_CART_ERR_UNKNOWN;
-    }
+    if (self->img.size < headersize) return ALDO_CART_ERR_EOF;
 
+    auto header = self->img.mem;
     // if last 4 bytes of header aren't 0 this is a very old format
     uint32_t tail;
     memcpy(&tail, header + 12, sizeof tail);
@@ -86,26 +87,118 @@ static int parse_ines(struct aldo_cartridge *self, FILE *f)
     info->ines_hdr.wram_blocks = header[8];
     info->ines_hdr.bus_conflicts = header[10] & 0x20;
 
-    auto err = aldo_mapper_ines_create(&self->mapper, &info->ines_hdr, f);
+    struct aldo_romspan rom = {
+        header + headersize,
+        self->img.size - headersize,
+    };
+    auto err = aldo_mapper_ines_create(&self->mapper, &info->ines_hdr, &rom);
     if (err == 0) {
         // TODO: we've found a ROM with extra bytes after CHR data
-        assert(fgetc(f) == EOF && feof(f));
+        assert(rom.size == 0);
     }
     return err;
 }
 
 // A raw ROM image is just a stream of bytes and has no identifying
 // header; if format cannot be determined, this is the default.
-static int parse_raw(struct aldo_cartridge *self, FILE *f)
+static int parse_raw(struct aldo_cartridge *self)
 {
-    auto err = aldo_mapper_raw_create(&self->mapper, f);
+    struct aldo_romspan rom = {self->img.mem, self->img.size};
+    auto err = aldo_mapper_raw_create(&self->mapper, &rom);
     // ROM file is too big for prg address space (no bank-switching)
-    if (err == 0 && !(fgetc(f) == EOF && feof(f))) {
+    if (err == 0 && rom.size > 0) {
         err = ALDO_CART_ERR_IMG_SIZE;
     }
     return err;
 }
 
+static int parse_image(struct aldo_cartridge *self)
+{
+    if (self->img.size == 0) return ALDO_CART_ERR_EOF;
+
+    detect_format(self);
+    switch (self->info.format) {
+    case ALDO_CRTF_INES:
+        return parse_ines(self);
+    case ALDO_CRTF_ALDO:
+    case ALDO_CRTF_NES20:
+    case ALDO_CRTF_NSF:
+        return ALDO_CART_ERR_FORMAT;
+    default:
+        return parse_raw(self);
+    }
+}
+
+// the cart takes the reference to a shared image even if it fails to parse
+static int create(aldo_cart **c, struct aldo_romimage img,
+                  const struct aldo_romimage *shared)
+{
+    struct aldo_cartridge *self = malloc(sizeof *self);
+    if (!self) {
+        if (shared) {
+            aldo_romcache_release(shared);
+        }
+        return ALDO_CART_ERR_ERNO;
+    }
+    *self = (typeof(*self)){.img = img, .shared = shared};
+
+    auto err = parse_image(self);
+    if (err == 0) {
+        *c = self;
+    } else {
+        aldo_cart_free(self);
+    }
+    return err;
+}
+
+// swap the image for the cached copy of its contents before parsing, so
+// identical carts share their ROM; a compressed image is replaced by its
+// decompressed contents, picking the archive entry if given.
+static int create_shared(aldo_cart **c, const uint8_t *mem, size_t size,
+                         enum aldo_romstorage storage, const char *entry)
+{
+    if (aldo_archive_detect(size, mem)) {
+        uint8_t *img;
+        size_t imgsize;
+        auto err = aldo_archive_extract(size, mem, entry, &img, &imgsize);
+        aldo_romcache_free(mem, size, storage);
+        if (err < 0) return err;
+        mem = img;
+        size = imgsize;
+        storage = ALDO_ROMS_HEAP;
+    }
+
+    auto shared = aldo_romcache_intern(mem, size, storage);
+    if (!shared) return ALDO_CART_ERR_ERNO;
+    return create(c, *shared, shared);
+}
+
+static int read_stream(aldo_cart **c, FILE *f, const char *entry)
+{
+    // most carts fit in the first allocation
+    size_t cap = ALDO_MEMBLOCK_64KB, size = 0;
+    uint8_t *img = nullptr;
+    do {
+        if (size == cap) {
+            cap *= 2;
+        }
+        uint8_t *grown = realloc(img, cap);
+        if (!grown) {
+            free(img);
+            return ALDO_CART_ERR_ERNO;
+        }
+        img = grown;
+        size += fread(img + size, sizeof *img, cap - size, f);
+    } while (size == cap);
+    if (ferror(f) || size == 0) {
+        free(img);
+        return ferror(f) ? ALDO_CART_ERR_IO : ALDO_CART_ERR_EOF;
+    }
+    // the image may be kept for a long time so trim the slack
+    uint8_t *fit = realloc(img, size);
+    return create_shared(c, fit ? fit : img, size, ALDO_ROMS_HEAP, entry);
+}
+
 static bool hr(FILE *f)
 {
     return fputs("-----------------------\n", f) != EOF;
@@ -218,32 +311,69 @@ int aldo_cart_create(aldo_cart **c, FILE *f)
     assert(c != nullptr);
     assert(f != nullptr);
 
-    struct aldo_cartridge *self = malloc(sizeof *self);
-    if (!self) return ALDO_CART_ERR_ERNO;
+    return read_stream(c, f, nullptr);
+}
 
-    auto err = detect_format(self, f);
-    if (err == 0) {
-        switch (self->info.format) {
-        case ALDO_CRTF_INES:
-            err = parse_ines(self, f);
-            break;
-        case ALDO_CRTF_ALDO:
-        case ALDO_CRTF_NES20:
-        case ALDO_CRTF_NSF:
-            err = ALDO_CART_ERR_FORMAT;
-            break;
-        default:
-            err = parse_raw(self, f);
-            break;
-        }
+int aldo_cart_create_mem(aldo_cart **c, size_t size,
+                         const uint8_t image[restrict size])
+{
+    assert(c != nullptr);
+    assert(image != nullptr);
+
+    if (!aldo_archive_detect(size, image)) {
+        return create(c, (struct aldo_romimage){image, size}, nullptr);
     }
 
-    if (err == 0) {
-        *c = self;
-    } else {
-        aldo_cart_free(self);
+    // a compressed image cannot be used in place, so decompress a copy
+    uint8_t *img;
+    size_t imgsize;
+    auto err = aldo_archive_extract(size, image, nullptr, &img, &imgsize);
+    if (err < 0) return err;
+    return create_shared(c, img, imgsize, ALDO_ROMS_HEAP, nullptr);
+}
+
+int aldo_cart_create_file(aldo_cart **c, const char *path)
+{
+    assert(c != nullptr);
+    assert(path != nullptr);
+
+    auto fd = open(path, O_RDONLY);
+    // a missing path may name an entry inside an archive as archive#entry
+    const char *entry = nullptr, *sep = strrchr(path, '#');
+    if (fd < 0 && errno == ENOENT && sep) {
+        auto len = (size_t)(sep - path);
+        char *archive = malloc(len + 1);
+        if (!archive) return ALDO_CART_ERR_ERNO;
+        memcpy(archive, path, len);
+        archive[len] = '\0';
+        fd = open(archive, O_RDONLY);
+        free(archive);
+        entry = sep + 1;
     }
-    return err;
+    if (fd < 0) return ALDO_CART_ERR_ERNO;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        close(fd);
+        return ALDO_CART_ERR_ERNO;
+    }
+    // pipes, devices, and empty files cannot be mapped so read them instead
+    if (!S_ISREG(st.st_mode) || st.st_size == 0) {
+        auto f = fdopen(fd, "rb");
+        if (!f) {
+            close(fd);
+            return ALDO_CART_ERR_ERNO;
+        }
+        auto err = read_stream(c, f, entry);
+        fclose(f);
+        return err;
+    }
+
+    auto size = (size_t)st.st_size;
+    auto img = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (img == MAP_FAILED) return ALDO_CART_ERR_ERNO;
+    return create_shared(c, img, size, ALDO_ROMS_MAPPED, entry);
 }
 
 void aldo_cart_free(aldo_cart *self)
@@ -253,6 +383,9 @@ void aldo_cart_free(aldo_cart *self)
     if (self->mapper) {
         self->mapper->dtor(self->mapper);
     }
+    if (self->shared) {
+        aldo_romcache_release(self->shared);
+    }
     free(self);
 }
 
@@ -343,10 +476,10 @@ struct aldo_blockview aldo_cart_chrblock(aldo_cart *self, size_t i)
     struct aldo_blockview bv = {.ord = i};
     if (!is_nes(self)) return bv;
 
-    auto chr = as_nesmap(self)->chrrom(self->mapper);
+    // CHR RAM carts have no CHR ROM accessor
     if (i < self->info.ines_hdr.chr_blocks) {
         bv.size = ALDO_MEMBLOCK_8KB;
-        bv.mem = chr + (i * bv.size);
+        bv.mem = as_nesmap(self)->chrrom(self->mapper) + (i * bv.size);
     }
     return bv;
 }
@@ -396,6 +529,55 @@ void aldo_cart_vbus_disconnect(aldo_cart *self, aldo_bus *b)
     }
 }
 
+ptrdiff_t aldo_cart_prgaddr(aldo_cart *self, uint16_t addr)
+{
+    assert(self != nullptr);
+    assert(self->mapper != nullptr);
+
+    return self->mapper->prgaddr
+            ? self->mapper->prgaddr(self->mapper, addr)
+            : -1;
+}
+
+ptrdiff_t aldo_cart_chraddr(aldo_cart *self, uint16_t addr)
+{
+    assert(self != nullptr);
+    assert(self->mapper != nullptr);
+
+    if (!is_nes(self)) return -1;
+
+    auto m = as_nesmap(self);
+    return m->chraddr ? m->chraddr(self->mapper, addr) : -1;
+}
+
+size_t aldo_cart_ramsize(aldo_cart *self)
+{
+    assert(self != nullptr);
+    assert(self->mapper != nullptr);
+
+    return self->mapper->ramsize ? self->mapper->ramsize(self->mapper) : 0;
+}
+
+void aldo_cart_ramsave(aldo_cart *self, uint8_t *buf)
+{
+    assert(self != nullptr);
+    assert(self->mapper != nullptr);
+
+    if (self->mapper->ramsave) {
+        self->mapper->ramsave(self->mapper, buf);
+    }
+}
+
+void aldo_cart_ramload(aldo_cart *self, const uint8_t *buf)
+{
+    assert(self != nullptr);
+    assert(self->mapper != nullptr);
+
+    if (self->mapper->ramload) {
+        self->mapper->ramload(self->mapper, buf);
+    }
+}
+
 int aldo_cart_write_dis_header(aldo_cart *self, const char *restrict name,
                                FILE *f)
 {
@@ -70,7 +70,9 @@ X(CART_ERR_OBSOLETE, -5, "OBSOLETE FORMAT") \
 X(CART_ERR_FORMAT, -6, "FORMAT UNSUPPORTED") \
 X(CART_ERR_FMT, -7, "FORMATTED OUTPUT FAILURE") \
 X(CART_ERR_NOCART, -8, "NO CART") \
-X(CART_ERR_ERNO, -9, "SYSTEM ERROR")
+X(CART_ERR_ERNO, -9, "SYSTEM ERROR") \
+X(CART_ERR_ARCHIVE, -10, "NO ROM IN ARCHIVE") \
+X(CART_ERR_INFLATE, -11, "CORRUPT COMPRESSED IMAGE")
 
 enum {
 #define X(s, v, e) ALDO_##s = v,
@@ -91,13 +93,33 @@ typedef struct aldo_cartridge aldo_cart;
 //
 
 aldo_const size_t AldoCartFmtSize = 17;
+// start of cart WRAM (PRG RAM) in CPU address space, ends at $7FFF
+aldo_const uint16_t AldoWramStartAddr = 0x6000;
 
 aldo_export
 const char *aldo_cart_errstr(int err) aldo_nothrow;
 
-// if returns non-zero error code, *c is unmodified
+// if create functions return non-zero error code, *c is unmodified
+// Stream and file images go through the process-wide ROM cache
+// (romcache.h) so carts with identical contents share one copy of ROM.
+// Images compressed with gzip or zip are detected by signature and
+// decompressed into a cached copy; zip archives load their first .nes
+// entry.
+// read the entire image from f
 aldo_export aldo_checkerr
 int aldo_cart_create(aldo_cart **c, FILE *f) aldo_nothrow;
+// use image in place without copying or caching, unless compressed; image
+// must outlive the cart.
+aldo_export aldo_checkerr
+int aldo_cart_create_mem(aldo_cart **c, size_t size,
+                         const uint8_t image[aldo_naz(size)]) aldo_nothrow;
+// map the file at path read-only, falling back to reading it if it cannot
+// be mapped; the file must not be truncated while the cart is loaded.
+// If path does not exist but has the form archive.zip#entry.nes the named
+// zip entry is loaded instead.
+aldo_export aldo_checkerr
+int aldo_cart_create_file(aldo_cart **c,
+                          const char *aldo_noalias path) aldo_nothrow;
 aldo_export
 void aldo_cart_free(aldo_cart *self) aldo_nothrow;
 
@@ -127,6 +149,16 @@ void aldo_cart_mbus_disconnect(aldo_cart *self, aldo_bus *b) aldo_nothrow;
 bool aldo_cart_vbus_connect(aldo_cart *self, aldo_bus *b) aldo_nothrow;
 void aldo_cart_vbus_disconnect(aldo_cart *self, aldo_bus *b) aldo_nothrow;
 
+// PRG ROM offset currently mapped to CPU address addr,
+// < 0 if addr is not mapped to PRG ROM.
+ptrdiff_t aldo_cart_prgaddr(aldo_cart *self, uint16_t addr) aldo_nothrow;
+// CHR ROM offset currently mapped to PPU address addr,
+// < 0 if addr is not mapped to CHR ROM.
+ptrdiff_t aldo_cart_chraddr(aldo_cart *self, uint16_t addr) aldo_nothrow;
+// size of writable cart memory (CHR RAM, WRAM) copied by save/load
+size_t aldo_cart_ramsize(aldo_cart *self) aldo_nothrow;
+void aldo_cart_ramsave(aldo_cart *self, uint8_t *buf) aldo_nothrow;
+void aldo_cart_ramload(aldo_cart *self, const uint8_t *buf) aldo_nothrow;
 int aldo_cart_write_dis_header(aldo_cart *self, const char *aldo_noalias name,
                                FILE *f) aldo_nothrow;
 void aldo_cart_snapshot(aldo_cart *self,
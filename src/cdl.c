@@ -0,0 +1,209 @@
+//
+//  cdl.c
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "cdl.h"
+
+#include "bytes.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct aldo_cdl_context {
+    uint8_t *prg, *chr;
+    size_t prgsize, chrsize;
+    bool indjump;   // Last opcode was an indirect jump
+};
+
+static size_t rom_size(aldo_cart *cart,
+                       struct aldo_blockview (*block)(aldo_cart *, size_t))
+{
+    size_t size = 0;
+    for (auto bv = block(cart, 0); bv.mem; bv = block(cart, bv.ord + 1)) {
+        size += bv.size;
+    }
+    return size;
+}
+
+static uint8_t bank_bits(uint16_t addr)
+{
+    // only the $8000-$FFFF banks are encoded, PRG mapped below that
+    // (e.g. raw ROM images) counts as the first bank.
+    return addr < ALDO_MEMBLOCK_32KB ? 0 : (uint8_t)((addr >> 11) & 0xc);
+}
+
+static void mark_prg(struct aldo_cdl_context *self, uint16_t addr,
+                     ptrdiff_t prgaddr, uint8_t flags)
+{
+    if (prgaddr < 0 || (size_t)prgaddr >= self->prgsize) return;
+    self->prg[prgaddr] |= flags | bank_bits(addr);
+}
+
+static size_t count_flag(size_t size, const uint8_t mem[size], uint8_t flag)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < size; ++i) {
+        count += (mem[i] & flag) != 0;
+    }
+    return count;
+}
+
+//
+// MARK: - Public Interface
+//
+
+aldo_cdl *aldo_cdl_new(aldo_cart *cart)
+{
+    assert(cart != nullptr);
+
+    struct aldo_cdl_context *self = malloc(sizeof *self);
+    if (!self) return self;
+
+    self->prgsize = rom_size(cart, aldo_cart_prgblock);
+    self->chrsize = rom_size(cart, aldo_cart_chrblock);
+    self->indjump = false;
+    // allocate at least 1 byte to always have a valid pointer
+    self->prg = calloc(self->prgsize ? self->prgsize : 1, sizeof *self->prg);
+    self->chr = calloc(self->chrsize ? self->chrsize : 1, sizeof *self->chr);
+    if (!self->prg || !self->chr) {
+        aldo_cdl_free(self);
+        return nullptr;
+    }
+    return self;
+}
+
+void aldo_cdl_free(aldo_cdl *self)
+{
+    assert(self != nullptr);
+
+    free(self->chr);
+    free(self->prg);
+    free(self);
+}
+
+void aldo_cdl_reset(aldo_cdl *self)
+{
+    assert(self != nullptr);
+
+    memset(self->prg, 0, self->prgsize);
+    memset(self->chr, 0, self->chrsize);
+    self->indjump = false;
+}
+
+uint8_t aldo_cdl_prg(aldo_cdl *self, size_t prgaddr)
+{
+    assert(self != nullptr);
+
+    return prgaddr < self->prgsize ? self->prg[prgaddr] : 0;
+}
+
+uint8_t aldo_cdl_chr(aldo_cdl *self, size_t chraddr)
+{
+    assert(self != nullptr);
+
+    return chraddr < self->chrsize ? self->chr[chraddr] : 0;
+}
+
+struct aldo_cdl_coverage aldo_cdl_coverage(aldo_cdl *self)
+{
+    assert(self != nullptr);
+
+    return (struct aldo_cdl_coverage){
+        .prgsize = self->prgsize,
+        .code = count_flag(self->prgsize, self->prg, ALDO_CDL_CODE),
+        .data = count_flag(self->prgsize, self->prg, ALDO_CDL_DATA),
+        .chrsize = self->chrsize,
+        .rendered = count_flag(self->chrsize, self->chr, ALDO_CDL_RENDERED),
+        .read = count_flag(self->chrsize, self->chr, ALDO_CDL_READ),
+    };
+}
+
+bool aldo_cdl_read(aldo_cdl *self, FILE *f)
+{
+    assert(self != nullptr);
+    assert(f != nullptr);
+
+    // read one extra byte to detect files larger than the cart
+    auto size = self->prgsize + self->chrsize;
+    uint8_t *buf = malloc(size + 1);
+    if (!buf) return false;
+
+    auto count = fread(buf, sizeof *buf, size + 1, f);
+    auto ok = !ferror(f) && count == size;
+    if (ok) {
+        for (size_t i = 0; i < self->prgsize; ++i) {
+            self->prg[i] |= buf[i];
+        }
+        for (size_t i = 0; i < self->chrsize; ++i) {
+            self->chr[i] |= buf[self->prgsize + i];
+        }
+    }
+    free(buf);
+    return ok;
+}
+
+bool aldo_cdl_write(aldo_cdl *self, FILE *f)
+{
+    assert(self != nullptr);
+    assert(f != nullptr);
+
+    uint8_t buf[ALDO_MEMBLOCK_1KB];
+    for (size_t i = 0; i < self->prgsize; i += sizeof buf) {
+        auto count = self->prgsize - i < sizeof buf
+                        ? self->prgsize - i
+                        : sizeof buf;
+        for (size_t j = 0; j < count; ++j) {
+            buf[j] = self->prg[i + j] & (uint8_t)~ALDO_CDL_OPCODE;
+        }
+        if (fwrite(buf, sizeof buf[0], count, f) < count) return false;
+    }
+    return fwrite(self->chr, sizeof *self->chr, self->chrsize, f)
+            == self->chrsize;
+}
+
+//
+// MARK: - Internal Interface
+//
+
+size_t aldo_cdl_datarun(aldo_cdl *self, size_t prgaddr, size_t max)
+{
+    assert(self != nullptr);
+
+    size_t count = 0;
+    for (; count < max && prgaddr + count < self->prgsize; ++count) {
+        auto flags = self->prg[prgaddr + count];
+        if (!(flags & ALDO_CDL_DATA) || (flags & ALDO_CDL_CODE)) break;
+    }
+    return count;
+}
+
+void aldo_cdl_opcode(aldo_cdl *self, uint16_t addr, ptrdiff_t prgaddr,
+                     bool indirect)
+{
+    assert(self != nullptr);
+
+    mark_prg(self, addr, prgaddr,
+             ALDO_CDL_CODE | ALDO_CDL_OPCODE
+             | (self->indjump ? ALDO_CDL_INDCODE : 0));
+    self->indjump = indirect;
+}
+
+void aldo_cdl_cpuread(aldo_cdl *self, uint16_t addr, ptrdiff_t prgaddr,
+                      uint8_t flags)
+{
+    assert(self != nullptr);
+
+    mark_prg(self, addr, prgaddr, flags);
+}
+
+void aldo_cdl_ppuread(aldo_cdl *self, ptrdiff_t chraddr, uint8_t flags)
+{
+    assert(self != nullptr);
+
+    if (chraddr < 0 || (size_t)chraddr >= self->chrsize) return;
+    self->chr[chraddr] |= flags;
+}
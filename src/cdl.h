@@ -0,0 +1,88 @@
+//
+//  cdl.h
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_cdl_h
+#define Aldo_cdl_h
+
+#include "cart.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// PRG flags, same bit layout as the de facto (FCEUX) CDL file format
+enum {
+    ALDO_CDL_CODE = 0x1,        // Executed as opcode or read as operand
+    ALDO_CDL_DATA = 0x2,        // Read as data
+    ALDO_CDL_BANK = 0xc,        // CPU bank accessed through:
+                                // $8000, $A000, $C000, $E000
+    ALDO_CDL_INDCODE = 0x10,    // Opcode reached by indirect jump
+    ALDO_CDL_INDDATA = 0x20,    // Data read by indirect addressing
+    ALDO_CDL_PCM = 0x40,        // DMC sample data
+    ALDO_CDL_OPCODE = 0x80,     // Executed as opcode; not written to files
+};
+
+// CHR flags
+enum {
+    ALDO_CDL_RENDERED = 0x1,    // Fetched by PPU for rendering
+    ALDO_CDL_READ = 0x2,        // Read by CPU through PPUDATA
+};
+
+// Byte counts of logged ROM
+struct aldo_cdl_coverage {
+    size_t prgsize, code, data, chrsize, rendered, read;
+};
+
+typedef struct aldo_cdl_context aldo_cdl;
+
+#include "bridgeopen.h"
+//
+// MARK: - Export
+//
+
+// sized to cart's PRG and CHR ROM; if returns null then errno is set
+// due to failed allocation.
+aldo_export aldo_ownresult
+aldo_cdl *aldo_cdl_new(aldo_cart *cart) aldo_nothrow;
+aldo_export
+void aldo_cdl_free(aldo_cdl *self) aldo_nothrow;
+
+aldo_export
+void aldo_cdl_reset(aldo_cdl *self) aldo_nothrow;
+aldo_export
+uint8_t aldo_cdl_prg(aldo_cdl *self, size_t prgaddr) aldo_nothrow;
+aldo_export
+uint8_t aldo_cdl_chr(aldo_cdl *self, size_t chraddr) aldo_nothrow;
+aldo_export
+struct aldo_cdl_coverage aldo_cdl_coverage(aldo_cdl *self) aldo_nothrow;
+// merge a CDL file into the current log; returns false on I/O error,
+// failed allocation, or if file size does not match the cart's ROM size,
+// leaving the log unmodified.
+aldo_export aldo_checkerr
+bool aldo_cdl_read(aldo_cdl *self, FILE *f) aldo_nothrow;
+// write PRG then CHR flags; returns false on I/O error
+aldo_export aldo_checkerr
+bool aldo_cdl_write(aldo_cdl *self, FILE *f) aldo_nothrow;
+
+//
+// MARK: - Internal
+//
+
+// length of the data-only run starting at prgaddr, up to max bytes
+size_t aldo_cdl_datarun(aldo_cdl *self, size_t prgaddr,
+                        size_t max) aldo_nothrow;
+// CPU opcode fetch at addr; indirect marks the next opcode as the
+// target of an indirect jump.
+void aldo_cdl_opcode(aldo_cdl *self, uint16_t addr, ptrdiff_t prgaddr,
+                     bool indirect) aldo_nothrow;
+void aldo_cdl_cpuread(aldo_cdl *self, uint16_t addr, ptrdiff_t prgaddr,
+                      uint8_t flags) aldo_nothrow;
+void aldo_cdl_ppuread(aldo_cdl *self, ptrdiff_t chraddr,
+                      uint8_t flags) aldo_nothrow;
+#include "bridgeclose.h"
+
+#endif
@@ -7,11 +7,15 @@
 
 #include "argparse.h"
 
+#include "bench.h"
 #include "bytes.h"
 #include "cliargs.h"
 #include "debug.h"
 #include "dis.h"
+#include "framesout.h"
 #include "haltexpr.h"
+#include "romindex.h"
+#include "testrom.h"
 
 #include <assert.h>
 #include <errno.h>
@@ -24,30 +28,56 @@
 static const char
     *const restrict BatchLong = "--batch",
     *const restrict BcdLong = "--bcd",
+    *const restrict BenchLong = "--bench",
+    *const restrict CallGraphLong = "--call-graph",
+    *const restrict CdlLong = "--cdl",
     *const restrict ChrDecodeLong = "--chr-decode",
+    *const restrict ChrPngLong = "--chr-png",
     *const restrict ChrScaleLong = "--chr-scale",
     *const restrict DebugFileLong = "--dbg-file",
     *const restrict DisassembleLong = "--disassemble",
+    *const restrict FrameHashesLong = "--frame-hashes",
+    *const restrict FrameRangeLong = "--frame-range",
+    *const restrict FramesOutLong = "--frames-out",
     *const restrict HaltLong = "--halt",
     *const restrict HelpLong = "--help",
+    *const restrict IndexLong = "--index",
     *const restrict InfoLong = "--info",
+    *const restrict ProfileLong = "--profile",
     *const restrict ResVectorLong = "--reset-vector",
+    *const restrict ServeLong = "--serve",
+    *const restrict TestRomsLong = "--test-roms",
     *const restrict TraceLong = "--trace",
+    *const restrict TraceCmpLong = "--trace-compare",
+    *const restrict VerifyHashesLong = "--verify-hashes",
     *const restrict VersionLong = "--version",
     *const restrict ZeroRamLong = "--zero-ram";
 
 constexpr char BatchShort = 'b';
 constexpr char BcdShort = 'D';
+constexpr char BenchShort = 'B';
+constexpr char CallGraphShort = 'G';
+constexpr char CdlShort = 'L';
 constexpr char ChrDecodeShort = 'c';
+constexpr char ChrPngShort = 'P';
 constexpr char ChrScaleShort = 's';
 constexpr char DebugFileShort = 'g';
 constexpr char DisassembleShort = 'd';
+constexpr char FrameHashesShort = 'F';
+constexpr char FrameRangeShort = 'R';
+constexpr char FramesOutShort = 'o';
 constexpr char HaltShort = 'H';
 constexpr char HelpShort = 'h';
+constexpr char IndexShort = 'I';
 constexpr char InfoShort = 'i';
+constexpr char ProfileShort = 'p';
 constexpr char ResVectorShort = 'r';
+constexpr char ServeShort = 'S';
+constexpr char TestRomsShort = 'u';
 constexpr char TraceShort = 't';
+constexpr char TraceCmpShort = 'T';
 constexpr char VerboseShort = 'v';
+constexpr char VerifyHashesShort = 'Y';
 constexpr char VersionShort = 'V';
 constexpr char ZeroRamShort = 'z';
 
@@ -57,7 +87,10 @@ constexpr auto MaxAddress = ALDO_ADDRMASK_64KB;
 static void init_cliargs(struct cliargs *args)
 {
     *args = (typeof(*args)){
+        .benchframes = BenchDefaultFrames,
         .chrscale = Aldo_MinChrScale,
+        .framelast = FramesNoLast,
+        .framestride = 1,
         .resetvector = Aldo_NoResetVector,
     };
 }
@@ -154,22 +187,66 @@ static bool parse_halt(const char *arg, int *restrict argi, int argc,
     return false;
 }
 
-static bool parse_dbgfile(const char *arg, int *restrict argi, int argc,
-                          char *argv[argc+1], struct cliargs *restrict args)
+static bool parse_file(const char *arg, struct cliargs *args)
 {
-    auto optlen = strlen(DebugFileLong);
-    if (arg[1] == DebugFileShort && arg[2] != '\0') {
-        args->dbgfilepath = arg + 2;
-    } else if (strncmp(arg, DebugFileLong, optlen) == 0) {
+    struct filearg **tail;
+    for (tail = &args->filelist; *tail; tail = &(*tail)->next);
+    if ((*tail = malloc(sizeof **tail))) {
+        **tail = (typeof(**tail)){.path = arg};
+        args->filepath = arg;
+        return true;
+    }
+    perror("File argument parse failed");
+    return false;
+}
+
+static bool parse_filepath(const char *arg, int *restrict argi, int argc,
+                           char *argv[argc+1], char shrt,
+                           const char *restrict lng, const char **path)
+{
+    auto optlen = strlen(lng);
+    if (arg[1] == shrt && arg[2] != '\0') {
+        *path = arg + 2;
+    } else if (strncmp(arg, lng, optlen) == 0) {
         const char *opt = strchr(arg, '=');
         if (opt && opt - arg == (ptrdiff_t)optlen) {
-            args->dbgfilepath = opt + 1;
+            *path = opt + 1;
         }
     }
-    if (!args->dbgfilepath && ++*argi < argc) {
-        args->dbgfilepath = argv[*argi];
+    if (!*path && ++*argi < argc) {
+        *path = argv[*argi];
     }
-    return args->dbgfilepath;
+    return *path;
+}
+
+// first[:last[:stride]], last may be empty for no last frame
+static bool convert_range(const char *restrict range,
+                          struct cliargs *restrict args)
+{
+    static constexpr size_t rangesize = 64;
+
+    if (strlen(range) >= rangesize) return false;
+    char buf[rangesize];
+    strcpy(buf, range);
+    long fields[] = {0, FramesNoLast, 1};
+    size_t count = 0;
+    for (char *field = buf, *sep; field; field = sep) {
+        if ((sep = strchr(field, ':'))) {
+            *sep++ = '\0';
+        }
+        if (count == aldo_arrsz(fields)) return false;
+        if (!(count == 1 && *field == '\0')
+            && !convert_num(field, 10, fields + count)) return false;
+        ++count;
+    }
+    long first = fields[0], last = fields[1], stride = fields[2];
+    if (first < 0 || first > INT_MAX
+        || (last != FramesNoLast && (last < first || last > INT_MAX))
+        || stride < 1 || stride > INT_MAX) return false;
+    args->framefirst = (int)first;
+    args->framelast = (int)last;
+    args->framestride = (int)stride;
+    return true;
 }
 
 static bool parse_arg(const char *arg, int *restrict argi, int argc,
@@ -199,7 +276,53 @@ static bool parse_arg(const char *arg, int *restrict argi, int argc,
     }
 
     if (parse_flag(arg, DebugFileShort, true, DebugFileLong)) {
-        return parse_dbgfile(arg, argi, argc, argv, args);
+        return parse_filepath(arg, argi, argc, argv, DebugFileShort,
+                              DebugFileLong, &args->dbgfilepath);
+    }
+
+    if (parse_flag(arg, CallGraphShort, true, CallGraphLong)) {
+        return parse_filepath(arg, argi, argc, argv, CallGraphShort,
+                              CallGraphLong, &args->callgraphpath);
+    }
+
+    if (parse_flag(arg, CdlShort, true, CdlLong)) {
+        return parse_filepath(arg, argi, argc, argv, CdlShort, CdlLong,
+                              &args->cdlpath);
+    }
+
+    if (parse_flag(arg, ProfileShort, true, ProfileLong)) {
+        return parse_filepath(arg, argi, argc, argv, ProfileShort,
+                              ProfileLong, &args->profilepath);
+    }
+
+    if (parse_flag(arg, FramesOutShort, true, FramesOutLong)) {
+        return parse_filepath(arg, argi, argc, argv, FramesOutShort,
+                              FramesOutLong, &args->framesoutpath);
+    }
+
+    if (parse_flag(arg, FrameHashesShort, true, FrameHashesLong)) {
+        return parse_filepath(arg, argi, argc, argv, FrameHashesShort,
+                              FrameHashesLong, &args->framehashpath);
+    }
+
+    if (parse_flag(arg, VerifyHashesShort, true, VerifyHashesLong)) {
+        return parse_filepath(arg, argi, argc, argv, VerifyHashesShort,
+                              VerifyHashesLong, &args->verifyhashpath);
+    }
+
+    if (parse_flag(arg, FrameRangeShort, true, FrameRangeLong)) {
+        const char *range = nullptr;
+        if (parse_filepath(arg, argi, argc, argv, FrameRangeShort,
+                           FrameRangeLong, &range)
+            && convert_range(range, args)) return true;
+        fputs("Invalid frame range format: expected first[:last[:stride]]\n",
+              stderr);
+        return false;
+    }
+
+    if (parse_flag(arg, TraceCmpShort, true, TraceCmpLong)) {
+        return parse_filepath(arg, argi, argc, argv, TraceCmpShort,
+                              TraceCmpLong, &args->tracecmppath);
     }
 
     setflag(args->chrdecode, arg, ChrDecodeShort, ChrDecodeLong);
@@ -211,8 +334,67 @@ static bool parse_arg(const char *arg, int *restrict argi, int argc,
         }
     }
 
+    setflag(args->bench, arg, BenchShort, BenchLong);
+    auto benchoptlen = strlen(BenchLong);
+    if (strncmp(arg, BenchLong, benchoptlen) == 0) {
+        const char *opt = strchr(arg, '=');
+        if (opt && opt - arg == (ptrdiff_t)benchoptlen) {
+            long frames;
+            if (!convert_num(opt + 1, 10, &frames) || frames < 1
+                || frames > INT_MAX) {
+                fprintf(stderr, "Invalid frame count: expected [1, %d]\n",
+                        INT_MAX);
+                return false;
+            }
+            args->benchframes = (int)frames;
+        }
+    }
+
+    setflag(args->serve, arg, ServeShort, ServeLong);
+    auto serveoptlen = strlen(ServeLong);
+    if (strncmp(arg, ServeLong, serveoptlen) == 0) {
+        const char *opt = strchr(arg, '=');
+        if (opt && opt - arg == (ptrdiff_t)serveoptlen) {
+            if (opt[1] == '\0') {
+                fputs("Expected socket path\n", stderr);
+                return false;
+            }
+            args->servepath = opt + 1;
+        }
+    }
+
+    setflag(args->index, arg, IndexShort, IndexLong);
+    auto indexoptlen = strlen(IndexLong);
+    if (strncmp(arg, IndexLong, indexoptlen) == 0) {
+        const char *opt = strchr(arg, '=');
+        if (opt && opt - arg == (ptrdiff_t)indexoptlen) {
+            if (opt[1] == '\0') {
+                fputs("Expected index path\n", stderr);
+                return false;
+            }
+            args->indexpath = opt + 1;
+        }
+    }
+
+    setflag(args->testroms, arg, TestRomsShort, TestRomsLong);
+    auto testoptlen = strlen(TestRomsLong);
+    if (strncmp(arg, TestRomsLong, testoptlen) == 0) {
+        const char *opt = strchr(arg, '=');
+        if (opt && opt - arg == (ptrdiff_t)testoptlen) {
+            long jobs;
+            if (!convert_num(opt + 1, 10, &jobs) || jobs < 1
+                || jobs > TestRomMaxJobs) {
+                fprintf(stderr, "Invalid job count: expected [1, %d]\n",
+                        TestRomMaxJobs);
+                return false;
+            }
+            args->testjobs = (int)jobs;
+        }
+    }
+
     setflag(args->batch, arg, BatchShort, BatchLong);
     setflag(args->bcdsupport, arg, BcdShort, BcdLong);
+    setflag(args->chrpng, arg, ChrPngShort, ChrPngLong);
     setflag(args->disassemble, arg, DisassembleShort, DisassembleLong);
     setflag(args->help, arg, HelpShort, HelpLong);
     setflag(args->info, arg, InfoShort, InfoLong);
@@ -251,8 +433,9 @@ bool argparse_parse(struct cliargs *restrict args, int argc,
                     argparse_cleanup(args);
                     return false;
                 }
-            } else {
-                args->filepath = arg;
+            } else if (!parse_file(arg, args)) {
+                argparse_cleanup(args);
+                return false;
             }
         }
     } else {
@@ -287,43 +470,103 @@ void argparse_usage(const char *me)
            BatchLong);
     printf("  -%-*c: enable BCD (binary-coded decimal) support (%s)\n", cpad,
            BcdShort, BcdLong);
+    sprintf(buf, "-%c f", CallGraphShort);
+    printf("  %-*s: track subroutine calls and write folded stacks to f,\n"
+           "  %-*s  or a JSON call tree if f ends in .json (%s f)\n", spad,
+           buf, spad, "", CallGraphLong);
+    sprintf(buf, "-%c f", CdlShort);
+    printf("  %-*s: log PRG/CHR code and data coverage to f, merging any\n"
+           "  %-*s  existing log; with -%c list logged data as data (%s f)\n",
+           spad, buf, spad, "", DisassembleShort, CdlLong);
     sprintf(buf, "-%c f", DebugFileShort);
     printf("  %-*s: line-delimited debugger file containing halt conditions\n"
            "  %-*s  and/or RESET vector override (%s f)\n", spad, buf, spad,
            "", DebugFileLong);
+    sprintf(buf, "-%c f", FrameHashesShort);
+    printf("  %-*s: write a hash of the screen, RAM, and VRAM at every\n"
+           "  %-*s  frame to log f (%s f)\n", spad, buf, spad, "",
+           FrameHashesLong);
+    sprintf(buf, "-%c f", FramesOutShort);
+    printf("  %-*s: write video frames to f: a Y4M stream if f is - (stdout)\n"
+           "  %-*s  or ends in .y4m, PNG files if f ends in .png, otherwise\n"
+           "  %-*s  raw palette indices; f may contain a %%d frame number\n"
+           "  %-*s  and must for PNG output; - implies batch mode and\n"
+           "  %-*s  moves text reports to stderr (%s f)\n", spad, buf,
+           spad, "", spad, "", spad, "", spad, "", FramesOutLong);
+    sprintf(buf, "-%c r", FrameRangeShort);
+    printf("  %-*s: frames to write with -%c as first[:last[:stride]],\n"
+           "  %-*s  numbered from 0 at power-up (%s r)\n", spad, buf,
+           FramesOutShort, spad, "", FrameRangeLong);
     sprintf(buf, "-%c e", HaltShort);
     printf("  %-*s: halt condition expression (%s e);\n"
            "  %-*s  multiple -%c options can be specified,\n"
            "  %-*s  see below usage section for syntax\n", spad, buf,
            HaltLong, spad, "", HaltShort, spad, "");
+    sprintf(buf, "-%c f", ProfileShort);
+    printf("  %-*s: profile CPU cycles and write annotated disassembly\n"
+           "  %-*s  and hot spots to f on exit (%s f)\n", spad, buf, spad,
+           "", ProfileLong);
+    printf("  -%-*c: decode CHR ROM into PNG rather than BMP files (%s)\n",
+           cpad, ChrPngShort, ChrPngLong);
     sprintf(buf, "-%c x", ResVectorShort);
     printf("  %-*s: override RESET vector [0x%X, 0x%X] (%s x)\n", spad, buf,
            MinAddress, MaxAddress, ResVectorLong);
     sprintf(buf, "-%c n", ChrScaleShort);
-    printf("  %-*s: CHR ROM BMP scaling factor [%d, %d] (%s n)\n", spad, buf,
+    printf("  %-*s: CHR ROM image scaling factor [%d, %d] (%s n)\n", spad, buf,
            Aldo_MinChrScale, Aldo_MaxChrScale, ChrScaleLong);
     printf("  -%-*c: turn on trace-logging and ram dumps (%s)\n", cpad,
            TraceShort, TraceLong);
+    sprintf(buf, "-%c f", TraceCmpShort);
+    printf("  %-*s: compare trace against golden log f in batch mode,\n"
+           "  %-*s  halting at first divergence (%s f)\n", spad, buf, spad,
+           "", TraceCmpLong);
+    sprintf(buf, "-%c f", VerifyHashesShort);
+    printf("  %-*s: compare frame hashes against reference log f (from\n"
+           "  %-*s  -%c) in batch mode, halting at first divergence (%s f)\n",
+           spad, buf, spad, "", FrameHashesShort, VerifyHashesLong);
     printf("  -%-*c: verbose output\n", cpad, VerboseShort);
     printf("  -%-*c: zero-out RAM on startup (%s)\n", cpad, ZeroRamShort,
            ZeroRamLong);
 
     puts("\ncommands (--alt)");
-    printf("  -%-*c: decode CHR ROM into BMP files (%s[=prefix]);\n"
+    printf("  -%-*c: benchmark unthrottled emulation, timing %d runs of\n"
+           "  %-*s  n frames after %d warmup frames; prints a table and\n"
+           "  %-*s  writes bench.json (%s[=n]); n default is %d\n", cpad,
+           BenchShort, BenchRuns, spad, "", BenchWarmupFrames, spad, "",
+           BenchLong, BenchDefaultFrames);
+    printf("  -%-*c: decode CHR ROM into BMP or PNG files (%s[=prefix]);\n"
            "  %-*s  prefix default is 'chr'\n", cpad, ChrDecodeShort,
            ChrDecodeLong, spad, "");
     printf("  -%-*c: disassemble file (%s);\n"
            "  %-*s  with -%c for duplicate lines\n", cpad, DisassembleShort,
            DisassembleLong, spad, "", VerboseShort);
     printf("  -%-*c: print usage (%s)\n", cpad, HelpShort, HelpLong);
+    printf("  -%-*c: index every .nes, .gz, and .zip cart under directory\n"
+           "  %-*s  file in parallel, re-reading only files whose size or\n"
+           "  %-*s  mtime changed (%s[=path]); path default is\n"
+           "  %-*s  file/%s; with -%c print the index\n", cpad, IndexShort,
+           spad, "", spad, "", IndexLong, spad, "", ROMINDEX_NAME,
+           VerboseShort);
     printf("  -%-*c: print cartridge info (%s);\n"
            "  %-*s  with -%c for more detail\n", cpad, InfoShort, InfoLong,
            spad, "", VerboseShort);
+    printf("  -%-*c: serve emulator sessions over stdin/stdout, or on Unix\n"
+           "  %-*s  socket path, one session per CPU at a time, taking\n"
+           "  %-*s  line commands such as load, break, run, peek, poke,\n"
+           "  %-*s  save, restore, and hash (%s[=path])\n", cpad,
+           ServeShort, spad, "", spad, "", spad, "", ServeLong);
+    printf("  -%-*c: run test ROMs reporting through the $6000 status\n"
+           "  %-*s  protocol, n at a time, and print a pass/fail table\n"
+           "  %-*s  (%s[=n]); n default is CPU count\n", cpad,
+           TestRomsShort, spad, "", spad, "", TestRomsLong);
     printf("  -%-*c: print version (%s)\n",  cpad, VersionShort, VersionLong);
 
     puts("\narguments");
-    printf("  %-*s: input file containing cartridge or program contents\n",
-           spad, main_arg);
+    printf("  %-*s: input file containing cartridge or program contents,\n"
+           "  %-*s  optionally gzip or zip compressed; archive.zip#entry\n"
+           "  %-*s  picks a zip entry, otherwise the first .nes entry loads;\n"
+           "  %-*s  with -%c, one or more test ROM files\n", spad, main_arg,
+           spad, "", spad, "", spad, "", TestRomsShort);
 
     puts("\nhalt condition expressions");
     printf("  %-*s: halt on instruction at address XXXX;\n"
@@ -334,6 +577,26 @@ void argparse_usage(const char *me)
     printf("  %-*s: halt after executing N cycles\n", spad, "Nc");
     printf("  %-*s: halt after executing N frames\n", spad, "Nf");
     printf("  %-*s: halt when the CPU enters a jammed state\n", spad, "jam");
+    printf("  %-*s: halt on bus access of address XXXX, or of range\n"
+           "  %-*s  XXXX-YYYY with k@XXXX-YYYY; k is r (read), w (write)\n"
+           "  %-*s  or rw (either), prefix with %s to watch VRAM instead\n"
+           "  %-*s  of CPU memory, e.g. w@0200-02FF or vrw@23C0\n",
+           spad, "k@XXXX", spad, "", spad, "", ALDO_HEXPR_VRAM_IND, spad, "");
+    printf("  %-*s: halt on expression E only if predicate P is true,\n"
+           "  %-*s  e.g. @C000 && A==$10\n", spad, "E && P", spad, "");
+    printf("  %-*s: halt on any instruction where predicate P is true,\n"
+           "  %-*s  e.g. [$0300]>$80 || scanline==241\n", spad, "P", spad, "");
+
+    puts("\nhalt predicates");
+    printf("  %-*s: compare operands with == != < <= > >=,\n"
+           "  %-*s  join comparisons with && and ||; operands are\n"
+           "  %-*s  registers A X Y P S, PC (current instruction),\n"
+           "  %-*s  scanline and dot (PPU position), hits (number of\n"
+           "  %-*s  times halt expression matched, or instructions run\n"
+           "  %-*s  for a predicate-only halt), [$XXXX] (byte at\n"
+           "  %-*s  address XXXX) or numbers ($hex, 0xhex, or decimal)\n",
+           spad, "P", spad, "", spad, "", spad, "", spad, "", spad, "",
+           spad, "");
 
     puts("\nRESET vector override expression");
     printf("  %-*s: set RESET vector to address XXXX;\n"
@@ -350,4 +613,9 @@ void argparse_cleanup(struct cliargs *args)
          curr = args->haltlist,
             args->haltlist = args->haltlist->next,
             free(curr));
+    for (struct filearg *curr;
+         args->filelist;
+         curr = args->filelist,
+            args->filelist = args->filelist->next,
+            free(curr));
 }
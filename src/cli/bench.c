@@ -0,0 +1,193 @@
+//
+//  bench.c
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "bench.h"
+
+#include "cycleclock.h"
+#include "tsutil.h"
+
+#include <assert.h>
+#include <inttypes.h>
+#include <math.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include <time.h>
+
+static int cmp_double(const void *a, const void *b)
+{
+    auto x = *(const double *)a;
+    auto y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// nearest-rank percentile of sorted samples
+static double percentile(size_t count, const double samples[count],
+                         double pct)
+{
+    assert(count > 0);
+
+    auto rank = (size_t)ceil(pct / 100 * (double)count);
+    return samples[rank > 0 ? rank - 1 : 0];
+}
+
+static long peak_rss_kb()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+#ifdef __APPLE__
+    // macOS reports max RSS in bytes rather than kilobytes
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+static double run_frame(aldo_nes *nes, struct aldo_clock *clock)
+{
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    clock->budget = aldo_nes_frame_factor();
+    aldo_nes_clock(nes, clock);
+    auto elapsed = aldo_elapsed(&start);
+    return aldo_timespec_to_ms(&elapsed) * ALDO_NS_PER_MS;
+}
+
+// time frames from powerup, returning dots actually run since the console
+// may halt before running every frame.
+static uint64_t run_once(aldo_nes *nes, aldo_cart *c, int frames,
+                         bool zeroram, double samples[static frames],
+                         uint64_t *cycles, int *timed)
+{
+    struct aldo_clock clock = {};
+    aldo_nes_powerup(nes, c, zeroram);
+    aldo_nes_halt(nes, false);
+    for (auto i = 0; i < BenchWarmupFrames && !aldo_nes_halted(nes); ++i) {
+        run_frame(nes, &clock);
+    }
+
+    auto start = clock.cycles;
+    uint64_t dots = 0;
+    *timed = 0;
+    while (*timed < frames && !aldo_nes_halted(nes)) {
+        samples[(*timed)++] = run_frame(nes, &clock);
+        dots += (uint64_t)(aldo_nes_frame_factor() - clock.budget);
+    }
+    *cycles = clock.cycles - start;
+    aldo_nes_powerdown(nes);
+    return dots;
+}
+
+//
+// MARK: - Public Interface
+//
+
+bool bench_run(aldo_nes *nes, aldo_cart *c, int frames, bool zeroram,
+               struct bench_result *result)
+{
+    assert(nes != nullptr);
+    assert(c != nullptr);
+    assert(frames > 0);
+    assert(result != nullptr);
+
+    double *samples = calloc((size_t)frames * BenchRuns, sizeof *samples);
+    if (!samples) return false;
+
+    *result = (typeof(*result)){};
+    double totalns = 0;
+    for (auto run = 0; run < BenchRuns; ++run) {
+        auto runsamples = samples + result->frames;
+        uint64_t cycles;
+        int timed;
+        result->dots += run_once(nes, c, frames, zeroram, runsamples,
+                                 &cycles, &timed);
+        result->cycles += cycles;
+        result->frames += (uint64_t)timed;
+        double runns = 0;
+        for (auto i = 0; i < timed; ++i) {
+            runns += runsamples[i];
+        }
+        totalns += runns;
+        result->runfps[run] = runns > 0 ? timed / (runns / AldoNsPerS) : 0;
+    }
+
+    result->runtime_s = totalns / AldoNsPerS;
+    if (result->frames > 0 && totalns > 0) {
+        result->fps = (double)result->frames / result->runtime_s;
+        result->cps = (double)result->cycles / result->runtime_s;
+        result->dps = (double)result->dots / result->runtime_s;
+        qsort(samples, result->frames, sizeof *samples, cmp_double);
+        result->median_ns = percentile(result->frames, samples, 50);
+        result->p95_ns = percentile(result->frames, samples, 95);
+        result->p99_ns = percentile(result->frames, samples, 99);
+    }
+    result->peak_rss_kb = peak_rss_kb();
+    free(samples);
+    return true;
+}
+
+bool bench_write_table(const struct bench_result *result,
+                       const char *restrict name, FILE *f)
+{
+    assert(result != nullptr);
+    assert(name != nullptr);
+    assert(f != nullptr);
+
+    fprintf(f, "---=== %s Benchmark ===---\n", name);
+    fprintf(f, "Runs: %d x %" PRIu64 " frames (%d warmup)\n", BenchRuns,
+            result->frames / BenchRuns, BenchWarmupFrames);
+    fprintf(f, "Runtime (sec): %.3f\n", result->runtime_s);
+    fprintf(f, "%-16s%14.2f\n", "Frames/sec:", result->fps);
+    fprintf(f, "%-16s%14.2f\n", "Cycles/sec:", result->cps);
+    fprintf(f, "%-16s%14.2f\n", "Dots/sec:", result->dps);
+    fputs("ns/frame\n", f);
+    fprintf(f, "%-16s%14.0f\n", "  median:", result->median_ns);
+    fprintf(f, "%-16s%14.0f\n", "  p95:", result->p95_ns);
+    fprintf(f, "%-16s%14.0f\n", "  p99:", result->p99_ns);
+    fputs("Frames/sec by run:", f);
+    for (auto i = 0; i < BenchRuns; ++i) {
+        fprintf(f, " %.2f", result->runfps[i]);
+    }
+    fputc('\n', f);
+    return fprintf(f, "%-16s%14ld\n", "Peak RSS (KB):", result->peak_rss_kb)
+            >= 0 && !ferror(f);
+}
+
+bool bench_write_json(const struct bench_result *result,
+                      const char *restrict name, FILE *f)
+{
+    assert(result != nullptr);
+    assert(name != nullptr);
+    assert(f != nullptr);
+
+    fputs("{\n  \"rom\": \"", f);
+    for (auto ch = name; *ch; ++ch) {
+        if (*ch == '"' || *ch == '\\') {
+            fputc('\\', f);
+        }
+        fputc(*ch, f);
+    }
+    fputs("\",\n", f);
+    fprintf(f, "  \"runs\": %d,\n", BenchRuns);
+    fprintf(f, "  \"warmup_frames\": %d,\n", BenchWarmupFrames);
+    fprintf(f, "  \"frames\": %" PRIu64 ",\n", result->frames);
+    fprintf(f, "  \"cycles\": %" PRIu64 ",\n", result->cycles);
+    fprintf(f, "  \"dots\": %" PRIu64 ",\n", result->dots);
+    fprintf(f, "  \"runtime_s\": %.6f,\n", result->runtime_s);
+    fprintf(f, "  \"fps\": %.3f,\n", result->fps);
+    fprintf(f, "  \"cycles_per_s\": %.3f,\n", result->cps);
+    fprintf(f, "  \"dots_per_s\": %.3f,\n", result->dps);
+    fprintf(f, "  \"ns_per_frame\": {\"median\": %.0f, \"p95\": %.0f,"
+            " \"p99\": %.0f},\n", result->median_ns, result->p95_ns,
+            result->p99_ns);
+    fputs("  \"run_fps\": [", f);
+    for (auto i = 0; i < BenchRuns; ++i) {
+        fprintf(f, "%s%.3f", i > 0 ? ", " : "", result->runfps[i]);
+    }
+    fputs("],\n", f);
+    return fprintf(f, "  \"peak_rss_kb\": %ld\n}\n", result->peak_rss_kb)
+            >= 0 && !ferror(f);
+}
@@ -0,0 +1,44 @@
+//
+//  bench.h
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_cli_bench_h
+#define Aldo_cli_bench_h
+
+#include "cart.h"
+#include "nes.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+constexpr int BenchDefaultFrames = 600;
+constexpr int BenchWarmupFrames = 60;
+constexpr int BenchRuns = 5;
+
+// Throughput of an unthrottled emulator run; rates are over all timed
+// frames and percentiles are of individual frame times.
+struct bench_result {
+    uint64_t frames, cycles, dots;
+    double
+        runtime_s, fps, cps, dps,
+        median_ns, p95_ns, p99_ns,
+        runfps[BenchRuns];
+    long peak_rss_kb;
+};
+
+// power up the console with cart and time frames per run for each run,
+// after warmup frames that are not timed; returns false if frame timings
+// cannot be allocated.
+bool bench_run(aldo_nes *nes, aldo_cart *c, int frames, bool zeroram,
+               struct bench_result *result);
+// returns false on I/O error
+bool bench_write_table(const struct bench_result *result,
+                       const char *restrict name, FILE *f);
+bool bench_write_json(const struct bench_result *result,
+                      const char *restrict name, FILE *f);
+
+#endif
@@ -8,27 +8,45 @@
 #include "cli.h"
 
 #include "argparse.h"
+#include "bench.h"
 #include "bytes.h"
+#include "callgraph.h"
 #include "cart.h"
+#include "cdl.h"
 #include "cliargs.h"
 #include "debug.h"
 #include "dis.h"
 #include "emu.h"
+#include "framehash.h"
+#include "framesout.h"
 #include "haltexpr.h"
 #include "nes.h"
+#include "profile.h"
+#include "rewind.h"
+#include "romindex.h"
+#include "server.h"
 #include "snapshot.h"
+#include "testrom.h"
+#include "tracecmp.h"
+#include "tsutil.h"
 #include "ui.h"
 #include "version.h"
 
+#include <errno.h>
+#include <inttypes.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 typedef int ui_loop(struct emulator *);
 ui_loop ui_batch_loop;
 ui_loop ui_curses_loop;
 const char *ui_curses_version();
 
+// checkpoint memory for reverse execution in interactive mode
+constexpr size_t RewindBudget = 64 * 1024 * 1024;
+
 static const char *const restrict ResetOverrideFmt =
     "RESET Override: " ALDO_HEXPR_RST_IND "%04X\n";
 
@@ -44,20 +62,14 @@ static void print_version()
 static aldo_cart *load_cart(const char *filename)
 {
     aldo_cart *c = nullptr;
-    auto f = fopen(filename, "rb");
-    if (f) {
-        auto err = aldo_cart_create(&c, f);
-        if (err < 0) {
-            fprintf(stderr, "Cart load failure (%d): %s\n", err,
-                    aldo_cart_errstr(err));
-            if (err == ALDO_CART_ERR_ERNO) {
-                perror("Cart system error");
-            }
+    auto err = aldo_cart_create_file(&c, filename);
+    if (err < 0) {
+        fprintf(stderr, "Cart load failure (%d): %s\n", err,
+                aldo_cart_errstr(err));
+        if (err == ALDO_CART_ERR_ERNO) {
+            fprintf(stderr, "%s: ", filename);
+            perror("Cart system error");
         }
-        fclose(f);
-    } else {
-        fprintf(stderr, "%s: ", filename);
-        perror("Cannot open cart file");
     }
     return c;
 }
@@ -77,10 +89,47 @@ static int print_cart_info(const struct cliargs *args, aldo_cart *c)
     return EXIT_SUCCESS;
 }
 
+// open and merge an existing code/data log, a missing file is not an error
+// since a new log will be written to that path.
+static bool load_cdl(const char *path, aldo_cdl *cdl, bool required)
+{
+    auto f = fopen(path, "rb");
+    if (!f) {
+        if (!required && errno == ENOENT) return true;
+        fprintf(stderr, "%s: ", path);
+        perror("Cannot open CDL file");
+        return false;
+    }
+    auto ok = aldo_cdl_read(cdl, f);
+    if (!ok) {
+        fprintf(stderr, "%s: CDL file read failure or size does not match"
+                " cart\n", path);
+    }
+    fclose(f);
+    return ok;
+}
+
 static int disassemble_cart_prg(const struct cliargs *args, aldo_cart *c)
 {
-    auto err = aldo_dis_cart_prg(c, argparse_filename(args->filepath),
-                                 args->verbose, false, stdout);
+    aldo_cdl *cdl = nullptr;
+    if (args->cdlpath) {
+        if (!(cdl = aldo_cdl_new(c))) {
+            perror("Unable to initialize code/data log");
+            return EXIT_FAILURE;
+        }
+        if (!load_cdl(args->cdlpath, cdl, true)) {
+            aldo_cdl_free(cdl);
+            return EXIT_FAILURE;
+        }
+    }
+    auto name = argparse_filename(args->filepath);
+    auto err = cdl
+                ? aldo_dis_cart_prg_cdl(c, name, args->verbose, false, cdl,
+                                        stdout)
+                : aldo_dis_cart_prg(c, name, args->verbose, false, stdout);
+    if (cdl) {
+        aldo_cdl_free(cdl);
+    }
     if (err < 0) {
         fprintf(stderr, "PRG decode error (%d): %s\n", err,
                 aldo_dis_errstr(err));
@@ -91,7 +140,11 @@ static int disassemble_cart_prg(const struct cliargs *args, aldo_cart *c)
 
 static int decode_cart_chr(const struct cliargs *args, aldo_cart *c)
 {
-    auto err = aldo_dis_cart_chr(c, args->chrscale, args->chrdecode_prefix, stdout);
+    auto err = args->chrpng
+                ? aldo_dis_cart_chr_png(c, args->chrscale,
+                                        args->chrdecode_prefix, stdout)
+                : aldo_dis_cart_chr(c, args->chrscale,
+                                    args->chrdecode_prefix, stdout);
     if (err < 0) {
         fprintf(stderr, "CHR decode error (%d): %s\n", err,
                 aldo_dis_errstr(err));
@@ -103,8 +156,20 @@ static int decode_cart_chr(const struct cliargs *args, aldo_cart *c)
     return EXIT_SUCCESS;
 }
 
+// text reports move to stderr when video frames are streamed to stdout
+static bool frames_to_stdout(const struct cliargs *args)
+{
+    return args->framesoutpath && strcmp(args->framesoutpath, "-") == 0;
+}
+
+static FILE *report_stream(const struct cliargs *args)
+{
+    return frames_to_stdout(args) ? stderr : stdout;
+}
+
 static bool parse_dbg_expression(aldo_debugger *dbg,
-                                 const char *restrict exprstr, bool verbose)
+                                 const char *restrict exprstr,
+                                 const struct cliargs *args)
 {
     struct aldo_debugexpr expr;
     auto err = aldo_haltexpr_parse_dbg(exprstr, &expr);
@@ -119,20 +184,22 @@ static bool parse_dbg_expression(aldo_debugger *dbg,
                 perror("Unable to add debug expression");
                 return false;
             }
-            if (verbose) {
+            if (args->verbose) {
                 char buf[AldoHexprFmtSize];
                 err = aldo_haltexpr_desc(&expr.hexpr, buf);
                 if (err < 0) {
                     fprintf(stderr, "Halt expr display error (%d): %s\n", err,
                             aldo_haltexpr_errstr(err));
                 } else {
-                    printf("Halt Condition: %s\n", buf);
+                    fprintf(report_stream(args), "Halt Condition: %s\n",
+                            buf);
                 }
             }
         } else {
             aldo_debug_set_vector_override(dbg, expr.resetvector);
-            if (verbose) {
-                printf(ResetOverrideFmt, expr.resetvector);
+            if (args->verbose) {
+                fprintf(report_stream(args), ResetOverrideFmt,
+                        expr.resetvector);
             }
         }
     }
@@ -144,7 +211,7 @@ static bool parse_debug_file(aldo_debugger *dbg, FILE *f,
 {
     char buf[AldoHexprFmtSize];
     while (fgets(buf, sizeof buf, f)) {
-        if (!parse_dbg_expression(dbg, buf, args->verbose)) {
+        if (!parse_dbg_expression(dbg, buf, args)) {
             return false;
         }
     }
@@ -176,13 +243,13 @@ static aldo_debugger *create_debugger(const struct cliargs *args)
         }
     } else {
         for (auto arg = args->haltlist; arg; arg = arg->next) {
-            if (!parse_dbg_expression(dbg, arg->expr, args->verbose))
+            if (!parse_dbg_expression(dbg, arg->expr, args))
                 goto exit_dbg;
         }
     }
     if (args->resetvector != Aldo_NoResetVector) {
         aldo_debug_set_vector_override(dbg, args->resetvector);
-        printf(ResetOverrideFmt, args->resetvector);
+        fprintf(report_stream(args), ResetOverrideFmt, args->resetvector);
     }
     return dbg;
 exit_dbg:
@@ -193,7 +260,8 @@ exit_dbg:
 static ui_loop *setup_ui(struct emulator *emu)
 {
     auto loop = ui_curses_loop;
-    if (emu->args->batch) {
+    if (emu->args->batch || emu->args->tracecmppath
+        || emu->args->verifyhashpath || frames_to_stdout(emu->args)) {
         aldo_nes_halt(emu->console, false);
         loop = ui_batch_loop;
     }
@@ -232,6 +300,128 @@ static void dump_ram(const struct emulator *emu)
     }
 }
 
+static bool write_profile(const struct emulator *emu, aldo_profiler *prof)
+{
+    static constexpr size_t hotspots = 32;
+
+    auto f = fopen(emu->args->profilepath, "w");
+    if (!f) {
+        fprintf(stderr, "%s: ", emu->args->profilepath);
+        perror("Cannot open profile file");
+        return false;
+    }
+    auto err = aldo_dis_hotspots(emu->cart, prof, hotspots, f);
+    if (err == 0 && fputc('\n', f) == EOF) {
+        err = ALDO_DIS_ERR_IO;
+    }
+    if (err == 0) {
+        err = aldo_dis_cart_prg_profile(emu->cart,
+                                        argparse_filename(emu->args->filepath),
+                                        prof, f);
+    }
+    fclose(f);
+    if (err < 0) {
+        fprintf(stderr, "Profile output error (%d): %s\n", err,
+                aldo_dis_errstr(err));
+        if (err == ALDO_DIS_ERR_ERNO) {
+            perror("Profile system error");
+        }
+        return false;
+    }
+    return true;
+}
+
+static bool write_callgraph(const struct emulator *emu, aldo_callgraph *cg)
+{
+    static constexpr size_t maxroutines = 64;
+
+    auto path = emu->args->callgraphpath;
+    auto f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "%s: ", path);
+        perror("Cannot open call graph file");
+        return false;
+    }
+    auto ext = strrchr(path, '.');
+    auto written = ext && strcmp(ext, ".json") == 0
+                    ? aldo_callgraph_write_json(cg, f)
+                    : aldo_callgraph_write_folded(cg, f);
+    if (!written) {
+        fprintf(stderr, "%s: ", path);
+        perror("Call graph write failure");
+    }
+    fclose(f);
+
+    struct aldo_cgroutine routines[maxroutines];
+    auto count = aldo_callgraph_routines(cg, maxroutines, routines);
+    for (size_t i = 0; i < count; ++i) {
+        auto r = routines + i;
+        if (r->overruns > 0) {
+            fprintf(stderr, "*** NMI handler $%04X overran vblank %" PRIu64
+                    " of %" PRIu64 " times (max %" PRIu64 " > %" PRIu64
+                    " cycles)\n", r->entry, r->overruns, r->calls,
+                    r->maxcall, Aldo_VBlankCycles);
+        }
+    }
+    return written;
+}
+
+static bool write_cdl(const struct emulator *emu, aldo_cdl *cdl)
+{
+    auto path = emu->args->cdlpath;
+    auto f = fopen(path, "wb");
+    if (!f) {
+        fprintf(stderr, "%s: ", path);
+        perror("Cannot open CDL file");
+        return false;
+    }
+    auto written = aldo_cdl_write(cdl, f);
+    if (!written) {
+        fprintf(stderr, "%s: ", path);
+        perror("CDL write failure");
+    }
+    fclose(f);
+
+    auto cov = aldo_cdl_coverage(cdl);
+    fprintf(emu->report, "PRG coverage: %zu/%zu bytes (%zu code, %zu data)\n",
+            cov.code + cov.data, cov.prgsize, cov.code, cov.data);
+    if (cov.chrsize > 0) {
+        fprintf(emu->report,
+                "CHR coverage: %zu/%zu bytes (%zu rendered, %zu read)\n",
+                cov.rendered + cov.read, cov.chrsize, cov.rendered, cov.read);
+    }
+    return written;
+}
+
+// the console has a single frame hook so share it between frame outputs
+struct framehooks {
+    framesout *frames;
+    struct framehash *hashes;
+};
+
+static bool run_framehooks(void *ctx, const uint8_t *screen)
+{
+    const struct framehooks *hooks = ctx;
+    auto result = true;
+    if (hooks->frames) {
+        result = framesout_frame(hooks->frames, screen);
+    }
+    if (hooks->hashes) {
+        result = framehash_frame(hooks->hashes, screen) && result;
+    }
+    return result;
+}
+
+static bool finish_frames(const struct emulator *emu, framesout *frames)
+{
+    uint64_t written;
+    auto result = framesout_free(frames, &written);
+    if (emu->args->verbose) {
+        fprintf(stderr, "Frames written: %" PRIu64 "\n", written);
+    }
+    return result;
+}
+
 static int run_emu(const struct cliargs *args, aldo_cart *c)
 {
     static const char *const restrict tracefile = "trace.log";
@@ -240,6 +430,7 @@ static int run_emu(const struct cliargs *args, aldo_cart *c)
         .args = args,
         .cart = c,
         .debugger = create_debugger(args),
+        .report = report_stream(args),
     };
     if (!emu.debugger) return EXIT_FAILURE;
 
@@ -254,7 +445,13 @@ static int run_emu(const struct cliargs *args, aldo_cart *c)
     }
 
     auto result = EXIT_SUCCESS;
-    FILE *tracelog = nullptr;
+    FILE
+        *tracelog = nullptr, *golden = nullptr,
+        *hashlog = nullptr, *hashref = nullptr;
+    aldo_profiler *prof = nullptr;
+    aldo_callgraph *cg = nullptr;
+    aldo_cdl *cdl = nullptr;
+    framesout *frames = nullptr;
     if (emu.args->tron) {
         if (!(tracelog = fopen(tracefile, "w"))) {
             fprintf(stderr, "%s: ", tracefile);
@@ -263,12 +460,97 @@ static int run_emu(const struct cliargs *args, aldo_cart *c)
             goto exit_debug;
         }
     }
+    if (emu.args->tracecmppath) {
+        if (!(golden = fopen(emu.args->tracecmppath, "r"))) {
+            fprintf(stderr, "%s: ", emu.args->tracecmppath);
+            perror("Cannot open golden trace file");
+            result = EXIT_FAILURE;
+            goto exit_trace;
+        }
+    }
+    if (emu.args->framehashpath) {
+        if (!(hashlog = fopen(emu.args->framehashpath, "w"))) {
+            fprintf(stderr, "%s: ", emu.args->framehashpath);
+            perror("Cannot open frame hash log");
+            result = EXIT_FAILURE;
+            goto exit_trace;
+        }
+    }
+    if (emu.args->verifyhashpath) {
+        if (!(hashref = fopen(emu.args->verifyhashpath, "r"))) {
+            fprintf(stderr, "%s: ", emu.args->verifyhashpath);
+            perror("Cannot open reference frame hash log");
+            result = EXIT_FAILURE;
+            goto exit_trace;
+        }
+    }
+    if (emu.args->profilepath) {
+        if (!(prof = aldo_profile_new())) {
+            perror("Unable to initialize profiler");
+            result = EXIT_FAILURE;
+            goto exit_trace;
+        }
+    }
+    if (emu.args->callgraphpath) {
+        if (!(cg = aldo_callgraph_new())) {
+            perror("Unable to initialize call graph");
+            result = EXIT_FAILURE;
+            goto exit_trace;
+        }
+    }
+    if (emu.args->cdlpath) {
+        if (!(cdl = aldo_cdl_new(c))) {
+            perror("Unable to initialize code/data log");
+            result = EXIT_FAILURE;
+            goto exit_trace;
+        }
+        if (!load_cdl(emu.args->cdlpath, cdl, false)) {
+            result = EXIT_FAILURE;
+            goto exit_trace;
+        }
+    }
+    if (emu.args->framesoutpath) {
+        if (!(frames = framesout_new(emu.args->framesoutpath,
+                                     emu.args->framefirst,
+                                     emu.args->framelast,
+                                     emu.args->framestride))) {
+            fprintf(stderr, "%s: ", emu.args->framesoutpath);
+            perror("Cannot open frames output");
+            result = EXIT_FAILURE;
+            goto exit_trace;
+        }
+    }
+    if (!emu.args->batch) {
+        if (!(emu.rewind = aldo_rewind_new(RewindBudget))) {
+            perror("Unable to initialize rewind history");
+            result = EXIT_FAILURE;
+            goto exit_trace;
+        }
+    }
     emu.console = aldo_nes_new(emu.debugger, emu.args->bcdsupport, tracelog);
     if (!emu.console) {
         perror("Unable to initialize console");
         result = EXIT_FAILURE;
         goto exit_trace;
     }
+    aldo_nes_set_profiler(emu.console, prof);
+    aldo_nes_set_callgraph(emu.console, cg);
+    aldo_nes_set_cdl(emu.console, cdl);
+    aldo_nes_set_rewind(emu.console, emu.rewind);
+    struct tracecmp cmp;
+    if (golden) {
+        tracecmp_init(&cmp, golden);
+        aldo_nes_set_tracehook(emu.console, tracecmp_line, &cmp);
+    }
+    struct framehash hashes;
+    struct framehooks hooks = {.frames = frames};
+    if (hashlog || hashref) {
+        framehash_init(&hashes, emu.console, hashlog, hashref);
+        emu.hashes = hooks.hashes = &hashes;
+    }
+    if (hooks.frames || hooks.hashes) {
+        aldo_nes_set_framehook(emu.console, run_framehooks, &hooks);
+    }
     if (!aldo_snapshot_extend(&emu.snapshot)) {
         perror("Unable to extend snapshot");
         result = EXIT_FAILURE;
@@ -285,6 +567,29 @@ static int run_emu(const struct cliargs *args, aldo_cart *c)
         }
         result = EXIT_FAILURE;
     }
+    // flush queued frames before any report can land in a stdout stream
+    if (frames) {
+        hooks.frames = nullptr;
+        if (!finish_frames(&emu, frames)) {
+            result = EXIT_FAILURE;
+        }
+        frames = nullptr;
+    }
+    if (golden && !tracecmp_finish(&cmp, emu.report)) {
+        result = EXIT_FAILURE;
+    }
+    if (emu.hashes && !framehash_finish(emu.hashes, emu.report)) {
+        result = EXIT_FAILURE;
+    }
+    if (prof && !write_profile(&emu, prof)) {
+        result = EXIT_FAILURE;
+    }
+    if (cg && !write_callgraph(&emu, cg)) {
+        result = EXIT_FAILURE;
+    }
+    if (cdl && !write_cdl(&emu, cdl)) {
+        result = EXIT_FAILURE;
+    }
     dump_ram(&emu);
     aldo_nes_set_snapshot(emu.console, nullptr);
     aldo_snapshot_cleanup(&emu.snapshot);
@@ -295,6 +600,32 @@ exit_console:
     }
     aldo_nes_free(emu.console);
 exit_trace:
+    if (frames && !finish_frames(&emu, frames)) {
+        result = EXIT_FAILURE;
+    }
+    if (emu.rewind) {
+        aldo_rewind_free(emu.rewind);
+    }
+    if (cdl) {
+        aldo_cdl_free(cdl);
+    }
+    if (cg) {
+        aldo_callgraph_free(cg);
+    }
+    if (prof) {
+        aldo_profile_free(prof);
+    }
+    if (hashref) {
+        fclose(hashref);
+    }
+    if (hashlog && fclose(hashlog) != 0) {
+        fprintf(stderr, "%s: ", emu.args->framehashpath);
+        perror("Frame hash log write failure");
+        result = EXIT_FAILURE;
+    }
+    if (golden) {
+        fclose(golden);
+    }
     if (tracelog) {
         fclose(tracelog);
     }
@@ -303,8 +634,201 @@ exit_debug:
     return result;
 }
 
+static int run_bench(const struct cliargs *args, aldo_cart *c)
+{
+    static const char *const restrict benchfile = "bench.json";
+
+    auto dbg = aldo_debug_new();
+    if (!dbg) {
+        perror("Unable to initialize debugger");
+        return EXIT_FAILURE;
+    }
+    auto result = EXIT_FAILURE;
+    auto console = aldo_nes_new(dbg, args->bcdsupport, nullptr);
+    if (!console) {
+        perror("Unable to initialize console");
+        goto exit_debug;
+    }
+    struct bench_result bench;
+    if (!bench_run(console, c, args->benchframes, args->zeroram, &bench)) {
+        perror("Unable to run benchmark");
+        goto exit_console;
+    }
+    auto name = argparse_filename(args->filepath);
+    if (!bench_write_table(&bench, name, stdout)) {
+        perror("Benchmark output failure");
+        goto exit_console;
+    }
+    auto f = fopen(benchfile, "w");
+    if (!f) {
+        fprintf(stderr, "%s: ", benchfile);
+        perror("Cannot open benchmark file");
+        goto exit_console;
+    }
+    if (bench_write_json(&bench, name, f)) {
+        result = EXIT_SUCCESS;
+    } else {
+        fprintf(stderr, "%s: ", benchfile);
+        perror("Benchmark file write failure");
+    }
+    fclose(f);
+exit_console:
+    aldo_nes_free(console);
+exit_debug:
+    aldo_debug_free(dbg);
+    return result;
+}
+
+static int run_server(const struct cliargs *args)
+{
+    struct server_opts opts = {
+        .path = args->servepath,
+        .workers = aldo_cpu_count(ServerMaxWorkers),
+        .bcdsupport = args->bcdsupport,
+        .zeroram = args->zeroram,
+    };
+    if (server_run(&opts)) return EXIT_SUCCESS;
+    if (args->servepath) {
+        fprintf(stderr, "%s: ", args->servepath);
+    }
+    perror("Server failure");
+    return EXIT_FAILURE;
+}
+
+static int run_test_roms(const struct cliargs *args)
+{
+    size_t count = 0;
+    for (auto f = args->filelist; f; f = f->next, ++count);
+    struct testrom *roms = calloc(count, sizeof *roms);
+    if (!roms) {
+        perror("Unable to allocate test ROMs");
+        return EXIT_FAILURE;
+    }
+    size_t i = 0;
+    for (auto f = args->filelist; f; f = f->next) {
+        roms[i++].path = f->path;
+    }
+
+    auto result = EXIT_FAILURE;
+    auto jobs = args->testjobs > 0
+                    ? args->testjobs
+                    : aldo_cpu_count(TestRomMaxJobs);
+    if (!testrom_run(count, roms, jobs, args->zeroram)) {
+        perror("Unable to run test ROMs");
+        goto exit_roms;
+    }
+    size_t failed;
+    if (!testrom_write_table(count, roms, &failed, stdout)) {
+        perror("Test ROM output failure");
+        goto exit_roms;
+    }
+    if (failed == 0) {
+        result = EXIT_SUCCESS;
+    }
+exit_roms:
+    free(roms);
+    return result;
+}
+
+// write to a temporary file renamed over the index so an interrupted run
+// leaves the previous index intact.
+static bool save_index(const struct romindex *idx, const char *path)
+{
+    static const char *const restrict suffix = ".tmp";
+
+    auto len = strlen(path) + strlen(suffix) + 1;
+    char *tmppath = malloc(len);
+    if (!tmppath) return false;
+    snprintf(tmppath, len, "%s%s", path, suffix);
+
+    auto saved = false;
+    auto f = fopen(tmppath, "wb");
+    if (f) {
+        saved = romindex_write(idx, f);
+        saved = fclose(f) == 0 && saved;
+        saved = saved && rename(tmppath, path) == 0;
+        if (!saved) {
+            auto err = errno;
+            remove(tmppath);
+            errno = err;
+        }
+    }
+    free(tmppath);
+    return saved;
+}
+
+static int run_index(const struct cliargs *args)
+{
+    auto dir = args->filepath;
+    auto indexpath = args->indexpath;
+    char *defaultpath = nullptr;
+    if (!indexpath) {
+        auto len = strlen(dir) + sizeof ROMINDEX_NAME + 1;
+        if (!(defaultpath = malloc(len))) {
+            perror("Unable to allocate index path");
+            return EXIT_FAILURE;
+        }
+        snprintf(defaultpath, len, "%s/%s", dir, ROMINDEX_NAME);
+        indexpath = defaultpath;
+    }
+
+    auto result = EXIT_FAILURE;
+    struct romindex idx = {};
+    struct romindex_stats stats = {};
+    auto f = fopen(indexpath, "rb");
+    if (f) {
+        auto loaded = romindex_read(&idx, f);
+        auto err = errno;
+        fclose(f);
+        if (!loaded) {
+            fprintf(stderr, "%s: ", indexpath);
+            // a damaged index is rebuilt from scratch
+            if (err == EILSEQ) {
+                fputs("Ignoring invalid index\n", stderr);
+            } else {
+                errno = err;
+                perror("Index read failure");
+                goto exit_index;
+            }
+        }
+    } else if (errno != ENOENT) {
+        fprintf(stderr, "%s: ", indexpath);
+        perror("Cannot open index");
+        goto exit_index;
+    }
+
+    if (!romindex_scan(&idx, dir, &stats)) {
+        fprintf(stderr, "%s: ", dir);
+        perror("Index scan failure");
+        goto exit_index;
+    }
+    if (!romindex_update(&idx, dir, aldo_cpu_count(RomIndexMaxJobs),
+                         &stats)) {
+        perror("Unable to read ROMs");
+        goto exit_index;
+    }
+    if (!save_index(&idx, indexpath)) {
+        fprintf(stderr, "%s: ", indexpath);
+        perror("Index write failure");
+        goto exit_index;
+    }
+    if (args->verbose && !romindex_write_table(&idx, stdout)) {
+        perror("Index output failure");
+        goto exit_index;
+    }
+    printf("%zu ROMs indexed: %zu read, %zu unchanged, %zu removed, "
+           "%zu errors\n", idx.count, stats.read, stats.unchanged,
+           stats.removed, stats.errors);
+    result = EXIT_SUCCESS;
+exit_index:
+    romindex_cleanup(&idx);
+    free(defaultpath);
+    return result;
+}
+
 static int run_cart(const struct cliargs *args, aldo_cart *c)
 {
+    if (args->bench) return run_bench(args, c);
     if (args->info) return print_cart_info(args, c);
     if (args->disassemble) return disassemble_cart_prg(args, c);
     if (args->chrdecode) return decode_cart_chr(args, c);
@@ -323,12 +847,17 @@ static int run_with_args(const struct cliargs *args)
         return EXIT_SUCCESS;
     }
 
+    if (args->serve) return run_server(args);
+
     if (!args->filepath) {
         fputs("No input file specified\n", stderr);
         argparse_usage(args->me);
         return EXIT_FAILURE;
     }
 
+    if (args->index) return run_index(args);
+    if (args->testroms) return run_test_roms(args);
+
     auto cart = load_cart(args->filepath);
     if (!cart) return EXIT_FAILURE;
 
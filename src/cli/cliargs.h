@@ -9,16 +9,24 @@
 #define Aldo_cli_cliargs_h
 
 struct cliargs {
+    struct filearg {
+        const char *path;       // Non-owning Pointer
+        struct filearg *next;
+    } *filelist;
     struct haltarg {
         const char *expr;       // Non-owning Pointer
         struct haltarg *next;
     } *haltlist;
     const char                  // Non-owning Pointers
-        *chrdecode_prefix, *dbgfilepath, *filepath, *me;
-    int chrscale, resetvector;
+        *callgraphpath, *cdlpath, *chrdecode_prefix, *dbgfilepath, *filepath,
+        *framehashpath, *framesoutpath, *indexpath, *me, *profilepath,
+        *servepath, *tracecmppath, *verifyhashpath;
+    int
+        benchframes, chrscale, framefirst, framelast, framestride, resetvector,
+        testjobs;
     bool
-        batch, bcdsupport, chrdecode, disassemble, help, info, tron, verbose,
-        version, zeroram;
+        batch, bcdsupport, bench, chrdecode, chrpng, disassemble, help, index,
+        info, serve, testroms, tron, verbose, version, zeroram;
 };
 
 #endif
@@ -11,14 +11,20 @@
 #include "debug.h"
 #include "cart.h"
 #include "cliargs.h"
+#include "framehash.h"
 #include "nes.h"
 #include "snapshot.h"
 
+#include <stdio.h>
+
 struct emulator {
     const struct cliargs *args; // Non-owning Pointer
     aldo_cart *cart;            // Non-owning Pointer
     aldo_debugger *debugger;
     aldo_nes *console;
+    aldo_rewind *rewind;        // Optional
+    const struct framehash *hashes; // Optional; Non-owning Pointer
+    FILE *report;               // Text reports; Non-owning Pointer
     struct aldo_snapshot snapshot;
 };
 
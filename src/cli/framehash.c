@@ -0,0 +1,149 @@
+//
+//  framehash.c
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "framehash.h"
+
+#include "bytes.h"
+
+#include <assert.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+static void update_digest(struct framehash *self)
+{
+    uint64_t hashes[] = {
+        self->actual.screen, self->actual.ram, self->actual.vram,
+    };
+    uint8_t bytes[sizeof hashes];
+    for (size_t i = 0; i < aldo_arrsz(hashes); ++i) {
+        for (size_t b = 0; b < sizeof hashes[0]; ++b) {
+            bytes[(i * sizeof hashes[0]) + b] = (uint8_t)(hashes[i] >> (8 * b));
+        }
+    }
+    self->digest = aldo_bytehash(self->digest, sizeof bytes, bytes);
+}
+
+static bool write_log(struct framehash *self)
+{
+    if (fprintf(self->log, "%" PRIu64 " %016" PRIx64 " %016" PRIx64 " %016"
+                PRIx64 "\n", self->frame, self->actual.screen,
+                self->actual.ram, self->actual.vram) > 0) return true;
+    self->state = FRAMEHASH_ERR;
+    return false;
+}
+
+static bool read_reference(struct framehash *self)
+{
+    auto fields = fscanf(self->reference, "%" SCNu64 " %" SCNx64 " %" SCNx64
+                         " %" SCNx64, &self->refframe, &self->expected.screen,
+                         &self->expected.ram, &self->expected.vram);
+    if (fields == 4 && self->refframe == self->frame) return true;
+    if (ferror(self->reference)) {
+        self->state = FRAMEHASH_ERR;
+    } else if (fields == EOF) {
+        self->state = FRAMEHASH_END;
+    } else if (fields == 4) {
+        self->state = FRAMEHASH_OUTOFSYNC;
+    } else {
+        self->state = FRAMEHASH_BADLINE;
+    }
+    return false;
+}
+
+static void print_hash(const char *restrict name, uint64_t expected,
+                       uint64_t actual, FILE *f)
+{
+    fprintf(f, "%c %-7s %016" PRIx64 "  %016" PRIx64 "\n",
+            expected == actual ? ' ' : '*', name, expected, actual);
+}
+
+//
+// MARK: - Public Interface
+//
+
+void framehash_init(struct framehash *self, aldo_nes *console, FILE *log,
+                    FILE *reference)
+{
+    assert(self != nullptr);
+    assert(console != nullptr);
+
+    *self = (typeof(*self)){
+        .console = console,
+        .log = log,
+        .reference = reference,
+        .digest = AldoFnvBasis,
+        .state = FRAMEHASH_MATCH,
+    };
+}
+
+bool framehash_frame(void *ctx, const uint8_t *)
+{
+    assert(ctx != nullptr);
+
+    struct framehash *self = ctx;
+    if (self->state != FRAMEHASH_MATCH) return false;
+
+    // stopping at the end of the reference log leaves the digest covering
+    // the same frames as the run that wrote it.
+    if (self->reference && !read_reference(self)) return false;
+    aldo_nes_framehashes(self->console, &self->actual);
+    update_digest(self);
+    if (self->log && !write_log(self)) return false;
+    if (self->reference
+        && (self->expected.screen != self->actual.screen
+            || self->expected.ram != self->actual.ram
+            || self->expected.vram != self->actual.vram)) {
+        self->state = FRAMEHASH_DIVERGED;
+        return false;
+    }
+    ++self->frame;
+    return true;
+}
+
+bool framehash_finish(const struct framehash *self, FILE *f)
+{
+    assert(self != nullptr);
+    assert(f != nullptr);
+
+    switch (self->state) {
+    case FRAMEHASH_MATCH:
+        if (self->reference) {
+            fprintf(f, "Frame hashes matched %" PRIu64 " frames; run stopped"
+                    " before end of reference log\n", self->frame);
+        }
+        return true;
+    case FRAMEHASH_DIVERGED:
+        fprintf(f, "Frame hashes diverged at frame %" PRIu64 "\n",
+                self->frame);
+        fprintf(f, "  %-7s %-16s  %s\n", "Memory", "Expected", "Actual");
+        print_hash("Screen", self->expected.screen, self->actual.screen, f);
+        print_hash("RAM", self->expected.ram, self->actual.ram, f);
+        print_hash("VRAM", self->expected.vram, self->actual.vram, f);
+        return false;
+    case FRAMEHASH_END:
+        fprintf(f, "Frame hashes matched all %" PRIu64 " frames of reference"
+                " log\n", self->frame);
+        return true;
+    case FRAMEHASH_OUTOFSYNC:
+        fprintf(f, "Reference frame hash log out of sync: expected frame %"
+                PRIu64 ", found frame %" PRIu64 "\n", self->frame,
+                self->refframe);
+        return false;
+    case FRAMEHASH_BADLINE:
+        fprintf(f, "Malformed reference frame hash log line for frame %"
+                PRIu64 "\n", self->frame);
+        return false;
+    case FRAMEHASH_ERR:
+        fputs("Frame hash log I/O failure\n", f);
+        return false;
+    default:
+        assert(((void)"INVALID FRAMEHASH STATE", false));
+        return false;
+    }
+}
@@ -0,0 +1,47 @@
+//
+//  framehash.h
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_cli_framehash_h
+#define Aldo_cli_framehash_h
+
+#include "nes.h"
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Per-frame hashes of the screen, RAM, and VRAM written to a compact log
+// and/or checked against a reference log; log lines are
+// "frame screen ram vram" with hashes in hexadecimal.
+struct framehash {
+    aldo_nes *console;                  // Non-owning Pointer
+    FILE *log, *reference;              // Optional; Non-owning Pointers
+    uint64_t
+        frame,                          // Frames hashed
+        digest,                         // Digest of all hashes
+        refframe;                       // Last frame number read from
+                                        // reference log
+    struct aldo_framehashes expected, actual;
+    enum framehash_state {
+        FRAMEHASH_MATCH,                // All verified frames match
+        FRAMEHASH_DIVERGED,             // Frame diverged from reference log
+        FRAMEHASH_END,                  // Reached end of reference log
+        FRAMEHASH_OUTOFSYNC,            // Reference line for wrong frame
+        FRAMEHASH_BADLINE,              // Malformed reference log line
+        FRAMEHASH_ERR,                  // Log I/O failure
+    } state;
+};
+
+void framehash_init(struct framehash *self, aldo_nes *console, FILE *log,
+                    FILE *reference);
+// aldo_framehook; returns false on divergence, end of reference log, a
+// reference line that does not match the frame, or I/O error.
+bool framehash_frame(void *ctx, const uint8_t *screen);
+// write verification report to f if there is a reference log, returns true
+// if no divergence, bad reference line, or I/O error was found.
+bool framehash_finish(const struct framehash *self, FILE *f);
+
+#endif
@@ -0,0 +1,354 @@
+//
+//  framesout.c
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "framesout.h"
+
+#include "nes.h"
+#include "png.h"
+#include "snapshot.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <errno.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// frames buffered ahead of the writer thread before emulation blocks;
+// about a second of video.
+constexpr size_t QueueSlots = 64;
+constexpr size_t PathSize = 1024;
+constexpr uint8_t PaletteMask = 0x3f;
+
+static_assert(AldoPaletteSize == PaletteMask + 1, "Unexpected palette size");
+
+enum frameformat {
+    FMT_RAW,
+    FMT_Y4M,
+    FMT_PNG,
+};
+
+struct framesout {
+    pthread_t writer;
+    pthread_mutex_t lock;
+    pthread_cond_t queued, drained;
+    const char *pattern;        // Non-owning Pointer
+    FILE *stream;               // Single-stream output, null for per-frame
+    uint8_t
+        *slots,                 // Queued screens, QueueSlots * screensize
+        *conv,                  // Writer thread RGB/YUV conversion buffer
+        yuv[PaletteMask + 1][3];
+    int framenums[QueueSlots];
+    size_t screensize, head, count;
+    uint64_t written;
+    int first, last, stride, next, width, height;
+    enum frameformat format;
+    bool done, failed;
+};
+
+static bool has_ext(const char *restrict pattern, const char *restrict ext)
+{
+    auto dot = strrchr(pattern, '.');
+    return dot && strcmp(dot, ext) == 0;
+}
+
+// count %d conversions, allowing zero-padding and width; any conversion
+// other than %% is invalid.
+static int pattern_conversions(const char *pattern)
+{
+    auto count = 0;
+    for (auto c = pattern; *c; ++c) {
+        if (*c != '%') continue;
+        if (*++c == '%') continue;
+        while (isdigit((unsigned char)*c)) {
+            ++c;
+        }
+        if (*c != 'd') return -1;
+        ++count;
+    }
+    return count;
+}
+
+// BT.601 limited-range YCbCr for each palette entry
+static void init_yuv(framesout *self)
+{
+    for (size_t i = 0; i < AldoPaletteSize; ++i) {
+        int r = AldoPalette[i][0], g = AldoPalette[i][1],
+            b = AldoPalette[i][2];
+        self->yuv[i][0] = (uint8_t)(((66 * r + 129 * g + 25 * b + 128) >> 8)
+                                    + 16);
+        self->yuv[i][1] = (uint8_t)(((-38 * r - 74 * g + 112 * b + 128) >> 8)
+                                    + 128);
+        self->yuv[i][2] = (uint8_t)(((112 * r - 94 * g - 18 * b + 128) >> 8)
+                                    + 128);
+    }
+}
+
+static bool open_stream(framesout *self)
+{
+    auto y4m = self->format == FMT_Y4M;
+    if (strcmp(self->pattern, "-") == 0) {
+        self->stream = stdout;
+    } else if (!(self->stream = fopen(self->pattern, "wb"))) {
+        return false;
+    }
+    // NTSC frame rate is the PPU dot clock over the average frame length,
+    // including the skipped dot on odd frames; NES pixels are 8:7.
+    return !y4m
+            || fprintf(self->stream, "YUV4MPEG2 W%d H%d F39375000:655171 Ip"
+                       " A8:7 C444\n", self->width, self->height) > 0;
+}
+
+static bool close_stream(framesout *self)
+{
+    if (!self->stream) return true;
+    if (self->stream == stdout) return fflush(stdout) == 0;
+    auto err = ferror(self->stream);
+    return fclose(self->stream) == 0 && !err;
+}
+
+//
+// MARK: - Writer Thread
+//
+
+static FILE *open_frame(const framesout *self, int frame)
+{
+    char path[PathSize];
+    auto len = snprintf(path, sizeof path, self->pattern, frame);
+    if (len < 0) return nullptr;
+    if ((size_t)len >= sizeof path) {
+        errno = ENAMETOOLONG;
+        return nullptr;
+    }
+    return fopen(path, "wb");
+}
+
+static bool write_y4m(framesout *self, const uint8_t *screen)
+{
+    // 4:4:4 planes, so no chroma subsampling blurs the pixel art
+    uint8_t
+        *y = self->conv,
+        *u = y + self->screensize,
+        *v = u + self->screensize;
+    for (size_t i = 0; i < self->screensize; ++i) {
+        auto px = self->yuv[screen[i] & PaletteMask];
+        y[i] = px[0];
+        u[i] = px[1];
+        v[i] = px[2];
+    }
+    auto planes = self->screensize * 3;
+    return fputs("FRAME\n", self->stream) != EOF
+            && fwrite(self->conv, 1, planes, self->stream) == planes;
+}
+
+static bool write_png(framesout *self, int frame, const uint8_t *screen)
+{
+    for (size_t i = 0; i < self->screensize; ++i) {
+        memcpy(self->conv + (i * 3), AldoPalette[screen[i] & PaletteMask], 3);
+    }
+    auto f = open_frame(self, frame);
+    if (!f) return false;
+    auto result = aldo_png_write_rgb(self->width, self->height, self->conv, f);
+    return fclose(f) == 0 && result;
+}
+
+static bool write_raw(framesout *self, int frame, const uint8_t *screen)
+{
+    if (self->stream) {
+        return fwrite(screen, 1, self->screensize, self->stream)
+                == self->screensize;
+    }
+    auto f = open_frame(self, frame);
+    if (!f) return false;
+    auto result = fwrite(screen, 1, self->screensize, f) == self->screensize;
+    return fclose(f) == 0 && result;
+}
+
+static bool write_frame(framesout *self, int frame, const uint8_t *screen)
+{
+    switch (self->format) {
+    case FMT_Y4M:
+        return write_y4m(self, screen);
+    case FMT_PNG:
+        return write_png(self, frame, screen);
+    default:
+        return write_raw(self, frame, screen);
+    }
+}
+
+static void *write_frames(void *ctx)
+{
+    framesout *self = ctx;
+    pthread_mutex_lock(&self->lock);
+    while (true) {
+        while (self->count == 0 && !self->done) {
+            pthread_cond_wait(&self->queued, &self->lock);
+        }
+        if (self->count == 0) break;
+
+        // head slot is not reused until count is decremented so it can be
+        // written without holding the lock; once output fails the rest of
+        // the queue is discarded.
+        auto slot = self->head;
+        auto failed = self->failed;
+        pthread_mutex_unlock(&self->lock);
+        auto ok = !failed
+                    && write_frame(self, self->framenums[slot],
+                                   self->slots + (slot * self->screensize));
+        pthread_mutex_lock(&self->lock);
+        if (ok) {
+            ++self->written;
+        } else if (!failed) {
+            perror("Frame write failure");
+            self->failed = true;
+        }
+        self->head = (self->head + 1) % QueueSlots;
+        --self->count;
+        pthread_cond_signal(&self->drained);
+    }
+    pthread_mutex_unlock(&self->lock);
+    return nullptr;
+}
+
+//
+// MARK: - Public Interface
+//
+
+framesout *framesout_new(const char *restrict pattern, int first, int last,
+                         int stride)
+{
+    assert(pattern != nullptr);
+    assert(first >= 0);
+    assert(last == FramesNoLast || last >= first);
+    assert(stride > 0);
+
+    auto conversions = pattern_conversions(pattern);
+    enum frameformat format = FMT_RAW;
+    if (strcmp(pattern, "-") == 0 || has_ext(pattern, ".y4m")) {
+        format = FMT_Y4M;
+    } else if (has_ext(pattern, ".png")) {
+        format = FMT_PNG;
+    }
+    if (conversions < 0 || conversions > 1
+        || (format == FMT_PNG && conversions != 1)
+        || (format == FMT_Y4M && conversions != 0)) {
+        errno = EINVAL;
+        return nullptr;
+    }
+
+    framesout *self = malloc(sizeof *self);
+    if (!self) return nullptr;
+    *self = (typeof(*self)){
+        .pattern = pattern,
+        .first = first,
+        .last = last,
+        .stride = stride,
+        .format = format,
+    };
+    aldo_nes_screen_size(&self->width, &self->height);
+    self->screensize = (size_t)self->width * (size_t)self->height;
+    init_yuv(self);
+
+    auto err = 0;
+    if (!(self->slots = malloc(QueueSlots * self->screensize))
+        || !(self->conv = malloc(self->screensize * 3))) {
+        err = errno;
+        goto exit_buffers;
+    }
+    if (format == FMT_Y4M || (format == FMT_RAW && conversions == 0)) {
+        if (!open_stream(self)) {
+            err = errno;
+            goto exit_stream;
+        }
+    }
+    if ((err = pthread_mutex_init(&self->lock, nullptr)) != 0) {
+        goto exit_stream;
+    }
+    if ((err = pthread_cond_init(&self->queued, nullptr)) != 0) {
+        goto exit_lock;
+    }
+    if ((err = pthread_cond_init(&self->drained, nullptr)) != 0) {
+        goto exit_queued;
+    }
+    if ((err = pthread_create(&self->writer, nullptr, write_frames, self))
+        != 0) {
+        goto exit_drained;
+    }
+    return self;
+exit_drained:
+    pthread_cond_destroy(&self->drained);
+exit_queued:
+    pthread_cond_destroy(&self->queued);
+exit_lock:
+    pthread_mutex_destroy(&self->lock);
+exit_stream:
+    close_stream(self);
+exit_buffers:
+    free(self->conv);
+    free(self->slots);
+    free(self);
+    errno = err;
+    return nullptr;
+}
+
+bool framesout_free(framesout *self, uint64_t *written)
+{
+    assert(self != nullptr);
+
+    pthread_mutex_lock(&self->lock);
+    self->done = true;
+    pthread_cond_signal(&self->queued);
+    pthread_mutex_unlock(&self->lock);
+    pthread_join(self->writer, nullptr);
+
+    auto result = !self->failed;
+    if (!close_stream(self) && result) {
+        perror("Frame output failure");
+        result = false;
+    }
+    if (written) {
+        *written = self->written;
+    }
+    pthread_cond_destroy(&self->drained);
+    pthread_cond_destroy(&self->queued);
+    pthread_mutex_destroy(&self->lock);
+    free(self->conv);
+    free(self->slots);
+    free(self);
+    return result;
+}
+
+bool framesout_frame(void *ctx, const uint8_t *screen)
+{
+    assert(ctx != nullptr);
+    assert(screen != nullptr);
+
+    framesout *self = ctx;
+    auto frame = self->next++;
+    if (frame < self->first
+        || (self->last != FramesNoLast && frame > self->last)
+        || (frame - self->first) % self->stride != 0) return true;
+
+    pthread_mutex_lock(&self->lock);
+    while (self->count == QueueSlots && !self->failed) {
+        pthread_cond_wait(&self->drained, &self->lock);
+    }
+    auto ok = !self->failed;
+    if (ok) {
+        auto slot = (self->head + self->count) % QueueSlots;
+        memcpy(self->slots + (slot * self->screensize), screen,
+               self->screensize);
+        self->framenums[slot] = frame;
+        ++self->count;
+        pthread_cond_signal(&self->queued);
+    }
+    pthread_mutex_unlock(&self->lock);
+    return ok;
+}
@@ -0,0 +1,38 @@
+//
+//  framesout.h
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_cli_framesout_h
+#define Aldo_cli_framesout_h
+
+#include <stdint.h>
+
+constexpr int FramesNoLast = -1;
+
+// Writes completed video frames on a background thread; the output format
+// is picked by pattern:
+//  "-" or *.y4m: YUV4MPEG2 stream (stdout for "-") for piping to an encoder
+//  *.png: one RGB PNG per frame, pattern must have a single %d conversion
+//  anything else: raw palette indices, one file per frame if pattern has
+//                 a %d conversion or a single stream otherwise
+typedef struct framesout framesout;
+
+// frames are numbered from 0 at powerup, writing frames [first, last]
+// (last may be FramesNoLast) every stride frames; if returns null then
+// errno is set due to invalid pattern, failed allocation, I/O error, or
+// failure to start the writer thread.
+framesout *framesout_new(const char *restrict pattern, int first, int last,
+                         int stride);
+// flushes pending frames and stops the writer thread, setting written to
+// the number of frames output if not null; returns false if any frame
+// failed to write.
+bool framesout_free(framesout *self, uint64_t *written);
+
+// aldo_framehook; blocks if the writer thread falls too far behind, and
+// returns false if output has failed to halt the console.
+bool framesout_frame(void *ctx, const uint8_t *screen);
+
+#endif
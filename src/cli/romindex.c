@@ -0,0 +1,506 @@
+//
+//  romindex.c
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "romindex.h"
+
+#include "bytes.h"
+#include "cart.h"
+#include "ctrlsignal.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+// Index file layout, all integers little-endian:
+//  header: "ALDOIDX", version byte, 4-byte record count
+//  record: 2-byte path length, path bytes, then the fixed fields in
+//          pack_record order
+static const char *const restrict Magic = "ALDOIDX";
+constexpr size_t MagicSize = 7;
+constexpr uint8_t Version = 1;
+constexpr size_t HeaderSize = MagicSize + 1 + 4;
+constexpr size_t RecordSize = 45;
+
+struct reclist {
+    struct romrecord *records;
+    size_t count, cap;
+};
+
+struct pool {
+    pthread_mutex_t lock;
+    struct romindex *idx;
+    const char *dir;
+    size_t next;
+};
+
+static void put_le(uint64_t v, size_t n, uint8_t buf[static n])
+{
+    for (size_t i = 0; i < n; ++i) {
+        buf[i] = (uint8_t)(v >> (8 * i));
+    }
+}
+
+static uint64_t get_le(size_t n, const uint8_t buf[static n])
+{
+    uint64_t v = 0;
+    for (size_t i = 0; i < n; ++i) {
+        v |= (uint64_t)buf[i] << (8 * i);
+    }
+    return v;
+}
+
+static int compare_records(const void *a, const void *b)
+{
+    const struct romrecord *ra = a, *rb = b;
+    return strcmp(ra->path, rb->path);
+}
+
+static void free_records(size_t count, struct romrecord records[count])
+{
+    for (size_t i = 0; i < count; ++i) {
+        free(records[i].path);
+    }
+    free(records);
+}
+
+// takes ownership of r.path only on success
+static bool append(struct reclist *l, struct romrecord r)
+{
+    if (l->count == l->cap) {
+        auto cap = l->cap > 0 ? l->cap * 2 : 64;
+        struct romrecord *grown = realloc(l->records, cap * sizeof *grown);
+        if (!grown) return false;
+        l->records = grown;
+        l->cap = cap;
+    }
+    l->records[l->count++] = r;
+    return true;
+}
+
+// join two path segments with a separator, or copy b if a is empty
+static char *join(const char *a, const char *b)
+{
+    auto alen = strlen(a);
+    auto blen = strlen(b);
+    size_t sep = alen > 0;
+    char *s = malloc(alen + sep + blen + 1);
+    if (!s) return nullptr;
+    memcpy(s, a, alen);
+    if (sep) {
+        s[alen] = '/';
+    }
+    memcpy(s + alen + sep, b, blen + 1);
+    return s;
+}
+
+//
+// MARK: - Serialization
+//
+
+static void pack_record(const struct romrecord *r,
+                        uint8_t buf[static RecordSize])
+{
+    put_le((uint64_t)r->mtime, 8, buf);
+    put_le(r->size, 8, buf + 8);
+    put_le(r->prghash, 8, buf + 16);
+    put_le(r->chrhash, 8, buf + 24);
+    put_le(r->prgsize, 4, buf + 32);
+    put_le(r->chrsize, 4, buf + 36);
+    buf[40] = (uint8_t)r->err;
+    buf[41] = r->format;
+    buf[42] = r->mapper_id;
+    buf[43] = r->mirror;
+    buf[44] = r->mapper_implemented;
+}
+
+static void unpack_record(const uint8_t buf[static RecordSize],
+                          struct romrecord *r)
+{
+    r->mtime = (int64_t)get_le(8, buf);
+    r->size = get_le(8, buf + 8);
+    r->prghash = get_le(8, buf + 16);
+    r->chrhash = get_le(8, buf + 24);
+    r->prgsize = (uint32_t)get_le(4, buf + 32);
+    r->chrsize = (uint32_t)get_le(4, buf + 36);
+    r->err = (int8_t)buf[40];
+    r->format = buf[41];
+    r->mapper_id = buf[42];
+    r->mirror = buf[43];
+    r->mapper_implemented = buf[44];
+}
+
+// short reads are a truncated index unless the stream failed
+static bool read_fail(FILE *f)
+{
+    if (!ferror(f)) {
+        errno = EILSEQ;
+    }
+    return false;
+}
+
+static bool read_record(FILE *f, struct romrecord *r)
+{
+    uint8_t len[2];
+    if (fread(len, 1, sizeof len, f) != sizeof len) return read_fail(f);
+    auto pathlen = aldo_batowr(len);
+    if (pathlen == 0) {
+        errno = EILSEQ;
+        return false;
+    }
+
+    *r = (typeof(*r)){.path = malloc(pathlen + 1u)};
+    if (!r->path) return false;
+    uint8_t buf[RecordSize];
+    if (fread(r->path, 1, pathlen, f) != pathlen
+        || fread(buf, 1, sizeof buf, f) != sizeof buf) {
+        free(r->path);
+        return read_fail(f);
+    }
+    r->path[pathlen] = '\0';
+    unpack_record(buf, r);
+    return true;
+}
+
+//
+// MARK: - Scanning
+//
+
+static bool has_rom_ext(const char *name)
+{
+    static const char *const restrict exts[] = {".nes", ".gz", ".zip"};
+
+    auto dot = strrchr(name, '.');
+    if (!dot || dot == name) return false;
+    for (size_t i = 0; i < sizeof exts / sizeof exts[0]; ++i) {
+        auto ext = exts[i];
+        auto len = strlen(ext);
+        if (strlen(dot) != len) continue;
+        size_t c = 0;
+        for (; c < len && tolower((unsigned char)dot[c]) == ext[c]; ++c);
+        if (c == len) return true;
+    }
+    return false;
+}
+
+static bool walk(struct reclist *found, const char *dir, const char *rel);
+
+static bool add_file(struct reclist *found, const char *dir, char *rel,
+                     const char *name, bool *added)
+{
+    *added = false;
+    auto full = join(dir, rel);
+    if (!full) return false;
+
+    struct stat st;
+    auto ok = true;
+    if (lstat(full, &st) == 0) {
+        if (S_ISDIR(st.st_mode)) {
+            ok = walk(found, dir, rel);
+        } else {
+            // follow links to files but not to directories, which may loop
+            auto exists = !S_ISLNK(st.st_mode) || stat(full, &st) == 0;
+            if (exists && S_ISREG(st.st_mode) && has_rom_ext(name)) {
+                ok = *added = append(found, (struct romrecord){
+                    .path = rel,
+                    .mtime = (int64_t)st.st_mtime,
+                    .size = (uint64_t)st.st_size,
+                    .stale = true,
+                });
+            }
+        }
+    }
+    free(full);
+    return ok;
+}
+
+// hidden entries are skipped, which includes the default index file;
+// unreadable subdirectories are skipped too, only dir itself must open.
+static bool walk(struct reclist *found, const char *dir, const char *rel)
+{
+    auto full = join(dir, rel);
+    if (!full) return false;
+    auto d = opendir(full);
+    free(full);
+    if (!d) return rel[0] != '\0';
+
+    auto ok = true;
+    struct dirent *ent;
+    while (ok && (ent = readdir(d))) {
+        if (ent->d_name[0] == '.') continue;
+        auto entrel = join(rel, ent->d_name);
+        auto added = false;
+        ok = entrel && add_file(found, dir, entrel, ent->d_name, &added);
+        if (!added) {
+            free(entrel);
+        }
+    }
+    closedir(d);
+    return ok;
+}
+
+//
+// MARK: - Reading ROMs
+//
+
+static uint64_t hash_blocks(aldo_cart *c,
+                            struct aldo_blockview (*block)(aldo_cart *,
+                                                           size_t),
+                            uint32_t *size)
+{
+    auto h = AldoFnvBasis;
+    *size = 0;
+    for (size_t i = 0;; ++i) {
+        auto bv = block(c, i);
+        if (!bv.mem) break;
+        h = aldo_bytehash(h, bv.size, bv.mem);
+        *size += (uint32_t)bv.size;
+    }
+    return *size > 0 ? h : 0;
+}
+
+static void read_rom(struct romrecord *r, const char *dir)
+{
+    *r = (typeof(*r)){.path = r->path, .mtime = r->mtime, .size = r->size};
+
+    aldo_cart *c;
+    auto path = join(dir, r->path);
+    r->err = path ? aldo_cart_create_file(&c, path) : ALDO_CART_ERR_ERNO;
+    free(path);
+    if (r->err < 0) return;
+
+    struct aldo_cartinfo info;
+    aldo_cart_getinfo(c, &info);
+    r->format = (uint8_t)info.format;
+    if (info.format == ALDO_CRTF_INES) {
+        r->mapper_id = info.ines_hdr.mapper_id;
+        r->mirror = (uint8_t)info.ines_hdr.mirror;
+        r->mapper_implemented = info.ines_hdr.mapper_implemented;
+    }
+    r->prghash = hash_blocks(c, aldo_cart_prgblock, &r->prgsize);
+    r->chrhash = hash_blocks(c, aldo_cart_chrblock, &r->chrsize);
+    aldo_cart_free(c);
+}
+
+static void *read_roms(void *ctx)
+{
+    struct pool *p = ctx;
+    auto count = p->idx->count;
+    for (;;) {
+        pthread_mutex_lock(&p->lock);
+        while (p->next < count && !p->idx->records[p->next].stale) {
+            ++p->next;
+        }
+        auto i = p->next < count ? p->next++ : count;
+        pthread_mutex_unlock(&p->lock);
+        if (i == count) return nullptr;
+        read_rom(p->idx->records + i, p->dir);
+    }
+}
+
+//
+// MARK: - Public Interface
+//
+
+bool romindex_read(struct romindex *idx, FILE *f)
+{
+    assert(idx != nullptr);
+    assert(f != nullptr);
+
+    uint8_t header[HeaderSize];
+    if (fread(header, 1, sizeof header, f) != sizeof header) {
+        return read_fail(f);
+    }
+    if (memcmp(header, Magic, MagicSize) != 0
+        || header[MagicSize] != Version) {
+        errno = EILSEQ;
+        return false;
+    }
+
+    // grow as records are read rather than trusting the count up front
+    auto count = get_le(4, header + MagicSize + 1);
+    struct reclist l = {};
+    for (uint64_t i = 0; i < count; ++i) {
+        struct romrecord r;
+        if (!read_record(f, &r)) goto exit_records;
+        if (!append(&l, r)) {
+            free(r.path);
+            goto exit_records;
+        }
+    }
+    qsort(l.records, l.count, sizeof *l.records, compare_records);
+    romindex_cleanup(idx);
+    idx->records = l.records;
+    idx->count = l.count;
+    return true;
+exit_records:
+    free_records(l.count, l.records);
+    return false;
+}
+
+bool romindex_scan(struct romindex *idx, const char *dir,
+                   struct romindex_stats *stats)
+{
+    assert(idx != nullptr);
+    assert(dir != nullptr);
+    assert(stats != nullptr);
+
+    struct reclist found = {};
+    if (!walk(&found, dir, "")) {
+        free_records(found.count, found.records);
+        return false;
+    }
+    qsort(found.records, found.count, sizeof *found.records,
+          compare_records);
+
+    size_t present = 0;
+    for (size_t i = 0; i < found.count; ++i) {
+        auto r = found.records + i;
+        struct romrecord *prev = bsearch(r, idx->records, idx->count,
+                                         sizeof *idx->records,
+                                         compare_records);
+        if (!prev) continue;
+        ++present;
+        if (!prev->stale && prev->mtime == r->mtime
+            && prev->size == r->size) {
+            // swap the equal paths so the previous index stays searchable
+            auto path = r->path;
+            *r = *prev;
+            prev->path = path;
+            ++stats->unchanged;
+        }
+    }
+    stats->removed += idx->count - present;
+
+    free_records(idx->count, idx->records);
+    idx->records = found.records;
+    idx->count = found.count;
+    return true;
+}
+
+bool romindex_update(struct romindex *idx, const char *dir, int jobs,
+                     struct romindex_stats *stats)
+{
+    assert(idx != nullptr);
+    assert(dir != nullptr);
+    assert(jobs > 0);
+    assert(stats != nullptr);
+
+    size_t stale = 0;
+    for (size_t i = 0; i < idx->count; ++i) {
+        stale += idx->records[i].stale;
+    }
+    if (stale > 0) {
+        struct pool p = {.idx = idx, .dir = dir};
+        auto err = pthread_mutex_init(&p.lock, nullptr);
+        if (err != 0) {
+            errno = err;
+            return false;
+        }
+
+        // same scheme as test ROMs: the calling thread is one of the jobs
+        // and threads that do start pick up the share of any that don't.
+        size_t helpers = (size_t)jobs < stale ? (size_t)jobs - 1 : stale - 1;
+        pthread_t *threads = helpers > 0 ? calloc(helpers, sizeof *threads)
+                                         : nullptr;
+        size_t started = 0;
+        for (; threads && started < helpers; ++started) {
+            if (pthread_create(threads + started, nullptr, read_roms, &p) != 0)
+                break;
+        }
+        read_roms(&p);
+        for (size_t i = 0; i < started; ++i) {
+            pthread_join(threads[i], nullptr);
+        }
+        free(threads);
+        pthread_mutex_destroy(&p.lock);
+    }
+
+    stats->read += stale;
+    for (size_t i = 0; i < idx->count; ++i) {
+        stats->errors += idx->records[i].err < 0;
+    }
+    return true;
+}
+
+bool romindex_write(const struct romindex *idx, FILE *f)
+{
+    assert(idx != nullptr);
+    assert(f != nullptr);
+
+    uint8_t header[HeaderSize];
+    memcpy(header, Magic, MagicSize);
+    header[MagicSize] = Version;
+    put_le(idx->count, 4, header + MagicSize + 1);
+    if (fwrite(header, 1, sizeof header, f) != sizeof header) return false;
+
+    for (size_t i = 0; i < idx->count; ++i) {
+        auto r = idx->records + i;
+        auto pathlen = strlen(r->path);
+        if (pathlen > UINT16_MAX) {
+            errno = ENAMETOOLONG;
+            return false;
+        }
+        uint8_t len[2], buf[RecordSize];
+        aldo_wrtoba((uint16_t)pathlen, len);
+        pack_record(r, buf);
+        if (fwrite(len, 1, sizeof len, f) != sizeof len
+            || fwrite(r->path, 1, pathlen, f) != pathlen
+            || fwrite(buf, 1, sizeof buf, f) != sizeof buf) return false;
+    }
+    return true;
+}
+
+bool romindex_write_table(const struct romindex *idx, FILE *f)
+{
+    assert(idx != nullptr);
+    assert(f != nullptr);
+
+    if (fprintf(f, "%-16s %6s %6s %6s %-15s %4s %-16s %-16s  %s\n",
+                "Format", "Mapper", "PRG KB", "CHR KB", "Mirroring", "Impl",
+                "PRG Hash", "CHR Hash", "ROM") < 0) return false;
+    for (size_t i = 0; i < idx->count; ++i) {
+        auto r = idx->records + i;
+        int err;
+        if (r->err < 0) {
+            err = fprintf(f, "%-16s %s: %s\n", "ERROR", r->path,
+                          aldo_cart_errstr(r->err));
+        } else if (r->format == ALDO_CRTF_INES) {
+            err = fprintf(f, "%-16s    %03d %6" PRIu32 " %6" PRIu32
+                          " %-15s %4s %016" PRIx64 " %016" PRIx64 "  %s\n",
+                          aldo_cart_formatname(r->format), r->mapper_id,
+                          r->prgsize / 1024, r->chrsize / 1024,
+                          aldo_ntmirror_name(r->mirror),
+                          r->mapper_implemented ? "yes" : "no", r->prghash,
+                          r->chrhash, r->path);
+        } else {
+            err = fprintf(f, "%-16s %6s %6" PRIu32 " %6" PRIu32
+                          " %-15s %4s %016" PRIx64 " %016" PRIx64 "  %s\n",
+                          aldo_cart_formatname(r->format), "-",
+                          r->prgsize / 1024, r->chrsize / 1024, "-", "-",
+                          r->prghash, r->chrhash, r->path);
+        }
+        if (err < 0) return false;
+    }
+    return true;
+}
+
+void romindex_cleanup(struct romindex *idx)
+{
+    assert(idx != nullptr);
+
+    free_records(idx->count, idx->records);
+    *idx = (typeof(*idx)){};
+}
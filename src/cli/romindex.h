@@ -0,0 +1,66 @@
+//
+//  romindex.h
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_cli_romindex_h
+#define Aldo_cli_romindex_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Incremental index of a ROM library: every .nes, .gz, and .zip file found
+// under a directory along with its cart metadata, saved as a compact binary
+// file. Files whose size and modification time match the previous index
+// keep their record without being read again.
+
+// default index file name, placed in the indexed directory
+#define ROMINDEX_NAME ".aldo-index"
+constexpr int RomIndexMaxJobs = 256;
+
+struct romrecord {
+    char *path;                 // Relative to library directory
+    int64_t mtime;              // Modification time in seconds
+    uint64_t
+        size,                   // File size in bytes
+        prghash,                // FNV-1a hash of PRG ROM
+        chrhash;                // FNV-1a hash of CHR ROM, 0 if CHR RAM
+    uint32_t prgsize, chrsize;  // ROM sizes in bytes
+    int err;                    // Cart error code, 0 if cart loaded
+    uint8_t format, mapper_id, mirror;
+    bool
+        mapper_implemented,
+        stale;                  // Not yet read for this index; not saved
+};
+
+struct romindex {
+    struct romrecord *records;  // Sorted by path
+    size_t count;
+};
+
+struct romindex_stats {
+    size_t read, unchanged, removed, errors;
+};
+
+// replace the index with the contents of a previously written index file;
+// returns false and sets errno on I/O or allocation error, with errno set
+// to EILSEQ if f does not hold a valid index.
+bool romindex_read(struct romindex *idx, FILE *f);
+// walk dir for ROM files, keeping records whose file size and mtime are
+// unchanged, adding stale records for new or changed files, and dropping
+// records for files that are gone; returns false and sets errno on error.
+bool romindex_scan(struct romindex *idx, const char *dir,
+                   struct romindex_stats *stats);
+// read every stale record's file under dir on up to jobs threads; returns
+// false if worker threads cannot be started, otherwise no record is stale.
+bool romindex_update(struct romindex *idx, const char *dir, int jobs,
+                     struct romindex_stats *stats);
+// returns false on I/O error
+bool romindex_write(const struct romindex *idx, FILE *f);
+bool romindex_write_table(const struct romindex *idx, FILE *f);
+void romindex_cleanup(struct romindex *idx);
+
+#endif
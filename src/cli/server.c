@@ -0,0 +1,595 @@
+//
+//  server.c
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "server.h"
+
+#include "bytes.h"
+#include "cart.h"
+#include "cycleclock.h"
+#include "debug.h"
+#include "haltexpr.h"
+#include "nes.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/*
+ * Commands; load and power reset the debugger so halt conditions are
+ * added after them:
+ *   load PATH          insert cart at PATH and power up -> ok FORMAT
+ *   power              power-cycle the console -> ok
+ *   break EXPR         add halt condition or reset vector override,
+ *                      in debug file syntax -> ok INDEX | ok vector
+ *   clear              remove all halt conditions -> ok
+ *   run frames|cycles N
+ *                      run N frames or CPU cycles, stopping early on a
+ *                      halt condition -> ok done|break INDEX|halt
+ *                      frames=N cycles=N
+ *   run until [vblank] [nmi] [write ADDR]
+ *                      run until any of the events (vblank start, NMI,
+ *                      CPU write to hex ADDR) or a halt condition; with no
+ *                      events run until halted, which needs a halt
+ *                      condition -> ok vblank|nmi|write|
+ *                      break INDEX|halt frames=N cycles=N
+ *   peek ADDR [N]      read N (default 1, max 256) bytes of CPU memory at
+ *                      hex ADDR -> ok HEXBYTES
+ *   poke ADDR HEXBYTES write bytes to CPU memory at hex ADDR -> ok N
+ *   save SLOT          save console state to SLOT [0-7] -> ok
+ *   restore SLOT       restore console state from SLOT -> ok
+ *   hash               hash screen, RAM, and VRAM -> ok SCREEN RAM VRAM
+ *   quit               end session -> ok
+ */
+constexpr size_t LineSize = 1024;
+constexpr size_t PeekMax = 256;
+constexpr size_t StateSlots = 8;
+
+struct session {
+    FILE *in, *out;                 // Non-owning Pointers
+    aldo_debugger *dbg;
+    aldo_nes *console;
+    aldo_cart *cart;
+    void *states[StateSlots];
+    struct aldo_clock clock;
+    bool zeroram;
+};
+
+struct server {
+    struct server_opts opts;
+    struct sockaddr_un addr;
+    pthread_mutex_t lock;
+    int fd, err;                // err is the accept failure stopping workers
+    bool stopping;
+};
+
+typedef bool command(struct session *, char *);
+
+static bool reply(struct session *s, const char *restrict fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    auto err = vfprintf(s->out, fmt, args);
+    va_end(args);
+    return err >= 0 && fputc('\n', s->out) != EOF && fflush(s->out) == 0;
+}
+
+static char *next_word(char **args)
+{
+    static const char *const restrict delim = " \t";
+    *args += strspn(*args, delim);
+    if (**args == '\0') return nullptr;
+
+    auto word = *args;
+    *args += strcspn(*args, delim);
+    if (**args != '\0') {
+        *(*args)++ = '\0';
+    }
+    return word;
+}
+
+static bool parse_u64(const char *restrict word, int base, uint64_t *n)
+{
+    if (!word || *word == '-') return false;
+
+    char *end;
+    errno = 0;
+    auto val = strtoull(word, &end, base);
+    if (errno == ERANGE || end == word || *end != '\0') return false;
+    *n = val;
+    return true;
+}
+
+static bool parse_addr(const char *restrict word, uint16_t *addr)
+{
+    uint64_t n;
+    if (!parse_u64(word, 16, &n) || n > ALDO_ADDRMASK_64KB) return false;
+    *addr = (uint16_t)n;
+    return true;
+}
+
+static bool parse_slot(const char *restrict word, size_t *slot)
+{
+    uint64_t n;
+    if (!parse_u64(word, 10, &n) || n >= StateSlots) return false;
+    *slot = (size_t)n;
+    return true;
+}
+
+static int hexval(char c)
+{
+    if ('0' <= c && c <= '9') return c - '0';
+    if ('a' <= c && c <= 'f') return c - 'a' + 10;
+    if ('A' <= c && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+static const char *run_reason(enum aldo_runevent event)
+{
+    switch (event) {
+    case ALDO_RUN_VBLANK:
+        return "vblank";
+    case ALDO_RUN_NMI:
+        return "nmi";
+    case ALDO_RUN_WRITE:
+        return "write";
+    case ALDO_RUN_HALT:
+        return "halt";
+    default:
+        return "done";
+    }
+}
+
+static void clear_states(struct session *s)
+{
+    for (size_t i = 0; i < StateSlots; ++i) {
+        free(s->states[i]);
+        s->states[i] = nullptr;
+    }
+}
+
+static void power_cycle(struct session *s)
+{
+    aldo_nes_powerdown(s->console);
+    s->clock = (typeof(s->clock)){};
+    aldo_nes_powerup(s->console, s->cart, s->zeroram);
+}
+
+//
+// MARK: - Commands
+//
+
+static bool cmd_load(struct session *s, char *args)
+{
+    auto path = next_word(&args);
+    if (!path) return reply(s, "err expected cart path");
+
+    aldo_cart *c;
+    auto err = aldo_cart_create_file(&c, path);
+    if (err < 0) {
+        return reply(s, "err %s", err == ALDO_CART_ERR_ERNO
+                                    ? strerror(errno)
+                                    : aldo_cart_errstr(err));
+    }
+
+    aldo_nes_powerdown(s->console);
+    if (s->cart) {
+        aldo_cart_free(s->cart);
+    }
+    clear_states(s);
+    s->cart = c;
+    s->clock = (typeof(s->clock)){};
+    aldo_nes_powerup(s->console, s->cart, s->zeroram);
+
+    char fmtname[AldoCartFmtSize];
+    err = aldo_cart_format_extname(s->cart, fmtname);
+    return reply(s, "ok %s", err < 0 ? aldo_cart_errstr(err) : fmtname);
+}
+
+static bool cmd_power(struct session *s, char *)
+{
+    if (!s->cart) return reply(s, "err no cart loaded");
+
+    power_cycle(s);
+    return reply(s, "ok");
+}
+
+static bool cmd_break(struct session *s, char *args)
+{
+    args += strspn(args, " \t");
+    struct aldo_debugexpr expr;
+    auto err = aldo_haltexpr_parse_dbg(args, &expr);
+    if (err < 0) return reply(s, "err %s", aldo_haltexpr_errstr(err));
+
+    if (expr.type == ALDO_DBG_EXPR_RESET) {
+        aldo_debug_set_vector_override(s->dbg, expr.resetvector);
+        return reply(s, "ok vector");
+    }
+    if (!aldo_debug_bp_add(s->dbg, expr.hexpr))
+        return reply(s, "err %s", strerror(errno));
+    return reply(s, "ok %zu", aldo_debug_bp_count(s->dbg) - 1);
+}
+
+static bool cmd_clear(struct session *s, char *)
+{
+    aldo_debug_bp_clear(s->dbg);
+    return reply(s, "ok");
+}
+
+// parse run until events, leaving events empty to run until halted
+static bool parse_events(char *args, unsigned int *events, uint16_t *addr)
+{
+    *events = 0;
+    for (auto word = next_word(&args); word; word = next_word(&args)) {
+        if (strcmp(word, "vblank") == 0) {
+            *events |= ALDO_RUN_VBLANK;
+        } else if (strcmp(word, "nmi") == 0) {
+            *events |= ALDO_RUN_NMI;
+        } else if (strcmp(word, "write") == 0
+                   && parse_addr(next_word(&args), addr)) {
+            *events |= ALDO_RUN_WRITE;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool cmd_run(struct session *s, char *args)
+{
+    if (!s->cart) return reply(s, "err no cart loaded");
+
+    auto unit = next_word(&args);
+    auto until = unit && strcmp(unit, "until") == 0;
+    auto frames = unit && strcmp(unit, "frames") == 0;
+    if (!until && !frames && !(unit && strcmp(unit, "cycles") == 0))
+        return reply(s, "err expected frames|cycles N or until [EVENTS]");
+
+    struct aldo_runstop stop;
+    if (until) {
+        unsigned int events;
+        uint16_t addr = 0;
+        if (!parse_events(args, &events, &addr))
+            return reply(s, "err expected events vblank|nmi|write ADDR");
+        if (events == 0 && aldo_debug_bp_count(s->dbg) == 0)
+            return reply(s, "err no halt conditions");
+        aldo_nes_halt(s->console, false);
+        // no events runs until a halt condition stops the console
+        stop = events == 0
+                ? aldo_nes_run_cycles(s->console, &s->clock, UINT64_MAX)
+                : aldo_nes_run_until(s->console, &s->clock, events, addr);
+    } else {
+        uint64_t count;
+        if (!parse_u64(next_word(&args), 10, &count) || count == 0)
+            return reply(s, "err expected frames|cycles N");
+        aldo_nes_halt(s->console, false);
+        stop = frames
+                ? aldo_nes_run_frames(s->console, &s->clock, count)
+                : aldo_nes_run_cycles(s->console, &s->clock, count);
+    }
+
+    char reason[32];
+    auto bp = aldo_debug_halted_at(s->dbg);
+    if (bp != Aldo_NoBreakpoint) {
+        snprintf(reason, sizeof reason, "break %td", bp);
+    } else {
+        strcpy(reason, run_reason(stop.event));
+    }
+    return reply(s, "ok %s frames=%" PRIu64 " cycles=%" PRIu64, reason,
+                 stop.frames, stop.cycles);
+}
+
+static bool cmd_peek(struct session *s, char *args)
+{
+    uint16_t addr;
+    if (!parse_addr(next_word(&args), &addr))
+        return reply(s, "err expected hex address");
+    uint64_t count = 1;
+    auto word = next_word(&args);
+    if (word && (!parse_u64(word, 10, &count) || count == 0
+                 || count > PeekMax))
+        return reply(s, "err expected byte count [1, %zu]", PeekMax);
+
+    // copy may stop at device boundaries so keep going until unmapped
+    uint8_t mem[PeekMax];
+    size_t total = 0, copied;
+    do {
+        copied = aldo_nes_copymem(s->console, (uint16_t)(addr + total),
+                                  (size_t)count - total, mem + total);
+        total += copied;
+    } while (copied > 0 && total < count);
+
+    char hex[(PeekMax * 2) + 1] = "";
+    for (size_t i = 0; i < total; ++i) {
+        sprintf(hex + (i * 2), "%02x", mem[i]);
+    }
+    return reply(s, "ok %s", hex);
+}
+
+static bool cmd_poke(struct session *s, char *args)
+{
+    uint16_t addr;
+    if (!parse_addr(next_word(&args), &addr))
+        return reply(s, "err expected hex address");
+    auto hex = next_word(&args);
+    auto len = hex ? strlen(hex) : 0;
+    if (len == 0 || len % 2 != 0 || len / 2 > PeekMax)
+        return reply(s, "err expected up to %zu hex bytes", PeekMax);
+
+    uint8_t bytes[PeekMax];
+    for (size_t i = 0; i < len / 2; ++i) {
+        auto hi = hexval(hex[i * 2]);
+        auto lo = hexval(hex[(i * 2) + 1]);
+        if (hi < 0 || lo < 0) return reply(s, "err invalid hex bytes");
+        bytes[i] = (uint8_t)(hi << 4 | lo);
+    }
+    return reply(s, "ok %zu",
+                 aldo_nes_writemem(s->console, addr, len / 2, bytes));
+}
+
+static bool cmd_save(struct session *s, char *args)
+{
+    size_t slot;
+    if (!parse_slot(next_word(&args), &slot))
+        return reply(s, "err expected slot [0, %zu]", StateSlots - 1);
+
+    if (!s->states[slot]
+        && !(s->states[slot] = malloc(aldo_nes_state_size(s->console))))
+        return reply(s, "err %s", strerror(errno));
+    aldo_nes_save_state(s->console, &s->clock, s->states[slot]);
+    return reply(s, "ok");
+}
+
+static bool cmd_restore(struct session *s, char *args)
+{
+    size_t slot;
+    if (!parse_slot(next_word(&args), &slot))
+        return reply(s, "err expected slot [0, %zu]", StateSlots - 1);
+    if (!s->states[slot]) return reply(s, "err empty slot");
+
+    aldo_nes_load_state(s->console, &s->clock, s->states[slot]);
+    return reply(s, "ok");
+}
+
+static bool cmd_hash(struct session *s, char *)
+{
+    struct aldo_framehashes hashes;
+    aldo_nes_framehashes(s->console, &hashes);
+    return reply(s, "ok %016" PRIx64 " %016" PRIx64 " %016" PRIx64,
+                 hashes.screen, hashes.ram, hashes.vram);
+}
+
+static bool cmd_quit(struct session *s, char *)
+{
+    reply(s, "ok");
+    return false;
+}
+
+static const struct {
+    const char *name;
+    command *run;
+} Commands[] = {
+    {"break", cmd_break},
+    {"clear", cmd_clear},
+    {"hash", cmd_hash},
+    {"load", cmd_load},
+    {"peek", cmd_peek},
+    {"poke", cmd_poke},
+    {"power", cmd_power},
+    {"quit", cmd_quit},
+    {"restore", cmd_restore},
+    {"run", cmd_run},
+    {"save", cmd_save},
+};
+
+//
+// MARK: - Sessions
+//
+
+static bool dispatch(struct session *s, char *line)
+{
+    auto name = next_word(&line);
+    if (!name) return reply(s, "err empty command");
+
+    for (size_t i = 0; i < aldo_arrsz(Commands); ++i) {
+        if (strcmp(name, Commands[i].name) == 0)
+            return Commands[i].run(s, line);
+    }
+    return reply(s, "err unknown command: %s", name);
+}
+
+static void serve_socket(int fd, const struct server_opts *opts)
+{
+    FILE *in = fdopen(fd, "r"), *out = nullptr;
+    if (!in) {
+        close(fd);
+        return;
+    }
+    auto outfd = dup(fd);
+    if (outfd >= 0 && !(out = fdopen(outfd, "w"))) {
+        close(outfd);
+    }
+    if (out) {
+        if (!server_session(in, out, opts)) {
+            perror("Session setup failed");
+        }
+        fclose(out);
+    }
+    fclose(in);
+}
+
+static bool server_stopping(struct server *srv)
+{
+    pthread_mutex_lock(&srv->lock);
+    auto stopping = srv->stopping;
+    pthread_mutex_unlock(&srv->lock);
+    return stopping;
+}
+
+// stop all workers, waking any blocked in accept with a throwaway
+// connection each; only the first error is kept.
+static void stop_server(struct server *srv, int err)
+{
+    pthread_mutex_lock(&srv->lock);
+    auto stopping = srv->stopping;
+    if (!stopping) {
+        srv->stopping = true;
+        srv->err = err;
+    }
+    pthread_mutex_unlock(&srv->lock);
+    if (stopping) return;
+
+    for (auto i = 0; i < srv->opts.workers; ++i) {
+        auto fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return;
+        auto connected = connect(fd, (const struct sockaddr *)&srv->addr,
+                                 sizeof srv->addr) == 0;
+        close(fd);
+        if (!connected) return;
+    }
+}
+
+static void *accept_sessions(void *ctx)
+{
+    struct server *srv = ctx;
+    while (!server_stopping(srv)) {
+        auto fd = accept(srv->fd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            // out of descriptors or buffers may clear up once other
+            // sessions end, so report it and keep the worker.
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS
+                || errno == ENOMEM) {
+                perror("Session accept failed");
+                sleep(1);
+                continue;
+            }
+            stop_server(srv, errno);
+            break;
+        }
+        if (server_stopping(srv)) {
+            close(fd);
+            break;
+        }
+        serve_socket(fd, &srv->opts);
+    }
+    return nullptr;
+}
+
+//
+// MARK: - Public Interface
+//
+
+bool server_session(FILE *in, FILE *out, const struct server_opts *opts)
+{
+    struct session s = {.in = in, .out = out, .zeroram = opts->zeroram};
+    if (!(s.dbg = aldo_debug_new())) return false;
+    if (!(s.console = aldo_nes_new(s.dbg, opts->bcdsupport, nullptr))) {
+        aldo_debug_free(s.dbg);
+        return false;
+    }
+
+    char line[LineSize];
+    auto serving = true;
+    while (serving && fgets(line, sizeof line, s.in)) {
+        auto len = strcspn(line, "\r\n");
+        if (line[len] == '\0' && !feof(s.in)) {
+            int c;
+            while ((c = fgetc(s.in)) != EOF && c != '\n');
+            serving = reply(&s, "err line too long");
+            continue;
+        }
+        line[len] = '\0';
+        serving = dispatch(&s, line);
+    }
+
+    aldo_nes_powerdown(s.console);
+    clear_states(&s);
+    if (s.cart) {
+        aldo_cart_free(s.cart);
+    }
+    aldo_nes_free(s.console);
+    aldo_debug_free(s.dbg);
+    return true;
+}
+
+bool server_run(const struct server_opts *opts)
+{
+    assert(opts != nullptr);
+    assert(opts->workers > 0);
+
+    if (!opts->path) return server_session(stdin, stdout, opts);
+
+    struct server srv = {
+        .opts = *opts,
+        .addr = {.sun_family = AF_UNIX},
+    };
+    if (strlen(opts->path) >= sizeof srv.addr.sun_path) {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+    strcpy(srv.addr.sun_path, opts->path);
+    auto err = pthread_mutex_init(&srv.lock, nullptr);
+    if (err != 0) {
+        errno = err;
+        return false;
+    }
+
+    // a client hanging up mid-reply must not take down the server
+    signal(SIGPIPE, SIG_IGN);
+    if ((srv.fd = socket(AF_UNIX, SOCK_STREAM, 0)) < 0) {
+        err = errno;
+        goto exit_lock;
+    }
+    // replace the stale socket of a previous server, but nothing else
+    struct stat st;
+    if (stat(opts->path, &st) == 0 && S_ISSOCK(st.st_mode)) {
+        unlink(opts->path);
+    }
+    if (bind(srv.fd, (const struct sockaddr *)&srv.addr, sizeof srv.addr) < 0
+        || listen(srv.fd, SOMAXCONN) < 0) {
+        err = errno;
+        goto exit_socket;
+    }
+
+    // the calling thread is one of the workers; each worker serves one
+    // session at a time and further clients wait in the listen backlog.
+    // An accept failure in any worker stops them all, and the socket
+    // outlives every worker.
+    auto helpers = (size_t)opts->workers - 1;
+    pthread_t *workers = helpers > 0 ? calloc(helpers, sizeof *workers)
+                                     : nullptr;
+    size_t started = 0;
+    for (; workers && started < helpers; ++started) {
+        if (pthread_create(workers + started, nullptr, accept_sessions,
+                           &srv) != 0) break;
+    }
+    accept_sessions(&srv);
+    for (size_t i = 0; i < started; ++i) {
+        pthread_join(workers[i], nullptr);
+    }
+    free(workers);
+    err = srv.err;
+    unlink(opts->path);
+exit_socket:
+    close(srv.fd);
+exit_lock:
+    pthread_mutex_destroy(&srv.lock);
+    errno = err;
+    return false;
+}
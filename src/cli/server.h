@@ -0,0 +1,34 @@
+//
+//  server.h
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_cli_server_h
+#define Aldo_cli_server_h
+
+#include <stdio.h>
+
+constexpr int ServerMaxWorkers = 256;
+
+// Line-oriented emulator sessions: each request is one line of
+// space-separated words and gets one "ok [result]" or "err message"
+// line in response; see server.c for the command list.
+struct server_opts {
+    const char *path;   // Unix socket path, or null for stdin/stdout
+    int workers;        // Concurrent sessions on a socket
+    bool bcdsupport, zeroram;
+};
+
+// serve one session, reading requests from in and writing replies to out
+// until quit or end of input; returns false if the session could not be
+// set up, with errno set.
+bool server_session(FILE *in, FILE *out, const struct server_opts *opts);
+
+// serve a single session over stdin/stdout, or accept sessions on a Unix
+// socket until a fatal error; returns false if the session or server
+// could not be set up, with errno set.
+bool server_run(const struct server_opts *opts);
+
+#endif
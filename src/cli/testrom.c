@@ -0,0 +1,250 @@
+//
+//  testrom.c
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "testrom.h"
+
+#include "cart.h"
+#include "ctrlsignal.h"
+#include "cycleclock.h"
+#include "debug.h"
+#include "nes.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// protocol asks for at least 100ms between reset request and reset
+constexpr uint64_t ResetDelayFrames = 6;
+constexpr size_t TextSize = 512;
+
+static const char *const restrict StatusNames[] = {
+    "PASS", "FAIL", "NOSTAT", "TIMEOUT", "HALT", "ERROR",
+};
+
+struct pool {
+    pthread_mutex_t lock;
+    struct testrom *roms;
+    size_t count, next;
+    bool zeroram;
+};
+
+static void run_frame(aldo_nes *nes, struct aldo_clock *clock)
+{
+    clock->budget = aldo_nes_frame_factor();
+    aldo_nes_clock(nes, clock);
+}
+
+// hold the reset line for a frame, long enough for the CPU to latch it
+static void reset_console(aldo_nes *nes, struct aldo_clock *clock)
+{
+    aldo_nes_set_probe(nes, ALDO_INT_RST, true);
+    run_frame(nes, clock);
+    aldo_nes_set_probe(nes, ALDO_INT_RST, false);
+}
+
+static void run_console(struct testrom *rom, aldo_nes *nes, aldo_cart *c,
+                        bool zeroram)
+{
+    struct aldo_clock clock = {};
+    uint64_t resetwait = 0;
+    auto protocol = false;
+    aldo_nes_powerup(nes, c, zeroram);
+    aldo_nes_halt(nes, false);
+    rom->status = TESTROM_TIMEOUT;
+    while (rom->frames < TestRomMaxFrames) {
+        run_frame(nes, &clock);
+        ++rom->frames;
+        if (aldo_nes_halted(nes)) {
+            rom->status = TESTROM_HALT;
+            break;
+        }
+
+        uint8_t header[TestRomHeaderSize];
+        auto status = aldo_nes_copymem(nes, AldoWramStartAddr, sizeof header,
+                                       header) == sizeof header
+                        ? testrom_status(header)
+                        : -1;
+        protocol |= status >= 0;
+        if (!protocol && rom->frames == TestRomStartFrames) {
+            rom->status = TESTROM_NOSTATUS;
+            break;
+        }
+        if (status < 0 || status == TestRomRunning) {
+            resetwait = 0;
+        } else if (status == TestRomReset) {
+            if (++resetwait == ResetDelayFrames) {
+                reset_console(nes, &clock);
+                ++rom->frames;
+                resetwait = 0;
+            }
+        } else {
+            rom->code = status;
+            rom->status = status == 0 ? TESTROM_PASS : TESTROM_FAIL;
+            break;
+        }
+    }
+    if (protocol) {
+        uint8_t text[TextSize];
+        auto len = aldo_nes_copymem(nes, AldoWramStartAddr + TestRomHeaderSize,
+                                    sizeof text, text);
+        testrom_message(len, text, rom->message);
+    } else {
+        rom->message[0] = '\0';
+    }
+    aldo_nes_powerdown(nes);
+}
+
+static void run_rom(struct testrom *rom, bool zeroram)
+{
+    aldo_cart *c;
+    rom->code = aldo_cart_create_file(&c, rom->path);
+    if (rom->code < 0) {
+        rom->status = TESTROM_ERR;
+        snprintf(rom->message, sizeof rom->message, "%s",
+                 rom->code == ALDO_CART_ERR_ERNO
+                    ? strerror(errno)
+                    : aldo_cart_errstr(rom->code));
+        return;
+    }
+
+    rom->status = TESTROM_ERR;
+    snprintf(rom->message, sizeof rom->message, "%s", strerror(ENOMEM));
+    auto dbg = aldo_debug_new();
+    if (!dbg) goto exit_cart;
+    auto nes = aldo_nes_new(dbg, false, nullptr);
+    if (!nes) goto exit_debug;
+
+    run_console(rom, nes, c, zeroram);
+
+    aldo_nes_free(nes);
+exit_debug:
+    aldo_debug_free(dbg);
+exit_cart:
+    aldo_cart_free(c);
+}
+
+static void *run_roms(void *ctx)
+{
+    struct pool *p = ctx;
+    for (;;) {
+        pthread_mutex_lock(&p->lock);
+        auto i = p->next < p->count ? p->next++ : p->count;
+        pthread_mutex_unlock(&p->lock);
+        if (i == p->count) return nullptr;
+        run_rom(p->roms + i, p->zeroram);
+    }
+}
+
+//
+// MARK: - Public Interface
+//
+
+int testrom_status(const uint8_t header[static TestRomHeaderSize])
+{
+    assert(header != nullptr);
+
+    return header[1] == 0xde && header[2] == 0xb0 && header[3] == 0x61
+            ? header[0]
+            : -1;
+}
+
+void testrom_message(size_t count, const uint8_t text[count],
+                     char message[static TestRomMessageSize])
+{
+    assert(text != nullptr);
+    assert(message != nullptr);
+
+    size_t len = 0;
+    auto space = false;
+    for (size_t i = 0; i < count && text[i] != '\0'; ++i) {
+        if (isspace(text[i])) {
+            space = len > 0;
+            continue;
+        }
+        if (len + (space ? 2 : 1) >= TestRomMessageSize) break;
+        if (space) {
+            message[len++] = ' ';
+            space = false;
+        }
+        message[len++] = isprint(text[i]) ? (char)text[i] : '?';
+    }
+    message[len] = '\0';
+}
+
+bool testrom_run(size_t count, struct testrom roms[count], int jobs,
+                 bool zeroram)
+{
+    assert(roms != nullptr);
+    assert(jobs > 0);
+
+    if (count == 0) return true;
+    for (size_t i = 0; i < count; ++i) {
+        auto r = roms + i;
+        *r = (typeof(*r)){.path = r->path};
+    }
+
+    struct pool p = {.roms = roms, .count = count, .zeroram = zeroram};
+    auto err = pthread_mutex_init(&p.lock, nullptr);
+    if (err != 0) {
+        errno = err;
+        return false;
+    }
+
+    // the calling thread is one of the jobs, and if helper threads fail
+    // to start the threads that did start pick up their share.
+    size_t helpers = (size_t)jobs < count ? (size_t)jobs - 1 : count - 1;
+    pthread_t *threads = helpers > 0 ? calloc(helpers, sizeof *threads)
+                                     : nullptr;
+    size_t started = 0;
+    for (; threads && started < helpers; ++started) {
+        if (pthread_create(threads + started, nullptr, run_roms, &p) != 0)
+            break;
+    }
+    run_roms(&p);
+    for (size_t i = 0; i < started; ++i) {
+        pthread_join(threads[i], nullptr);
+    }
+    free(threads);
+    pthread_mutex_destroy(&p.lock);
+    return true;
+}
+
+bool testrom_write_table(size_t count, const struct testrom roms[count],
+                         size_t *failed, FILE *f)
+{
+    assert(roms != nullptr);
+    assert(failed != nullptr);
+    assert(f != nullptr);
+
+    *failed = 0;
+    if (fprintf(f, "%-7s %6s %4s  %s\n", "Result", "Frames", "Code",
+                "ROM") < 0) return false;
+    for (size_t i = 0; i < count; ++i) {
+        auto r = roms + i;
+        if (r->status != TESTROM_PASS) {
+            ++*failed;
+        }
+        if (fprintf(f, "%-7s %6" PRIu64 " ", StatusNames[r->status],
+                    r->frames) < 0) return false;
+        auto err = r->status == TESTROM_PASS || r->status == TESTROM_FAIL
+                    ? fprintf(f, "%4d  ", r->code)
+                    : fprintf(f, "%4s  ", "-");
+        if (err < 0) return false;
+        err = r->message[0] != '\0' && r->status != TESTROM_PASS
+                ? fprintf(f, "%s: %s\n", r->path, r->message)
+                : fprintf(f, "%s\n", r->path);
+        if (err < 0) return false;
+    }
+    return fprintf(f, "%zu of %zu passed\n", count - *failed, count) >= 0;
+}
@@ -0,0 +1,59 @@
+//
+//  testrom.h
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_cli_testrom_h
+#define Aldo_cli_testrom_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+// Test ROMs following the status-byte protocol report through WRAM:
+//  $6000: status, $80 running, $81 reset requested, < $80 result code
+//  $6001-$6003: signature $DE $B0 $61, set once status is valid
+//  $6004: zero-terminated text output
+constexpr size_t TestRomHeaderSize = 4;
+constexpr size_t TestRomMessageSize = 128;
+constexpr int TestRomMaxFrames = 60 * 120;
+// ROMs that have not set the signature by this frame never will
+constexpr int TestRomStartFrames = 60 * 10;
+constexpr int TestRomMaxJobs = 256;
+constexpr int TestRomRunning = 0x80;
+constexpr int TestRomReset = 0x81;
+
+struct testrom {
+    const char *path;                   // Non-owning Pointer
+    uint64_t frames;                    // Frames run before result or timeout
+    enum testrom_status {
+        TESTROM_PASS,                   // Result code 0
+        TESTROM_FAIL,                   // Non-zero result code
+        TESTROM_NOSTATUS,               // No signature by TestRomStartFrames
+        TESTROM_TIMEOUT,                // No result within TestRomMaxFrames
+        TESTROM_HALT,                   // Console halted before a result
+        TESTROM_ERR,                    // ROM could not be loaded or run
+    } status;
+    int code;                           // Result code or cart error code
+    char message[TestRomMessageSize];   // Text output or error description
+};
+
+// status byte from header at $6000, or -1 if signature is not set
+int testrom_status(const uint8_t header[static TestRomHeaderSize]);
+// copy zero-terminated text output into message as a single line,
+// collapsing whitespace runs into single spaces.
+void testrom_message(size_t count, const uint8_t text[count],
+                     char message[static TestRomMessageSize]);
+
+// run each ROM to a result on up to jobs threads; returns false if worker
+// threads cannot be started, otherwise every ROM has a status.
+bool testrom_run(size_t count, struct testrom roms[count], int jobs,
+                 bool zeroram);
+// returns false on I/O error, otherwise sets failed to the number of ROMs
+// that did not pass.
+bool testrom_write_table(size_t count, const struct testrom roms[count],
+                         size_t *failed, FILE *f);
+
+#endif
@@ -0,0 +1,329 @@
+//
+//  tracecmp.c
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "tracecmp.h"
+
+#include "bytes.h"
+
+#include <assert.h>
+#include <ctype.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define TRACE_FIELD_X \
+X(PC, "PC") \
+X(BYTES, "Bytes") \
+X(A, "A") \
+X(X, "X") \
+X(Y, "Y") \
+X(P, "P") \
+X(S, "S") \
+X(PPU, "PPU") \
+X(CYC, "CYC")
+
+enum tracefield {
+#define X(s, n) TRF_##s,
+    TRACE_FIELD_X
+#undef X
+    TRF_COUNT,
+};
+
+// B flag is not a physical status register bit so it is excluded from
+// comparison, same as the nestest diff in the Makefile.
+constexpr uint64_t StatusMask = 0xef;
+
+struct tracefields {
+    uint64_t values[TRF_COUNT];
+    unsigned int present;
+};
+
+static void set_field(struct tracefields *f, enum tracefield field,
+                      uint64_t value)
+{
+    f->values[field] = value;
+    f->present |= 1u << field;
+}
+
+static void parse_register(struct tracefields *f, enum tracefield field,
+                           const char *regs, const char *tag)
+{
+    auto r = strstr(regs, tag);
+    unsigned int value;
+    if (r && sscanf(r + strlen(tag), "%2X", &value) == 1) {
+        set_field(f, field, value);
+    }
+}
+
+// Parse either trace format into comparable fields:
+// nestest: "C000  4C F5 C5  JMP $C5F5  A:00 X:00 Y:00 P:24 SP:FD PPU:  0, 21 CYC:7"
+// aldo:    "C000: 4C F5 C5  JMP $C5F5  A:00 X:00 Y:00 P:24 (nvUbdIzc) S:FD PPU:  0, 21 CPU:7"
+static bool parse_fields(const char *line, struct tracefields *f)
+{
+    *f = (typeof(*f)){};
+
+    unsigned int pc;
+    int n;
+    if (sscanf(line, "%4X%n", &pc, &n) < 1 || n != 4) return false;
+    set_field(f, TRF_PC, pc);
+
+    auto cur = line + n;
+    if (*cur == ':') {
+        ++cur;
+    }
+    while (*cur == ' ') {
+        ++cur;
+    }
+    // pack byte count into upper byte so short and long instructions
+    // with the same leading bytes never compare equal
+    uint64_t bytes = 0;
+    int count = 0;
+    for (;
+         count < 3 && isxdigit((unsigned char)cur[0])
+            && isxdigit((unsigned char)cur[1]) && cur[2] == ' ';
+         ++count, cur += 3) {
+        unsigned int b;
+        sscanf(cur, "%2X", &b);
+        bytes = (bytes << 8) | b;
+    }
+    if (count > 0) {
+        set_field(f, TRF_BYTES, ((uint64_t)count << 24) | bytes);
+    }
+
+    auto regs = strstr(cur, " A:");
+    if (!regs) return true;
+
+    parse_register(f, TRF_A, regs, " A:");
+    parse_register(f, TRF_X, regs, " X:");
+    parse_register(f, TRF_Y, regs, " Y:");
+    parse_register(f, TRF_P, regs, " P:");
+    parse_register(f, TRF_S, regs, " S:");
+    parse_register(f, TRF_S, regs, " SP:");
+    auto ppu = strstr(regs, "PPU:");
+    int line_no, dot;
+    if (ppu && sscanf(ppu, "PPU:%d,%d", &line_no, &dot) == 2) {
+        set_field(f, TRF_PPU, ((uint64_t)line_no << 16) | (uint16_t)dot);
+    }
+    auto cyc = strstr(regs, "CPU:");
+    if (!cyc) {
+        cyc = strstr(regs, "CYC:");
+    }
+    uint64_t cycles;
+    if (cyc && sscanf(cyc + 4, "%" SCNu64, &cycles) == 1) {
+        set_field(f, TRF_CYC, cycles);
+    }
+    return true;
+}
+
+static bool field_equal(const struct tracefields *expected,
+                        const struct tracefields *actual,
+                        enum tracefield field)
+{
+    uint64_t lhs = expected->values[field], rhs = actual->values[field];
+    if (field == TRF_P) {
+        lhs &= StatusMask;
+        rhs &= StatusMask;
+    }
+    return lhs == rhs;
+}
+
+// compare only the fields present in both lines
+static bool fields_equal(const struct tracefields *expected,
+                         const struct tracefields *actual)
+{
+    auto common = expected->present & actual->present;
+    for (enum tracefield i = 0; i < TRF_COUNT; ++i) {
+        if (aldo_getbit(common, i) && !field_equal(expected, actual, i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static const char *format_field(const struct tracefields *f,
+                                enum tracefield field, char buf[static 24])
+{
+    if (!aldo_getbit(f->present, field)) return "--";
+
+    auto value = f->values[field];
+    switch (field) {
+    case TRF_PC:
+        sprintf(buf, "%04" PRIX64, value);
+        break;
+    case TRF_BYTES:
+        {
+            auto count = (int)(value >> 24);
+            auto len = 0;
+            for (auto i = count - 1; i >= 0; --i) {
+                len += sprintf(buf + len, "%s%02X", len > 0 ? " " : "",
+                               (unsigned int)((value >> (i * 8)) & 0xff));
+            }
+        }
+        break;
+    case TRF_PPU:
+        sprintf(buf, "%3d,%3d", (int)(value >> 16), (int)(value & 0xffff));
+        break;
+    case TRF_CYC:
+        sprintf(buf, "%" PRIu64, value);
+        break;
+    default:
+        sprintf(buf, "%02" PRIX64, value);
+        break;
+    }
+    return buf;
+}
+
+static void trim_newline(char *line)
+{
+    line[strcspn(line, "\r\n")] = '\0';
+}
+
+// read next non-blank golden line, discarding any overflow of long lines
+static bool read_golden(struct tracecmp *self)
+{
+    while (fgets(self->expected, sizeof self->expected, self->golden)) {
+        auto len = strlen(self->expected);
+        if (len > 0 && self->expected[len - 1] != '\n') {
+            int c;
+            while ((c = fgetc(self->golden)) != EOF && c != '\n');
+        }
+        ++self->goldenline;
+        trim_newline(self->expected);
+        if (self->expected[0] != '\0') return true;
+    }
+    self->expected[0] = '\0';
+    self->state = ferror(self->golden) ? TRACECMP_ERR : TRACECMP_END;
+    return false;
+}
+
+static void push_context(struct tracecmp *self)
+{
+    strcpy(self->context[self->history], self->actual);
+    self->history = (self->history + 1) % TraceCmpContext;
+}
+
+static void print_divergence(const struct tracecmp *self, FILE *f)
+{
+    fprintf(f, "Trace diverged at line %" PRIu64 " (golden log line %" PRIu64
+            ")\n", self->matched + 1, self->goldenline);
+    auto count = self->matched < TraceCmpContext
+                    ? (size_t)self->matched
+                    : TraceCmpContext;
+    if (count > 0) {
+        fprintf(f, "--- Preceding %zu lines ---\n", count);
+    }
+    for (size_t i = TraceCmpContext - count; i < TraceCmpContext; ++i) {
+        fprintf(f, "  %s\n",
+                self->context[(self->history + i) % TraceCmpContext]);
+    }
+    fprintf(f, "--- Divergence ---\n"
+            "- %s\n"
+            "+ %s\n", self->expected, self->actual);
+
+    struct tracefields expected, actual;
+    parse_fields(self->expected, &expected);
+    parse_fields(self->actual, &actual);
+    static const char *const restrict names[] = {
+#define X(s, n) n,
+        TRACE_FIELD_X
+#undef X
+    };
+    fprintf(f, "  %-6s %-12s %-12s\n", "Field", "Expected", "Actual");
+    for (enum tracefield i = 0; i < TRF_COUNT; ++i) {
+        char ebuf[24], abuf[24];
+        bool common = aldo_getbit(expected.present & actual.present, i);
+        fprintf(f, "%c %-6s %-12s %-12s\n",
+                common && !field_equal(&expected, &actual, i) ? '*' : ' ',
+                names[i], format_field(&expected, i, ebuf),
+                format_field(&actual, i, abuf));
+    }
+}
+
+//
+// MARK: - Public Interface
+//
+
+void tracecmp_init(struct tracecmp *self, FILE *golden)
+{
+    assert(self != nullptr);
+    assert(golden != nullptr);
+
+    *self = (typeof(*self)){.golden = golden, .state = TRACECMP_SYNC};
+}
+
+bool tracecmp_line(void *ctx, const char *line)
+{
+    assert(ctx != nullptr);
+    assert(line != nullptr);
+
+    struct tracecmp *self = ctx;
+    struct tracefields expected, actual;
+    switch (self->state) {
+    case TRACECMP_SYNC:
+        // skip emulator lines (e.g. the RESET sequence) until reaching the
+        // golden log's starting address.
+        if (self->expected[0] == '\0' && !read_golden(self)) return false;
+        if (!parse_fields(self->expected, &expected)
+            || !parse_fields(line, &actual)
+            || expected.values[TRF_PC] != actual.values[TRF_PC]) return true;
+        self->state = TRACECMP_MATCH;
+        break;
+    case TRACECMP_MATCH:
+        if (!read_golden(self)) return false;
+        parse_fields(self->expected, &expected);
+        parse_fields(line, &actual);
+        break;
+    default:
+        return false;
+    }
+
+    snprintf(self->actual, sizeof self->actual, "%s", line);
+    trim_newline(self->actual);
+    if (!fields_equal(&expected, &actual)) {
+        self->state = TRACECMP_DIVERGED;
+        return false;
+    }
+    push_context(self);
+    ++self->matched;
+    return true;
+}
+
+bool tracecmp_finish(struct tracecmp *self, FILE *f)
+{
+    assert(self != nullptr);
+    assert(f != nullptr);
+
+    // a run halted on the golden log's final line is a complete match
+    if (self->state == TRACECMP_MATCH) {
+        read_golden(self);
+    }
+    switch (self->state) {
+    case TRACECMP_SYNC:
+        fputs("Trace never reached golden log start address\n", f);
+        return false;
+    case TRACECMP_MATCH:
+        fprintf(f, "Trace matched %" PRIu64 " lines; run stopped before end"
+                " of golden log (line %" PRIu64 ")\n", self->matched,
+                self->goldenline);
+        return true;
+    case TRACECMP_DIVERGED:
+        print_divergence(self, f);
+        return false;
+    case TRACECMP_END:
+        fprintf(f, "Trace matched all %" PRIu64 " lines of golden log\n",
+                self->matched);
+        return true;
+    case TRACECMP_ERR:
+        fputs("Golden log I/O failure\n", f);
+        return false;
+    default:
+        assert(((void)"INVALID TRACECMP STATE", false));
+        return false;
+    }
+}
@@ -0,0 +1,45 @@
+//
+//  tracecmp.h
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_cli_tracecmp_h
+#define Aldo_cli_tracecmp_h
+
+#include "nes.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+constexpr size_t TraceCmpContext = 8;
+constexpr size_t TraceCmpGoldenSize = 256;
+
+// Streaming comparison of emulator trace lines against a golden trace log;
+// accepts both nestest-style and Aldo trace log formats for either side.
+struct tracecmp {
+    FILE *golden;                       // Golden trace log; Non-owning Pointer
+    uint64_t goldenline, matched;       // Golden log line, matched lines
+    size_t history;                     // Next slot in context ring buffer
+    enum tracecmp_state {
+        TRACECMP_SYNC,                  // Waiting for first golden PC
+        TRACECMP_MATCH,                 // All compared lines match
+        TRACECMP_DIVERGED,              // Trace diverged from golden log
+        TRACECMP_END,                   // Reached end of golden log
+        TRACECMP_ERR,                   // Golden log I/O failure
+    } state;
+    char
+        expected[TraceCmpGoldenSize],
+        actual[AldoTraceLineSize],
+        context[TraceCmpContext][AldoTraceLineSize];
+};
+
+void tracecmp_init(struct tracecmp *self, FILE *golden);
+// aldo_tracehook; returns false on divergence or end of golden log
+bool tracecmp_line(void *ctx, const char *line);
+// write comparison report to f, returns true if no divergence was found
+bool tracecmp_finish(struct tracecmp *self, FILE *f);
+
+#endif
@@ -16,6 +16,8 @@
 
 #include <assert.h>
 #include <inttypes.h>
+#include <limits.h>
+#include <math.h>
 #include <signal.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -24,9 +26,18 @@
 
 static const char *const restrict DistractorFormat = "%c Running\u2026";
 
+// Each tick runs the console until halted or out of budget, and the budget
+// adapts to the measured emulation rate so a tick lasts about this long;
+// wall-clock sampling, progress, and signal checks happen only between ticks.
+constexpr double TickTargetMs = 100.0;
+// Arbitrary starting budget, 6502s often ran at 1 MHz so a million
+// cycles per tick seems as good a number as any.
+constexpr int InitialBudget = 1000000;
+
 struct runclock {
     struct aldo_clock clock;
     double avg_ticktime_ms;
+    int budget, ran;
 };
 
 static void clearline()
@@ -57,7 +68,7 @@ static int init_ui()
     return sigaction(SIGINT, &act, nullptr) == 0 ? 0 : ALDO_UI_ERR_ERNO;
 }
 
-static void tick_start(struct runclock *c, const struct emulator *emu)
+static void sample_clock(struct runclock *c)
 {
     aldo_clock_tickstart(&c->clock, true);
 
@@ -67,18 +78,33 @@ static void tick_start(struct runclock *c, const struct emulator *emu)
     c->avg_ticktime_ms = (c->clock.ticktime_ms + (ticks * c->avg_ticktime_ms))
                             / (ticks + 1);
 
-    // Arbitrary per-tick budget, 6502s often ran at 1 MHz so a million
-    // cycles per tick seems as good a number as any.
-    c->clock.budget = 1e6;
     // app runtime and emulator time are equivalent in batch mode
     c->clock.emutime = c->clock.runtime;
+}
 
-    // exit batch mode if emulator is halted
-    if (aldo_nes_halted(emu->console)) {
-        QuitSignal = 1;
+static void adapt_budget(struct runclock *c)
+{
+    if (c->ran <= 0 || !isgreater(c->clock.ticktime_ms, 0.0)) return;
+
+    auto rate = c->ran / c->clock.ticktime_ms;
+    auto budget = rate * TickTargetMs;
+    auto minbudget = aldo_nes_frame_factor();
+    if (budget < minbudget) {
+        c->budget = minbudget;
+    } else if (budget > INT_MAX) {
+        c->budget = INT_MAX;
+    } else {
+        c->budget = (int)budget;
     }
 }
 
+static void tick_start(struct runclock *c)
+{
+    sample_clock(c);
+    adapt_budget(c);
+    c->clock.budget = c->budget;
+}
+
 static void update_progress(const struct runclock *c)
 {
     static constexpr char distractor[] = {'|', '/', '-', '\\'};
@@ -97,6 +123,7 @@ static void update_progress(const struct runclock *c)
 
 static void tick_end(struct runclock *c)
 {
+    c->ran = c->budget - c->clock.budget;
     aldo_clock_tickend(&c->clock);
 }
 
@@ -106,19 +133,25 @@ static void write_summary(const struct emulator *emu, const struct runclock *c)
     if (!emu->args->verbose) return;
 
     bool scale_ms = c->clock.runtime < 1;
-    printf("---=== %s ===---\n", argparse_filename(emu->args->filepath));
-    printf("Runtime (%ssec): %.3f\n", scale_ms ? "m" : "",
-           scale_ms ? c->clock.runtime * ALDO_MS_PER_S : c->clock.runtime);
-    printf("Avg Tick Time (msec): %.3f\n", c->avg_ticktime_ms);
-    printf("Total Cycles: %" PRIu64 "\n", c->clock.cycles);
-    printf("Avg Cycles/sec: %.2f\n",
-           (double)c->clock.cycles / c->clock.runtime);
+    auto f = emu->report;
+    fprintf(f, "---=== %s ===---\n", argparse_filename(emu->args->filepath));
+    fprintf(f, "Runtime (%ssec): %.3f\n", scale_ms ? "m" : "",
+            scale_ms ? c->clock.runtime * ALDO_MS_PER_S : c->clock.runtime);
+    fprintf(f, "Avg Tick Time (msec): %.3f\n", c->avg_ticktime_ms);
+    fprintf(f, "Ticks: %" PRIu64 "\n", c->clock.ticks);
+    fprintf(f, "Total Cycles: %" PRIu64 "\n", c->clock.cycles);
+    fprintf(f, "Avg Cycles/sec: %.2f\n",
+            (double)c->clock.cycles / c->clock.runtime);
+    fprintf(f, "Total Frames: %" PRIu64 "\n", c->clock.frames);
+    if (emu->hashes) {
+        fprintf(f, "Frame Digest: %016" PRIx64 "\n", emu->hashes->digest);
+    }
     auto bp = aldo_debug_halted(emu->debugger);
     if (bp) {
         char break_desc[AldoHexprFmtSize];
         auto err = aldo_haltexpr_desc(&bp->expr, break_desc);
-        printf("Break: %s\n",
-               err < 0 ? aldo_haltexpr_errstr(err) : break_desc);
+        fprintf(f, "Break: %s\n",
+                err < 0 ? aldo_haltexpr_errstr(err) : break_desc);
     }
 }
 
@@ -133,14 +166,18 @@ int ui_batch_loop(struct emulator *emu)
     auto err = init_ui();
     if (err < 0) return err;
 
-    struct runclock clock = {};
+    struct runclock clock = {.budget = InitialBudget};
     aldo_clock_start(&clock.clock);
-    do {
-        tick_start(&clock, emu);
+    // a halt ends the run as soon as the console stops rather than
+    // waiting for the next tick.
+    while (QuitSignal == 0 && !aldo_nes_halted(emu->console)) {
+        tick_start(&clock);
         aldo_nes_clock(emu->console, &clock.clock);
         update_progress(&clock);
         tick_end(&clock);
-    } while (QuitSignal == 0);
+    }
+    // final wall-clock sample covers the last tick
+    sample_clock(&clock);
     write_summary(emu, &clock);
 
     return 0;
@@ -227,6 +227,7 @@ static void drawcontrols(const struct view *v, const struct emulator *emu,
 
     mvwhline(v->content, ++cursor_y, 0, 0, w);
     mvwaddstr(v->content, ++cursor_y, 0, "Halt/Run: <Space>");
+    mvwaddstr(v->content, ++cursor_y, 0, "Step Back/Reverse: u/U");
     mvwaddstr(v->content, ++cursor_y, 0, "Run Mode: m/M");
     mvwaddstr(v->content, ++cursor_y, 0, "Signal: d, i, n, s");
     mvwaddstr(v->content, ++cursor_y, 0,
@@ -255,6 +256,13 @@ static void drawdebugger(const struct view *v, const struct emulator *emu)
     werase(v->content);
     mvwprintw(v->content, cursor_y++, 0, "Tracing: %s",
               emu->args->tron ? "On" : "Off");
+    if (emu->rewind) {
+        mvwprintw(v->content, cursor_y++, 0, "Rewind: %zu (%.1fms)",
+                  aldo_rewind_count(emu->rewind),
+                  aldo_rewind_last_ms(emu->rewind));
+    } else {
+        mvwaddstr(v->content, cursor_y++, 0, "Rewind: Off");
+    }
     mvwaddstr(v->content, cursor_y++, 0, "Reset Override: ");
     auto resetvector = aldo_debug_vector_override(emu->debugger);
     if (resetvector == Aldo_NoResetVector) {
@@ -265,8 +273,31 @@ static void drawdebugger(const struct view *v, const struct emulator *emu)
     auto bp = aldo_debug_halted(emu->debugger);
     char break_desc[AldoHexprFmtSize];
     auto err = aldo_haltexpr_desc(bp ? &bp->expr : &empty, break_desc);
-    mvwprintw(v->content, cursor_y, 0, "Break: %s",
+    mvwprintw(v->content, cursor_y++, 0, "Break: %s",
               err < 0 ? aldo_haltexpr_errstr(err) : break_desc);
+    mvwaddstr(v->content, cursor_y++, 0, "Watchpoints:");
+    auto maxy = getmaxy(v->content);
+    auto watches = 0;
+    auto count = (ptrdiff_t)aldo_debug_bp_count(emu->debugger);
+    for (ptrdiff_t i = 0; i < count && cursor_y < maxy; ++i) {
+        bp = aldo_debug_bp_at(emu->debugger, i);
+        switch (bp->expr.cond) {
+        case ALDO_HLT_READ:
+        case ALDO_HLT_WRITE:
+        case ALDO_HLT_ACCESS:
+            err = aldo_haltexpr_desc(&bp->expr, break_desc);
+            mvwprintw(v->content, cursor_y++, 1, "%c %s",
+                      bp->enabled ? '*' : ' ',
+                      err < 0 ? aldo_haltexpr_errstr(err) : break_desc);
+            ++watches;
+            break;
+        default:
+            break;
+        }
+    }
+    if (watches == 0) {
+        waddstr(v->content, " None");
+    }
 }
 
 static void drawcart(const struct view *v, const struct emulator *emu)
@@ -892,7 +923,7 @@ static void init_ui(struct layout *l, int ramsheets)
     static constexpr auto col2w = 29;
     static constexpr auto col3w = 29;
     static constexpr auto col4w = 54;
-    static constexpr auto sysh = 27;
+    static constexpr auto sysh = 28;
     static constexpr auto crth = 4;
     static constexpr auto cpuh = 20;
     static constexpr auto maxh = 37;
@@ -1037,6 +1068,12 @@ static void handle_input(struct viewstate *vs, const struct emulator *emu)
         aldo_nes_set_probe(emu->console, ALDO_INT_RST,
                            !aldo_nes_probe(emu->console, ALDO_INT_RST));
         break;
+    case 'u':
+        aldo_nes_step_back(emu->console, &vs->clock.clock);
+        break;
+    case 'U':
+        aldo_nes_reverse_continue(emu->console, &vs->clock.clock);
+        break;
     }
 }
 
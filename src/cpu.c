@@ -1750,6 +1750,13 @@ bool aldo_cpu_jammed(const struct aldo_mos6502 *self)
     return self->t == 4 && Aldo_Decode[self->opc].mode == ALDO_AM_JAM;
 }
 
+uint8_t aldo_cpu_status(const struct aldo_mos6502 *self)
+{
+    assert(self != nullptr);
+
+    return get_p(self, false);
+}
+
 void aldo_cpu_snapshot(const struct aldo_mos6502 *self, struct aldo_snapshot *snp)
 {
     assert(self != nullptr);
@@ -1759,7 +1766,7 @@ void aldo_cpu_snapshot(const struct aldo_mos6502 *self, struct aldo_snapshot *sn
     cpu->program_counter = self->pc;
     cpu->accumulator = self->a;
     cpu->stack_pointer = self->s;
-    cpu->status = get_p(self, false);
+    cpu->status = aldo_cpu_status(self);
     cpu->xindex = self->x;
     cpu->yindex = self->y;
 
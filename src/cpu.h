@@ -95,6 +95,7 @@ int aldo_cpu_cycle(struct aldo_mos6502 *self);
 bool aldo_cpu_reset_pending(const struct aldo_mos6502 *self);
 bool aldo_cpu_suspended(const struct aldo_mos6502 *self);
 bool aldo_cpu_jammed(const struct aldo_mos6502 *self);
+uint8_t aldo_cpu_status(const struct aldo_mos6502 *self);
 void aldo_cpu_snapshot(const struct aldo_mos6502 *self, struct aldo_snapshot *snp);
 
 struct aldo_peekresult
@@ -11,6 +11,7 @@
 #include "bytes.h"
 #include "cpu.h"
 #include "cycleclock.h"
+#include "ppu.h"
 #include "tsutil.h"
 
 #include <assert.h>
@@ -19,40 +20,60 @@
 #include <stdlib.h>
 #include <string.h>
 
+// Index of enabled breakpoints by condition, rebuilt whenever the
+// breakpoint list changes; lets the per-cycle break check avoid scanning
+// the breakpoint list until some condition could actually match.
+struct breakpoint_index {
+    uint64_t addresses[ALDO_MEMBLOCK_64KB / 64];    // Address bitmap
+    struct pending_target {
+        uint64_t next, base;    // Earliest target at or after base count
+    } cycles, frames;
+    uint64_t watchpages[2][ALDO_MEMBLOCK_64KB / 256 / 64];  // CPU/VRAM
+                                                            // page bitmaps
+    double runtime;             // Earliest runtime target
+    size_t enabled;             // Count of enabled breakpoints
+    bool
+        exprs,                  // Any predicate-only breakpoints
+        jam;                    // Any jam breakpoints
+};
+
+// Bus accesses to watched pages since the last break check
+struct watch_log {
+    struct watch_event {
+        uint16_t addr;
+        bool vram, write;
+    } events[8];
+    size_t count;
+};
+
 struct aldo_debugger_context {
     struct breakpoint_vector {
         size_t capacity, size;
         struct aldo_breakpoint *items;
     } breakpoints;
+    struct breakpoint_index bpindex;
     struct aldo_mos6502 *cpu;   // Non-owning Pointer
+    const struct aldo_rp2c02 *ppu;  // Non-owning Pointer
     struct resdecorator {
         struct aldo_busdevice inner;
         uint16_t vector;
         bool active;
     } dec;
+    // watch decorators are only installed on bus partitions containing
+    // watched pages and always wrap any other decorators.
+    struct watchdecorator {
+        struct aldo_busdevice inner;
+        struct aldo_debugger_context *dbg;
+        uint16_t addr;          // Decorated partition address
+        bool vram;
+    } watchdecs[16];
+    size_t watchdec_count;
+    struct watch_log watchlog;
     ptrdiff_t halted;
     int resetvector;
+    bool replaying;             // Re-executing history, do not count hits
 };
 
-static void remove_reset_override(struct aldo_debugger_context *self)
-{
-    if (!self->dec.active) return;
-
-    auto r = aldo_bus_set(self->cpu->mbus, ALDO_CPU_VECTOR_RST,
-                          self->dec.inner);
-    (void)r, assert(r);
-    self->dec = (typeof(self->dec)){};
-}
-
-static void update_reset_override(struct aldo_debugger_context *self)
-{
-    if (self->resetvector == Aldo_NoResetVector) {
-        remove_reset_override(self);
-    } else {
-        aldo_debug_sync_bus(self);
-    }
-}
-
 //
 // MARK: - Bus Interception
 //
@@ -89,6 +110,158 @@ static size_t resetaddr_copy(const void *restrict ctx, uint16_t addr,
             : 0;
 }
 
+static aldo_bus *watch_bus(const struct aldo_debugger_context *self, bool vram)
+{
+    if (vram) return self->ppu ? self->ppu->vbus : nullptr;
+    return self->cpu ? self->cpu->mbus : nullptr;
+}
+
+static void watch_record(struct watchdecorator *dec, uint16_t addr,
+                         bool write)
+{
+    auto self = dec->dbg;
+    // detached CPU cycles (peek mode, RST) are not real bus activity
+    if (!dec->vram && self->cpu && self->cpu->detached) return;
+
+    auto pages = self->bpindex.watchpages[dec->vram];
+    auto page = addr >> 8;
+    if (!aldo_getbit(pages[page / 64], page % 64)) return;
+
+    auto log = &self->watchlog;
+    if (log->count < aldo_arrsz(log->events)) {
+        log->events[log->count++] = (struct watch_event){
+            addr, dec->vram, write,
+        };
+    }
+}
+
+static bool watch_bus_read(void *restrict ctx, uint16_t addr,
+                           uint8_t *restrict d)
+{
+    struct watchdecorator *dec = ctx;
+    watch_record(dec, addr, false);
+    return dec->inner.read ? dec->inner.read(dec->inner.ctx, addr, d) : false;
+}
+
+static bool watch_bus_write(void *ctx, uint16_t addr, uint8_t d)
+{
+    struct watchdecorator *dec = ctx;
+    watch_record(dec, addr, true);
+    return dec->inner.write
+            ? dec->inner.write(dec->inner.ctx, addr, d)
+            : false;
+}
+
+static size_t watch_bus_copy(const void *restrict ctx, uint16_t addr,
+                             size_t count, uint8_t dest[restrict count])
+{
+    const struct watchdecorator *dec = ctx;
+    return dec->inner.copy
+            ? dec->inner.copy(dec->inner.ctx, addr, count, dest)
+            : 0;
+}
+
+static void add_bus_watches(struct aldo_debugger_context *self, bool vram)
+{
+    auto bus = watch_bus(self, vram);
+    if (!bus) return;
+
+    auto pages = self->bpindex.watchpages[vram];
+    for (size_t page = 0; page < ALDO_MEMBLOCK_64KB / 256; ++page) {
+        if (!aldo_getbit(pages[page / 64], page % 64)) continue;
+        if (self->watchdec_count == aldo_arrsz(self->watchdecs)) return;
+
+        auto dec = self->watchdecs + self->watchdec_count;
+        auto addr = (uint16_t)(page << 8);
+        struct aldo_busdevice prev, watch_device = {
+            watch_bus_read, watch_bus_write, watch_bus_copy, dec,
+        };
+        // out of range of the bus' address space
+        if (!aldo_bus_swap(bus, addr, watch_device, &prev)) return;
+        // partition already decorated by an earlier page
+        if (prev.read == watch_bus_read) {
+            aldo_bus_set(bus, addr, prev);
+            continue;
+        }
+        *dec = (typeof(*dec)){
+            .inner = prev,
+            .dbg = self,
+            .addr = addr,
+            .vram = vram,
+        };
+        ++self->watchdec_count;
+    }
+}
+
+static void add_watches(struct aldo_debugger_context *self)
+{
+    add_bus_watches(self, false);
+    add_bus_watches(self, true);
+}
+
+static void remove_watches(struct aldo_debugger_context *self)
+{
+    while (self->watchdec_count > 0) {
+        auto dec = self->watchdecs + --self->watchdec_count;
+        auto bus = watch_bus(self, dec->vram);
+        struct aldo_busdevice prev;
+        if (bus && aldo_bus_swap(bus, dec->addr, dec->inner, &prev)
+            && prev.ctx != dec) {
+            // partition was remapped since the decorator was installed
+            aldo_bus_set(bus, dec->addr, prev);
+        }
+    }
+    self->watchlog.count = 0;
+}
+
+static void update_watches(struct aldo_debugger_context *self)
+{
+    remove_watches(self);
+    add_watches(self);
+}
+
+//
+// MARK: - Bus Decorators
+//
+
+static void remove_reset_override(struct aldo_debugger_context *self)
+{
+    if (!self->dec.active) return;
+
+    auto r = aldo_bus_set(self->cpu->mbus, ALDO_CPU_VECTOR_RST,
+                          self->dec.inner);
+    (void)r, assert(r);
+    self->dec = (typeof(self->dec)){};
+}
+
+static void sync_reset_override(struct aldo_debugger_context *self)
+{
+    if (self->resetvector == Aldo_NoResetVector || !self->cpu) return;
+
+    if (self->dec.active) {
+        self->dec.vector = (uint16_t)self->resetvector;
+        return;
+    }
+
+    self->dec = (typeof(self->dec)){.vector = (uint16_t)self->resetvector};
+    struct aldo_busdevice resetaddr_device = {
+        resetaddr_read, resetaddr_write, resetaddr_copy, &self->dec,
+    };
+    self->dec.active = aldo_bus_swap(self->cpu->mbus, ALDO_CPU_VECTOR_RST,
+                                     resetaddr_device, &self->dec.inner);
+}
+
+static void update_reset_override(struct aldo_debugger_context *self)
+{
+    if (self->resetvector == Aldo_NoResetVector) {
+        remove_watches(self);
+        remove_reset_override(self);
+        add_watches(self);
+    } else {
+        aldo_debug_sync_bus(self);
+    }
+}
+
 //
 // MARK: - Breakpoints
 //
@@ -123,6 +296,160 @@ static bool halt_jammed(const struct aldo_mos6502 *cpu)
     return aldo_cpu_jammed(cpu);
 }
 
+static bool halt_watch(const struct aldo_breakpoint *bp,
+                       const struct watch_log *log)
+{
+    auto watch = &bp->expr.watch;
+    for (size_t i = 0; i < log->count; ++i) {
+        auto e = log->events + i;
+        if (e->vram != watch->vram || e->addr < watch->low
+            || watch->high < e->addr) continue;
+        switch (bp->expr.cond) {
+        case ALDO_HLT_READ:
+            if (!e->write) return true;
+            break;
+        case ALDO_HLT_WRITE:
+            if (e->write) return true;
+            break;
+        default:
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool halt_triggered(const struct aldo_breakpoint *bp,
+                           const struct aldo_clock *clk,
+                           const struct aldo_mos6502 *cpu,
+                           const struct watch_log *log)
+{
+    switch (bp->expr.cond) {
+    case ALDO_HLT_ADDR:
+        return halt_address(bp, cpu);
+    case ALDO_HLT_TIME:
+        return halt_runtime(bp, clk);
+    case ALDO_HLT_CYCLES:
+        return halt_cycles(bp, clk);
+    case ALDO_HLT_FRAMES:
+        return halt_frames(bp, clk);
+    case ALDO_HLT_JAM:
+        return halt_jammed(cpu);
+    case ALDO_HLT_READ:
+    case ALDO_HLT_WRITE:
+    case ALDO_HLT_ACCESS:
+        return halt_watch(bp, log);
+    case ALDO_HLT_EXPR:
+        return cpu->signal.sync;
+    default:
+        return false;
+    }
+}
+
+//
+// MARK: - Predicate Evaluation
+//
+
+static int64_t predicate_var(const struct aldo_breakpoint *bp,
+                             const struct aldo_mos6502 *cpu,
+                             const struct aldo_rp2c02 *ppu, uint8_t var)
+{
+    switch (var) {
+    case ALDO_HVAR_A:
+        return cpu->a;
+    case ALDO_HVAR_X:
+        return cpu->x;
+    case ALDO_HVAR_Y:
+        return cpu->y;
+    case ALDO_HVAR_P:
+        return aldo_cpu_status(cpu);
+    case ALDO_HVAR_S:
+        return cpu->s;
+    case ALDO_HVAR_PC:
+        return cpu->addrinst;
+    case ALDO_HVAR_SCANLINE:
+        return ppu ? ppu->line : 0;
+    case ALDO_HVAR_DOT:
+        return ppu ? ppu->dot : 0;
+    case ALDO_HVAR_HITS:
+        return (int64_t)bp->hits;
+    default:
+        return 0;
+    }
+}
+
+// peek memory without bus side-effects
+static int64_t predicate_mem(const struct aldo_mos6502 *cpu, uint16_t addr)
+{
+    uint8_t d = 0;
+    aldo_bus_copy(cpu->mbus, addr, 1, &d);
+    return d;
+}
+
+static int64_t predicate_op(uint8_t op, int64_t lhs, int64_t rhs)
+{
+    switch (op) {
+    case ALDO_HOP_EQ:
+        return lhs == rhs;
+    case ALDO_HOP_NE:
+        return lhs != rhs;
+    case ALDO_HOP_LE:
+        return lhs <= rhs;
+    case ALDO_HOP_GE:
+        return lhs >= rhs;
+    case ALDO_HOP_LT:
+        return lhs < rhs;
+    case ALDO_HOP_GT:
+        return lhs > rhs;
+    case ALDO_HOP_AND:
+        return lhs && rhs;
+    case ALDO_HOP_OR:
+        return lhs || rhs;
+    default:
+        return 0;
+    }
+}
+
+// run compiled predicate bytecode; malformed code never halts
+static bool halt_predicate(const struct aldo_breakpoint *bp,
+                           const struct aldo_mos6502 *cpu,
+                           const struct aldo_rp2c02 *ppu)
+{
+    auto code = bp->expr.predicate;
+    if (code[0] == ALDO_HOP_END) return true;
+
+    int64_t stack[AldoHexprCodeSize / 2];
+    size_t top = 0, pc = 0;
+    while (pc < AldoHexprCodeSize && code[pc] != ALDO_HOP_END) {
+        auto op = code[pc];
+        switch (op) {
+        case ALDO_HOP_IMM:
+            if (pc + 5 > AldoHexprCodeSize) return false;
+            stack[top++] = aldo_batodw(code + pc + 1);
+            pc += 5;
+            break;
+        case ALDO_HOP_VAR:
+            if (pc + 2 > AldoHexprCodeSize) return false;
+            stack[top++] = predicate_var(bp, cpu, ppu, code[pc + 1]);
+            pc += 2;
+            break;
+        case ALDO_HOP_MEM:
+            if (pc + 3 > AldoHexprCodeSize) return false;
+            stack[top++] = predicate_mem(cpu, aldo_batowr(code + pc + 1));
+            pc += 3;
+            break;
+        default:
+            if (top < 2 || op >= ALDO_HOP_COUNT) return false;
+            --top;
+            stack[top - 1] = predicate_op(op, stack[top - 1], stack[top]);
+            ++pc;
+            break;
+        }
+        // every operand is at least 2 bytes so the stack cannot overflow
+        assert(top <= aldo_arrsz(stack));
+    }
+    return top == 1 && stack[0];
+}
+
 //
 // MARK: - Breakpoint Vector
 //
@@ -169,39 +496,29 @@ static bool bpvector_insert(struct breakpoint_vector *vec,
         if (!bpvector_resize(vec)) return false;
     }
     auto slot = vec->items + vec->size;
-    *slot = (typeof(*slot)){expr, true};
+    *slot = (typeof(*slot)){.expr = expr, .enabled = true};
     ++vec->size;
     return true;
 }
 
-static ptrdiff_t bpvector_break(const struct breakpoint_vector *vec,
+// count hits on every triggered breakpoint but halt on the first
+// whose predicate also passes.
+static ptrdiff_t bpvector_break(struct breakpoint_vector *vec,
                                 const struct aldo_clock *clk,
-                                const struct aldo_mos6502 *cpu)
+                                const struct aldo_mos6502 *cpu,
+                                const struct aldo_rp2c02 *ppu,
+                                const struct watch_log *log, bool counthits)
 {
+    auto halted = Aldo_NoBreakpoint;
     for (ptrdiff_t i = 0; i < (ptrdiff_t)vec->size; ++i) {
         auto bp = vec->items + i;
-        if (!bp->enabled) continue;
-        switch (bp->expr.cond) {
-        case ALDO_HLT_ADDR:
-            if (halt_address(bp, cpu)) return i;
-            break;
-        case ALDO_HLT_TIME:
-            if (halt_runtime(bp, clk)) return i;
-            break;
-        case ALDO_HLT_CYCLES:
-            if (halt_cycles(bp, clk)) return i;
-            break;
-        case ALDO_HLT_FRAMES:
-            if (halt_frames(bp, clk)) return i;
-            break;
-        case ALDO_HLT_JAM:
-            if (halt_jammed(cpu)) return i;
-            break;
-        default:
-            break;
+        if (!bp->enabled || !halt_triggered(bp, clk, cpu, log)) continue;
+        bp->hits += counthits;
+        if (halted == Aldo_NoBreakpoint && halt_predicate(bp, cpu, ppu)) {
+            halted = i;
         }
     }
-    return Aldo_NoBreakpoint;
+    return halted;
 }
 
 static bool bpvector_remove(struct breakpoint_vector *vec, ptrdiff_t at)
@@ -230,6 +547,122 @@ static void bpvector_free(struct breakpoint_vector *vec)
     free(vec->items);
 }
 
+//
+// MARK: - Breakpoint Index
+//
+
+static uint64_t bpindex_target(const struct aldo_breakpoint *bp)
+{
+    return bp->expr.cond == ALDO_HLT_CYCLES ? bp->expr.cycles : bp->expr.frames;
+}
+
+static void bpindex_pending(struct pending_target *pending,
+                            const struct breakpoint_vector *vec,
+                            enum aldo_haltcondition cond, uint64_t base)
+{
+    *pending = (typeof(*pending)){UINT64_MAX, base};
+    for (size_t i = 0; i < vec->size; ++i) {
+        auto bp = vec->items + i;
+        if (!bp->enabled || bp->expr.cond != cond) continue;
+        auto target = bpindex_target(bp);
+        if (base <= target && target < pending->next) {
+            pending->next = target;
+        }
+    }
+}
+
+static void bpindex_build(struct breakpoint_index *idx,
+                          const struct breakpoint_vector *vec)
+{
+    memset(idx->addresses, 0, sizeof idx->addresses);
+    memset(idx->watchpages, 0, sizeof idx->watchpages);
+    idx->runtime = INFINITY;
+    idx->enabled = 0;
+    idx->exprs = idx->jam = false;
+    for (size_t i = 0; i < vec->size; ++i) {
+        auto bp = vec->items + i;
+        if (!bp->enabled) continue;
+        ++idx->enabled;
+        switch (bp->expr.cond) {
+        case ALDO_HLT_ADDR:
+            idx->addresses[bp->expr.address / 64] |=
+                1ull << (bp->expr.address % 64);
+            break;
+        case ALDO_HLT_TIME:
+            idx->runtime = fmin(idx->runtime, bp->expr.runtime);
+            break;
+        case ALDO_HLT_JAM:
+            idx->jam = true;
+            break;
+        case ALDO_HLT_READ:
+        case ALDO_HLT_WRITE:
+        case ALDO_HLT_ACCESS:
+            {
+                auto pages = idx->watchpages[bp->expr.watch.vram];
+                for (auto page = bp->expr.watch.low >> 8;
+                     page <= bp->expr.watch.high >> 8;
+                     ++page) {
+                    pages[page / 64] |= 1ull << (page % 64);
+                }
+            }
+            break;
+        case ALDO_HLT_EXPR:
+            idx->exprs = true;
+            break;
+        default:
+            break;
+        }
+    }
+    bpindex_pending(&idx->cycles, vec, ALDO_HLT_CYCLES, 0);
+    bpindex_pending(&idx->frames, vec, ALDO_HLT_FRAMES, 0);
+}
+
+// a count below the base means the clock was reset, so recalculate
+// the earliest pending target once the count passes it.
+static bool bpindex_target_due(const struct pending_target *pending,
+                               uint64_t count)
+{
+    return count >= pending->next || count < pending->base;
+}
+
+static bool bpindex_check(const struct breakpoint_index *idx,
+                          const struct aldo_clock *clk,
+                          const struct aldo_mos6502 *cpu,
+                          const struct watch_log *log)
+{
+    return log->count > 0
+            || (cpu->signal.sync
+            && (idx->exprs
+                || aldo_getbit(idx->addresses[cpu->addrinst / 64],
+                               cpu->addrinst % 64)))
+            || bpindex_target_due(&idx->cycles, clk->cycles)
+            || bpindex_target_due(&idx->frames, clk->frames)
+            || isgreaterequal(clk->emutime - idx->runtime,
+                              1.0 / ALDO_MS_PER_S)
+            || (idx->jam && halt_jammed(cpu));
+}
+
+static ptrdiff_t bpindex_break(struct breakpoint_index *idx,
+                               struct breakpoint_vector *vec,
+                               const struct aldo_clock *clk,
+                               const struct aldo_mos6502 *cpu,
+                               const struct aldo_rp2c02 *ppu,
+                               const struct watch_log *log, bool counthits)
+{
+    if (!bpindex_check(idx, clk, cpu, log)) return Aldo_NoBreakpoint;
+
+    // Only scan the full breakpoint list when the index reports a possible
+    // match; this preserves breakpoint priority by list order.
+    auto halted = bpvector_break(vec, clk, cpu, ppu, log, counthits);
+    if (bpindex_target_due(&idx->cycles, clk->cycles)) {
+        bpindex_pending(&idx->cycles, vec, ALDO_HLT_CYCLES, clk->cycles);
+    }
+    if (bpindex_target_due(&idx->frames, clk->frames)) {
+        bpindex_pending(&idx->frames, vec, ALDO_HLT_FRAMES, clk->frames);
+    }
+    return halted;
+}
+
 //
 // MARK: - Public Interface
 //
@@ -250,6 +683,7 @@ aldo_debugger *aldo_debug_new()
         aldo_debug_free(self);
         return nullptr;
     }
+    bpindex_build(&self->bpindex, &self->breakpoints);
     return self;
 }
 
@@ -281,7 +715,10 @@ bool aldo_debug_bp_add(aldo_debugger *self, struct aldo_haltexpr expr)
     assert(self != nullptr);
     assert(ALDO_HLT_NONE < expr.cond && expr.cond < ALDO_HLT_COUNT);
 
-    return bpvector_insert(&self->breakpoints, expr);
+    if (!bpvector_insert(&self->breakpoints, expr)) return false;
+    bpindex_build(&self->bpindex, &self->breakpoints);
+    update_watches(self);
+    return true;
 }
 
 const struct aldo_breakpoint *aldo_debug_bp_at(aldo_debugger *self,
@@ -299,6 +736,8 @@ void aldo_debug_bp_enable(aldo_debugger *self, ptrdiff_t at, bool enabled)
     auto bp = bpvector_at(&self->breakpoints, at);
     if (bp) {
         bp->enabled = enabled;
+        bpindex_build(&self->bpindex, &self->breakpoints);
+        update_watches(self);
     }
 }
 
@@ -323,6 +762,8 @@ void aldo_debug_bp_remove(aldo_debugger *self, ptrdiff_t at)
     assert(self != nullptr);
 
     if (!bpvector_remove(&self->breakpoints, at)) return;
+    bpindex_build(&self->bpindex, &self->breakpoints);
+    update_watches(self);
 
     // If we removed the currently halted breakpoint we need to clear
     // the halt flag; if we removed a breakpoint before the currently halted
@@ -339,6 +780,8 @@ void aldo_debug_bp_clear(aldo_debugger *self)
     assert(self != nullptr);
 
     bpvector_clear(&self->breakpoints);
+    bpindex_build(&self->bpindex, &self->breakpoints);
+    update_watches(self);
     self->halted = Aldo_NoBreakpoint;
 }
 
@@ -367,32 +810,56 @@ void aldo_debug_cpu_connect(aldo_debugger *self, struct aldo_mos6502 *cpu)
     assert(cpu != nullptr);
 
     self->cpu = cpu;
+    update_watches(self);
 }
 
 void aldo_debug_cpu_disconnect(aldo_debugger *self)
 {
     assert(self != nullptr);
 
+    remove_watches(self);
     self->cpu = nullptr;
+    add_watches(self);
+}
+
+void aldo_debug_ppu_connect(aldo_debugger *self,
+                            const struct aldo_rp2c02 *ppu)
+{
+    assert(self != nullptr);
+    assert(ppu != nullptr);
+
+    self->ppu = ppu;
+    update_watches(self);
+}
+
+void aldo_debug_ppu_disconnect(aldo_debugger *self)
+{
+    assert(self != nullptr);
+
+    remove_watches(self);
+    self->ppu = nullptr;
+    add_watches(self);
 }
 
 void aldo_debug_sync_bus(aldo_debugger *self)
 {
     assert(self != nullptr);
 
-    if (self->resetvector == Aldo_NoResetVector || !self->cpu) return;
+    // watches must be outermost so peel them off while updating the reset
+    // override; this also picks up any partitions remapped since they
+    // were installed.
+    remove_watches(self);
+    sync_reset_override(self);
+    add_watches(self);
+}
 
-    if (self->dec.active) {
-        self->dec.vector = (uint16_t)self->resetvector;
-        return;
-    }
+bool aldo_debug_armed(aldo_debugger *self)
+{
+    assert(self != nullptr);
 
-    self->dec = (typeof(self->dec)){.vector = (uint16_t)self->resetvector};
-    struct aldo_busdevice resetaddr_device = {
-        resetaddr_read, resetaddr_write, resetaddr_copy, &self->dec,
-    };
-    self->dec.active = aldo_bus_swap(self->cpu->mbus, ALDO_CPU_VECTOR_RST,
-                                     resetaddr_device, &self->dec.inner);
+    return self->cpu
+            && (self->bpindex.enabled > 0
+                || self->halted != Aldo_NoBreakpoint);
 }
 
 bool aldo_debug_break(aldo_debugger *self, const struct aldo_clock *clk)
@@ -402,11 +869,25 @@ bool aldo_debug_break(aldo_debugger *self, const struct aldo_clock *clk)
 
     if (!self->cpu) return false;
 
-    if (self->halted == Aldo_NoBreakpoint
-        && (self->halted = bpvector_break(&self->breakpoints, clk, self->cpu))
-            != Aldo_NoBreakpoint) {
-        return true;
-    }
+    auto halted = self->halted == Aldo_NoBreakpoint
+                    && (self->halted = bpindex_break(&self->bpindex,
+                                                     &self->breakpoints, clk,
+                                                     self->cpu, self->ppu,
+                                                     &self->watchlog,
+                                                     !self->replaying))
+                        != Aldo_NoBreakpoint;
+    // bus activity is only checked against the cycle it happened on
+    self->watchlog.count = 0;
+    if (halted) return true;
     self->halted = Aldo_NoBreakpoint;
     return false;
 }
+
+void aldo_debug_set_replay(aldo_debugger *self, bool replay)
+{
+    assert(self != nullptr);
+
+    self->replaying = replay;
+    self->halted = Aldo_NoBreakpoint;
+    self->watchlog.count = 0;
+}
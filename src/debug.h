@@ -11,13 +11,18 @@
 #include "haltexpr.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 struct aldo_clock;
 struct aldo_mos6502;
+struct aldo_rp2c02;
 
 struct aldo_breakpoint {
     struct aldo_haltexpr expr;
     bool enabled;
+    uint64_t hits;  // Times the halt condition matched, even if the
+                    // predicate did not; a predicate-only condition
+                    // matches every instruction.
 };
 
 typedef struct aldo_debugger_context aldo_debugger;
@@ -74,9 +79,17 @@ void aldo_debug_reset(aldo_debugger *self) aldo_nothrow;
 void aldo_debug_cpu_connect(aldo_debugger *self,
                             struct aldo_mos6502 *cpu) aldo_nothrow;
 void aldo_debug_cpu_disconnect(aldo_debugger *self) aldo_nothrow;
+void aldo_debug_ppu_connect(aldo_debugger *self,
+                            const struct aldo_rp2c02 *ppu) aldo_nothrow;
+void aldo_debug_ppu_disconnect(aldo_debugger *self) aldo_nothrow;
 void aldo_debug_sync_bus(aldo_debugger *self) aldo_nothrow;
+// false if aldo_debug_break cannot halt, allowing callers to skip it
+bool aldo_debug_armed(aldo_debugger *self) aldo_nothrow;
 bool aldo_debug_break(aldo_debugger *self,
                       const struct aldo_clock *clk) aldo_nothrow;
+// replaying history re-checks breakpoints without counting hits; either
+// transition clears any pending halt.
+void aldo_debug_set_replay(aldo_debugger *self, bool replay) aldo_nothrow;
 #include "bridgeclose.h"
 
 #endif
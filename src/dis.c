@@ -11,11 +11,17 @@
 #include "cpu.h"
 #include "ctrlsignal.h"
 #include "haltexpr.h"
+#include "png.h"
 #include "ppu.h"
 #include "snapshot.h"
+#include "tsutil.h"
 
 #include <assert.h>
+#include <errno.h>
+#include <inttypes.h>
 #include <math.h>
+#include <pthread.h>
+#include <stdarg.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -25,6 +31,12 @@ static const char *const restrict Mnemonics[] = {
 #undef X
 };
 
+constexpr uint8_t MnemonicLens[] = {
+#define X(s, d, f, ...) sizeof #s - 1,
+    ALDO_DEC_INST_X
+#undef X
+};
+
 static const char *const restrict Descriptions[] = {
 #define X(s, d, f, ...) d,
     ALDO_DEC_INST_X
@@ -109,52 +121,102 @@ static uint16_t interrupt_vector(const struct aldo_snapshot *snp)
     return aldo_batowr(snp->prg.vectors + 4);
 }
 
+static constexpr char HexDigits[] = "0123456789ABCDEF";
+
+static char *print_hex8(uint8_t b, char dis[restrict static 2])
+{
+    dis[0] = HexDigits[b >> 4];
+    dis[1] = HexDigits[b & 0xf];
+    return dis + 2;
+}
+
+static char *print_hex16(uint16_t wr, char dis[restrict static 4])
+{
+    return print_hex8((uint8_t)wr, print_hex8((uint8_t)(wr >> 8), dis));
+}
+
+static int print_mnemonic(enum aldo_inst in, char dis[restrict])
+{
+    auto i = 0 <= in && in < aldo_arrsz(MnemonicLens) ? in : ALDO_IN_UDF;
+    memcpy(dis, Mnemonics[i], MnemonicLens[i]);
+    return MnemonicLens[i];
+}
+
+// The addressing mode string tables are printf formats, but disassembly
+// only ever uses the %02X, %04X, and %+hhd conversions so expand them
+// directly; this is the hot path of full PRG disassembly.
+static int print_format(const char *restrict fmt, uint16_t operand,
+                        char dis[restrict])
+{
+    auto out = dis;
+    for (auto c = fmt; *c != '\0'; ++c) {
+        if (*c != '%') {
+            *out++ = *c;
+        } else if (strncmp(c, "%02X", 4) == 0) {
+            out = print_hex8((uint8_t)operand, out);
+            c += 3;
+        } else if (strncmp(c, "%04X", 4) == 0) {
+            out = print_hex16(operand, out);
+            c += 3;
+        } else if (strncmp(c, "%+hhd", 5) == 0) {
+            auto rel = (int8_t)operand;
+            auto mag = rel < 0 ? -rel : rel;
+            *out++ = rel < 0 ? '-' : '+';
+            if (mag >= 100) {
+                *out++ = (char)('0' + mag / 100);
+            }
+            if (mag >= 10) {
+                *out++ = (char)('0' + mag / 10 % 10);
+            }
+            *out++ = (char)('0' + mag % 10);
+            c += 4;
+        } else {
+            return ALDO_DIS_ERR_FMT;
+        }
+    }
+    *out = '\0';
+    return (int)(out - dis);
+}
+
 static int print_raw(uint16_t addr, const struct aldo_dis_instruction *inst,
                      char dis[restrict static AldoDisInstSize])
 {
-    int total, count;
-    total = count = sprintf(dis, "%04X: ", addr);
-    if (count < 0) return ALDO_DIS_ERR_FMT;
-
+    auto out = print_hex16(addr, dis);
+    *out++ = ':';
+    *out++ = ' ';
     for (size_t i = 0; i < inst->bv.size; ++i) {
-        count = sprintf(dis + total, "%02X ", inst->bv.mem[i]);
-        if (count < 0) return ALDO_DIS_ERR_FMT;
-        total += count;
+        out = print_hex8(inst->bv.mem[i], out);
+        *out++ = ' ';
     }
-
-    return total;
+    *out = '\0';
+    return (int)(out - dis);
 }
 
 static int print_operand(const struct aldo_dis_instruction *inst,
                          char dis[restrict])
 {
     auto strtable = StringTables[inst->d.mode];
-    int count;
     switch (inst->bv.size) {
     case 1:
         dis[0] = '\0';
-        count = 0;
-        break;
+        return 0;
     case 2:
-        count = sprintf(dis, strtable[inst->bv.size - 1], inst->bv.mem[1]);
-        break;
+        return print_format(strtable[inst->bv.size - 1], inst->bv.mem[1],
+                            dis);
     case 3:
-        count = sprintf(dis, strtable[inst->bv.size - 1],
-                        aldo_batowr(inst->bv.mem + 1));
-        break;
+        return print_format(strtable[inst->bv.size - 1],
+                            aldo_batowr(inst->bv.mem + 1), dis);
     default:
         assert(((void)"INVALID ADDR MODE LENGTH", false));
         return ALDO_DIS_ERR_INV_ADDRMD;
     }
-    if (count < 0) return ALDO_DIS_ERR_FMT;
-    return count;
 }
 
 static int print_instruction(const struct aldo_dis_instruction *inst,
                              char dis[restrict])
 {
-    auto operation = sprintf(dis, "%s ", mnemonic(inst->d.instruction));
-    if (operation < 0) return ALDO_DIS_ERR_FMT;
+    auto operation = print_mnemonic(inst->d.instruction, dis);
+    dis[operation++] = ' ';
 
     auto operand = print_operand(inst, dis + operation);
     if (operand < 0) return ALDO_DIS_ERR_FMT;
@@ -170,62 +232,317 @@ struct repeat_condition {
     bool skip;
 };
 
-static int print_prg_line(const char *restrict dis, bool verbose,
+// PRG blocks are formatted into memory, possibly on several threads at
+// once, and then written out in block order.
+struct prgtext {
+    char *mem;
+    size_t len, cap;
+};
+
+// make room for at least n more bytes, returning the write position
+static char *prgtext_reserve(struct prgtext *text, size_t n)
+{
+    if (text->cap - text->len < n) {
+        auto cap = text->cap > 0 ? text->cap : (size_t)ALDO_MEMBLOCK_16KB;
+        while (cap - text->len < n) {
+            cap *= 2;
+        }
+        char *mem = realloc(text->mem, cap);
+        if (!mem) return nullptr;
+        text->mem = mem;
+        text->cap = cap;
+    }
+    return text->mem + text->len;
+}
+
+static int prgtext_putline(struct prgtext *text, const char *restrict line,
+                           size_t len)
+{
+    auto out = prgtext_reserve(text, len + 1);
+    if (!out) return ALDO_DIS_ERR_ERNO;
+    memcpy(out, line, len);
+    out[len] = '\n';
+    text->len += len + 1;
+    return 0;
+}
+
+// formatted lines other than instructions are short and rare
+constexpr size_t PrgTextLineSize = 64;
+
+static int prgtext_printf(struct prgtext *text, const char *restrict fmt, ...)
+{
+    auto out = prgtext_reserve(text, PrgTextLineSize);
+    if (!out) return ALDO_DIS_ERR_ERNO;
+
+    va_list args;
+    va_start(args, fmt);
+    auto count = vsnprintf(out, PrgTextLineSize, fmt, args);
+    va_end(args);
+    if (count < 0 || (size_t)count >= PrgTextLineSize) return ALDO_DIS_ERR_FMT;
+    text->len += (size_t)count;
+    return 0;
+}
+
+// annotation column width: percentage and cycle count
+constexpr int ProfileColSize = 22;
+
+static int print_prg_line(const char *restrict dis, size_t len, bool verbose,
                           const struct aldo_dis_instruction *curr_inst,
-                          struct repeat_condition *repeat, FILE *f)
+                          bool hot, struct repeat_condition *repeat,
+                          struct prgtext *text)
 {
-    if (verbose && fprintf(f, "%s\n", dis) < 0) goto io_failure;
+    int err;
+    if (verbose && (err = prgtext_putline(text, dis, len)) < 0) return err;
 
-    if (aldo_dis_inst_equal(curr_inst, &repeat->prev_inst)) {
+    if (!hot && aldo_dis_inst_equal(curr_inst, &repeat->prev_inst)) {
         // only print placeholder on first duplicate seen
         if (!repeat->skip) {
             repeat->skip = true;
-            if (fputs("*\n", f) == EOF) goto io_failure;
+            return prgtext_putline(text, "*", 1);
         }
     } else {
-        if (fprintf(f, "%s\n", dis) < 0) goto io_failure;
-        repeat->prev_inst = *curr_inst;
+        if ((err = prgtext_putline(text, dis, len)) < 0) return err;
+        // never fold unexecuted lines into an executed one
+        repeat->prev_inst = hot
+                            ? (struct aldo_dis_instruction){}
+                            : *curr_inst;
         repeat->skip = false;
     }
     return 0;
+}
+
+static int print_profile_col(const struct aldo_hotspot *h, uint64_t total,
+                             char col[restrict static ProfileColSize + 1])
+{
+    if (h->cycles == 0) return sprintf(col, "%*s", ProfileColSize, "");
 
-io_failure:
-    return ALDO_DIS_ERR_IO;
+    auto pct = total > 0 ? (double)h->cycles * 100.0 / (double)total : 0.0;
+    return sprintf(col, "%6.2f%% %13" PRIu64 " ", pct, h->cycles);
 }
 
 static int print_prgblock(const struct aldo_blockview *bv, bool verbose,
-                          FILE *f)
+                          aldo_profiler *prof, aldo_cdl *cdl,
+                          struct prgtext *text)
 {
-    auto io_err = fprintf(f, "Block %zu (%zuKB)\n", bv->ord,
-                          bv->size >> ALDO_BITWIDTH_1KB);
-    if (io_err < 0) return ALDO_DIS_ERR_IO;
-    if (fputs("--------\n", f) == EOF) return ALDO_DIS_ERR_IO;
+    auto err = prgtext_printf(text, "Block %zu (%zuKB)\n--------\n", bv->ord,
+                              bv->size >> ALDO_BITWIDTH_1KB);
+    if (err < 0) return err;
 
     struct repeat_condition repeat = {};
     struct aldo_dis_instruction inst;
-    char dis[AldoDisInstSize];
+    char line[ProfileColSize + AldoDisInstSize];
+    size_t linelen = 0;
+    // annotations go in front of the disassembly
+    auto dis = prof ? line + ProfileColSize : line;
+    auto total = prof ? aldo_profile_total(prof) : 0;
     // by convention, count backwards from CPU vector locations
     assert(bv->size <= ALDO_MEMBLOCK_64KB);
     auto addr = (uint16_t)(ALDO_MEMBLOCK_64KB - bv->size);
 
-    int result;
-    for (result = aldo_dis_parse_inst(bv, 0, &inst);
-         result > 0;
-         result = aldo_dis_parse_inst(bv, inst.offset + inst.bv.size, &inst)) {
+    int result = 0;
+    size_t at = 0;
+    while (true) {
+        auto prgaddr = (bv->ord * bv->size) + at;
+        // logged data is listed as a single line instead of as instructions
+        auto datalen = cdl ? aldo_cdl_datarun(cdl, prgaddr, bv->size - at) : 0;
+        if (datalen > 0) {
+            if (repeat.skip
+                && (err = prgtext_putline(text, line, linelen)) < 0) break;
+            repeat = (struct repeat_condition){};
+            err = prgtext_printf(text, "%04X: .data %zu byte%s\n", addr,
+                                 datalen, datalen == 1 ? "" : "s");
+            if (err < 0) break;
+            at += datalen;
+            addr += (uint16_t)datalen;
+            continue;
+        }
+
+        result = aldo_dis_parse_inst(bv, at, &inst);
+        if (result <= 0) break;
         result = aldo_dis_inst(addr, &inst, dis);
         if (result <= 0) break;
-        io_err = print_prg_line(dis, verbose, &inst, &repeat, f);
-        if (io_err < 0) break;
+        linelen = (size_t)(dis - line) + (size_t)result;
+        auto hot = false;
+        if (prof) {
+            auto h = aldo_profile_prg(prof, prgaddr);
+            hot = h.cycles > 0;
+            // column is NUL-terminated on top of the disassembly
+            auto first = dis[0];
+            if (print_profile_col(&h, total, line) < 0) {
+                result = ALDO_DIS_ERR_FMT;
+                break;
+            }
+            dis[0] = first;
+        }
+        err = print_prg_line(line, linelen, verbose, &inst, hot, &repeat,
+                             text);
+        if (err < 0) break;
+        at += inst.bv.size;
         addr += (uint16_t)inst.bv.size;
     }
+    if (err < 0) return err;
     if (result < 0) return result;
-    if (io_err < 0) return io_err;
 
     // always print the last line even if it would normally be skipped
-    if (repeat.skip && fprintf(f, "%s\n", dis) < 0) return ALDO_DIS_ERR_IO;
+    return repeat.skip ? prgtext_putline(text, line, linelen) : 0;
+}
+
+// upper bound on worker threads, counting the calling thread
+constexpr size_t PoolMaxWorkers = 16;
+
+struct workpool {
+    pthread_mutex_t lock;
+    size_t count, next;
+    void *ctx;
+    void (*job)(void *, size_t);
+};
+
+static void *run_jobs(void *ctx)
+{
+    struct workpool *p = ctx;
+    for (;;) {
+        pthread_mutex_lock(&p->lock);
+        auto i = p->next < p->count ? p->next++ : p->count;
+        pthread_mutex_unlock(&p->lock);
+        if (i == p->count) return nullptr;
+        p->job(p->ctx, i);
+    }
+}
+
+// run job(ctx, i) for every i in [0, count) on up to one thread per CPU,
+// with the calling thread as one of the workers; if helper threads fail
+// to start the threads that did start pick up their share.
+static int run_pool(size_t count, void *ctx, void (*job)(void *, size_t))
+{
+    struct workpool p = {.count = count, .ctx = ctx, .job = job};
+    auto err = pthread_mutex_init(&p.lock, nullptr);
+    if (err != 0) {
+        errno = err;
+        return ALDO_DIS_ERR_ERNO;
+    }
+
+    pthread_t threads[PoolMaxWorkers];
+    auto workers = (size_t)aldo_cpu_count(PoolMaxWorkers);
+    size_t
+        helpers = count > 0 ? (workers < count ? workers : count) - 1 : 0,
+        started = 0;
+    for (; started < helpers; ++started) {
+        if (pthread_create(threads + started, nullptr, run_jobs, &p) != 0)
+            break;
+    }
+    run_jobs(&p);
+    for (size_t i = 0; i < started; ++i) {
+        pthread_join(threads[i], nullptr);
+    }
+    pthread_mutex_destroy(&p.lock);
+    return 0;
+}
+
+struct prgjob {
+    struct aldo_blockview bv;
+    struct prgtext text;
+    int err;
+};
+
+// upper bound on formatted PRG blocks held in memory at once
+constexpr size_t PrgWindowSize = 16;
+
+struct prgwindow {
+    struct prgjob jobs[PrgWindowSize];
+    size_t count;
+    aldo_profiler *prof;
+    aldo_cdl *cdl;
+    bool verbose;
+};
+
+static void format_prgblock(void *ctx, size_t i)
+{
+    struct prgwindow *w = ctx;
+    auto job = w->jobs + i;
+    job->err = print_prgblock(&job->bv, w->verbose, w->prof, w->cdl,
+                              &job->text);
+}
+
+static int write_prgblocks(const struct prgwindow *w, bool unified_output,
+                           FILE *f)
+{
+    for (size_t i = 0; i < w->count; ++i) {
+        auto job = w->jobs + i;
+        if (fputc('\n', f) == EOF) return ALDO_DIS_ERR_IO;
+        if (job->text.len > 0
+            && fwrite(job->text.mem, 1, job->text.len, f) < job->text.len)
+            return ALDO_DIS_ERR_IO;
+        if (job->err == ALDO_DIS_ERR_ERNO) {
+            // the allocation failed on a worker thread with its own errno
+            errno = ENOMEM;
+            return job->err;
+        }
+        // Disassembly errors may occur normally if data bytes are
+        // interpreted as instructions so note the result and continue.
+        if (job->err < 0) {
+            auto err = fprintf(unified_output ? f : stderr,
+                               "Dis err (%d): %s\n", job->err,
+                               aldo_dis_errstr(job->err));
+            if (err < 0) return ALDO_DIS_ERR_IO;
+        }
+    }
     return 0;
 }
 
+static int print_cart_prg(aldo_cart *cart, const char *restrict name,
+                          bool verbose, bool unified_output,
+                          aldo_profiler *prof, aldo_cdl *cdl, FILE *f)
+{
+    auto bv = aldo_cart_prgblock(cart, 0);
+    if (!bv.mem) return ALDO_DIS_ERR_PRGROM;
+
+    if (aldo_cart_write_dis_header(cart, name, f) < 0) return ALDO_DIS_ERR_IO;
+
+    // Format a window of blocks in parallel, then write the window out in
+    // order before starting the next; text buffers are reused throughout.
+    struct prgwindow w = {.prof = prof, .cdl = cdl, .verbose = verbose};
+    int err;
+    do {
+        for (w.count = 0; w.count < PrgWindowSize && bv.mem; ++w.count) {
+            w.jobs[w.count].bv = bv;
+            w.jobs[w.count].text.len = 0;
+            bv = aldo_cart_prgblock(cart, bv.ord + 1);
+        }
+        err = run_pool(w.count, &w, format_prgblock);
+        if (err == 0) {
+            err = write_prgblocks(&w, unified_output, f);
+        }
+    } while (err == 0 && bv.mem);
+
+    for (size_t i = 0; i < PrgWindowSize; ++i) {
+        free(w.jobs[i].text.mem);
+    }
+    return err;
+}
+
+static int print_hotspot(aldo_cart *cart, const struct aldo_hotspot *h,
+                         uint64_t total, FILE *f)
+{
+    char col[ProfileColSize + 1], dis[AldoDisInstSize];
+    if (print_profile_col(h, total, col) < 0) return ALDO_DIS_ERR_FMT;
+
+    if (h->prgaddr < 0) {
+        return fprintf(f, "%s%10" PRIu64 "  %5s  %04X: --\n", col, h->execs,
+                       "--", h->addr) < 0 ? ALDO_DIS_ERR_IO : 0;
+    }
+
+    auto err = aldo_dis_hotspot(cart, h, dis);
+    if (err <= 0) {
+        sprintf(dis, "%04X: %s", h->addr,
+                err < 0 ? aldo_dis_errstr(err) : "--");
+    }
+    auto blocksize = aldo_cart_prgblock(cart, 0).size;
+    return fprintf(f, "%s%10" PRIu64 "  %5zu  %s\n", col, h->execs,
+                   (size_t)h->prgaddr / blocksize, dis) < 0
+            ? ALDO_DIS_ERR_IO
+            : 0;
+}
+
 // hardcode max scale to ~7MB bmp file size
 constexpr auto ScaleGuard = 20;
 
@@ -278,46 +595,44 @@ constexpr size_t BmpInfoHeaderSize = 40;
 constexpr size_t BmpHeaderSize = BmpFileHeaderSize + BmpInfoHeaderSize
                                     + BmpPaletteSize;
 
-static void fill_tile_sheet_row(uint8_t *restrict packedrow,
-                                uint32_t tiley, uint32_t pixely,
-                                uint32_t tilesdim, uint32_t tile_sections,
-                                uint32_t scale, uint32_t section_pxldim,
-                                const struct aldo_blockview *bv)
+// No fixed palette for tiles so use grayscale;
+// fun fact, this is the original Gameboy palette.
+static constexpr uint8_t ChrShades[] = {0, 103, 182, 255};
+
+// PNG supports 2 bpp palette indices so tile pixels map onto it directly
+constexpr uint8_t PngBitsPerPixel = 2;
+
+// render the palette index of every pixel in a tile sheet, one byte per
+// pixel in row-major order, expanding a whole tile row at a time.
+static void render_tile_sheet(const struct aldo_blockview *bv,
+                              uint32_t tilesdim, uint32_t tile_sections,
+                              uint8_t *restrict sheet)
 {
+    uint32_t
+        section_pxldim = tilesdim * AldoChrTileDim,
+        sheetw = section_pxldim * tile_sections;
     for (uint32_t section = 0; section < tile_sections; ++section) {
-        for (uint32_t tilex = 0; tilex < tilesdim; ++tilex) {
-            // Get the index in tile space first, then calculate the
-            // byte index in CHR space for the given tile's current row.
-            size_t
-                tileidx = tilex + (tiley * tilesdim)
-                            + (section * tilesdim * tilesdim),
-                chr_row = (tileidx * AldoChrTileStride) + pixely;
-            uint8_t
-                plane0 = bv->mem[chr_row],
-                plane1 = bv->mem[chr_row + AldoChrTileDim];
-            // 8 2-bit pixels make a single CHR tile row; each 2-bit
-            // pixel will be expanded to 4-bits and packed 2 pixels per byte
-            // for a 4 bpp BMP.
-            auto pixelrow = aldo_byteshuffle(plane0, plane1);
-            for (size_t pixelx = 0; pixelx < AldoChrTileDim; ++pixelx) {
-                // packedpixel is the pixel in (prescaled) bmp-row space;
-                // pixelidx is the 2-bit slice of pixelrow that maps to the
-                // packedpixel; BMP layout goes from left-to-right so pixelidx
-                // goes "backwards" from MSBs to LSBs.
+        for (uint32_t tiley = 0; tiley < tilesdim; ++tiley) {
+            for (uint32_t tilex = 0; tilex < tilesdim; ++tilex) {
                 size_t
-                    packedpixel = pixelx + (tilex * AldoChrTileDim)
-                                    + (section * section_pxldim),
-                    pixelidx = AldoChrTileStride - ((pixelx + 1) * 2);
-                uint8_t pixel =
-                    (uint8_t)((pixelrow & (0x3 << pixelidx)) >> pixelidx);
-                assert(pixelidx < AldoChrTileStride);
-                for (uint32_t scalex = 0; scalex < scale; ++scalex) {
-                    size_t scaledpixel = scalex + (packedpixel * scale);
-                    if (scaledpixel % 2 == 0) {
-                        packedrow[scaledpixel / 2] =
-                            (uint8_t)(pixel << BmpBitsPerPixel);
-                    } else {
-                        packedrow[scaledpixel / 2] |= pixel;
+                    tileidx = tilex + (tiley * tilesdim)
+                                + (section * tilesdim * tilesdim),
+                    origin = (tiley * AldoChrTileDim * sheetw)
+                                + (section * section_pxldim)
+                                + (tilex * AldoChrTileDim);
+                auto tile = bv->mem + (tileidx * AldoChrTileStride);
+                for (auto pixely = 0; pixely < AldoChrTileDim; ++pixely) {
+                    uint8_t
+                        plane0 = tile[pixely],
+                        plane1 = tile[pixely + AldoChrTileDim];
+                    auto row = sheet + origin + ((size_t)pixely * sheetw);
+                    // each 2-bit pixel takes one bit from both planes,
+                    // with the leftmost pixel in the MSBs.
+                    for (auto pixelx = 0; pixelx < AldoChrTileDim; ++pixelx) {
+                        auto bit = AldoChrTileDim - 1 - pixelx;
+                        row[pixelx] = (uint8_t)(((plane0 >> bit) & 0x1)
+                                                | ((plane1 >> bit) & 0x1)
+                                                    << 1);
                     }
                 }
             }
@@ -325,6 +640,29 @@ static void fill_tile_sheet_row(uint8_t *restrict packedrow,
     }
 }
 
+// pack count pixels of depth bits each into out MSB-first, repeating every
+// pixel scale times; a partial last byte is filled out with zeros.
+static void pack_pixels(const uint8_t *restrict pixels, uint32_t count,
+                        uint32_t scale, uint8_t depth, uint8_t *restrict out)
+{
+    auto perbyte = 8 / depth;
+    uint8_t packed = 0;
+    auto n = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        for (uint32_t scalex = 0; scalex < scale; ++scalex) {
+            packed = (uint8_t)(packed << depth | pixels[i]);
+            if (++n == perbyte) {
+                *out++ = packed;
+                packed = 0;
+                n = 0;
+            }
+        }
+    }
+    if (n > 0) {
+        *out = (uint8_t)(packed << (depth * (perbyte - n)));
+    }
+}
+
 static int write_chrtiles(const struct aldo_blockview *bv, uint32_t tilesdim,
                           uint32_t tile_sections, uint32_t scale,
                           FILE *bmpfile)
@@ -395,65 +733,204 @@ static int write_chrtiles(const struct aldo_blockview *bv, uint32_t tilesdim,
         BYTE rgbReserved;
      }[BMP_BITS_PER_PIXEL];
      */
-    // No fixed palette for tiles so use grayscale;
-    // fun fact, this is the original Gameboy palette.
-    static constexpr uint8_t palettes[BmpPaletteSize] = {
-        0, 0, 0, 0,         // #000000
-        103, 103, 103, 0,   // #676767
-        182, 182, 182, 0,   // #b6b6b6
-        255, 255, 255, 0,   // #ffffff
-    };
+    uint8_t palettes[BmpPaletteSize] = {};
+    for (size_t i = 0; i < aldo_arrsz(ChrShades); ++i) {
+        memset(palettes + (i * 4), ChrShades[i], 3);
+    }
     witems = aldo_arrsz(palettes);
     wcount = fwrite(palettes, sizeof palettes[0], witems, bmpfile);
     if (wcount < witems) return ALDO_DIS_ERR_IO;
 
-    // BMP pixels are written bottom-row first
-    uint8_t *packedrow = calloc(packedrow_size, sizeof *packedrow);
-    if (!packedrow) return ALDO_DIS_ERR_ERNO;
-
-    for (auto tiley = (int32_t)(tilesdim - 1); tiley >= 0; --tiley) {
-        for (auto pixely = (int32_t)(AldoChrTileDim - 1);
-             pixely >= 0;
-             --pixely) {
-            for (uint32_t scaley = 0; scaley < scale; ++scaley) {
-                fill_tile_sheet_row(packedrow, (uint32_t)tiley,
-                                    (uint32_t)pixely, tilesdim, tile_sections,
-                                    scale, section_pxldim, bv);
-                witems = packedrow_size / sizeof *packedrow;
-                wcount = fwrite(packedrow, sizeof *packedrow, witems, bmpfile);
-                if (wcount < witems) goto cleanup;
+    uint32_t sheetw = section_pxldim * tile_sections;
+    uint8_t
+        *sheet = malloc((size_t)sheetw * section_pxldim),
+        *packedrow = calloc(packedrow_size, sizeof *packedrow);
+    auto err = 0;
+    if (!sheet || !packedrow) {
+        err = ALDO_DIS_ERR_ERNO;
+        goto cleanup;
+    }
+    render_tile_sheet(bv, tilesdim, tile_sections, sheet);
+
+    // BMP pixels are written bottom-row first; scaling repeats each pixel
+    // across the packed row and then repeats the whole row.
+    for (auto pixely = section_pxldim; pixely-- > 0;) {
+        pack_pixels(sheet + ((size_t)pixely * sheetw), sheetw, scale,
+                    BmpBitsPerPixel, packedrow);
+        for (uint32_t scaley = 0; scaley < scale; ++scaley) {
+            witems = packedrow_size / sizeof *packedrow;
+            wcount = fwrite(packedrow, sizeof *packedrow, witems, bmpfile);
+            if (wcount < witems) {
+                err = ALDO_DIS_ERR_ERNO;
+                goto cleanup;
             }
         }
     }
 cleanup:
     free(packedrow);
-    return wcount < witems ? ALDO_DIS_ERR_ERNO : 0;
+    free(sheet);
+    return err;
+}
+
+static int write_chrtiles_png(const struct aldo_blockview *bv,
+                              uint32_t tilesdim, uint32_t tile_sections,
+                              uint32_t scale, FILE *pngfile)
+{
+    uint32_t
+        section_pxldim = tilesdim * AldoChrTileDim,
+        sheetw = section_pxldim * tile_sections,
+        pngw = sheetw * scale,
+        pngh = section_pxldim * scale;
+    size_t rowsize = (((size_t)pngw * PngBitsPerPixel) + 7) / 8;
+    uint8_t
+        *sheet = malloc((size_t)sheetw * section_pxldim),
+        *pixels = malloc(rowsize * pngh);
+    auto err = 0;
+    if (!sheet || !pixels) {
+        err = ALDO_DIS_ERR_ERNO;
+        goto cleanup;
+    }
+    render_tile_sheet(bv, tilesdim, tile_sections, sheet);
+
+    // scaling repeats each pixel across a packed row and then copies the
+    // whole row.
+    for (uint32_t pixely = 0; pixely < section_pxldim; ++pixely) {
+        auto row = pixels + ((size_t)pixely * scale * rowsize);
+        pack_pixels(sheet + ((size_t)pixely * sheetw), sheetw, scale,
+                    PngBitsPerPixel, row);
+        for (uint32_t scaley = 1; scaley < scale; ++scaley) {
+            memcpy(row + (scaley * rowsize), row, rowsize);
+        }
+    }
+
+    uint8_t palette[aldo_arrsz(ChrShades) * 3];
+    for (size_t i = 0; i < aldo_arrsz(ChrShades); ++i) {
+        memset(palette + (i * 3), ChrShades[i], 3);
+    }
+    if (!aldo_png_write_indexed((int)pngw, (int)pngh, PngBitsPerPixel,
+                                (int)aldo_arrsz(ChrShades), palette, pixels,
+                                pngfile)) {
+        err = ALDO_DIS_ERR_ERNO;
+    }
+cleanup:
+    free(pixels);
+    free(sheet);
+    return err;
 }
 
-static int write_chrblock(const struct aldo_blockview *bv, uint32_t scale,
-                          const char *restrict bmpfilename, FILE *output)
+static int write_chrfile(const struct aldo_blockview *bv, uint32_t scale,
+                         bool png, const char *restrict filename)
 {
     uint32_t tilesdim, tile_sections;
     auto err = measure_tile_sheet(bv->size, &tilesdim, &tile_sections);
     if (err < 0) return err;
 
-    auto bmpfile = fopen(bmpfilename, "wb");
-    if (!bmpfile) return ALDO_DIS_ERR_ERNO;
+    auto file = fopen(filename, "wb");
+    if (!file) return ALDO_DIS_ERR_ERNO;
+
+    err = png
+            ? write_chrtiles_png(bv, tilesdim, tile_sections, scale, file)
+            : write_chrtiles(bv, tilesdim, tile_sections, scale, file);
+    fclose(file);
+    return err;
+}
 
-    err = write_chrtiles(bv, tilesdim, tile_sections, scale, bmpfile);
-    fclose(bmpfile);
+static int print_chrblock(const struct aldo_blockview *bv, uint32_t scale,
+                          const char *restrict filename, FILE *output)
+{
+    uint32_t tilesdim, tile_sections;
+    auto err = measure_tile_sheet(bv->size, &tilesdim, &tile_sections);
+    if (err < 0) return err;
 
-    if (err == 0) {
-        err = fprintf(output,
-                      "Block %zu (%zuKB), %u x %u tiles (%u section%s)",
-                      bv->ord, bv->size >> ALDO_BITWIDTH_1KB, tilesdim,
-                      tilesdim, tile_sections, tile_sections == 1 ? "" : "s");
-        if (err < 0) return ALDO_DIS_ERR_IO;
-        if (scale > 1 && fprintf(output, " (%ux scale)", scale) < 0)
-            return ALDO_DIS_ERR_IO;
-        if (fprintf(output, ": %s\n", bmpfilename) < 0) return ALDO_DIS_ERR_IO;
+    err = fprintf(output, "Block %zu (%zuKB), %u x %u tiles (%u section%s)",
+                  bv->ord, bv->size >> ALDO_BITWIDTH_1KB, tilesdim, tilesdim,
+                  tile_sections, tile_sections == 1 ? "" : "s");
+    if (err < 0) return ALDO_DIS_ERR_IO;
+    if (scale > 1 && fprintf(output, " (%ux scale)", scale) < 0)
+        return ALDO_DIS_ERR_IO;
+    if (fprintf(output, ": %s\n", filename) < 0) return ALDO_DIS_ERR_IO;
+    return 0;
+}
+
+struct chrjob {
+    struct aldo_blockview bv;
+    char *filename;
+    int err, errnum;
+};
+
+struct chrsheets {
+    struct chrjob *jobs;
+    uint32_t scale;
+    bool png;
+};
+
+static void write_chrsheet(void *ctx, size_t i)
+{
+    struct chrsheets *sheets = ctx;
+    auto job = sheets->jobs + i;
+    job->err = write_chrfile(&job->bv, sheets->scale, sheets->png,
+                             job->filename);
+    // errno is per-thread so keep it for the caller
+    job->errnum = errno;
+}
+
+static int decode_cart_chr(aldo_cart *cart, int chrscale,
+                           const char *restrict chrdecode_prefix, bool png,
+                           FILE *output)
+{
+    if (chrscale <= 0 || chrscale > ScaleGuard) return ALDO_DIS_ERR_CHRSCL;
+
+    size_t count = 0;
+    while (aldo_cart_chrblock(cart, count).mem) {
+        ++count;
+    }
+    if (count == 0) return ALDO_DIS_ERR_CHRROM;
+
+    const char *prefix = chrdecode_prefix && chrdecode_prefix[0] != '\0'
+                            ? chrdecode_prefix
+                            : "chr";
+    size_t
+        prefixlen = strlen(prefix),
+        namesize = prefixlen + 8;   // prefix + nnn.bmp + nul
+    struct chrjob *jobs = calloc(count, sizeof *jobs);
+    char *filenames = malloc(count * namesize);
+    auto err = 0;
+    if (!jobs || !filenames) {
+        err = ALDO_DIS_ERR_ERNO;
+        goto cleanup;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        auto job = jobs + i;
+        job->bv = aldo_cart_chrblock(cart, i);
+        job->filename = filenames + (i * namesize);
+        if (snprintf(job->filename, namesize, "%s%03zu.%s", prefix,
+                     job->bv.ord, png ? "png" : "bmp") < 0) {
+            err = ALDO_DIS_ERR_FMT;
+            goto cleanup;
+        }
     }
 
+    // render every block in parallel, then report them in order up to
+    // the first failure.
+    struct chrsheets sheets = {
+        .jobs = jobs,
+        .scale = (uint32_t)chrscale,
+        .png = png,
+    };
+    err = run_pool(count, &sheets, write_chrsheet);
+    for (size_t i = 0; err == 0 && i < count; ++i) {
+        auto job = jobs + i;
+        if (job->err < 0) {
+            errno = job->errnum;
+            err = job->err;
+        } else {
+            err = print_chrblock(&job->bv, sheets.scale, job->filename,
+                                 output);
+        }
+    }
+cleanup:
+    free(filenames);
+    free(jobs);
     return err;
 }
 
@@ -535,17 +1012,16 @@ int aldo_dis_inst(uint16_t addr, const struct aldo_dis_instruction *inst,
         return 0;
     }
 
-    int count, total;
-    total = count = print_raw(addr, inst, dis);
-    if (count < 0) return count;
+    auto total = print_raw(addr, inst, dis);
 
     // padding between raw bytes and disassembled instruction
-    count = sprintf(dis + total, "%*s", ((3 - (int)inst->bv.size) * 3) + 1,
-                    "");
-    if (count < 0) return ALDO_DIS_ERR_FMT;
-    total += count;
+    auto padding = ((3 - (int)inst->bv.size) * 3) + 1;
+    if (padding > 0) {
+        memset(dis + total, ' ', (size_t)padding);
+        total += padding;
+    }
 
-    count = print_instruction(inst, dis + total);
+    auto count = print_instruction(inst, dis + total);
     if (count < 0) return count;
     if (inst->d.unofficial && total > 0) {
         dis[total - 1] = '*';
@@ -617,63 +1093,102 @@ int aldo_dis_cart_prg(aldo_cart *cart, const char *restrict name, bool verbose,
     assert(name != nullptr);
     assert(f != nullptr);
 
-    auto bv = aldo_cart_prgblock(cart, 0);
-    if (!bv.mem) return ALDO_DIS_ERR_PRGROM;
+    return print_cart_prg(cart, name, verbose, unified_output, nullptr,
+                          nullptr, f);
+}
 
-    if (aldo_cart_write_dis_header(cart, name, f) < 0) return ALDO_DIS_ERR_IO;
+int aldo_dis_cart_prg_profile(aldo_cart *cart, const char *restrict name,
+                              aldo_profiler *prof, FILE *f)
+{
+    assert(cart != nullptr);
+    assert(name != nullptr);
+    assert(prof != nullptr);
+    assert(f != nullptr);
 
-    do {
-        if (fputc('\n', f) == EOF) return ALDO_DIS_ERR_IO;
-        auto err = print_prgblock(&bv, verbose, f);
-        // Disassembly errors may occur normally if data bytes are
-        // interpreted as instructions so note the result and continue.
-        if (err < 0) {
-            err = fprintf(unified_output ? f : stderr,
-                          "Dis err (%d): %s\n", err, aldo_dis_errstr(err));
-            if (err < 0) return ALDO_DIS_ERR_IO;
-        }
-        bv = aldo_cart_prgblock(cart, bv.ord + 1);
-    } while (bv.mem);
+    if (fprintf(f, "Profile: %" PRIu64 " cycles\n",
+                aldo_profile_total(prof)) < 0) return ALDO_DIS_ERR_IO;
+    return print_cart_prg(cart, name, false, true, prof, nullptr, f);
+}
 
-    return 0;
+int aldo_dis_cart_prg_cdl(aldo_cart *cart, const char *restrict name,
+                          bool verbose, bool unified_output, aldo_cdl *cdl,
+                          FILE *f)
+{
+    assert(cart != nullptr);
+    assert(name != nullptr);
+    assert(cdl != nullptr);
+    assert(f != nullptr);
+
+    return print_cart_prg(cart, name, verbose, unified_output, nullptr, cdl,
+                          f);
 }
 
-int aldo_dis_cart_chr(aldo_cart *cart, int chrscale,
-                      const char *restrict chrdecode_prefix, FILE *output)
+int aldo_dis_hotspot(aldo_cart *cart, const struct aldo_hotspot *h,
+                     char dis[restrict static AldoDisInstSize])
 {
     assert(cart != nullptr);
-    assert(output != nullptr);
+    assert(h != nullptr);
+    assert(dis != nullptr);
 
-    if (chrscale <= 0 || chrscale > ScaleGuard) return ALDO_DIS_ERR_CHRSCL;
+    if (h->prgaddr < 0) return 0;
 
-    auto bv = aldo_cart_chrblock(cart, 0);
-    if (!bv.mem) return ALDO_DIS_ERR_CHRROM;
+    auto blocksize = aldo_cart_prgblock(cart, 0).size;
+    if (blocksize == 0) return 0;
 
-    const char *prefix = chrdecode_prefix && chrdecode_prefix[0] != '\0'
-                            ? chrdecode_prefix
-                            : "chr";
-    size_t
-        prefixlen = strlen(prefix),
-        namesize = prefixlen + 8;   // prefix + nnn.bmp + nul
-    char *bmpfilename = malloc(namesize);
-    if (!bmpfilename) return ALDO_DIS_ERR_ERNO;
+    auto bv = aldo_cart_prgblock(cart, (size_t)h->prgaddr / blocksize);
+    if (!bv.mem) return 0;
 
-    int err;
-    do {
-        err = snprintf(bmpfilename, namesize, "%s%03zu.bmp", prefix, bv.ord);
-        if (err < 0) {
-            err = ALDO_DIS_ERR_FMT;
-            break;
-        }
-        err = write_chrblock(&bv, (uint32_t)chrscale, bmpfilename, output);
-        if (err < 0) break;
-        bv = aldo_cart_chrblock(cart, bv.ord + 1);
-    } while (bv.mem);
+    struct aldo_dis_instruction inst;
+    auto err = aldo_dis_parse_inst(&bv, (size_t)h->prgaddr % blocksize,
+                                   &inst);
+    if (err <= 0) return err;
+    return aldo_dis_inst(h->addr, &inst, dis);
+}
+
+int aldo_dis_hotspots(aldo_cart *cart, aldo_profiler *prof, size_t n,
+                      FILE *f)
+{
+    assert(cart != nullptr);
+    assert(prof != nullptr);
+    assert(f != nullptr);
+
+    if (n == 0) return 0;
 
-    free(bmpfilename);
+    struct aldo_hotspot *hs = calloc(n, sizeof *hs);
+    if (!hs) return ALDO_DIS_ERR_ERNO;
+
+    auto count = aldo_profile_hotspots(prof, n, hs);
+    auto total = aldo_profile_total(prof);
+    int err = fprintf(f, "Hot Spots (top %zu of %" PRIu64 " cycles)\n"
+                      "%7s %13s %10s  %5s  %s\n", count, total, "%", "Cycles",
+                      "Execs", "Block", "Instruction") < 0
+                ? ALDO_DIS_ERR_IO
+                : 0;
+    for (size_t i = 0; err == 0 && i < count; ++i) {
+        err = print_hotspot(cart, hs + i, total, f);
+    }
+    free(hs);
     return err;
 }
 
+int aldo_dis_cart_chr(aldo_cart *cart, int chrscale,
+                      const char *restrict chrdecode_prefix, FILE *output)
+{
+    assert(cart != nullptr);
+    assert(output != nullptr);
+
+    return decode_cart_chr(cart, chrscale, chrdecode_prefix, false, output);
+}
+
+int aldo_dis_cart_chr_png(aldo_cart *cart, int chrscale,
+                          const char *restrict chrdecode_prefix, FILE *output)
+{
+    assert(cart != nullptr);
+    assert(output != nullptr);
+
+    return decode_cart_chr(cart, chrscale, chrdecode_prefix, true, output);
+}
+
 int aldo_dis_cart_chrblock(const struct aldo_blockview *bv, int scale, FILE *f)
 {
     assert(bv != nullptr);
@@ -9,8 +9,10 @@
 #define Aldo_dis_h
 
 #include "cart.h"
+#include "cdl.h"
 #include "debug.h"
 #include "decode.h"
+#include "profile.h"
 
 #include <stddef.h>
 #include <stdint.h>
@@ -78,10 +80,33 @@ int aldo_dis_datapath(const struct aldo_snapshot *snp,
 aldo_export aldo_checkerr
 int aldo_dis_cart_prg(aldo_cart *cart, const char *aldo_noalias name,
                       bool verbose, bool unified_output, FILE *f) aldo_nothrow;
+// PRG disassembly annotated with each instruction's share of profiled cycles
+aldo_export aldo_checkerr
+int aldo_dis_cart_prg_profile(aldo_cart *cart, const char *aldo_noalias name,
+                              aldo_profiler *prof, FILE *f) aldo_nothrow;
+// PRG disassembly that lists runs of logged data-only bytes as single
+// .data lines rather than decoding them as instructions.
+aldo_export aldo_checkerr
+int aldo_dis_cart_prg_cdl(aldo_cart *cart, const char *aldo_noalias name,
+                          bool verbose, bool unified_output, aldo_cdl *cdl,
+                          FILE *f) aldo_nothrow;
+// disassemble a PRG ROM hot spot, returns 0 if hot spot is not in PRG ROM
+aldo_export aldo_checkerr
+int aldo_dis_hotspot(aldo_cart *cart, const struct aldo_hotspot *h,
+                     char dis[aldo_nacz(AldoDisInstSize)]) aldo_nothrow;
+// flat list of the n instructions with the most profiled cycles
+aldo_export aldo_checkerr
+int aldo_dis_hotspots(aldo_cart *cart, aldo_profiler *prof, size_t n,
+                      FILE *f) aldo_nothrow;
 aldo_export aldo_checkerr
 int aldo_dis_cart_chr(aldo_cart *cart, int chrscale,
                       const char *aldo_noalias chrdecode_prefix,
                       FILE *output) aldo_nothrow;
+// decode CHR ROM into indexed-color PNG files instead of BMP files
+aldo_export aldo_checkerr
+int aldo_dis_cart_chr_png(aldo_cart *cart, int chrscale,
+                          const char *aldo_noalias chrdecode_prefix,
+                          FILE *output) aldo_nothrow;
 aldo_export aldo_checkerr
 int aldo_dis_cart_chrblock(const struct aldo_blockview *bv, int scale,
                            FILE *f) aldo_nothrow;
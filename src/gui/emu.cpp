@@ -19,6 +19,7 @@ namespace
 {
 
 constexpr const char* CartLoadFailure = "Cart load failure";
+constexpr aldo::et::size RewindBudget = 64 * 1024 * 1024;
 
 auto get_prefspath(const gui_platform& p)
 {
@@ -35,16 +36,13 @@ auto get_prefspath(const gui_platform& p)
 ALDO_OWN
 auto load_cart(const std::filesystem::path& filepath)
 {
-    using file_handle = aldo::handle<std::FILE, std::fclose>;
-
     aldo_cart* c;
-    file_handle f{std::fopen(filepath.c_str(), "rb")};
-    if (!f) throw aldo::AldoError{"Cannot open cart file", filepath, errno};
-
-    auto err = aldo_cart_create(&c, f.get());
+    // loading by path lets the cart map the file, unpack compressed
+    // images, and pick archive entries given as archive.zip#entry.nes
+    auto err = aldo_cart_create_file(&c, filepath.c_str());
     if (err < 0) {
         if (err == ALDO_CART_ERR_ERNO) throw aldo::AldoError{
-            CartLoadFailure, "System error", errno,
+            "Cannot open cart file", filepath, errno,
         };
         throw aldo::AldoError{CartLoadFailure, err, aldo_cart_errstr};
     };
@@ -60,9 +58,14 @@ auto load_cart(const std::filesystem::path& filepath)
 
 aldo::Emulator::Emulator(aldo::debug_handle d, aldo::console_handle c,
                          const gui_platform& p)
-: prefspath{get_prefspath(p)}, hdbg{std::move(d)}, hconsole{std::move(c)}
+: prefspath{get_prefspath(p)}, hdbg{std::move(d)}, hconsole{std::move(c)},
+    hrewind{aldo_rewind_new(RewindBudget)}
 {
+    if (!hrewind) throw aldo::AldoError{
+        "Unable to initialize rewind history", "System error", errno,
+    };
     aldo_nes_set_snapshot(consolep(), snapshotp());
+    aldo_nes_set_rewind(consolep(), hrewind.get());
 }
 
 std::string_view aldo::Emulator::displayCartName() const noexcept
@@ -81,12 +84,29 @@ std::optional<aldo_cartinfo> aldo::Emulator::cartInfo() const
     return info;
 }
 
+void aldo::Emulator::profile(bool enable)
+{
+    if (enable == profiling()) return;
+
+    if (enable) {
+        hprof.reset(aldo_profile_new());
+        if (!hprof) throw aldo::AldoError{
+            "Unable to start profiler", "System error", errno,
+        };
+        aldo_nes_set_profiler(consolep(), hprof.get());
+    } else {
+        aldo_nes_set_profiler(consolep(), nullptr);
+        hprof.reset();
+    }
+}
+
 void aldo::Emulator::loadCart(const std::filesystem::path& filepath)
 {
     auto c = load_cart(filepath);
     saveCartState();
     aldo_nes_powerdown(consolep());
     hcart.reset(c);
+    profileReset();
     aldo_nes_powerup(consolep(), cartp(), zeroRam);
     cartpath = filepath;
     cartname = cartpath.stem();
@@ -99,6 +119,16 @@ void aldo::Emulator::update(aldo::viewstate& vs) noexcept
     aldo_nes_clock(consolep(), vs.clock.clockp());
 }
 
+void aldo::Emulator::stepBack(aldo::viewstate& vs) noexcept
+{
+    aldo_nes_step_back(consolep(), vs.clock.clockp());
+}
+
+void aldo::Emulator::reverseContinue(aldo::viewstate& vs) noexcept
+{
+    aldo_nes_reverse_continue(consolep(), vs.clock.clockp());
+}
+
 //
 // MARK: - Private Interface
 //
@@ -126,5 +156,7 @@ void aldo::Emulator::cleanup() const noexcept
     } catch (...) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Unknown Emu dtor error!");
     }
+    aldo_nes_set_profiler(consolep(), nullptr);
+    aldo_nes_set_rewind(consolep(), nullptr);
     aldo_nes_set_snapshot(consolep(), nullptr);
 }
@@ -12,19 +12,24 @@
 #include "cart.h"
 #include "ctrlsignal.h"
 #include "debug.hpp"
+#include "dis.h"
 #include "emutypes.hpp"
 #include "error.hpp"
 #include "handle.hpp"
 #include "nes.h"
 #include "palette.hpp"
+#include "profile.h"
+#include "rewind.h"
 #include "snapshot.h"
 
 #include <SDL3/SDL.h>
 
 #include <filesystem>
 #include <optional>
+#include <span>
 #include <string_view>
 #include <cerrno>
+#include <cstdint>
 
 struct gui_platform;
 
@@ -39,6 +44,8 @@ namespace emu
 {
 
 using cart_handle = handle<aldo_cart, aldo_cart_free>;
+using profile_handle = handle<aldo_profiler, aldo_profile_free>;
+using rewind_handle = handle<aldo_rewind, aldo_rewind_free>;
 
 class Snapshot {
 public:
@@ -113,8 +120,41 @@ public:
         aldo_nes_set_probe(consolep(), signal, active);
     }
 
+    bool profiling() const noexcept { return static_cast<bool>(hprof); }
+    void profile(bool enable);
+    void profileReset() noexcept
+    {
+        if (!hprof) return;
+        aldo_profile_reset(hprof.get());
+    }
+    std::uint64_t profileTotal() const noexcept
+    {
+        return hprof ? aldo_profile_total(hprof.get()) : 0;
+    }
+    et::size hotSpots(std::span<aldo_hotspot> hs) const noexcept
+    {
+        if (!hprof) return 0;
+        return aldo_profile_hotspots(hprof.get(), hs.size(), hs.data());
+    }
+    int hotSpotDisassembly(const aldo_hotspot& h, et::tchar* dis) const noexcept
+    {
+        if (!hcart) return 0;
+        return aldo_dis_hotspot(cartp(), &h, dis);
+    }
+
+    et::size rewindCount() const noexcept
+    {
+        return aldo_rewind_count(hrewind.get());
+    }
+    double rewindLastMs() const noexcept
+    {
+        return aldo_rewind_last_ms(hrewind.get());
+    }
+
     void loadCart(const std::filesystem::path& filepath);
     void update(viewstate& vs) noexcept;
+    void stepBack(viewstate& vs) noexcept;
+    void reverseContinue(viewstate& vs) noexcept;
 
     bool zeroRam = false;
 
@@ -132,6 +172,8 @@ private:
     Debugger hdbg;
     console_handle hconsole;
     emu::Snapshot hsnp;
+    emu::profile_handle hprof;
+    emu::rewind_handle hrewind;
     Palette hpalette;
 };
 
@@ -158,6 +158,33 @@ auto handle_keydown(const SDL_Event& ev, const aldo::Emulator& emu,
             vs.addProbeCommand(ALDO_INT_RST, !emu.probe(ALDO_INT_RST));
         }
         break;
+    case SDLK_T:
+        if (is_free_key(ev)) {
+            vs.clock.toggleTurbo();
+        }
+        break;
+    case SDLK_TAB:
+        if (is_free_key(ev)) {
+            vs.clock.holdTurbo(true);
+        }
+        break;
+    case SDLK_U:
+        if (is_free_key(ev, true)) {
+            vs.commands.emplace(shift_pressed(ev)
+                                ? aldo::Command::reverseContinue
+                                : aldo::Command::stepBack);
+        }
+        break;
+    }
+}
+
+auto handle_keyup(const SDL_Event& ev, aldo::viewstate& vs) noexcept
+{
+    // always release held keys, even if ImGui has since taken the keyboard
+    switch (ev.key.key) {
+    case SDLK_TAB:
+        vs.clock.holdTurbo(false);
+        break;
     }
 }
 
@@ -214,15 +241,27 @@ auto process_command(const aldo::command_state& cs, aldo::Emulator& emu,
             emu.probe(signal, active);
         }
         break;
+    case aldo::Command::profile:
+        emu.profile(std::get<bool>(cs.value));
+        break;
+    case aldo::Command::profileReset:
+        emu.profileReset();
+        break;
     case aldo::Command::resetVectorClear:
         debugger.vectorClear();
         break;
     case aldo::Command::resetVectorOverride:
         debugger.vectorOverride(std::get<int>(cs.value));
         break;
+    case aldo::Command::reverseContinue:
+        emu.reverseContinue(vs);
+        break;
     case aldo::Command::quit:
         vs.running = false;
         break;
+    case aldo::Command::stepBack:
+        emu.stepBack(vs);
+        break;
     case aldo::Command::zeroRamOnPowerup:
         emu.zeroRam = std::get<bool>(cs.value);
         break;
@@ -244,6 +283,9 @@ void aldo::input::handle(aldo::Emulator& emu, aldo::viewstate& vs,
         case SDL_EVENT_KEY_DOWN:
             handle_keydown(ev, emu, vs);
             break;
+        case SDL_EVENT_KEY_UP:
+            handle_keyup(ev, vs);
+            break;
         case SDL_EVENT_QUIT:
             vs.commands.emplace(aldo::Command::quit);
             break;
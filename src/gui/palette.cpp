@@ -15,6 +15,12 @@
 #include <iterator>
 #include <ranges>
 #include <tuple>
+#include <cassert>
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define ALDO_PALETTE_NEON 1
+#endif
 
 namespace
 {
@@ -24,6 +30,32 @@ constexpr aldo::palette::sz
 
 using pal_buf = std::array<std::ifstream::char_type, PalFileLength>;
 
+// 8-bit fixed-point level of an attenuated channel, about 0.816
+constexpr ImU32 EmphasisLevel = 209;
+
+// PPUMASK emphasis bits 5-7 select a pair of tables, grayscale bit 0 picks
+// the grayscale table of the pair.
+constexpr aldo::palette::sz table_index(Uint8 mask) noexcept
+{
+    return static_cast<aldo::palette::sz>(((mask >> 4) & 0xe) | (mask & 0x1));
+}
+
+// NTSC color emphasis darkens the channels not being emphasized, so each
+// channel is attenuated if any other channel's emphasis bit is set; bits
+// are red (0x1), green (0x2), and blue (0x4).
+constexpr aldo::palette::datav emphasize(aldo::palette::datav c,
+                                         aldo::palette::sz emphasis) noexcept
+{
+    if (emphasis == 0) return c;
+
+    auto attenuate = [emphasis](ImU32 ch, aldo::palette::sz bit) {
+        return (emphasis & ~bit) ? (ch * EmphasisLevel) >> 8 : ch;
+    };
+    auto [r, g, b] = aldo::colors::rgb(c);
+    return IM_COL32(attenuate(r, 0x1), attenuate(g, 0x2), attenuate(b, 0x4),
+                    SDL_ALPHA_OPAQUE);
+}
+
 auto parse_colors(const pal_buf& buf)
 {
     auto newColors = std::make_unique<aldo::palette::datav[]>(aldo::palette::Size);
@@ -58,7 +90,49 @@ aldo::palette::datav aldo::Palette::getColor(aldo::palette::sz idx) const
 {
     assert(idx < aldo::palette::Size);
 
-    return std::visit([idx](auto&& c) { return c[idx]; }, colors);
+    return tables.front()[idx];
+}
+
+void aldo::Palette::convertLine(std::span<const Uint8> line, Uint8 mask,
+                                aldo::palette::datav* out) const noexcept
+{
+    static constexpr auto idxMask = static_cast<Uint8>(aldo::palette::Size - 1);
+
+    assert(out != nullptr);
+
+    const auto& colorTable = tables[table_index(mask)];
+    decltype(line)::size_type i = 0;
+#ifdef ALDO_PALETTE_NEON
+    // Split the table into one 64-byte plane per color byte so each plane
+    // is a single 4-register table lookup, then re-interleave the looked-up
+    // bytes on store; 16 pixels per iteration.
+    static constexpr int lanes = 16, planeCount = 4;
+    static_assert(sizeof(aldo::palette::datav) == planeCount,
+                  "Palette color is not 4 bytes wide");
+    static_assert(aldo::palette::Size == lanes * planeCount,
+                  "Palette size does not fit a 4-register table lookup");
+
+    auto src = reinterpret_cast<const uint8_t*>(colorTable.data());
+    uint8x16x4_t planes[planeCount];
+    for (auto q = 0; q < planeCount; ++q) {
+        auto quarter = vld4q_u8(src + (q * lanes * planeCount));
+        for (auto p = 0; p < planeCount; ++p) {
+            planes[p].val[q] = quarter.val[p];
+        }
+    }
+    auto idxBits = vdupq_n_u8(idxMask);
+    for (; i + lanes <= line.size(); i += lanes) {
+        auto idx = vandq_u8(vld1q_u8(line.data() + i), idxBits);
+        uint8x16x4_t px;
+        for (auto p = 0; p < planeCount; ++p) {
+            px.val[p] = vqtbl4q_u8(planes[p], idx);
+        }
+        vst4q_u8(reinterpret_cast<uint8_t*>(out + i), px);
+    }
+#endif
+    for (; i < line.size(); ++i) {
+        out[i] = colorTable[line[i] & idxMask];
+    }
 }
 
 void aldo::Palette::load(const std::filesystem::path& filepath)
@@ -80,4 +154,24 @@ void aldo::Palette::load(const std::filesystem::path& filepath)
 
     colors = parse_colors(buf);
     filename = filepath.filename();
+    buildTables();
+}
+
+//
+// MARK: - Private Interface
+//
+
+void aldo::Palette::buildTables() noexcept
+{
+    for (aldo::palette::sz t = 0; t < tables.size(); ++t) {
+        // grayscale drops the hue bits, keeping only the color's brightness
+        aldo::palette::sz hueMask = t & 0x1 ? 0x30 : 0x3f, emphasis = t >> 1;
+        auto& table = tables[t];
+        for (aldo::palette::sz idx = 0; idx < table.size(); ++idx) {
+            auto c = std::visit([i = idx & hueMask](auto&& cs) {
+                return cs[i];
+            }, colors);
+            table[idx] = emphasize(c, emphasis);
+        }
+    }
 }
@@ -113,6 +113,9 @@ public:
     }
     et::qword missedTicks() const noexcept { return missed; }
     aldo_clockscale scale() const noexcept { return currentScale; }
+    // achieved emulation speed relative to full-speed frame rate
+    double speed() const noexcept { return speedMultiplier; }
+    bool turbo() const noexcept { return turboHeld || turboLocked; }
 
     bool atMinRate() const noexcept
     {
@@ -135,6 +138,7 @@ public:
     {
         clock().emutime = 0;
         missed = clock().cycles = clock().frames = clock().subcycle = 0;
+        speedFrames = 0;
     }
 
     RunTimer timeInput() noexcept { return RunTimer{dtInput}; }
@@ -173,7 +177,21 @@ public:
         setScale(static_cast<aldo_clockscale>(!currentScale));
     }
 
+    void holdTurbo(bool held) noexcept
+    {
+        setTurbo(held, turboLocked);
+    }
+
+    void toggleTurbo() noexcept
+    {
+        setTurbo(turboHeld, !turboLocked);
+    }
+
 private:
+    // Turbo ignores the clock rate and sizes each tick's budget to fill
+    // this much of the tick with emulation, leaving the rest for input
+    // and rendering within a 60Hz display refresh.
+    static constexpr double TurboSliceMs = 12, SpeedIntervalS = 0.5;
     friend RunTick;
 
     bool atRateLimit(int cycleLimit, int frameLimit) const noexcept
@@ -183,27 +201,69 @@ private:
                 : clock().rate == frameLimit;
     }
 
+    void setTurbo(bool held, bool locked) noexcept
+    {
+        auto wasTurbo = turbo();
+        turboHeld = held;
+        turboLocked = locked;
+        if (wasTurbo && !turbo()) {
+            // drop whatever is left of the last turbo budget
+            clock().budget = 0;
+            clock().timebudget_ms = 0;
+        }
+    }
+
     void tickStart(bool resetBudget) noexcept
     {
         aldo_clock_tickstart(clockp(), resetBudget);
+        turboTick = turbo() && !resetBudget;
+        if (turboTick) {
+            clock().budget = turboBudget;
+        }
     }
 
     void tickEnd() noexcept
     {
+        if (turboTick && clock().budget < turboBudget && dtUpdate > 0) {
+            // size the next turbo budget from this tick's dots per ms,
+            // between a frame and a second of frames per tick.
+            double
+                dotsPerMs = (turboBudget - clock().budget) / dtUpdate,
+                frameDots = aldo_nes_frame_factor();
+            turboBudget = static_cast<int>(std::clamp(dotsPerMs * TurboSliceMs,
+                                                      frameDots,
+                                                      frameDots * Aldo_MaxFps));
+        }
         aldo_clock_tickend(clockp());
         if (clock().ticktime_ms < dtTotalMs()) {
             ++missed;
         }
+        sampleSpeed();
+    }
+
+    void sampleSpeed() noexcept
+    {
+        auto elapsed = clock().runtime - speedTime;
+        if (elapsed < SpeedIntervalS) return;
+
+        auto frames = clock().frames - std::min(speedFrames, clock().frames);
+        speedMultiplier = static_cast<double>(frames) / elapsed
+                            / Aldo_MaxFps;
+        speedFrames = clock().frames;
+        speedTime = clock().runtime;
     }
 
     aldo_clock clk{
         .rate = Aldo_MaxFps,
         .rate_factor = aldo_nes_frame_factor(),
     };
-    et::qword missed = 0;
-    double dtInput = 0, dtUpdate = 0, dtRender = 0;
+    et::qword missed = 0, speedFrames = 0;
+    double
+        dtInput = 0, dtUpdate = 0, dtRender = 0, speedMultiplier = 0,
+        speedTime = 0;
     aldo_clockscale currentScale = ALDO_CS_FRAME;
-    int oldRate = 10;
+    int oldRate = 10, turboBudget = aldo_nes_frame_factor();
+    bool turboHeld = false, turboLocked = false, turboTick = false;
 };
 
 // inlined here to avoid circular type resolution with RunClock
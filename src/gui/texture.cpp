@@ -17,6 +17,7 @@
 #include <array>
 #include <concepts>
 #include <ranges>
+#include <span>
 #include <cassert>
 
 static_assert(std::same_as<Uint32, ImU32>,
@@ -122,14 +123,19 @@ aldo::VideoScreen::VideoScreen(SDL_Point resolution, const aldo::MediaRuntime& m
 : tex{resolution, mr.renderer()} {}
 
 void aldo::VideoScreen::draw(const aldo::et::byte* vbuf,
+                             const aldo::et::byte* linemasks,
                              const aldo::Palette& p) const
 {
     assert(vbuf != nullptr);
+    assert(linemasks != nullptr);
 
     auto data = tex.lock();
     assert(data.size() == screen_buffer_length());
-    for (auto i = 0; i < data.size(); ++i) {
-        data.pixels[i] = p.getColor(vbuf[i]);
+    auto width = static_cast<std::span<const aldo::et::byte>::size_type>(
+        data.width);
+    for (auto row = 0; row < data.height; ++row) {
+        std::span line{vbuf + (row * data.width), width};
+        p.convertLine(line, linemasks[row], data.pixels + (row * data.stride));
     }
 }
 
@@ -122,7 +122,8 @@ class VideoScreen {
 public:
     VideoScreen(SDL_Point resolution, const MediaRuntime& mr);
 
-    void draw(const et::byte* vbuf, const Palette& p) const;
+    void draw(const et::byte* vbuf, const et::byte* linemasks,
+              const Palette& p) const;
     void render(float scale, bool sdRatio) const noexcept
     {
         // 4:3 SD TV ratio scales the x-axis by about 1.14 from square
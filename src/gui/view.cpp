@@ -445,6 +445,9 @@ auto speed_menu_items(aldo::viewstate& vs) noexcept
     if (ImGui::MenuItem("Clock Scale", "c")) {
         vs.clock.toggleScale();
     }
+    if (ImGui::MenuItem("Turbo", "t", vs.clock.turbo())) {
+        vs.clock.toggleTurbo();
+    }
 }
 
 auto mode_menu_item(aldo::viewstate& vs, const aldo::Emulator& emu)
@@ -539,6 +542,21 @@ auto tools_menu(aldo::viewstate& vs)
     }
 }
 
+auto speed_status(const aldo::viewstate& vs)
+{
+    std::array<char, 24> buf;
+    std::snprintf(buf.data(), buf.size(), "%s%.2fx",
+                  vs.clock.turbo() ? "Turbo " : "", vs.clock.speed());
+    auto width = ImGui::CalcTextSize(buf.data()).x
+                    + ImGui::GetStyle().ItemSpacing.x;
+    ImGui::SameLine(ImGui::GetWindowWidth() - width);
+    ScopedColor turbo{
+        {ImGuiCol_Text, aldo::colors::Attention},
+        vs.clock.turbo(),
+    };
+    ImGui::TextUnformatted(buf.data());
+}
+
 auto main_menu(aldo::viewstate& vs, const aldo::Emulator& emu,
                const aldo::MediaRuntime& mr, view_span views)
 {
@@ -548,15 +566,17 @@ auto main_menu(aldo::viewstate& vs, const aldo::Emulator& emu,
         controls_menu(vs, emu);
         windows_menu(views);
         tools_menu(vs);
+        speed_status(vs);
         ImGui::EndMainMenuBar();
     }
 }
 
-auto input_address(aldo::et::word* addr) noexcept
+auto input_address(aldo::et::word* addr,
+                   const char* label = "Address") noexcept
 {
     ImGui::SetNextItemWidth(aldo::style::glyph_size().x * 6);
     ScopedID id = addr;
-    return ImGui::InputScalar("Address", ImGuiDataType_U16, addr, nullptr,
+    return ImGui::InputScalar(label, ImGuiDataType_U16, addr, nullptr,
                               nullptr, "%04X");
 }
 
@@ -1160,6 +1180,14 @@ private:
         case ALDO_HLT_JAM:
             ImGui::Dummy({0, ImGui::GetFrameHeight()});
             break;
+        case ALDO_HLT_READ:
+        case ALDO_HLT_WRITE:
+        case ALDO_HLT_ACCESS:
+            renderWatchInput();
+            break;
+        case ALDO_HLT_EXPR:
+            renderPredicateInput();
+            break;
         default:
             SDL_LogWarn(SDL_LOG_CATEGORY_APPLICATION,
                         "Invalid halt condition selection: %d",
@@ -1170,12 +1198,63 @@ private:
             ImGui::SetKeyboardFocusHere(-1);
         }
         auto submitted = ImGui::IsItemDeactivated() && enter_pressed();
+        if (currentHaltExpression.cond != ALDO_HLT_EXPR) {
+            renderPredicateInput();
+            submitted |= ImGui::IsItemDeactivated() && enter_pressed();
+        }
         if (ImGui::Button("Add") || submitted) {
-            vs.commands.emplace(aldo::Command::breakpointAdd,
-                                currentHaltExpression);
+            addBreakpoint();
+        }
+        if (predicateErr < 0) {
+            ImGui::SameLine();
+            ImGui::TextUnformatted(aldo_haltexpr_errstr(predicateErr));
         }
     }
 
+    void renderWatchInput() noexcept
+    {
+        auto& watch = currentHaltExpression.watch;
+        ImGui::Checkbox("VRAM", &watch.vram);
+        ImGui::SameLine();
+        input_address(&watch.low, "From");
+        ImGui::SameLine();
+        input_address(&watch.high, "To");
+        // keep the range valid for the selected bus
+        if (watch.vram) {
+            watch.low &= ALDO_ADDRMASK_16KB;
+            watch.high &= ALDO_ADDRMASK_16KB;
+        }
+        watch.high = std::max(watch.low, watch.high);
+    }
+
+    void renderPredicateInput() noexcept
+    {
+        ImGui::SetNextItemWidth(aldo::style::glyph_size().x * 24);
+        ImGui::InputTextWithHint("Predicate", "A==$10 && [$0300]>$80",
+                                 predicate.data(), predicate.size());
+    }
+
+    void addBreakpoint() noexcept
+    {
+        auto expr = currentHaltExpression;
+        predicateErr = 0;
+        if (predicate.front() != '\0' || expr.cond == ALDO_HLT_EXPR) {
+            // attach the predicate by reparsing the condition's debug format
+            // so the library does all the compiling.
+            aldo_debugexpr dbgexpr{.hexpr = expr, .type = ALDO_DBG_EXPR_HALT};
+            aldo::hexpr_buffer cond;
+            predicateErr = aldo_haltexpr_fmtdbg(&dbgexpr, cond.data());
+            if (predicateErr < 0) return;
+            std::array<aldo::et::tchar, 2 * AldoHexprFmtSize> text;
+            std::snprintf(text.data(), text.size(), "%s%s%s", cond.data(),
+                          cond.front() == '\0' ? "" : " && ",
+                          predicate.data());
+            predicateErr = aldo_haltexpr_parse(text.data(), &expr);
+            if (predicateErr < 0) return;
+        }
+        vs.commands.emplace(aldo::Command::breakpointAdd, expr);
+    }
+
     void renderBreakpointList()
     {
         ImVec2 dims{
@@ -1223,6 +1302,8 @@ private:
                 bpSelections.select(idx);
             }
         }
+        ImGui::SetItemTooltip("%" PRIu64 " hit%s", bp.hits,
+                              bp.hits == 1 ? "" : "s");
     }
 
     void renderListControls(bp_sz bpCount)
@@ -1277,9 +1358,98 @@ private:
     aldo::et::word resetAddr = 0x0;
     HaltCombo conditionsCombo;
     aldo_haltexpr currentHaltExpression;
+    aldo::hexpr_buffer predicate{};
+    int predicateErr = 0;
     SelectedBreakpoints bpSelections;
 };
 
+class HotSpotsView final : public aldo::View {
+public:
+    HotSpotsView(aldo::viewstate& vs, const aldo::Emulator& emu,
+                 const aldo::MediaRuntime& mr) noexcept
+    : View{"Hot Spots", vs, emu, mr} {}
+    HotSpotsView(aldo::viewstate&, aldo::Emulator&&,
+                 const aldo::MediaRuntime&) = delete;
+    HotSpotsView(aldo::viewstate&, const aldo::Emulator&,
+                 aldo::MediaRuntime&&) = delete;
+    HotSpotsView(aldo::viewstate&, aldo::Emulator&&,
+                 aldo::MediaRuntime&&) = delete;
+
+protected:
+    void renderContents() override
+    {
+        renderControls();
+        ImGui::Separator();
+        // scanning every counter is too slow to do each frame
+        if (refreshInterval.elapsed(vs.clock.clock())) {
+            count = emu.hotSpots(hotspots);
+            total = emu.profileTotal();
+        }
+        renderHotSpots();
+    }
+
+private:
+    void renderControls() const noexcept
+    {
+        auto profiling = emu.profiling();
+        if (ImGui::Checkbox("Profile", &profiling)) {
+            vs.commands.emplace(aldo::Command::profile, profiling);
+        }
+        ImGui::SameLine();
+        DisabledIf dif = !profiling;
+        if (ImGui::Button("Reset")) {
+            vs.commands.emplace(aldo::Command::profileReset);
+        }
+        ImGui::SameLine();
+        ImGui::Text("Total: %" PRIu64 " cycles", total);
+    }
+
+    void renderHotSpots() const noexcept
+    {
+        static constexpr auto tableConfig = ImGuiTableFlags_BordersOuter
+                                            | ImGuiTableFlags_BordersV
+                                            | ImGuiTableFlags_RowBg
+                                            | ImGuiTableFlags_SizingFixedFit
+                                            | ImGuiTableFlags_ScrollY;
+
+        if (!ImGui::BeginTable("hotspots", Cols, tableConfig)) return;
+
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("%");
+        ImGui::TableSetupColumn("Cycles");
+        ImGui::TableSetupColumn("Execs");
+        ImGui::TableSetupColumn("Instruction");
+        ImGui::TableHeadersRow();
+        std::array<aldo::et::tchar, AldoDisInstSize> disasm;
+        for (aldo::et::size i = 0; i < count; ++i) {
+            const auto& h = hotspots[i];
+            ImGui::TableNextColumn();
+            ImGui::Text("%6.2f%%", total > 0
+                                    ? 100.0 * static_cast<double>(h.cycles)
+                                        / static_cast<double>(total)
+                                    : 0.0);
+            ImGui::TableNextColumn();
+            ImGui::Text("%" PRIu64, h.cycles);
+            ImGui::TableNextColumn();
+            ImGui::Text("%" PRIu64, h.execs);
+            ImGui::TableNextColumn();
+            if (emu.hotSpotDisassembly(h, disasm.data()) > 0) {
+                ImGui::TextUnformatted(disasm.data());
+            } else {
+                ImGui::Text("%04X: --", h.addr);
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    static constexpr int Cols = 4;
+
+    RefreshInterval<500.0> refreshInterval;
+    std::array<aldo_hotspot, 32> hotspots{};
+    aldo::et::size count = 0;
+    std::uint64_t total = 0;
+};
+
 class NametablesView final : public aldo::View {
 public:
     NametablesView(aldo::viewstate& vs, const aldo::Emulator& emu,
@@ -2585,6 +2755,17 @@ private:
         if (ImGui::Checkbox("RST", &rst)) {
             vs.addProbeCommand(ALDO_INT_RST, rst);
         }
+
+        if (ImGui::Button("Step Back")) {
+            vs.commands.emplace(aldo::Command::stepBack);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Reverse")) {
+            vs.commands.emplace(aldo::Command::reverseContinue);
+        }
+        ImGui::SameLine();
+        ImGui::Text("History: %zu (%.1fms)", emu.rewindCount(),
+                    emu.rewindLastMs());
     }
 
     RefreshInterval<200.0> statsInterval;
@@ -2611,8 +2792,8 @@ protected:
     {
         static constexpr std::array scales{"1x", "1.5x", "2x", "2.5x"};
 
-        if (emu.snapshot().video->newframe) {
-            screen.draw(emu.snapshot().video->screen, emu.palette());
+        if (auto vsp = emu.snapshot().video; vsp->newframe) {
+            screen.draw(vsp->screen, vsp->linemasks, emu.palette());
         }
         screen.render((static_cast<float>(scaleSelection) / 2.0f) + 1, sdRatio);
 
@@ -2656,6 +2837,7 @@ aldo::Layout::Layout(aldo::viewstate& vs, const aldo::Emulator& emu,
         CartInfoView,
         CpuView,
         DebuggerView,
+        HotSpotsView,
         NametablesView,
         PaletteView,
         PatternTablesView,
@@ -36,9 +36,13 @@ enum class Command {
     paletteLoad,
     paletteUnload,
     probe,
+    profile,
+    profileReset,
     resetVectorClear,
     resetVectorOverride,
+    reverseContinue,
     quit,
+    stepBack,
     zeroRamOnPowerup,
 };
 
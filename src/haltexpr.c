@@ -10,58 +10,400 @@
 #include "bytes.h"
 
 #include <assert.h>
+#include <ctype.h>
+#include <errno.h>
 #include <inttypes.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-static int parse_resetvector(const char *restrict str, int *resetvector)
+// any of these before the first && means the whole expression is a predicate
+static const char *const restrict PredicateChars = "=<>![|";
+static const char *const restrict AndToken = "&&";
+
+static const char *const restrict VarNames[] = {
+#define X(s, n) n,
+    ALDO_HEXPR_VAR_X
+#undef X
+};
+
+static const char *const restrict WatchKinds[] = {"r", "w", "rw"};
+
+static const char *const restrict OpTokens[] = {
+#define X(s, t) t,
+    ALDO_HEXPR_OP_X
+#undef X
+};
+
+static bool is_operand(uint8_t op)
 {
-    if (!str) return ALDO_HEXPR_ERR_SCAN;
+    return op == ALDO_HOP_IMM || op == ALDO_HOP_VAR || op == ALDO_HOP_MEM;
+}
 
-    char u[2];
-    unsigned int addr;
-    bool
-        parsed = sscanf(str, " %1[" ALDO_HEXPR_RST_IND "]%X", u, &addr) == 2,
-        valid = addr < ALDO_MEMBLOCK_64KB;
-    if (parsed) {
-        if (!valid) return ALDO_HEXPR_ERR_VALUE;
-        *resetvector = (int)addr;
-        return 0;
+static bool is_comparison(uint8_t op)
+{
+    return ALDO_HOP_EQ <= op && op <= ALDO_HOP_GT;
+}
+
+static size_t operand_size(uint8_t op)
+{
+    switch (op) {
+    case ALDO_HOP_IMM:
+        return 5;
+    case ALDO_HOP_VAR:
+        return 2;
+    case ALDO_HOP_MEM:
+        return 3;
+    default:
+        return 1;
     }
-    return ALDO_HEXPR_ERR_SCAN;
 }
 
 //
-// MARK: - Public Interface
+// MARK: - Predicate Compiler
 //
 
-const char *aldo_haltexpr_errstr(int err)
+struct pred_compiler {
+    const char *cur;
+    uint8_t *code;
+    size_t len;
+    int err;
+};
+
+static void skip_space(struct pred_compiler *c)
 {
-    switch (err) {
-#define X(s, v, e) case ALDO_##s: return e;
-        ALDO_HEXPR_ERRCODE_X
-#undef X
-    default:
-        return "UNKNOWN ERR";
+    while (isspace((unsigned char)*c->cur)) {
+        ++c->cur;
     }
 }
 
-const char *aldo_haltcond_description(enum aldo_haltcondition cond)
+static bool match_token(struct pred_compiler *c, const char *token)
 {
-    switch (cond) {
-#define X(s, d) case ALDO_##s: return d;
-        ALDO_HEXPR_COND_X
-#undef X
+    skip_space(c);
+    auto len = strlen(token);
+    if (strncmp(c->cur, token, len) != 0) return false;
+    c->cur += len;
+    return true;
+}
+
+static bool emit(struct pred_compiler *c, const uint8_t bytes[], size_t count)
+{
+    if (c->err < 0) return false;
+    // always leave room for the terminating HOP_END
+    if (c->len + count >= AldoHexprCodeSize) {
+        c->err = ALDO_HEXPR_ERR_PREDSIZE;
+        return false;
+    }
+    memcpy(c->code + c->len, bytes, count);
+    c->len += count;
+    return true;
+}
+
+static bool fail(struct pred_compiler *c, int err)
+{
+    if (c->err == 0) {
+        c->err = err;
+    }
+    return false;
+}
+
+static bool scan_number(struct pred_compiler *c, uint32_t *value)
+{
+    skip_space(c);
+    auto start = c->cur;
+    auto base = 10;
+    if (*start == '$') {
+        ++start;
+        base = 16;
+    } else if (start[0] == '0' && (start[1] == 'x' || start[1] == 'X')) {
+        start += 2;
+        base = 16;
+    }
+    if (!isxdigit((unsigned char)*start)) return fail(c, ALDO_HEXPR_ERR_PRED);
+
+    char *end;
+    errno = 0;
+    auto n = strtoul(start, &end, base);
+    if (errno == ERANGE || n > UINT32_MAX) {
+        return fail(c, ALDO_HEXPR_ERR_VALUE);
+    }
+    if (end == start || isalnum((unsigned char)*end)) {
+        return fail(c, ALDO_HEXPR_ERR_PRED);
+    }
+    c->cur = end;
+    *value = (uint32_t)n;
+    return true;
+}
+
+static bool scan_var(struct pred_compiler *c, enum aldo_hexprvar *var)
+{
+    size_t len = 0;
+    while (isalpha((unsigned char)c->cur[len])) {
+        ++len;
+    }
+    for (auto i = 0; i < ALDO_HVAR_COUNT; ++i) {
+        auto name = VarNames[i];
+        if (strlen(name) != len) continue;
+        auto match = true;
+        for (size_t j = 0; j < len && match; ++j) {
+            match = tolower((unsigned char)c->cur[j])
+                    == tolower((unsigned char)name[j]);
+        }
+        if (match) {
+            c->cur += len;
+            *var = (enum aldo_hexprvar)i;
+            return true;
+        }
+    }
+    return fail(c, ALDO_HEXPR_ERR_PRED);
+}
+
+// operand := '[' number ']' | variable | number
+static bool compile_operand(struct pred_compiler *c)
+{
+    skip_space(c);
+    uint32_t value;
+    if (*c->cur == '[') {
+        ++c->cur;
+        if (!scan_number(c, &value)) return false;
+        if (value >= ALDO_MEMBLOCK_64KB) return fail(c, ALDO_HEXPR_ERR_VALUE);
+        if (!match_token(c, "]")) return fail(c, ALDO_HEXPR_ERR_PRED);
+        uint8_t mem[3] = {ALDO_HOP_MEM};
+        aldo_wrtoba((uint16_t)value, mem + 1);
+        return emit(c, mem, sizeof mem);
+    }
+    if (isalpha((unsigned char)*c->cur)) {
+        enum aldo_hexprvar var;
+        if (!scan_var(c, &var)) return false;
+        return emit(c, (uint8_t[]){ALDO_HOP_VAR, (uint8_t)var}, 2);
+    }
+    if (!scan_number(c, &value)) return false;
+    uint8_t imm[5] = {ALDO_HOP_IMM};
+    aldo_dwtoba(value, imm + 1);
+    return emit(c, imm, sizeof imm);
+}
+
+// comparison := operand op operand
+static bool compile_comparison(struct pred_compiler *c)
+{
+    if (!compile_operand(c)) return false;
+    for (uint8_t op = ALDO_HOP_EQ; op <= ALDO_HOP_GT; ++op) {
+        if (match_token(c, OpTokens[op])) {
+            return compile_operand(c) && emit(c, &op, 1);
+        }
+    }
+    return fail(c, ALDO_HEXPR_ERR_PRED);
+}
+
+// and := comparison ('&&' comparison)*
+static bool compile_and(struct pred_compiler *c)
+{
+    if (!compile_comparison(c)) return false;
+    while (match_token(c, OpTokens[ALDO_HOP_AND])) {
+        if (!compile_comparison(c)
+            || !emit(c, (uint8_t[]){ALDO_HOP_AND}, 1)) return false;
+    }
+    return true;
+}
+
+// or := and ('||' and)*
+static bool compile_or(struct pred_compiler *c)
+{
+    if (!compile_and(c)) return false;
+    while (match_token(c, OpTokens[ALDO_HOP_OR])) {
+        if (!compile_and(c)
+            || !emit(c, (uint8_t[]){ALDO_HOP_OR}, 1)) return false;
+    }
+    return true;
+}
+
+static int compile_predicate(const char *str,
+                             uint8_t code[restrict static AldoHexprCodeSize])
+{
+    struct pred_compiler c = {.cur = str, .code = code};
+    memset(code, 0, AldoHexprCodeSize);
+    if (compile_or(&c)) {
+        skip_space(&c);
+        if (*c.cur != '\0') {
+            fail(&c, ALDO_HEXPR_ERR_PRED);
+        }
+    }
+    return c.err;
+}
+
+//
+// MARK: - Predicate Formatting
+//
+
+// formatted terms of a predicate; operands are held unformatted until
+// their comparison is known so values can print in the variable's radix.
+struct pred_term {
+    uint8_t op;     // Operand kind or HOP_END for formatted text
+    uint32_t value;
+    char text[AldoHexprFmtSize];
+};
+
+static bool decimal_var(const struct pred_term *t)
+{
+    return t->op == ALDO_HOP_VAR
+            && (t->value == ALDO_HVAR_SCANLINE || t->value == ALDO_HVAR_DOT
+                || t->value == ALDO_HVAR_HITS);
+}
+
+static int format_operand(const struct pred_term *t, bool decimal,
+                          char buf[static AldoHexprFmtSize])
+{
+    switch (t->op) {
+    case ALDO_HOP_VAR:
+        return sprintf(buf, "%s", VarNames[t->value]);
+    case ALDO_HOP_MEM:
+        return sprintf(buf, "[$%04" PRIX32 "]", t->value);
+    case ALDO_HOP_IMM:
+        if (decimal) return sprintf(buf, "%" PRIu32, t->value);
+        return sprintf(buf, t->value <= UINT8_MAX
+                            ? "$%02" PRIX32
+                            : (t->value <= UINT16_MAX
+                               ? "$%04" PRIX32
+                               : "$%" PRIX32), t->value);
     default:
-        return "INVALID CONDITION";
+        return ALDO_HEXPR_ERR_PRED;
     }
 }
 
-int aldo_haltexpr_parse(const char *restrict str, struct aldo_haltexpr *expr)
+static int format_comparison(struct pred_term *lhs, const struct pred_term *rhs,
+                             uint8_t op)
 {
-    assert(expr != nullptr);
+    char l[AldoHexprFmtSize], r[AldoHexprFmtSize];
+    int err;
+    if ((err = format_operand(lhs, decimal_var(rhs), l)) < 0) return err;
+    if ((err = format_operand(rhs, decimal_var(lhs), r)) < 0) return err;
+    auto count = snprintf(lhs->text, sizeof lhs->text, "%s%s%s", l,
+                          OpTokens[op], r);
+    lhs->op = ALDO_HOP_END;
+    return count;
+}
 
-    if (!str) return ALDO_HEXPR_ERR_SCAN;
+static int format_logical(struct pred_term *lhs, const struct pred_term *rhs,
+                          uint8_t op)
+{
+    if (lhs->op != ALDO_HOP_END || rhs->op != ALDO_HOP_END) {
+        return ALDO_HEXPR_ERR_PRED;
+    }
+    auto len = strlen(lhs->text);
+    auto count = snprintf(lhs->text + len, sizeof lhs->text - len, " %s %s",
+                          OpTokens[op], rhs->text);
+    return count < 0 ? count : (int)len + count;
+}
+
+static int format_predicate(const uint8_t code[restrict static AldoHexprCodeSize],
+                            char *restrict buf, size_t size)
+{
+    struct pred_term stack[AldoHexprCodeSize / 2];
+    size_t top = 0;
+    for (size_t pc = 0; pc < AldoHexprCodeSize && code[pc] != ALDO_HOP_END;) {
+        auto op = code[pc];
+        auto opsize = operand_size(op);
+        if (pc + opsize > AldoHexprCodeSize) return ALDO_HEXPR_ERR_PRED;
+        if (is_operand(op)) {
+            if (top == aldo_arrsz(stack)) return ALDO_HEXPR_ERR_PRED;
+            auto t = stack + top++;
+            t->op = op;
+            t->value = op == ALDO_HOP_IMM
+                        ? aldo_batodw(code + pc + 1)
+                        : (op == ALDO_HOP_MEM
+                           ? aldo_batowr(code + pc + 1)
+                           : code[pc + 1]);
+            if (op == ALDO_HOP_VAR && t->value >= ALDO_HVAR_COUNT) {
+                return ALDO_HEXPR_ERR_PRED;
+            }
+        } else if (op < ALDO_HOP_COUNT && top >= 2) {
+            auto lhs = stack + top - 2;
+            auto count = is_comparison(op)
+                            ? format_comparison(lhs, lhs + 1, op)
+                            : format_logical(lhs, lhs + 1, op);
+            if (count < 0) return count;
+            if ((size_t)count >= sizeof lhs->text) {
+                return ALDO_HEXPR_ERR_PREDSIZE;
+            }
+            --top;
+        } else {
+            return ALDO_HEXPR_ERR_PRED;
+        }
+        pc += opsize;
+    }
+    if (top != 1 || stack[0].op != ALDO_HOP_END) return ALDO_HEXPR_ERR_PRED;
+    auto count = snprintf(buf, size, "%s", stack[0].text);
+    if (count < 0) return ALDO_HEXPR_ERR_FMT;
+    if ((size_t)count >= size) return ALDO_HEXPR_ERR_PREDSIZE;
+    return count;
+}
+
+// append " && <predicate>" to a formatted halt condition
+static int append_predicate(const struct aldo_haltexpr *expr, int count,
+                            char buf[restrict static AldoHexprFmtSize])
+{
+    if (count < 0 || expr->predicate[0] == ALDO_HOP_END) return count;
+
+    if (count > 0) {
+        auto sep = snprintf(buf + count, AldoHexprFmtSize - (size_t)count,
+                            " %s ", AndToken);
+        if (sep < 0) return ALDO_HEXPR_ERR_FMT;
+        count += sep;
+        if ((size_t)count >= AldoHexprFmtSize) return ALDO_HEXPR_ERR_PREDSIZE;
+    }
+    auto pred = format_predicate(expr->predicate, buf + count,
+                                 AldoHexprFmtSize - (size_t)count);
+    return pred < 0 ? pred : count + pred;
+}
 
+// [v]r@XXXX[-XXXX], [v]w@XXXX[-XXXX], [v]rw@XXXX[-XXXX]
+static bool parse_watch(const char *restrict str,
+                        enum aldo_haltcondition cond,
+                        struct aldo_haltexpr *expr, bool *valid)
+{
+    char kind[4];
+    unsigned int low, high;
+    int n = 0;
+    if (sscanf(str, " %3[RrWwVv]@%X%n", kind, &low, &n) < 2 || n == 0) {
+        return false;
+    }
+    for (auto c = kind; *c; ++c) {
+        *c = (char)tolower((unsigned char)*c);
+    }
+    auto vram = kind[0] == ALDO_HEXPR_VRAM_IND[0];
+    if (strcmp(kind + vram, WatchKinds[cond - ALDO_HLT_READ]) != 0) {
+        return false;
+    }
+    if (sscanf(str + n, "-%X", &high) < 1) {
+        high = low;
+    }
+    *valid = low <= high
+                && high < (vram ? ALDO_MEMBLOCK_16KB : ALDO_MEMBLOCK_64KB);
+    *expr = (typeof(*expr)){
+        .watch = {(uint16_t)low, (uint16_t)high, vram},
+        .cond = cond,
+    };
+    return true;
+}
+
+static int format_watch(const struct aldo_watchrange *watch,
+                        const char *restrict prefix, const char *restrict kind,
+                        const char *restrict sep,
+                        const char *restrict rangesep,
+                        char buf[restrict static AldoHexprFmtSize])
+{
+    auto count = sprintf(buf, "%s%s%s%04X", watch->vram ? prefix : "", kind,
+                         sep, watch->low);
+    if (count < 0 || watch->high == watch->low) return count;
+
+    auto rest = sprintf(buf + count, "%s%04X", rangesep, watch->high);
+    return rest < 0 ? rest : count + rest;
+}
+
+static int parse_condition(const char *restrict str,
+                           struct aldo_haltexpr *expr)
+{
     auto parsed = false;
     auto valid = false;
     char u[2];
@@ -109,6 +451,14 @@ int aldo_haltexpr_parse(const char *restrict str, struct aldo_haltexpr *expr)
             valid = true;
             e = (typeof(e)){.cond = (enum aldo_haltcondition)i};
             break;
+        case ALDO_HLT_READ:
+        case ALDO_HLT_WRITE:
+        case ALDO_HLT_ACCESS:
+            parsed = parse_watch(str, (enum aldo_haltcondition)i, &e, &valid);
+            break;
+        case ALDO_HLT_EXPR:
+            // predicate-only expressions have no condition syntax
+            continue;
         default:
             assert(((void)"INVALID HALT CONDITION", false));
             return ALDO_HEXPR_ERR_COND;
@@ -122,6 +472,81 @@ int aldo_haltexpr_parse(const char *restrict str, struct aldo_haltexpr *expr)
     return ALDO_HEXPR_ERR_SCAN;
 }
 
+static int parse_resetvector(const char *restrict str, int *resetvector)
+{
+    if (!str) return ALDO_HEXPR_ERR_SCAN;
+
+    char u[2];
+    unsigned int addr;
+    bool
+        parsed = sscanf(str, " %1[" ALDO_HEXPR_RST_IND "]%X", u, &addr) == 2,
+        valid = addr < ALDO_MEMBLOCK_64KB;
+    if (parsed) {
+        if (!valid) return ALDO_HEXPR_ERR_VALUE;
+        *resetvector = (int)addr;
+        return 0;
+    }
+    return ALDO_HEXPR_ERR_SCAN;
+}
+
+//
+// MARK: - Public Interface
+//
+
+const char *aldo_haltexpr_errstr(int err)
+{
+    switch (err) {
+#define X(s, v, e) case ALDO_##s: return e;
+        ALDO_HEXPR_ERRCODE_X
+#undef X
+    default:
+        return "UNKNOWN ERR";
+    }
+}
+
+const char *aldo_haltcond_description(enum aldo_haltcondition cond)
+{
+    switch (cond) {
+#define X(s, d) case ALDO_##s: return d;
+        ALDO_HEXPR_COND_X
+#undef X
+    default:
+        return "INVALID CONDITION";
+    }
+}
+
+int aldo_haltexpr_parse(const char *restrict str, struct aldo_haltexpr *expr)
+{
+    assert(expr != nullptr);
+
+    if (!str) return ALDO_HEXPR_ERR_SCAN;
+
+    // the text before the first && is the halt condition, unless it is
+    // itself a predicate in which case the predicate runs every instruction.
+    auto pred = strstr(str, AndToken);
+    auto condlen = pred ? (size_t)(pred - str) : strlen(str);
+    struct aldo_haltexpr e = {};
+    int err;
+    if (strcspn(str, PredicateChars) < condlen) {
+        e.cond = ALDO_HLT_EXPR;
+        err = compile_predicate(str, e.predicate);
+    } else {
+        err = parse_condition(str, &e);
+        if (err == 0 && pred) {
+            err = compile_predicate(pred + strlen(AndToken), e.predicate);
+        }
+    }
+    if (err < 0) return err;
+
+    // reject predicates too long to format back into an expression
+    char buf[AldoHexprFmtSize];
+    err = aldo_haltexpr_desc(&e, buf);
+    if (err < 0) return err;
+
+    *expr = e;
+    return 0;
+}
+
 int aldo_haltexpr_parse_dbg(const char *restrict str,
                             struct aldo_debugexpr *expr)
 {
@@ -136,8 +561,13 @@ int aldo_haltexpr_parse_dbg(const char *restrict str,
         };
     } else {
         int resetvector;
-        err = parse_resetvector(str, &resetvector);
-        if (err < 0) return err;
+        auto rerr = parse_resetvector(str, &resetvector);
+        if (rerr < 0) {
+            // only expressions starting with the reset indicator report
+            // reset vector errors.
+            auto start = str ? str + strspn(str, " \t\n\v\f\r") : str;
+            return start && *start == ALDO_HEXPR_RST_IND[0] ? rerr : err;
+        }
         *expr = (typeof(*expr)){
             .resetvector = resetvector,
             .type = ALDO_DBG_EXPR_RESET,
@@ -172,6 +602,17 @@ int aldo_haltexpr_desc(const struct aldo_haltexpr *expr,
     case ALDO_HLT_JAM:
         count = sprintf(buf, "CPU JAMMED");
         break;
+    case ALDO_HLT_READ:
+    case ALDO_HLT_WRITE:
+    case ALDO_HLT_ACCESS:
+        count = format_watch(&expr->watch, "VRAM ",
+                             aldo_haltcond_description(expr->cond), " $", "-$",
+                             buf);
+        break;
+    case ALDO_HLT_EXPR:
+        count = 0;
+        buf[0] = '\0';
+        break;
     default:
         assert(((void)"INVALID HALT CONDITION", false));
         return ALDO_HEXPR_ERR_COND;
@@ -179,6 +620,7 @@ int aldo_haltexpr_desc(const struct aldo_haltexpr *expr,
 
     if (count < 0) return ALDO_HEXPR_ERR_FMT;
 
+    count = append_predicate(expr, count, buf);
     assert(count < (int)AldoHexprFmtSize);
     return count;
 }
@@ -210,10 +652,23 @@ int aldo_haltexpr_fmtdbg(const struct aldo_debugexpr *expr,
         case ALDO_HLT_JAM:
             count = sprintf(buf, "JAM");
             break;
+        case ALDO_HLT_READ:
+        case ALDO_HLT_WRITE:
+        case ALDO_HLT_ACCESS:
+            count = format_watch(&hexpr->watch, ALDO_HEXPR_VRAM_IND,
+                                 WatchKinds[hexpr->cond - ALDO_HLT_READ], "@",
+                                 "-", buf);
+            break;
+        case ALDO_HLT_EXPR:
+            count = 0;
+            buf[0] = '\0';
+            break;
         default:
             assert(((void)"INVALID HALT CONDITION", false));
             return ALDO_HEXPR_ERR_COND;
         }
+        if (count < 0) return ALDO_HEXPR_ERR_FMT;
+        count = append_predicate(hexpr, count, buf);
     }
 
     if (count < 0) return ALDO_HEXPR_ERR_FMT;
@@ -18,7 +18,11 @@ X(HLT_ADDR, "Address") \
 X(HLT_TIME, "Time") \
 X(HLT_CYCLES, "Cycles") \
 X(HLT_FRAMES, "Frames") \
-X(HLT_JAM, "Jammed")
+X(HLT_JAM, "Jammed") \
+X(HLT_READ, "Read") \
+X(HLT_WRITE, "Write") \
+X(HLT_ACCESS, "Access") \
+X(HLT_EXPR, "Expression")
 
 enum aldo_haltcondition {
 #define X(s, d) ALDO_##s,
@@ -27,14 +31,72 @@ enum aldo_haltcondition {
     ALDO_HLT_COUNT,
 };
 
+// X(symbol, name)
+#define ALDO_HEXPR_VAR_X \
+X(HVAR_A, "A") \
+X(HVAR_X, "X") \
+X(HVAR_Y, "Y") \
+X(HVAR_P, "P") \
+X(HVAR_S, "S") \
+X(HVAR_PC, "PC") \
+X(HVAR_SCANLINE, "scanline") \
+X(HVAR_DOT, "dot") \
+X(HVAR_HITS, "hits")
+
+enum aldo_hexprvar {
+#define X(s, n) ALDO_##s,
+    ALDO_HEXPR_VAR_X
+#undef X
+    ALDO_HVAR_COUNT,
+};
+
+// Predicate bytecode is postfix; operands push a value and operators
+// pop two values and push the result.
+// X(symbol, token)
+#define ALDO_HEXPR_OP_X \
+X(HOP_END, "") \
+X(HOP_IMM, "") \
+X(HOP_VAR, "") \
+X(HOP_MEM, "") \
+X(HOP_EQ, "==") \
+X(HOP_NE, "!=") \
+X(HOP_LE, "<=") \
+X(HOP_GE, ">=") \
+X(HOP_LT, "<") \
+X(HOP_GT, ">") \
+X(HOP_AND, "&&") \
+X(HOP_OR, "||")
+
+enum aldo_hexprop {
+#define X(s, t) ALDO_##s,
+    ALDO_HEXPR_OP_X
+#undef X
+    ALDO_HOP_COUNT,
+};
+
 #define ALDO_HEXPR_RST_IND "!"
+#define ALDO_HEXPR_VRAM_IND "v"
+
+#include "bridgeopen.h"
+aldo_const size_t AldoHexprCodeSize = 48;
+aldo_const size_t AldoHexprFmtSize = 96;
 
+// A halt condition optionally guarded by a compiled predicate, evaluated
+// only when the condition triggers; an all-zero predicate always passes.
+// Predicate encoding: HOP_IMM + 4-byte little-endian value,
+// HOP_VAR + 1-byte variable, HOP_MEM + 2-byte little-endian address,
+// comparison and logical operators are a single byte.
 struct aldo_haltexpr {
     union {
         uint64_t cycles, frames;
         float runtime;
         uint16_t address;
+        struct aldo_watchrange {
+            uint16_t low, high;     // Inclusive address range
+            bool vram;              // Watch video bus instead of CPU bus
+        } watch;
     };
+    uint8_t predicate[AldoHexprCodeSize];
     enum aldo_haltcondition cond;
 };
 
@@ -54,7 +116,9 @@ struct aldo_debugexpr {
 X(HEXPR_ERR_SCAN, -1, "FORMATTED INPUT FAILURE") \
 X(HEXPR_ERR_VALUE, -2, "INVALID PARSED VALUE") \
 X(HEXPR_ERR_FMT, -3, "FORMATTED OUTPUT FAILURE") \
-X(HEXPR_ERR_COND, -4, "INVALID HALT CONDITION")
+X(HEXPR_ERR_COND, -4, "INVALID HALT CONDITION") \
+X(HEXPR_ERR_PRED, -5, "INVALID PREDICATE") \
+X(HEXPR_ERR_PREDSIZE, -6, "PREDICATE TOO LONG")
 
 enum {
 #define X(s, v, e) ALDO_##s = v,
@@ -62,9 +126,6 @@ enum {
 #undef X
 };
 
-#include "bridgeopen.h"
-aldo_const size_t AldoHexprFmtSize = 25;
-
 aldo_export
 const char *aldo_haltexpr_errstr(int err) aldo_nothrow;
 aldo_export
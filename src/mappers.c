@@ -15,16 +15,20 @@
 
 #include <assert.h>
 #include <stddef.h>
+#include <string.h>
 
 struct raw_mapper {
     struct aldo_mapper vtable;
-    uint8_t *rom;
+    const uint8_t *rom;         // Cart image ROM; Non-owning Pointer
 };
 
 struct ines_mapper {
     struct aldo_nesmapper vtable;
-    uint8_t *prg, *chr, *wram, id;
-    bool chrram, ptstale;
+    const uint8_t *prg, *chr;   // Cart image ROM, or chr aliases chrram;
+                                // Non-owning Pointers
+    uint8_t *chrram, *wram, id;
+    size_t wramsize;
+    bool ptstale;
 };
 
 struct ines_000_mapper {
@@ -34,14 +38,13 @@ struct ines_000_mapper {
     bool hmirroring;
 };
 
-static int load_blocks(uint8_t *restrict *mem, size_t size, FILE *f)
+static int take_blocks(const uint8_t **mem, size_t size,
+                       struct aldo_romspan *rom)
 {
-    if (!(*mem = calloc(size, sizeof **mem))) return ALDO_CART_ERR_ERNO;
-    if (fread(*mem, sizeof **mem, size, f) < size) {
-        if (feof(f)) return ALDO_CART_ERR_EOF;
-        if (ferror(f)) return ALDO_CART_ERR_IO;
-        return ALDO_CART_ERR_UNKNOWN;
-    }
+    if (rom->size < size) return ALDO_CART_ERR_EOF;
+    *mem = rom->mem;
+    rom->mem += size;
+    rom->size -= size;
     return 0;
 }
 
@@ -65,11 +68,13 @@ static void mem_load(uint8_t *restrict d, const uint8_t *restrict mem,
     *d = mem[addr & mask];
 }
 
-// TODO: once we introduce wram or additional mappers this implementation won't
-// be so common anymore.
+// TODO: once we introduce additional mappers this implementation won't be so
+// common anymore.
 static void clear_prg_device(aldo_bus *b)
 {
-    auto r = aldo_bus_clear(b, ALDO_MEMBLOCK_32KB);
+    auto r = aldo_bus_clear(b, AldoWramStartAddr);
+    (void)r, assert(r);
+    r = aldo_bus_clear(b, ALDO_MEMBLOCK_32KB);
     (void)r, assert(r);
 }
 
@@ -107,7 +112,8 @@ static bool raw_prgr(void *restrict ctx, uint16_t addr, uint8_t *restrict d)
     // addr=[$8000-$FFFF]
     assert(addr > ALDO_ADDRMASK_32KB);
 
-    mem_load(d, ctx, addr, ALDO_ADDRMASK_32KB);
+    const struct raw_mapper *m = ctx;
+    mem_load(d, m->rom, addr, ALDO_ADDRMASK_32KB);
     return true;
 }
 
@@ -117,16 +123,15 @@ static size_t raw_prgc(const void *restrict ctx, uint16_t addr, size_t count,
     // addr=[$8000-$FFFF]
     assert(addr > ALDO_ADDRMASK_32KB);
 
-    return aldo_bytecopy_bank(ctx, ALDO_BITWIDTH_32KB, addr, count, dest);
+    const struct raw_mapper *m = ctx;
+    return aldo_bytecopy_bank(m->rom, ALDO_BITWIDTH_32KB, addr, count, dest);
 }
 
 static void raw_dtor(struct aldo_mapper *self)
 {
     assert(self != nullptr);
 
-    auto m = (struct raw_mapper *)self;
-    free(m->rom);
-    free(m);
+    free(self);
 }
 
 static const uint8_t *raw_prgrom(const struct aldo_mapper *self)
@@ -136,6 +141,11 @@ static const uint8_t *raw_prgrom(const struct aldo_mapper *self)
     return ((const struct raw_mapper *)self)->rom;
 }
 
+static ptrdiff_t raw_prgaddr(const struct aldo_mapper *, uint16_t addr)
+{
+    return addr > ALDO_ADDRMASK_32KB ? addr & ALDO_ADDRMASK_32KB : -1;
+}
+
 static bool raw_mbus_connect(struct aldo_mapper *self, aldo_bus *b)
 {
     assert(self != nullptr);
@@ -143,7 +153,7 @@ static bool raw_mbus_connect(struct aldo_mapper *self, aldo_bus *b)
     return aldo_bus_set(b, ALDO_MEMBLOCK_32KB, (struct aldo_busdevice){
         .read = raw_prgr,
         .copy = raw_prgc,
-        .ctx = ((struct raw_mapper *)self)->rom,
+        .ctx = self,
     });
 }
 
@@ -156,8 +166,7 @@ static void ines_dtor(struct aldo_mapper *self)
     assert(self != nullptr);
 
     auto m = (struct ines_mapper *)self;
-    free(m->chr);
-    free(m->prg);
+    free(m->chrram);
     free(m->wram);
     free(m);
 }
@@ -176,6 +185,87 @@ static const uint8_t *ines_chrrom(const struct aldo_mapper *self)
     return ((const struct ines_mapper *)self)->chr;
 }
 
+static size_t ines_ramsize(const struct aldo_mapper *self)
+{
+    assert(self != nullptr);
+
+    auto m = (const struct ines_mapper *)self;
+    return (m->chrram ? ALDO_MEMBLOCK_8KB : 0) + m->wramsize;
+}
+
+static void ines_ramsave(const struct aldo_mapper *self, uint8_t *buf)
+{
+    assert(self != nullptr);
+    assert(buf != nullptr);
+
+    auto m = (const struct ines_mapper *)self;
+    if (m->chrram) {
+        memcpy(buf, m->chr, ALDO_MEMBLOCK_8KB);
+        buf += ALDO_MEMBLOCK_8KB;
+    }
+    if (m->wram) {
+        memcpy(buf, m->wram, m->wramsize);
+    }
+}
+
+static void ines_ramload(struct aldo_mapper *self, const uint8_t *buf)
+{
+    assert(self != nullptr);
+    assert(buf != nullptr);
+
+    auto m = (struct ines_mapper *)self;
+    if (m->chrram) {
+        memcpy(m->chrram, buf, ALDO_MEMBLOCK_8KB);
+        buf += ALDO_MEMBLOCK_8KB;
+        m->ptstale = true;
+    }
+    if (m->wram) {
+        memcpy(m->wram, buf, m->wramsize);
+    }
+}
+
+static bool ines_wramr(void *restrict ctx, uint16_t addr, uint8_t *restrict d)
+{
+    // addr=[$6000-$7FFF]
+    assert(AldoWramStartAddr <= addr && addr < ALDO_MEMBLOCK_32KB);
+
+    const struct ines_mapper *m = ctx;
+    mem_load(d, m->wram, addr, ALDO_ADDRMASK_8KB);
+    return true;
+}
+
+static bool ines_wramw(void *ctx, uint16_t addr, uint8_t d)
+{
+    // addr=[$6000-$7FFF]
+    assert(AldoWramStartAddr <= addr && addr < ALDO_MEMBLOCK_32KB);
+
+    struct ines_mapper *m = ctx;
+    m->wram[addr & ALDO_ADDRMASK_8KB] = d;
+    return true;
+}
+
+static size_t ines_wramc(const void *restrict ctx, uint16_t addr, size_t count,
+                         uint8_t dest[restrict count])
+{
+    // addr=[$6000-$7FFF]
+    assert(AldoWramStartAddr <= addr && addr < ALDO_MEMBLOCK_32KB);
+
+    const struct ines_mapper *m = ctx;
+    return aldo_bytecopy_bank(m->wram, ALDO_BITWIDTH_8KB, addr, count, dest);
+}
+
+// bind the first 8KB WRAM bank, if any, to $6000
+static bool ines_wram_connect(struct ines_mapper *self, aldo_bus *b)
+{
+    if (!self->wram) return true;
+    return aldo_bus_set(b, AldoWramStartAddr, (struct aldo_busdevice){
+        .read = ines_wramr,
+        .write = ines_wramw,
+        .copy = ines_wramc,
+        .ctx = self,
+    });
+}
+
 static bool ines_unimplemented_mbus_connect(struct aldo_mapper *, aldo_bus *b)
 {
     clear_prg_device(b);
@@ -219,6 +309,19 @@ static size_t ines_000_prgc(const void *restrict ctx, uint16_t addr,
     return aldo_bytecopy_bank(m->super.prg, width, addr, count, dest);
 }
 
+static ptrdiff_t ines_000_prgaddr(const struct aldo_mapper *self,
+                                  uint16_t addr)
+{
+    assert(self != nullptr);
+
+    if (addr <= ALDO_ADDRMASK_32KB) return -1;
+
+    auto m = (const struct ines_000_mapper *)self;
+    return addr & (m->blockcount == 2
+                   ? ALDO_ADDRMASK_32KB
+                   : ALDO_ADDRMASK_16KB);
+}
+
 static bool ines_000_chrr(void *restrict ctx, uint16_t addr,
                            uint8_t *restrict d)
 {
@@ -230,13 +333,23 @@ static bool ines_000_chrr(void *restrict ctx, uint16_t addr,
     return true;
 }
 
+static ptrdiff_t ines_000_chraddr(const struct aldo_mapper *self,
+                                  uint16_t addr)
+{
+    assert(self != nullptr);
+
+    if (((const struct ines_mapper *)self)->chrram
+        || addr > ALDO_ADDRMASK_8KB) return -1;
+    return addr;
+}
+
 static bool ines_000_chrw(void *ctx, uint16_t addr, uint8_t d)
 {
     // addr=[$0000-$1FFF]
     assert(addr < ALDO_MEMBLOCK_8KB);
 
     struct ines_mapper *m = ctx;
-    m->chr[addr & ALDO_ADDRMASK_8KB] = d;
+    m->chrram[addr & ALDO_ADDRMASK_8KB] = d;
     m->ptstale = true;
     return true;
 }
@@ -274,19 +387,20 @@ static size_t ines_000_vrmc(const void *restrict ctx, uint16_t addr,
     return m->vrbd.copy(m->vrbd.ctx, addr, count, dest);
 }
 
-// TODO: binding to $8000 is too simple; WRAM needs at least $6000, and the
-// CPU memory map defines start of cart mapping at $4020; the most complex
-// mappers need access to entire 64KB address space in order to snoop on
-// all CPU activity. Similar rules hold for PPU.
+// TODO: binding to $6000 and $8000 is too simple; the CPU memory map defines
+// start of cart mapping at $4020; the most complex mappers need access to
+// entire 64KB address space in order to snoop on all CPU activity. Similar
+// rules hold for PPU.
 static bool ines_000_mbus_connect(struct aldo_mapper *self, aldo_bus *b)
 {
     assert(self != nullptr);
 
-    return aldo_bus_set(b, ALDO_MEMBLOCK_32KB, (struct aldo_busdevice){
-        .read = ines_000_prgr,
-        .copy = ines_000_prgc,
-        .ctx = self,
-    });
+    return ines_wram_connect((struct ines_mapper *)self, b)
+        && aldo_bus_set(b, ALDO_MEMBLOCK_32KB, (struct aldo_busdevice){
+            .read = ines_000_prgr,
+            .copy = ines_000_prgc,
+            .ctx = self,
+        });
 }
 
 static bool ines_000_vbus_connect(struct aldo_mapper *self, aldo_bus *b)
@@ -353,10 +467,10 @@ static void ines_000_snapshot(struct aldo_mapper *self,
 // MARK: - Public Interface
 //
 
-int aldo_mapper_raw_create(struct aldo_mapper **m, FILE *f)
+int aldo_mapper_raw_create(struct aldo_mapper **m, struct aldo_romspan *rom)
 {
     assert(m != nullptr);
-    assert(f != nullptr);
+    assert(rom != nullptr);
 
     struct raw_mapper *self = malloc(sizeof *self);
     if (!self) return ALDO_CART_ERR_ERNO;
@@ -365,13 +479,14 @@ int aldo_mapper_raw_create(struct aldo_mapper **m, FILE *f)
         .vtable = {
             .dtor = raw_dtor,
             .prgrom = raw_prgrom,
+            .prgaddr = raw_prgaddr,
             .mbus_connect = raw_mbus_connect,
             .mbus_disconnect = clear_prg_device,
         },
     };
 
     // TODO: assume a 32KB ROM file (can i do mirroring later?)
-    auto err = load_blocks(&self->rom, ALDO_MEMBLOCK_32KB, f);
+    auto err = take_blocks(&self->rom, ALDO_MEMBLOCK_32KB, rom);
     if (err == 0) {
         *m = (struct aldo_mapper *)self;
     } else {
@@ -381,11 +496,12 @@ int aldo_mapper_raw_create(struct aldo_mapper **m, FILE *f)
 }
 
 int aldo_mapper_ines_create(struct aldo_mapper **m,
-                            struct aldo_ines_header *header, FILE *f)
+                            struct aldo_ines_header *header,
+                            struct aldo_romspan *rom)
 {
     assert(m != nullptr);
     assert(header != nullptr);
-    assert(f != nullptr);
+    assert(rom != nullptr);
 
     struct ines_mapper *self;
     if (header->mapper_id == 0) {
@@ -394,16 +510,26 @@ int aldo_mapper_ines_create(struct aldo_mapper **m,
 
         *self = (typeof(*self)){
             .vtable = {
-                .extends = {.mbus_connect = ines_000_mbus_connect},
+                .extends = {
+                    .mbus_connect = ines_000_mbus_connect,
+                    .prgaddr = ines_000_prgaddr,
+                },
                 .vbus_connect = ines_000_vbus_connect,
                 .vbus_disconnect = ines_000_vbus_disconnect,
                 .snapshot = ines_000_snapshot,
+                .chraddr = ines_000_chraddr,
             },
         };
         assert(header->prg_blocks <= 2);
         auto m = (struct ines_000_mapper *)self;
         m->blockcount = header->prg_blocks;
         m->hmirroring = header->mirror == ALDO_NTM_HORIZONTAL;
+        // iNES 1.0 has no reliable PRG RAM flag (byte 6 bit 1 only marks
+        // battery backing) so NROM always gets a bank at $6000, which is
+        // where test ROMs report their status.
+        if (header->wram_blocks == 0) {
+            header->wram_blocks = 1;
+        }
         header->mapper_implemented = true;
     } else {
         if (!(self = malloc(sizeof *self))) return ALDO_CART_ERR_ERNO;
@@ -421,6 +547,9 @@ int aldo_mapper_ines_create(struct aldo_mapper **m,
     base->dtor = ines_dtor;
     base->prgrom = ines_prgrom;
     base->mbus_disconnect = clear_prg_device;
+    base->ramsize = ines_ramsize;
+    base->ramsave = ines_ramsave;
+    base->ramload = ines_ramload;
     if (header->chr_blocks > 0) {
         self->vtable.chrrom = ines_chrrom;
     }
@@ -430,13 +559,12 @@ int aldo_mapper_ines_create(struct aldo_mapper **m,
     int err;
     if (header->trainer) {
         // skip 512 bytes of trainer data
-        if (fseek(f, 512, SEEK_CUR) != 0) {
-            err = ALDO_CART_ERR_ERNO;
-            goto cleanup;
-        }
+        const uint8_t *trainer;
+        err = take_blocks(&trainer, 512, rom);
+        if (err < 0) goto cleanup;
     }
 
-    if (header->wram) {
+    if (header->wram || header->wram_blocks > 0) {
         size_t sz = (header->wram_blocks == 0
                      ? 1
                      : header->wram_blocks) * ALDO_MEMBLOCK_8KB;
@@ -444,20 +572,24 @@ int aldo_mapper_ines_create(struct aldo_mapper **m,
             err = ALDO_CART_ERR_ERNO;
             goto cleanup;
         }
+        self->wramsize = sz;
     }
 
-    err = load_blocks(&self->prg, header->prg_blocks * ALDO_MEMBLOCK_16KB, f);
+    err = take_blocks(&self->prg, header->prg_blocks * ALDO_MEMBLOCK_16KB,
+                      rom);
     if (err < 0) goto cleanup;
 
     if (header->chr_blocks == 0) {
         // TODO: this size is controlled by the mapper in many cases
-        if (!(self->chr = calloc(ALDO_MEMBLOCK_8KB, sizeof *self->chr))) {
+        if (!(self->chrram = calloc(ALDO_MEMBLOCK_8KB,
+                                    sizeof *self->chrram))) {
             err = ALDO_CART_ERR_ERNO;
             goto cleanup;
         }
-        self->chrram = true;
+        self->chr = self->chrram;
     } else {
-        err = load_blocks(&self->chr, header->chr_blocks * ALDO_MEMBLOCK_8KB, f);
+        err = take_blocks(&self->chr, header->chr_blocks * ALDO_MEMBLOCK_8KB,
+                          rom);
     }
 
 cleanup:
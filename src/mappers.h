@@ -11,21 +11,41 @@
 #include "bustype.h"
 #include "cart.h"
 
+#include <stddef.h>
 #include <stdint.h>
-#include <stdio.h>
 #include <stdlib.h>
 
 struct aldo_mapper;
 struct aldo_snapshot;
+
+// Unread remainder of a cart image; mappers take ROM blocks from the front
+// and point straight into the image, which must outlive the mapper.
+struct aldo_romspan {
+    const uint8_t *mem;
+    size_t size;
+};
+
 typedef bool aldo_busconn(struct aldo_mapper *, aldo_bus *);
 typedef void aldo_busdisconn(aldo_bus *);
 typedef const uint8_t *aldo_mapper_rom(const struct aldo_mapper *);
+typedef ptrdiff_t aldo_mapper_prgaddr(const struct aldo_mapper *, uint16_t);
+typedef ptrdiff_t aldo_mapper_chraddr(const struct aldo_mapper *, uint16_t);
+typedef size_t aldo_mapper_ramsize(const struct aldo_mapper *);
+typedef void aldo_mapper_ramsave(const struct aldo_mapper *, uint8_t *);
+typedef void aldo_mapper_ramload(struct aldo_mapper *, const uint8_t *);
 
 struct aldo_mapper {
     void (*dtor)(struct aldo_mapper *);
     aldo_busconn *mbus_connect;
     aldo_busdisconn *mbus_disconnect;
     aldo_mapper_rom *prgrom;
+    // Optional Interface
+    // PRG ROM offset currently mapped to a CPU address, < 0 if unmapped
+    aldo_mapper_prgaddr *prgaddr;
+    // Writable cart memory (CHR RAM, WRAM) saved and loaded as one block
+    aldo_mapper_ramsize *ramsize;
+    aldo_mapper_ramsave *ramsave;
+    aldo_mapper_ramload *ramload;
 };
 
 struct aldo_nesmapper {
@@ -35,11 +55,14 @@ struct aldo_nesmapper {
     aldo_mapper_rom *chrrom;
     // Optional Interface
     void (*snapshot)(struct aldo_mapper *, struct aldo_snapshot *);
+    // CHR ROM offset currently mapped to a PPU address, < 0 if unmapped
+    aldo_mapper_chraddr *chraddr;
 };
 
 // if create functions return non-zero error code, *m is unmodified
-int aldo_mapper_raw_create(struct aldo_mapper **m, FILE *f);
+int aldo_mapper_raw_create(struct aldo_mapper **m, struct aldo_romspan *rom);
 int aldo_mapper_ines_create(struct aldo_mapper **m,
-                            struct aldo_ines_header *header, FILE *f);
+                            struct aldo_ines_header *header,
+                            struct aldo_romspan *rom);
 
 #endif
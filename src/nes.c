@@ -10,15 +10,28 @@
 #include "apu.h"
 #include "bus.h"
 #include "bytes.h"
+#include "callgraph.h"
+#include "cdl.h"
 #include "cpu.h"
 #include "cycleclock.h"
 #include "ppu.h"
+#include "profile.h"
+#include "rewind.h"
 #include "snapshot.h"
 #include "trace.h"
+#include "tsutil.h"
 
 #include <assert.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+constexpr int InstLens[] = {
+#define X(s, b, ...) b,
+    ALDO_DEC_ADDRMODE_X
+#undef X
+};
 
 constexpr auto ScreenWidth = 256;
 constexpr auto ScreenHeight = 240;
@@ -29,7 +42,15 @@ struct aldo_nes001 {
     aldo_cart *cart;            // Game Cartridge; Non-owning Pointer
     aldo_debugger *dbg;         // Debugger Context; Non-owning Pointer
     struct aldo_snapshot *snp;  // Console Snapshot; Non-owning Pointer
+    aldo_profiler *prof;        // Optional profiler; Non-owning Pointer
+    aldo_callgraph *cg;         // Optional call graph; Non-owning Pointer
+    aldo_cdl *cdl;              // Optional code/data log; Non-owning Pointer
+    aldo_rewind *rw;            // Optional rewind history; Non-owning Pointer
     FILE *tracelog;             // Optional trace log; Non-owning Pointer
+    aldo_tracehook *tracehook;  // Optional trace line hook
+    void *tracectx;             // Trace hook context; Non-owning Pointer
+    aldo_framehook *framehook;  // Optional completed frame hook
+    void *framectx;             // Frame hook context; Non-owning Pointer
     size_t vbuf;                // Current video buffer to fill
     struct aldo_rp2a03 apu;     // RP2A03 Microprocessor
     struct aldo_rp2c02 ppu;     // RP2C02 PPU
@@ -41,12 +62,20 @@ struct aldo_nes001 {
             rdy: 1,                     // RDY Probe
             rst: 1;                     // RESET Probe
     } probe;                            // Interrupt Input Probes (active high)
+    struct {
+        uint64_t
+            dots,                       // PPU dots since powerup
+            syncs[2],                   // Dots at last two instruction fetches
+            frames[2];                  // Dots at last two frame ends
+    } pos;                              // Rewind Position Marks
     bool
         halted,                         // Whether the emulator is suspended
+        pinpending,                     // Inputs changed, pin a checkpoint
         tracefailed;                    // Trace log I/O failed during run
     uint8_t ram[ALDO_MEMBLOCK_2KB],     // CPU Internal RAM
             vram[ALDO_MEMBLOCK_2KB],    // PPU Internal RAM
-            vbufs[2][ScreenWidth * ScreenHeight];   // Double-buffered Video
+            vbufs[2][ScreenWidth * ScreenHeight],   // Double-buffered Video
+            vmasks[2][ScreenHeight];    // PPUMASK at start of each line
 };
 
 static void mem_load(uint8_t *restrict d, const uint8_t *restrict mem,
@@ -132,13 +161,15 @@ static bool create_mbus(struct aldo_nes001 *self)
      *   $0000 - $1FFF: 2KB RAM mirrored to 8KB
      *   $2000 - $3FFF: 8 PPU registers mirrored to 8KB
      *   $4000 - $401F: APU, DMA, Joypads, unused processor test functionality
-     *   $4020 - $7FFF: unmapped
+     *   $4020 - $5FFF: unmapped
+     *   $6000 - $7FFF: 8KB Cart WRAM
      *   $8000 - $FFFF: 32KB Cart
      */
-    self->apu.cpu.mbus = aldo_bus_new(ALDO_BITWIDTH_64KB, 5,
+    self->apu.cpu.mbus = aldo_bus_new(ALDO_BITWIDTH_64KB, 6,
                                       ALDO_MEMBLOCK_8KB,
                                       ALDO_MEMBLOCK_16KB,
                                       ALDO_MEMBLOCK_16KB + 0x20,
+                                      AldoWramStartAddr,
                                       ALDO_MEMBLOCK_32KB);
     if (!self->apu.cpu.mbus) return false;
 
@@ -217,12 +248,14 @@ static bool setup(struct aldo_nes001 *self)
     if (!create_vbus(self)) return false;
     aldo_ppu_connect(&self->ppu, self->apu.cpu.mbus);
     aldo_debug_cpu_connect(self->dbg, &self->apu.cpu);
+    aldo_debug_ppu_connect(self->dbg, &self->ppu);
     return true;
 }
 
 static void teardown(struct aldo_nes001 *self)
 {
     disconnect_cart(self);
+    aldo_debug_ppu_disconnect(self->dbg);
     aldo_debug_cpu_disconnect(self->dbg);
     aldo_bus_free(self->ppu.vbus);
     aldo_bus_free(self->apu.cpu.mbus);
@@ -245,6 +278,10 @@ static void set_screen_dot(struct aldo_nes001 *self)
     auto screendot = (size_t)(c.dot + (c.line * ScreenWidth));
     assert(screendot < aldo_arrsz(self->vbufs[self->vbuf]));
     self->vbufs[self->vbuf][screendot] = self->ppu.pxpl.px;
+    if (c.dot == 0) {
+        assert((size_t)c.line < aldo_arrsz(self->vmasks[self->vbuf]));
+        self->vmasks[self->vbuf][c.line] = aldo_ppu_mask(&self->ppu);
+    }
 }
 
 static void set_cpu_pins(struct aldo_nes001 *self)
@@ -285,6 +322,7 @@ static void snapshot_screen(struct aldo_nes001 *self)
     assert(self->snp->video != nullptr);
 
     self->snp->video->screen = self->vbufs[!self->vbuf];
+    self->snp->video->linemasks = self->vmasks[!self->vbuf];
     self->snp->video->newframe = true;
 }
 
@@ -298,6 +336,15 @@ static void snapshot_video(struct aldo_nes001 *self, bool framedone)
     }
 }
 
+// refresh video snapshots skipped during a run that ended early
+static void catchup_video(struct aldo_nes001 *self, bool framedone)
+{
+    snapshot_gfx(self);
+    if (framedone) {
+        snapshot_screen(self);
+    }
+}
+
 static void snapshot_sys(struct aldo_nes001 *self)
 {
     auto snp = self->snp;
@@ -336,26 +383,125 @@ static void init_snapshot(struct aldo_nes001 *self)
 static void instruction_trace(struct aldo_nes001 *self,
                               const struct aldo_clock *clock, int adjustment)
 {
-    if (!self->tracelog || self->tracefailed
+    if (!(self->tracelog || self->tracehook) || self->tracefailed
         || !self->apu.cpu.signal.sync) return;
 
     struct aldo_snapshot snp = {};
     snapshot_bus(self, &snp);
     // Trace the cycle/pixel count up to the current instruction so
     // do NOT count the just-executed instruction fetch cycle.
-    self->tracefailed = !aldo_trace_line(self->tracelog, adjustment,
-                                         clock->cycles, &self->apu.cpu,
-                                         &self->ppu, self->dbg, &snp);
+    char line[AldoTraceLineSize];
+    if (aldo_trace_format(adjustment, clock->cycles, &self->apu.cpu,
+                          &self->ppu, self->dbg, &snp, line) < 0) {
+        self->tracefailed = true;
+        return;
+    }
+    if (self->tracelog && fputs(line, self->tracelog) < 0) {
+        self->tracefailed = true;
+    }
+    if (self->tracehook && !self->tracehook(self->tracectx, line)) {
+        aldo_nes_halt(self, true);
+    }
 }
 
-static bool clock_ppu(struct aldo_nes001 *self, struct aldo_clock *clock)
+static void log_cpu_read(struct aldo_nes001 *self)
 {
+    auto cpu = &self->apu.cpu;
+    if (aldo_cpu_suspended(cpu)) {
+        // OAM DMA read; suspended CPU only repeats its last read
+        if (self->apu.oam.s == ALDO_SIG_COMMITTED) {
+            auto addr = self->apu.addrbus;
+            aldo_cdl_cpuread(self->cdl, addr,
+                             aldo_cart_prgaddr(self->cart, addr),
+                             ALDO_CDL_DATA);
+        }
+        return;
+    }
+    if (!cpu->signal.rw) return;
+
+    auto addr = cpu->addrbus;
+    auto prgaddr = aldo_cart_prgaddr(self->cart, addr);
+    auto mode = Aldo_Decode[cpu->opc].mode;
+    if (cpu->signal.sync) {
+        aldo_cdl_opcode(self->cdl, addr, prgaddr, mode == ALDO_AM_JIND);
+        return;
+    }
+    if (prgaddr < 0) return;
+
+    if ((uint16_t)(addr - cpu->addrinst) < InstLens[mode]) {
+        aldo_cdl_cpuread(self->cdl, addr, prgaddr, ALDO_CDL_CODE);
+        return;
+    }
+    // only count effective-address reads as data, skipping the dummy
+    // reads of implied, stack, and branch instructions.
+    switch (mode) {
+    case ALDO_AM_INDX:
+    case ALDO_AM_INDY:
+        aldo_cdl_cpuread(self->cdl, addr, prgaddr,
+                         ALDO_CDL_DATA | ALDO_CDL_INDDATA);
+        break;
+    case ALDO_AM_ZP:
+    case ALDO_AM_ZPX:
+    case ALDO_AM_ZPY:
+    case ALDO_AM_ABS:
+    case ALDO_AM_ABSX:
+    case ALDO_AM_ABSY:
+    case ALDO_AM_JIND:
+        aldo_cdl_cpuread(self->cdl, addr, prgaddr, ALDO_CDL_DATA);
+        break;
+    case ALDO_AM_BRK:
+        if (addr >= ALDO_CPU_VECTOR_NMI) {
+            aldo_cdl_cpuread(self->cdl, addr, prgaddr, ALDO_CDL_DATA);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void log_ppu_read(struct aldo_nes001 *self, bool cpuvram)
+{
+    if (self->ppu.signal.rd) return;
+
+    // a completed CPU VRAM operation is a PPUDATA read
+    aldo_cdl_ppuread(self->cdl,
+                     aldo_cart_chraddr(self->cart, self->ppu.vaddrbus),
+                     cpuvram && !self->ppu.cvp
+                        ? ALDO_CDL_READ
+                        : ALDO_CDL_RENDERED);
+}
+
+// advance the PPU one dot, returning whether it finished a frame
+static bool cycle_ppu(struct aldo_nes001 *self, struct aldo_clock *clock)
+{
+    auto cpuvram = self->cdl && self->ppu.cvp;
     auto framedone = aldo_ppu_cycle(&self->ppu);
+    if (self->cdl && self->cart) {
+        log_ppu_read(self, cpuvram);
+    }
+    ++self->pos.dots;
     clock->frames += (uint64_t)framedone;
-    --clock->budget;
+    if (framedone) {
+        self->pos.frames[1] = self->pos.frames[0];
+        self->pos.frames[0] = self->pos.dots;
+    }
+    if (framedone && self->cg) {
+        aldo_callgraph_frame(self->cg);
+    }
     set_ppu_pins(self);
     set_screen_dot(self);
     self->vbuf ^= framedone;
+    if (framedone && self->framehook
+        && !self->framehook(self->framectx, self->vbufs[!self->vbuf])) {
+        aldo_nes_halt(self, true);
+    }
+    return framedone;
+}
+
+static bool clock_ppu(struct aldo_nes001 *self, struct aldo_clock *clock)
+{
+    auto framedone = cycle_ppu(self, clock);
+    --clock->budget;
     snapshot_video(self, framedone);
     // TODO: ppu debug hook goes here
     if (++clock->subcycle < Aldo_PpuRatio) {
@@ -367,14 +513,76 @@ static bool clock_ppu(struct aldo_nes001 *self, struct aldo_clock *clock)
     return true;
 }
 
-static void clock_cpu(struct aldo_nes001 *self, struct aldo_clock *clock)
+static enum aldo_cgevent call_event(const struct aldo_mos6502 *cpu)
+{
+    // interrupts are serviced as a BRK instruction
+    if (cpu->opc == Aldo_BrkOpcode) {
+        if (cpu->rst == ALDO_SIG_COMMITTED) return ALDO_CGE_RESET;
+        if (cpu->nmi == ALDO_SIG_COMMITTED) return ALDO_CGE_NMI;
+        if (cpu->irq == ALDO_SIG_COMMITTED) return ALDO_CGE_IRQ;
+        return ALDO_CGE_BRK;
+    }
+    switch (Aldo_Decode[cpu->opc].instruction) {
+    case ALDO_IN_JSR:
+        return ALDO_CGE_CALL;
+    case ALDO_IN_RTI:
+    case ALDO_IN_RTS:
+        return ALDO_CGE_RETURN;
+    default:
+        return ALDO_CGE_NONE;
+    }
+}
+
+// attribute cycles to the current instruction and routine; DMA and
+// interrupt cycles count against the instruction they interrupted.
+static void profile_cycles(struct aldo_nes001 *self, int cycles)
+{
+    auto cpu = &self->apu.cpu;
+    if (cpu->signal.sync) {
+        if (self->prof) {
+            aldo_profile_exec(self->prof, cpu->addrinst,
+                              self->cart
+                                ? aldo_cart_prgaddr(self->cart,
+                                                    cpu->addrinst)
+                                : Aldo_NoPrgAddr);
+        }
+        if (self->cg) {
+            aldo_callgraph_exec(self->cg, cpu->addrinst, cpu->s,
+                                call_event(cpu));
+        }
+    }
+    if (self->prof) {
+        aldo_profile_cycles(self->prof, cycles);
+    }
+    if (self->cg) {
+        aldo_callgraph_cycles(self->cg, cycles);
+    }
+}
+
+// advance the CPU one cycle, returning the cycles counted (0 or 1);
+// tracing is left to the caller.
+static int cycle_cpu(struct aldo_nes001 *self, struct aldo_clock *clock)
 {
     auto cycles = aldo_apu_cycle(&self->apu);
     set_cpu_pins(self);
     clock->subcycle = 0;
     clock->cycles += (uint64_t)cycles;
-    instruction_trace(self, clock, -cycles);
+    if (self->apu.cpu.signal.sync) {
+        self->pos.syncs[1] = self->pos.syncs[0];
+        self->pos.syncs[0] = self->pos.dots;
+    }
+    if (self->prof || self->cg) {
+        profile_cycles(self, cycles);
+    }
+    if (self->cdl && self->cart) {
+        log_cpu_read(self);
+    }
+    return cycles;
+}
 
+static void clock_cpu(struct aldo_nes001 *self, struct aldo_clock *clock)
+{
+    instruction_trace(self, clock, -cycle_cpu(self, clock));
     switch (self->mode) {
     // both cases are possible on cycle-boundary
     case ALDO_EXC_SUBCYCLE:
@@ -392,6 +600,292 @@ static void clock_cpu(struct aldo_nes001 *self, struct aldo_clock *clock)
     }
 }
 
+//
+// MARK: - Rewinding
+//
+
+// Console state at a position in the rewind history; the cart's writable
+// memory trails the console since its size depends on the cart.
+struct nes_checkpoint {
+    struct aldo_nes001 nes;
+    uint64_t cycles, frames;
+    uint8_t subcycle;
+    uint8_t cart[];
+};
+
+static size_t checkpoint_size(struct aldo_nes001 *self)
+{
+    return sizeof(struct nes_checkpoint)
+            + (self->cart ? aldo_cart_ramsize(self->cart) : 0);
+}
+
+static void fill_checkpoint(struct aldo_nes001 *self,
+                            const struct aldo_clock *clock,
+                            struct nes_checkpoint *cp)
+{
+    cp->nes = *self;
+    cp->cycles = clock->cycles;
+    cp->frames = clock->frames;
+    cp->subcycle = clock->subcycle;
+    if (self->cart) {
+        aldo_cart_ramsave(self->cart, cp->cart);
+    }
+}
+
+static void save_checkpoint(struct aldo_nes001 *self,
+                            const struct aldo_clock *clock, bool pinned)
+{
+    struct nes_checkpoint *cp = aldo_rewind_save(self->rw, self->pos.dots,
+                                                 checkpoint_size(self),
+                                                 pinned);
+    // out of memory only costs rewind history, so keep running
+    if (!cp) return;
+
+    fill_checkpoint(self, clock, cp);
+}
+
+static void restore_checkpoint(struct aldo_nes001 *self,
+                               const struct nes_checkpoint *cp,
+                               struct aldo_clock *clock)
+{
+    // attachments, mode, and host-side state stay as they are
+    auto nes = &cp->nes;
+    self->vbuf = nes->vbuf;
+    self->apu = nes->apu;
+    self->ppu = nes->ppu;
+    self->probe = nes->probe;
+    self->pos = nes->pos;
+    memcpy(self->ram, nes->ram, sizeof self->ram);
+    memcpy(self->vram, nes->vram, sizeof self->vram);
+    memcpy(self->vbufs, nes->vbufs, sizeof self->vbufs);
+    memcpy(self->vmasks, nes->vmasks, sizeof self->vmasks);
+    clock->cycles = cp->cycles;
+    clock->frames = cp->frames;
+    clock->subcycle = cp->subcycle;
+    if (self->cart) {
+        aldo_cart_ramload(self->cart, cp->cart);
+    }
+}
+
+// Replay from the restored checkpoint up to target dot, returning the
+// last dot a breakpoint hit on; profiling, logging, tracing, and frame
+// hooks already saw this history so they are suspended for the replay.
+static uint64_t replay(struct aldo_nes001 *self, struct aldo_clock *clock,
+                       uint64_t target, bool *hit)
+{
+    auto prof = self->prof;
+    auto cg = self->cg;
+    auto cdl = self->cdl;
+    auto tracelog = self->tracelog;
+    auto tracehook = self->tracehook;
+    auto framehook = self->framehook;
+    auto snp = self->snp;
+    auto mode = self->mode;
+    auto budget = clock->budget;
+    self->prof = nullptr;
+    self->cg = nullptr;
+    self->cdl = nullptr;
+    self->tracelog = nullptr;
+    self->tracehook = nullptr;
+    self->framehook = nullptr;
+    self->snp = nullptr;
+    self->mode = ALDO_EXC_RUN;
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    auto from = self->pos.dots;
+    uint64_t lasthit = 0;
+    auto debugging = hit && aldo_debug_armed(self->dbg);
+    aldo_debug_set_replay(self->dbg, true);
+    while (self->pos.dots < target) {
+        if (!clock_ppu(self, clock)) continue;
+        clock_cpu(self, clock);
+        if (debugging && aldo_debug_break(self->dbg, clock)) {
+            lasthit = self->pos.dots;
+            *hit = true;
+        }
+    }
+    aldo_debug_set_replay(self->dbg, false);
+    auto elapsed = aldo_elapsed(&start);
+    aldo_rewind_replayed(self->rw, self->pos.dots - from,
+                         aldo_timespec_to_ms(&elapsed));
+
+    self->prof = prof;
+    self->cg = cg;
+    self->cdl = cdl;
+    self->tracelog = tracelog;
+    self->tracehook = tracehook;
+    self->framehook = framehook;
+    self->snp = snp;
+    self->mode = mode;
+    clock->budget = budget;
+    return lasthit;
+}
+
+static bool rewind_to(struct aldo_nes001 *self, struct aldo_clock *clock,
+                      uint64_t target)
+{
+    uint64_t at;
+    const struct nes_checkpoint *cp = aldo_rewind_find(self->rw, target, &at);
+    if (!cp) return false;
+
+    restore_checkpoint(self, cp, clock);
+    replay(self, clock, target, nullptr);
+    return true;
+}
+
+static void rewind_done(struct aldo_nes001 *self)
+{
+    aldo_rewind_truncate(self->rw, self->pos.dots);
+    aldo_nes_halt(self, true);
+    init_snapshot(self);
+}
+
+// the previous mark before the current position
+static uint64_t prev_mark(const struct aldo_nes001 *self,
+                          const uint64_t marks[static 2])
+{
+    return marks[0] < self->pos.dots ? marks[0] : marks[1];
+}
+
+//
+// MARK: - Run Loops
+//
+
+// Full-speed run loops, one per combination of tracing (t), snapshots (s),
+// and breakpoints (d); these are fixed for the length of a clock call so
+// each variant's checks compile away instead of branching every dot.
+// Video snapshots are only taken within the last frame's worth of budget,
+// as any frame completed before that is replaced before the run returns;
+// a run that halts before its window takes its graphics snapshot catches
+// up on the way out.
+typedef void run_loop_fn(struct aldo_nes001 *, struct aldo_clock *);
+
+#define RUN_LOOP(t, s, d) \
+static void run_loop_##t##s##d(struct aldo_nes001 *self, \
+                               struct aldo_clock *clock) \
+{ \
+    bool skipped = false, frameskipped = false; \
+    while (clock->budget > 0 && !aldo_nes_halted(self)) { \
+        auto framedone = cycle_ppu(self, clock); \
+        --clock->budget; \
+        if (s) { \
+            if (clock->budget < Aldo_DotsPerFrame) { \
+                if (frameskipped) { \
+                    snapshot_screen(self); \
+                    frameskipped = false; \
+                } \
+                skipped &= !aldo_ppu_gfxsnp_dot(&self->ppu); \
+                snapshot_video(self, framedone); \
+            } else { \
+                skipped = true; \
+                frameskipped |= framedone; \
+            } \
+        } \
+        if (++clock->subcycle < Aldo_PpuRatio) continue; \
+\
+        auto cycles = cycle_cpu(self, clock); \
+        if (t) { \
+            instruction_trace(self, clock, -cycles); \
+        } \
+        if (self->rw && aldo_rewind_due(self->rw, self->pos.dots)) { \
+            save_checkpoint(self, clock, false); \
+        } \
+        if (d && aldo_debug_break(self->dbg, clock)) { \
+            aldo_nes_halt(self, true); \
+        } \
+    } \
+    if (s && skipped) { \
+        catchup_video(self, frameskipped); \
+    } \
+}
+RUN_LOOP(0, 0, 0)
+RUN_LOOP(0, 0, 1)
+RUN_LOOP(0, 1, 0)
+RUN_LOOP(0, 1, 1)
+RUN_LOOP(1, 0, 0)
+RUN_LOOP(1, 0, 1)
+RUN_LOOP(1, 1, 0)
+RUN_LOOP(1, 1, 1)
+#undef RUN_LOOP
+
+// indexed by [tracing][snapshots][debugging]
+static run_loop_fn *const RunLoops[2][2][2] = {
+    {{run_loop_000, run_loop_001}, {run_loop_010, run_loop_011}},
+    {{run_loop_100, run_loop_101}, {run_loop_110, run_loop_111}},
+};
+
+//
+// MARK: - Bulk Running
+//
+
+struct runcond {
+    uint64_t frames, cycles;    // Stop once this many have run
+    unsigned int events;        // Events that end the run early
+    uint16_t writeaddr;         // Watched address for ALDO_RUN_WRITE
+};
+
+// Run outside the real-time clock and execution mode: no budget, no
+// per-dot snapshots or mode checks; the snapshot, if any, is refreshed
+// once when the run stops. Hooks, breakpoints, and rewind checkpoints
+// still apply.
+static struct aldo_runstop run(struct aldo_nes001 *self,
+                               struct aldo_clock *clock, struct runcond cond)
+{
+    auto startframes = clock->frames;
+    auto startcycles = clock->cycles;
+    auto debugging = aldo_debug_armed(self->dbg);
+    auto watchvblank = (cond.events & ALDO_RUN_VBLANK) != 0;
+    auto watchnmi = (cond.events & ALDO_RUN_NMI) != 0;
+    auto watchwrite = (cond.events & ALDO_RUN_WRITE) != 0;
+    if (self->rw && self->pinpending && !aldo_nes_halted(self)) {
+        save_checkpoint(self, clock, true);
+        self->pinpending = false;
+    }
+    enum aldo_runevent event = ALDO_RUN_NONE;
+    auto done = false;
+    while (!done && event == ALDO_RUN_NONE) {
+        if (aldo_nes_halted(self)) {
+            event = ALDO_RUN_HALT;
+            break;
+        }
+        bool vblank = self->ppu.status.v;
+        auto framedone = cycle_ppu(self, clock);
+        if (watchvblank && !vblank && self->ppu.status.v) {
+            event = ALDO_RUN_VBLANK;
+        }
+        done = framedone && clock->frames - startframes >= cond.frames;
+        // a stop always finishes a due CPU cycle so the clock never rests
+        // on a subcycle boundary.
+        if (++clock->subcycle < Aldo_PpuRatio) continue;
+
+        // NMI line is active low
+        bool nmi = self->apu.cpu.signal.nmi;
+        instruction_trace(self, clock, -cycle_cpu(self, clock));
+        if (watchnmi && nmi && !self->apu.cpu.signal.nmi) {
+            event = ALDO_RUN_NMI;
+        }
+        if (watchwrite && !self->apu.cpu.signal.rw
+            && self->apu.cpu.addrbus == cond.writeaddr) {
+            event = ALDO_RUN_WRITE;
+        }
+        if (self->rw && aldo_rewind_due(self->rw, self->pos.dots)) {
+            save_checkpoint(self, clock, false);
+        }
+        if (debugging && aldo_debug_break(self->dbg, clock)) {
+            aldo_nes_halt(self, true);
+            event = ALDO_RUN_HALT;
+        }
+        done |= clock->cycles - startcycles >= cond.cycles;
+    }
+    init_snapshot(self);
+    return (struct aldo_runstop){
+        .event = event,
+        .cycles = clock->cycles - startcycles,
+        .frames = clock->frames - startframes,
+    };
+}
+
 //
 // MARK: - Public Interface
 //
@@ -406,6 +900,17 @@ aldo_nes *aldo_nes_new(aldo_debugger *dbg, bool bcdsupport, FILE *tracelog)
     self->cart = nullptr;
     self->dbg = dbg;
     self->tracelog = tracelog;
+    self->tracehook = nullptr;
+    self->tracectx = nullptr;
+    self->framehook = nullptr;
+    self->framectx = nullptr;
+    self->prof = nullptr;
+    self->cg = nullptr;
+    self->cdl = nullptr;
+    self->rw = nullptr;
+    self->snp = nullptr;
+    self->pos = (typeof(self->pos)){};
+    self->pinpending = false;
     // TODO: ditch this option when aldo can emulate more than just NES
     self->apu.cpu.bcd = bcdsupport;
     self->halted = self->probe.rdy = true;
@@ -414,6 +919,7 @@ aldo_nes *aldo_nes_new(aldo_debugger *dbg, bool bcdsupport, FILE *tracelog)
     // uninitialized vbuffer can have out-of-range palette values
     for (size_t i = 0; i < aldo_arrsz(self->vbufs); ++i) {
         aldo_memclr(self->vbufs[i]);
+        aldo_memclr(self->vmasks[i]);
     }
     if (!setup(self)) {
         aldo_nes_free(self);
@@ -446,6 +952,11 @@ void aldo_nes_powerup(aldo_nes *self, aldo_cart *c, bool zeroram)
     aldo_apu_powerup(&self->apu);
     aldo_ppu_powerup(&self->ppu);
     self->mode = ALDO_EXC_RUN;
+    self->pos = (typeof(self->pos)){};
+    self->pinpending = true;
+    if (self->rw) {
+        aldo_rewind_reset(self->rw);
+    }
 }
 
 void aldo_nes_powerdown(aldo_nes *self)
@@ -491,6 +1002,55 @@ bool aldo_nes_tracefailed(aldo_nes *self)
     return self->tracefailed;
 }
 
+void aldo_nes_set_tracehook(aldo_nes *self, aldo_tracehook *hook, void *ctx)
+{
+    assert(self != nullptr);
+
+    self->tracehook = hook;
+    self->tracectx = ctx;
+}
+
+void aldo_nes_set_framehook(aldo_nes *self, aldo_framehook *hook, void *ctx)
+{
+    assert(self != nullptr);
+
+    self->framehook = hook;
+    self->framectx = ctx;
+}
+
+void aldo_nes_set_profiler(aldo_nes *self, aldo_profiler *prof)
+{
+    assert(self != nullptr);
+
+    self->prof = prof;
+}
+
+void aldo_nes_set_callgraph(aldo_nes *self, aldo_callgraph *cg)
+{
+    assert(self != nullptr);
+
+    self->cg = cg;
+}
+
+void aldo_nes_set_cdl(aldo_nes *self, aldo_cdl *cdl)
+{
+    assert(self != nullptr);
+
+    self->cdl = cdl;
+}
+
+void aldo_nes_set_rewind(aldo_nes *self, aldo_rewind *rw)
+{
+    assert(self != nullptr);
+
+    self->rw = rw;
+    if (rw) {
+        // history starts from the current state
+        aldo_rewind_reset(rw);
+        self->pinpending = true;
+    }
+}
+
 enum aldo_execmode aldo_nes_mode(aldo_nes *self)
 {
     assert(self != nullptr);
@@ -560,6 +1120,9 @@ void aldo_nes_set_probe(aldo_nes *self, enum aldo_interrupt signal, bool active)
         assert(((void)"INVALID NES PROBE", false));
         break;
     }
+    // replay cannot reproduce probe changes so history must not
+    // replay across one.
+    self->pinpending = true;
 }
 
 void aldo_nes_clock(aldo_nes *self, struct aldo_clock *clock)
@@ -570,16 +1133,144 @@ void aldo_nes_clock(aldo_nes *self, struct aldo_clock *clock)
     if (aldo_nes_halted(self)) return;
 
     reset_snapshot(self->snp);
-    while (clock->budget > 0) {
-        if (!clock_ppu(self, clock)) continue;
-        clock_cpu(self, clock);
-        if (aldo_debug_break(self->dbg, clock)) {
-            aldo_nes_halt(self, true);
+    // breakpoints cannot change while clocking so skip the debugger
+    // entirely for this run if it has nothing to check.
+    auto debugging = aldo_debug_armed(self->dbg);
+    if (self->rw && self->pinpending) {
+        save_checkpoint(self, clock, true);
+    }
+    self->pinpending = false;
+    if (self->mode == ALDO_EXC_RUN) {
+        // a trace failure mid-run is still caught by instruction_trace
+        auto tracing = (self->tracelog || self->tracehook)
+                        && !self->tracefailed;
+        RunLoops[tracing][self->snp != nullptr][debugging](self, clock);
+    } else {
+        while (clock->budget > 0 && !aldo_nes_halted(self)) {
+            if (!clock_ppu(self, clock)) continue;
+            clock_cpu(self, clock);
+            if (self->rw && aldo_rewind_due(self->rw, self->pos.dots)) {
+                save_checkpoint(self, clock, false);
+            }
+            if (debugging && aldo_debug_break(self->dbg, clock)) {
+                aldo_nes_halt(self, true);
+            }
         }
     }
     snapshot_sys(self);
 }
 
+struct aldo_runstop aldo_nes_run_frames(aldo_nes *self,
+                                        struct aldo_clock *clock,
+                                        uint64_t frames)
+{
+    assert(self != nullptr);
+    assert(clock != nullptr);
+
+    if (frames == 0) return (struct aldo_runstop){};
+    return run(self, clock, (struct runcond){
+        .frames = frames,
+        .cycles = UINT64_MAX,
+    });
+}
+
+struct aldo_runstop aldo_nes_run_cycles(aldo_nes *self,
+                                        struct aldo_clock *clock,
+                                        uint64_t cycles)
+{
+    assert(self != nullptr);
+    assert(clock != nullptr);
+
+    if (cycles == 0) return (struct aldo_runstop){};
+    return run(self, clock, (struct runcond){
+        .frames = UINT64_MAX,
+        .cycles = cycles,
+    });
+}
+
+struct aldo_runstop aldo_nes_run_until(aldo_nes *self,
+                                       struct aldo_clock *clock,
+                                       unsigned int events, uint16_t writeaddr)
+{
+    assert(self != nullptr);
+    assert(clock != nullptr);
+
+    if (events == 0) return (struct aldo_runstop){};
+    return run(self, clock, (struct runcond){
+        .frames = UINT64_MAX,
+        .cycles = UINT64_MAX,
+        .events = events,
+        .writeaddr = writeaddr,
+    });
+}
+
+bool aldo_nes_step_back(aldo_nes *self, struct aldo_clock *clock)
+{
+    assert(self != nullptr);
+    assert(clock != nullptr);
+
+    if (!self->rw || self->pos.dots == 0) return false;
+
+    uint64_t target;
+    switch (self->mode) {
+    case ALDO_EXC_SUBCYCLE:
+        target = self->pos.dots - 1;
+        break;
+    case ALDO_EXC_CYCLE:
+        target = self->pos.dots - (clock->subcycle > 0
+                                   ? clock->subcycle
+                                   : (uint64_t)Aldo_PpuRatio);
+        break;
+    case ALDO_EXC_STEP:
+        target = prev_mark(self, self->pos.syncs);
+        break;
+    case ALDO_EXC_RUN:
+    default:
+        target = prev_mark(self, self->pos.frames);
+        break;
+    }
+    if (target >= self->pos.dots || !rewind_to(self, clock, target)) {
+        return false;
+    }
+    rewind_done(self);
+    return true;
+}
+
+bool aldo_nes_reverse_continue(aldo_nes *self, struct aldo_clock *clock)
+{
+    assert(self != nullptr);
+    assert(clock != nullptr);
+
+    if (!self->rw || self->pos.dots < 2) return false;
+
+    // search back one checkpoint interval at a time for the latest
+    // breakpoint hit before the current position; each checkpoint's own
+    // dot is covered by the interval ending at it.
+    auto end = self->pos.dots - 1;
+    uint64_t at;
+    const struct nes_checkpoint *cp;
+    const struct nes_checkpoint *oldest = nullptr;
+    while (end > 0 && (cp = aldo_rewind_find(self->rw, end - 1, &at))) {
+        restore_checkpoint(self, cp, clock);
+        auto hit = false;
+        auto lasthit = replay(self, clock, end, &hit);
+        if (hit) {
+            restore_checkpoint(self, cp, clock);
+            replay(self, clock, lasthit, nullptr);
+            rewind_done(self);
+            return true;
+        }
+        oldest = cp;
+        end = at;
+    }
+    // no more history so stop at its beginning
+    if (oldest) {
+        restore_checkpoint(self, oldest, clock);
+        rewind_done(self);
+    }
+    return false;
+}
+
 int aldo_nes_cycle_factor()
 {
     return Aldo_PpuRatio;
@@ -615,3 +1306,71 @@ void aldo_nes_dumpram(aldo_nes *self, FILE *fs[static 3], bool errs[static 3])
         errs[2] = !aldo_ppu_dumpram(&self->ppu, f);
     }
 }
+
+void aldo_nes_framehashes(aldo_nes *self, struct aldo_framehashes *hashes)
+{
+    assert(self != nullptr);
+    assert(hashes != nullptr);
+
+    auto screen = self->vbufs[!self->vbuf];
+    hashes->screen = aldo_bytehash(AldoFnvBasis, sizeof self->vbufs[0],
+                                   screen);
+    hashes->ram = aldo_bytehash(AldoFnvBasis, sizeof self->ram, self->ram);
+    hashes->vram = aldo_bytehash(AldoFnvBasis, sizeof self->vram, self->vram);
+}
+
+size_t aldo_nes_copymem(aldo_nes *self, uint16_t addr, size_t count,
+                        uint8_t dest[restrict count])
+{
+    assert(self != nullptr);
+    assert(dest != nullptr);
+
+    return aldo_bus_copy(self->apu.cpu.mbus, addr, count, dest);
+}
+
+size_t aldo_nes_writemem(aldo_nes *self, uint16_t addr, size_t count,
+                         const uint8_t src[restrict count])
+{
+    assert(self != nullptr);
+    assert(src != nullptr);
+
+    size_t written = 0;
+    while (written < count
+           && aldo_bus_write(self->apu.cpu.mbus, (uint16_t)(addr + written),
+                             src[written])) {
+        ++written;
+    }
+    return written;
+}
+
+size_t aldo_nes_state_size(aldo_nes *self)
+{
+    assert(self != nullptr);
+
+    return checkpoint_size(self);
+}
+
+void aldo_nes_save_state(aldo_nes *self, const struct aldo_clock *clock,
+                         void *state)
+{
+    assert(self != nullptr);
+    assert(clock != nullptr);
+    assert(state != nullptr);
+
+    fill_checkpoint(self, clock, state);
+}
+
+void aldo_nes_load_state(aldo_nes *self, struct aldo_clock *clock,
+                         const void *state)
+{
+    assert(self != nullptr);
+    assert(clock != nullptr);
+    assert(state != nullptr);
+
+    restore_checkpoint(self, state, clock);
+    // history after the loaded state no longer happened
+    if (self->rw) {
+        aldo_rewind_reset(self->rw);
+        self->pinpending = true;
+    }
+}
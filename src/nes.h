@@ -8,18 +8,55 @@
 #ifndef Aldo_nes_h
 #define Aldo_nes_h
 
+#include "callgraph.h"
 #include "cart.h"
+#include "cdl.h"
 #include "ctrlsignal.h"
 #include "debug.h"
+#include "profile.h"
+#include "rewind.h"
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 
 struct aldo_clock;
 struct aldo_snapshot;
 typedef struct aldo_nes001 aldo_nes;
 
+// Hashes of the most recently completed frame and of CPU and PPU internal
+// RAM, for comparing runs without storing their contents.
+struct aldo_framehashes {
+    uint64_t screen, ram, vram;
+};
+
+// Events that end a bulk run; halting (breakpoint, hook, or an
+// already-halted console) always ends a run.
+enum aldo_runevent {
+    ALDO_RUN_NONE,              // Run reached its frame or cycle count
+    ALDO_RUN_VBLANK = 0x1,      // PPU entered vertical blank
+    ALDO_RUN_NMI = 0x2,         // CPU NMI line was asserted
+    ALDO_RUN_WRITE = 0x4,       // CPU wrote to the watched address
+    ALDO_RUN_HALT = 0x8,        // Console halted
+};
+
+// Why a bulk run stopped and how far it got
+struct aldo_runstop {
+    enum aldo_runevent event;
+    uint64_t cycles, frames;    // CPU cycles and frames completed by the run
+};
+
 #include "bridgeopen.h"
+aldo_const size_t AldoTraceLineSize = 128;
+
+// Trace hook, called with each formatted trace line (including the
+// trailing newline); return false to halt the console.
+typedef bool aldo_tracehook(void *, const char *);
+// Frame hook, called with the completed screen of palette indices each time
+// the PPU finishes a frame; the screen is only valid for the duration of the
+// call. Return false to halt the console.
+typedef bool aldo_framehook(void *, const uint8_t *);
+
 // if returns null then errno is set due to failed allocation
 aldo_export aldo_ownresult
 aldo_nes *aldo_nes_new(aldo_debugger *dbg, bool bcdsupport,
@@ -44,6 +81,26 @@ bool aldo_nes_bcd_support(aldo_nes *self) aldo_nothrow;
 aldo_export
 bool aldo_nes_tracefailed(aldo_nes *self) aldo_nothrow;
 aldo_export
+void aldo_nes_set_tracehook(aldo_nes *self, aldo_tracehook *hook,
+                            void *ctx) aldo_nothrow;
+aldo_export
+void aldo_nes_set_framehook(aldo_nes *self, aldo_framehook *hook,
+                            void *ctx) aldo_nothrow;
+// optional cycle profiler, set to null to turn off profiling
+aldo_export
+void aldo_nes_set_profiler(aldo_nes *self, aldo_profiler *prof) aldo_nothrow;
+// optional subroutine call graph, set to null to turn off call tracking
+aldo_export
+void aldo_nes_set_callgraph(aldo_nes *self, aldo_callgraph *cg) aldo_nothrow;
+// optional code/data log sized for the inserted cart, set to null to turn
+// off logging.
+aldo_export
+void aldo_nes_set_cdl(aldo_nes *self, aldo_cdl *cdl) aldo_nothrow;
+// optional checkpoint history enabling reverse execution, history restarts
+// from the console's current state; set to null to turn off checkpoints.
+aldo_export
+void aldo_nes_set_rewind(aldo_nes *self, aldo_rewind *rw) aldo_nothrow;
+aldo_export
 enum aldo_execmode aldo_nes_mode(aldo_nes *self) aldo_nothrow;
 aldo_export
 void aldo_nes_set_mode(aldo_nes *self, enum aldo_execmode mode) aldo_nothrow;
@@ -59,6 +116,37 @@ void aldo_nes_set_probe(aldo_nes *self, enum aldo_interrupt signal,
 
 aldo_export
 void aldo_nes_clock(aldo_nes *self, struct aldo_clock *clock) aldo_nothrow;
+// Bulk runs ignore the clock budget and execution mode, advancing the
+// clock's counters as they go, and stop early if the console halts.
+// run until the given number of frames complete
+aldo_export
+struct aldo_runstop aldo_nes_run_frames(aldo_nes *self,
+                                        struct aldo_clock *clock,
+                                        uint64_t frames) aldo_nothrow;
+// run for the given number of CPU cycles
+aldo_export
+struct aldo_runstop aldo_nes_run_cycles(aldo_nes *self,
+                                        struct aldo_clock *clock,
+                                        uint64_t cycles) aldo_nothrow;
+// run until one of the events in the aldo_runevent mask occurs, with
+// writeaddr the address watched by ALDO_RUN_WRITE; an empty mask returns
+// without running, otherwise without a halt or event this never returns.
+aldo_export
+struct aldo_runstop aldo_nes_run_until(aldo_nes *self,
+                                       struct aldo_clock *clock,
+                                       unsigned int events,
+                                       uint16_t writeaddr) aldo_nothrow;
+// step back by the unit of the current execution mode (dot, CPU cycle,
+// instruction, or frame when running) and halt; returns false if rewind
+// history does not reach that far, leaving the console unchanged.
+aldo_export
+bool aldo_nes_step_back(aldo_nes *self, struct aldo_clock *clock) aldo_nothrow;
+// rewind to the most recent breakpoint hit and halt; returns false if
+// there is no hit in rewind history, leaving the console at the oldest
+// point in history.
+aldo_export
+bool aldo_nes_reverse_continue(aldo_nes *self,
+                               struct aldo_clock *clock) aldo_nothrow;
 aldo_export
 int aldo_nes_cycle_factor() aldo_nothrow;
 aldo_export
@@ -69,6 +157,33 @@ void aldo_nes_set_snapshot(aldo_nes *self, struct aldo_snapshot *snp) aldo_nothr
 aldo_export
 void aldo_nes_dumpram(aldo_nes *self, FILE *fs[aldo_cz(3)],
                       bool errs[aldo_cz(3)]) aldo_nothrow;
+// meant to be called from a frame hook, where RAM reflects the frame
+// boundary.
+aldo_export
+void aldo_nes_framehashes(aldo_nes *self,
+                          struct aldo_framehashes *hashes) aldo_nothrow;
+// copy CPU memory starting at addr into dest without read side-effects,
+// returning bytes copied; copy stops at the end of the device mapped to
+// addr, and nothing is copied from unmapped or side-effect-only addresses.
+aldo_export
+size_t aldo_nes_copymem(aldo_nes *self, uint16_t addr, size_t count,
+                        uint8_t dest[aldo_naz(count)]) aldo_nothrow;
+// write src to CPU memory starting at addr as if written by the CPU,
+// returning bytes written; stops at the first address with no writable
+// device.
+aldo_export
+size_t aldo_nes_writemem(aldo_nes *self, uint16_t addr, size_t count,
+                         const uint8_t src[aldo_naz(count)]) aldo_nothrow;
+// in-memory console state, including cart RAM, that can only be loaded
+// back into the same console with the same cart inserted.
+aldo_export
+size_t aldo_nes_state_size(aldo_nes *self) aldo_nothrow;
+aldo_export
+void aldo_nes_save_state(aldo_nes *self, const struct aldo_clock *clock,
+                         void *state) aldo_nothrow;
+aldo_export
+void aldo_nes_load_state(aldo_nes *self, struct aldo_clock *clock,
+                         const void *state) aldo_nothrow;
 #include "bridgeclose.h"
 
 #endif
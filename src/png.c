@@ -0,0 +1,739 @@
+//
+//  png.c
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "png.h"
+
+#include "bytes.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// PNG details from: https://www.w3.org/TR/png-3/
+// zlib/deflate details from: RFC 1950 and RFC 1951
+
+// largest payload of a single stored deflate block
+constexpr size_t StoredBlockMax = 0xffff;
+constexpr uint32_t AdlerMod = 65521;
+// most bytes summed before adler32 sums must be reduced to fit 32 bits
+constexpr size_t AdlerMaxRun = 5552;
+constexpr uint8_t BitDepth = 8;
+constexpr uint8_t ColorTypeRgb = 2;
+constexpr uint8_t ColorTypeIndexed = 3;
+constexpr size_t RgbChannels = 3;
+
+// PNG integers are big-endian, unlike everything else in Aldo
+static void put_be32(uint32_t v, uint8_t bytes[static 4])
+{
+    for (size_t i = 0; i < 4; ++i) {
+        bytes[i] = (uint8_t)(v >> (8 * (3 - i)));
+    }
+}
+
+static void adler_update(uint32_t *restrict a, uint32_t *restrict b,
+                         size_t len, const uint8_t buf[restrict len])
+{
+    while (len > 0) {
+        auto n = len < AdlerMaxRun ? len : AdlerMaxRun;
+        for (size_t i = 0; i < n; ++i) {
+            *a += buf[i];
+            *b += *a;
+        }
+        *a %= AdlerMod;
+        *b %= AdlerMod;
+        buf += n;
+        len -= n;
+    }
+}
+
+//
+// MARK: - Chunk Stream
+//
+
+struct chunkstream {
+    FILE *f;
+    uint32_t crc;
+    bool err;
+};
+
+static void chunk_put(struct chunkstream *s, size_t len,
+                      const uint8_t buf[static len])
+{
+    s->crc = aldo_png_crc(s->crc, len, buf);
+    s->err = s->err || fwrite(buf, 1, len, s->f) != len;
+}
+
+static void chunk_begin(struct chunkstream *s, uint32_t len,
+                        const char type[static 4])
+{
+    uint8_t lenbytes[4];
+    put_be32(len, lenbytes);
+    s->err = s->err || fwrite(lenbytes, 1, sizeof lenbytes, s->f)
+                        != sizeof lenbytes;
+    // chunk CRC covers type and data but not length
+    s->crc = 0;
+    chunk_put(s, 4, (const uint8_t *)type);
+}
+
+static void chunk_end(struct chunkstream *s)
+{
+    uint8_t crcbytes[4];
+    put_be32(s->crc, crcbytes);
+    s->err = s->err || fwrite(crcbytes, 1, sizeof crcbytes, s->f)
+                        != sizeof crcbytes;
+}
+
+//
+// MARK: - Stored Deflate Stream
+//
+
+// zlib stream of stored blocks, written into an IDAT chunk as it goes
+struct zstream {
+    struct chunkstream *chunk;
+    size_t total, blockleft;
+    uint32_t a, b;
+};
+
+static void zstream_put(struct zstream *z, size_t len,
+                        const uint8_t buf[static len])
+{
+    while (len > 0) {
+        if (z->blockleft == 0) {
+            assert(z->total > 0);
+
+            auto blocklen = z->total < StoredBlockMax
+                            ? z->total
+                            : StoredBlockMax;
+            z->total -= blocklen;
+            // BFINAL bit and BTYPE 00, then LEN and its one's complement,
+            // both little-endian.
+            uint8_t header[] = {
+                (uint8_t)(z->total == 0),
+                (uint8_t)blocklen,
+                (uint8_t)(blocklen >> 8),
+                (uint8_t)~blocklen,
+                (uint8_t)(~blocklen >> 8),
+            };
+            chunk_put(z->chunk, sizeof header, header);
+            z->blockleft = blocklen;
+        }
+        auto n = len < z->blockleft ? len : z->blockleft;
+        adler_update(&z->a, &z->b, n, buf);
+        chunk_put(z->chunk, n, buf);
+        z->blockleft -= n;
+        buf += n;
+        len -= n;
+    }
+}
+
+static size_t zstream_size(size_t datalen)
+{
+    // zlib header, block headers, data, adler32 trailer
+    auto blocks = (datalen + StoredBlockMax - 1) / StoredBlockMax;
+    return 2 + (blocks * 5) + datalen + 4;
+}
+
+static void write_idat(struct chunkstream *s, size_t rowlen, int height,
+                       const uint8_t *restrict pixels)
+{
+    // every row is prefixed with a filter type byte
+    auto datalen = (rowlen + 1) * (size_t)height;
+    chunk_begin(s, (uint32_t)zstream_size(datalen), "IDAT");
+
+    // CMF deflate with 32K window, FLG with no dictionary and a check
+    // value making CMF*256 + FLG a multiple of 31.
+    static constexpr uint8_t zheader[] = {0x78, 0x1};
+    chunk_put(s, sizeof zheader, zheader);
+
+    struct zstream z = {.chunk = s, .total = datalen, .a = 1};
+    static constexpr uint8_t filter_none[] = {0x0};
+    for (auto row = 0; row < height; ++row) {
+        zstream_put(&z, sizeof filter_none, filter_none);
+        zstream_put(&z, rowlen, pixels + ((size_t)row * rowlen));
+    }
+    uint8_t adler[4];
+    put_be32(z.b << 16 | z.a, adler);
+    chunk_put(s, sizeof adler, adler);
+    chunk_end(s);
+}
+
+//
+// MARK: - Deflate Codes
+//
+
+// match length and distance symbols shared by inflate and deflate
+constexpr int EndOfBlock = 256;
+static constexpr uint16_t LengthBase[] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59,
+    67, 83, 99, 115, 131, 163, 195, 227, 258,
+};
+static constexpr uint8_t LengthExtra[] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4,
+    5, 5, 5, 5, 0,
+};
+static constexpr uint16_t DistanceBase[] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513,
+    769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
+};
+static constexpr uint8_t DistanceExtra[] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10,
+    11, 11, 12, 12, 13, 13,
+};
+
+//
+// MARK: - Inflate Stream
+//
+
+constexpr int MaxCodeBits = 15;
+constexpr size_t MaxLitCodes = 288;
+constexpr size_t MaxDistCodes = 30;
+constexpr size_t CodeLenCodes = 19;
+
+struct inflater {
+    const uint8_t *src;
+    uint8_t *dst;
+    size_t srclen, srcpos, dstlen, dstpos;
+    uint32_t bitbuf;
+    int bitcount;
+    bool eof;
+};
+
+// canonical Huffman code as the number of codes of each length followed by
+// the symbols in code order
+struct huffman {
+    uint16_t counts[MaxCodeBits + 1], symbols[MaxLitCodes];
+};
+
+// deflate packs bits starting at the least-significant bit of each byte;
+// running out of input sets eof and reads as zeros.
+static uint32_t getbits(struct inflater *s, int need)
+{
+    while (s->bitcount < need) {
+        if (s->srcpos == s->srclen) {
+            s->eof = true;
+            return 0;
+        }
+        s->bitbuf |= (uint32_t)s->src[s->srcpos++] << s->bitcount;
+        s->bitcount += 8;
+    }
+    auto val = s->bitbuf & ((1u << need) - 1);
+    s->bitbuf >>= need;
+    s->bitcount -= need;
+    return val;
+}
+
+// returns false if the lengths over-subscribe the code; incomplete codes
+// are fine since unused codes fail in decode.
+static bool build(struct huffman *h, size_t n,
+                  const uint8_t lengths[static n])
+{
+    memset(h->counts, 0, sizeof h->counts);
+    for (size_t i = 0; i < n; ++i) {
+        ++h->counts[lengths[i]];
+    }
+    int left = 1;
+    for (int len = 1; len <= MaxCodeBits; ++len) {
+        left <<= 1;
+        left -= h->counts[len];
+        if (left < 0) return false;
+    }
+
+    uint16_t offsets[MaxCodeBits + 1] = {};
+    for (int len = 1; len < MaxCodeBits; ++len) {
+        offsets[len + 1] = (uint16_t)(offsets[len] + h->counts[len]);
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (lengths[i] > 0) {
+            h->symbols[offsets[lengths[i]]++] = (uint16_t)i;
+        }
+    }
+    return true;
+}
+
+// Huffman codes are packed most-significant bit first, so walk the code
+// one bit at a time, checking it against the range of codes of each length.
+static int decode(struct inflater *s, const struct huffman *h)
+{
+    int code = 0, first = 0, index = 0;
+    for (int len = 1; len <= MaxCodeBits; ++len) {
+        code |= (int)getbits(s, 1);
+        int count = h->counts[len];
+        if (code - first < count) return h->symbols[index + (code - first)];
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+    return -1;
+}
+
+static bool inflate_codes(struct inflater *s, const struct huffman *lit,
+                          const struct huffman *dist)
+{
+    for (;;) {
+        auto sym = decode(s, lit);
+        if (s->eof || sym < 0) return false;
+        if (sym < EndOfBlock) {
+            if (s->dstpos == s->dstlen) return false;
+            s->dst[s->dstpos++] = (uint8_t)sym;
+            continue;
+        }
+        if (sym == EndOfBlock) return true;
+
+        sym -= EndOfBlock + 1;
+        if (sym >= (int)aldo_arrsz(LengthBase)) {
+            return false;
+        }
+        size_t len = LengthBase[sym] + getbits(s, LengthExtra[sym]);
+        auto dsym = decode(s, dist);
+        if (s->eof || dsym < 0 || dsym >= (int)MaxDistCodes) return false;
+        size_t distance = DistanceBase[dsym] + getbits(s, DistanceExtra[dsym]);
+        if (s->eof || distance > s->dstpos
+            || len > s->dstlen - s->dstpos) return false;
+        // copy a byte at a time as a match may overlap itself to repeat
+        // a short run.
+        for (; len > 0; --len, ++s->dstpos) {
+            s->dst[s->dstpos] = s->dst[s->dstpos - distance];
+        }
+    }
+}
+
+static bool inflate_stored(struct inflater *s)
+{
+    // stored blocks start on a byte boundary, dropping any partial byte
+    s->bitbuf = 0;
+    s->bitcount = 0;
+    if (s->srclen - s->srcpos < 4) return false;
+
+    auto len = aldo_batowr(s->src + s->srcpos);
+    auto nlen = aldo_batowr(s->src + s->srcpos + 2);
+    s->srcpos += 4;
+    if ((len ^ nlen) != 0xffff || len > s->srclen - s->srcpos
+        || len > s->dstlen - s->dstpos) return false;
+
+    memcpy(s->dst + s->dstpos, s->src + s->srcpos, len);
+    s->srcpos += len;
+    s->dstpos += len;
+    return true;
+}
+
+static bool inflate_fixed(struct inflater *s)
+{
+    uint8_t lengths[MaxLitCodes + MaxDistCodes];
+    size_t i = 0;
+    for (; i < 144; ++i) {
+        lengths[i] = 8;
+    }
+    for (; i < 256; ++i) {
+        lengths[i] = 9;
+    }
+    for (; i < 280; ++i) {
+        lengths[i] = 7;
+    }
+    for (; i < MaxLitCodes; ++i) {
+        lengths[i] = 8;
+    }
+    for (; i < MaxLitCodes + MaxDistCodes; ++i) {
+        lengths[i] = 5;
+    }
+
+    struct huffman lit, dist;
+    build(&lit, MaxLitCodes, lengths);
+    build(&dist, MaxDistCodes, lengths + MaxLitCodes);
+    return inflate_codes(s, &lit, &dist);
+}
+
+static bool inflate_dynamic(struct inflater *s)
+{
+    static constexpr uint8_t order[CodeLenCodes] = {
+        16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
+    };
+
+    size_t nlit = getbits(s, 5) + 257;
+    size_t ndist = getbits(s, 5) + 1;
+    size_t ncode = getbits(s, 4) + 4;
+    // the last two literal/length codes are reserved
+    if (s->eof || nlit > MaxLitCodes - 2 || ndist > MaxDistCodes) {
+        return false;
+    }
+
+    uint8_t lengths[MaxLitCodes + MaxDistCodes] = {};
+    for (size_t i = 0; i < ncode; ++i) {
+        lengths[order[i]] = (uint8_t)getbits(s, 3);
+    }
+    struct huffman lencode;
+    if (s->eof || !build(&lencode, CodeLenCodes, lengths)) return false;
+
+    // literal/length and distance code lengths are one run-length encoded
+    // sequence, so repeats may cross from one into the other.
+    size_t i = 0;
+    while (i < nlit + ndist) {
+        auto sym = decode(s, &lencode);
+        if (s->eof || sym < 0) return false;
+        if (sym < 16) {
+            lengths[i++] = (uint8_t)sym;
+            continue;
+        }
+        uint8_t len = 0;
+        size_t repeat;
+        if (sym == 16) {
+            if (i == 0) return false;
+            len = lengths[i - 1];
+            repeat = 3 + getbits(s, 2);
+        } else if (sym == 17) {
+            repeat = 3 + getbits(s, 3);
+        } else {
+            repeat = 11 + getbits(s, 7);
+        }
+        if (s->eof || repeat > nlit + ndist - i) return false;
+        memset(lengths + i, len, repeat);
+        i += repeat;
+    }
+    // a block with no way to end is corrupt
+    if (lengths[EndOfBlock] == 0) return false;
+
+    struct huffman lit, dist;
+    if (!build(&lit, nlit, lengths)
+        || !build(&dist, ndist, lengths + nlit)) return false;
+    return inflate_codes(s, &lit, &dist);
+}
+
+//
+// MARK: - Fast Deflate Stream
+//
+
+// Greedy LZ77 over a single-entry hash table, encoded as one block with
+// deflate's fixed Huffman codes; scaled sprite sheets are mostly repeated
+// pixels and repeated rows so this compresses them very well.
+constexpr size_t MinMatch = 4;
+constexpr size_t MaxMatch = 258;
+constexpr size_t WindowSize = 32768;
+constexpr int HashBits = 15;
+// literal/length alphabet size
+constexpr int LitLenCodes = 286;
+
+// fixed Huffman codes, bit-reversed for deflate's LSB-first packing, and
+// symbol lookups for match lengths and distances.
+struct fixedcodes {
+    uint16_t litcode[LitLenCodes];
+    uint8_t litlen[LitLenCodes], distcode[30], lensym[MaxMatch + 1];
+    // distances up to 256 index directly, longer ones by 128-wide range
+    uint8_t distsym[512];
+};
+
+static uint16_t reverse_bits(uint16_t code, int len)
+{
+    uint16_t rev = 0;
+    for (auto i = 0; i < len; ++i) {
+        rev = (uint16_t)(rev << 1 | ((code >> i) & 0x1));
+    }
+    return rev;
+}
+
+static void build_fixed_codes(struct fixedcodes *fc)
+{
+    for (auto sym = 0; sym < LitLenCodes; ++sym) {
+        uint16_t code;
+        uint8_t len;
+        if (sym < 144) {
+            code = (uint16_t)(0x30 + sym);
+            len = 8;
+        } else if (sym < 256) {
+            code = (uint16_t)(0x190 + sym - 144);
+            len = 9;
+        } else if (sym < 280) {
+            code = (uint16_t)(sym - 256);
+            len = 7;
+        } else {
+            code = (uint16_t)(0xc0 + sym - 280);
+            len = 8;
+        }
+        fc->litcode[sym] = reverse_bits(code, len);
+        fc->litlen[sym] = len;
+    }
+    for (size_t i = 0; i < aldo_arrsz(LengthBase); ++i) {
+        for (size_t n = LengthBase[i];
+             n < LengthBase[i] + (1u << LengthExtra[i]) && n <= MaxMatch;
+             ++n) {
+            fc->lensym[n] = (uint8_t)i;
+        }
+    }
+    for (size_t i = 0; i < aldo_arrsz(DistanceBase); ++i) {
+        fc->distcode[i] = (uint8_t)reverse_bits((uint16_t)i, 5);
+        for (size_t d = DistanceBase[i];
+             d < DistanceBase[i] + (1u << DistanceExtra[i]);
+             ++d) {
+            fc->distsym[d <= 256 ? d - 1 : 256 + ((d - 1) >> 7)] = (uint8_t)i;
+        }
+    }
+}
+
+struct bitstream {
+    uint8_t *out;
+    size_t at;
+    uint64_t bits;
+    int count;
+};
+
+static void bits_put(struct bitstream *bs, uint32_t v, int len)
+{
+    bs->bits |= (uint64_t)v << bs->count;
+    bs->count += len;
+    while (bs->count >= 8) {
+        bs->out[bs->at++] = (uint8_t)bs->bits;
+        bs->bits >>= 8;
+        bs->count -= 8;
+    }
+}
+
+static void put_symbol(struct bitstream *bs, const struct fixedcodes *fc,
+                       int sym)
+{
+    bits_put(bs, fc->litcode[sym], fc->litlen[sym]);
+}
+
+static void put_match(struct bitstream *bs, const struct fixedcodes *fc,
+                      size_t len, size_t dist)
+{
+    auto ls = fc->lensym[len];
+    put_symbol(bs, fc, 257 + ls);
+    bits_put(bs, (uint32_t)(len - LengthBase[ls]), LengthExtra[ls]);
+
+    auto ds = fc->distsym[dist <= 256 ? dist - 1 : 256 + ((dist - 1) >> 7)];
+    bits_put(bs, fc->distcode[ds], 5);
+    bits_put(bs, (uint32_t)(dist - DistanceBase[ds]), DistanceExtra[ds]);
+}
+
+static uint32_t hash4(const uint8_t p[static MinMatch])
+{
+    auto v = (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16
+                | (uint32_t)p[3] << 24;
+    return (v * 2654435761u) >> (32 - HashBits);
+}
+
+static void write_header(struct chunkstream *s, int width, int height,
+                         uint8_t depth, uint8_t colortype)
+{
+    static constexpr uint8_t signature[] = {
+        0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n',
+    };
+    s->err = fwrite(signature, 1, sizeof signature, s->f) != sizeof signature;
+
+    uint8_t ihdr[13] = {
+        [8] = depth,
+        [9] = colortype,
+        // compression, filter, and interlace methods are all 0
+    };
+    put_be32((uint32_t)width, ihdr);
+    put_be32((uint32_t)height, ihdr + 4);
+    chunk_begin(s, sizeof ihdr, "IHDR");
+    chunk_put(s, sizeof ihdr, ihdr);
+    chunk_end(s);
+}
+
+//
+// MARK: - Public Interface
+//
+
+bool aldo_png_write_rgb(int width, int height, const uint8_t *restrict rgb,
+                        FILE *f)
+{
+    assert(width > 0);
+    assert(height > 0);
+    assert(rgb != nullptr);
+    assert(f != nullptr);
+
+    struct chunkstream s = {.f = f};
+    write_header(&s, width, height, BitDepth, ColorTypeRgb);
+    write_idat(&s, (size_t)width * RgbChannels, height, rgb);
+
+    chunk_begin(&s, 0, "IEND");
+    chunk_end(&s);
+    return !s.err;
+}
+
+bool aldo_png_write_indexed(int width, int height, int depth, int colors,
+                            const uint8_t *restrict palette,
+                            const uint8_t *restrict pixels, FILE *f)
+{
+    assert(width > 0);
+    assert(height > 0);
+    assert(depth == 1 || depth == 2 || depth == 4 || depth == 8);
+    assert(0 < colors && colors <= 1 << depth);
+    assert(palette != nullptr);
+    assert(pixels != nullptr);
+    assert(f != nullptr);
+
+    // every row is prefixed with a filter type byte of 0 (none)
+    auto rowlen = (((size_t)width * (size_t)depth) + 7) / 8;
+    auto datalen = (rowlen + 1) * (size_t)height;
+    uint8_t *data = malloc(datalen);
+    if (!data) return false;
+    for (auto row = 0; row < height; ++row) {
+        auto line = data + ((rowlen + 1) * (size_t)row);
+        line[0] = 0;
+        memcpy(line + 1, pixels + (rowlen * (size_t)row), rowlen);
+    }
+    uint8_t *zdata;
+    auto zlen = aldo_png_deflate(datalen, data, &zdata);
+    free(data);
+    if (zlen == 0) return false;
+
+    struct chunkstream s = {.f = f};
+    write_header(&s, width, height, (uint8_t)depth, ColorTypeIndexed);
+
+    auto palsize = (size_t)colors * RgbChannels;
+    chunk_begin(&s, (uint32_t)palsize, "PLTE");
+    chunk_put(&s, palsize, palette);
+    chunk_end(&s);
+
+    chunk_begin(&s, (uint32_t)zlen, "IDAT");
+    chunk_put(&s, zlen, zdata);
+    chunk_end(&s);
+    free(zdata);
+
+    chunk_begin(&s, 0, "IEND");
+    chunk_end(&s);
+    return !s.err;
+}
+
+uint32_t aldo_png_crc(uint32_t crc, size_t len,
+                      const uint8_t buf[restrict len])
+{
+    // half-byte lookup table for the reflected polynomial 0xEDB88320
+    static constexpr uint32_t table[] = {
+        0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
+        0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+        0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+        0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c,
+    };
+
+    crc = ~crc;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= buf[i];
+        crc = table[crc & 0xf] ^ (crc >> 4);
+        crc = table[crc & 0xf] ^ (crc >> 4);
+    }
+    return ~crc;
+}
+
+size_t aldo_png_deflate(size_t len, const uint8_t src[restrict len],
+                        uint8_t **dst)
+{
+    assert(src != nullptr);
+    assert(dst != nullptr);
+
+    // Worst case is all 9-bit literals; a match is never longer than the
+    // literals it replaces since it covers at least 4 bytes in 31 bits.
+    // Add zlib header, block header and end code, and adler32 trailer.
+    // positions are tracked in 32 bits
+    if (len >= UINT32_MAX) {
+        errno = EOVERFLOW;
+        return 0;
+    }
+    auto bound = 2 + len + (len / 8) + 4 + 4;
+    uint8_t *out = malloc(bound);
+    uint32_t *head = calloc(1u << HashBits, sizeof *head);
+    struct fixedcodes *fc = malloc(sizeof *fc);
+    if (!out || !head || !fc) {
+        free(out);
+        free(head);
+        free(fc);
+        return 0;
+    }
+    build_fixed_codes(fc);
+
+    // CMF deflate with 32K window, FLG with no dictionary and a check
+    // value making CMF*256 + FLG a multiple of 31.
+    out[0] = 0x78;
+    out[1] = 0x1;
+    struct bitstream bs = {.out = out, .at = 2};
+    // BFINAL bit and BTYPE 01
+    bits_put(&bs, 0x3, 3);
+
+    // hash table holds the last position + 1 seen for a 4-byte prefix
+    size_t at = 0;
+    while (at + MinMatch <= len) {
+        auto h = hash4(src + at);
+        size_t candidate = head[h];
+        head[h] = (uint32_t)(at + 1);
+        size_t matchlen = 0;
+        if (candidate > 0 && at - (candidate - 1) <= WindowSize) {
+            auto prev = src + candidate - 1;
+            auto max = len - at < MaxMatch ? len - at : MaxMatch;
+            while (matchlen < max && prev[matchlen] == src[at + matchlen]) {
+                ++matchlen;
+            }
+        }
+        if (matchlen < MinMatch) {
+            put_symbol(&bs, fc, src[at++]);
+            continue;
+        }
+        put_match(&bs, fc, matchlen, at - (candidate - 1));
+        // index the rest of the match so later repeats can find it
+        auto end = at + matchlen;
+        for (++at; at < end && at + MinMatch <= len; ++at) {
+            head[hash4(src + at)] = (uint32_t)(at + 1);
+        }
+        at = end;
+    }
+    while (at < len) {
+        put_symbol(&bs, fc, src[at++]);
+    }
+    put_symbol(&bs, fc, EndOfBlock);
+    bits_put(&bs, 0, 7);
+    free(head);
+    free(fc);
+
+    uint32_t a = 1, b = 0;
+    adler_update(&a, &b, len, src);
+    put_be32(b << 16 | a, out + bs.at);
+    *dst = out;
+    return bs.at + 4;
+}
+
+bool aldo_inflate(size_t srclen, const uint8_t src[restrict srclen],
+                  size_t dstlen, uint8_t dst[restrict dstlen])
+{
+    assert(src != nullptr);
+    assert(dst != nullptr);
+
+    struct inflater s = {
+        .src = src,
+        .dst = dst,
+        .srclen = srclen,
+        .dstlen = dstlen,
+    };
+    bool last;
+    do {
+        last = getbits(&s, 1);
+        auto type = getbits(&s, 2);
+        if (s.eof) return false;
+
+        bool ok;
+        switch (type) {
+        case 0:
+            ok = inflate_stored(&s);
+            break;
+        case 1:
+            ok = inflate_fixed(&s);
+            break;
+        case 2:
+            ok = inflate_dynamic(&s);
+            break;
+        default:
+            ok = false;
+            break;
+        }
+        if (!ok || s.eof) return false;
+    } while (!last);
+    return s.dstpos == s.dstlen;
+}
@@ -0,0 +1,60 @@
+//
+//  png.h
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_png_h
+#define Aldo_png_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "bridgeopen.h"
+//
+// MARK: - Export
+//
+
+// Minimal PNG encoder with no external dependencies; truecolor images are
+// written with uncompressed (stored) deflate blocks, indexed images with
+// a fast fixed-Huffman deflate that favors speed over size. The matching
+// inflate for compressed cart containers lives here too.
+
+// write width x height 8-bit RGB triples in row-major order as a truecolor
+// PNG; returns false on I/O error.
+aldo_export aldo_checkerr
+bool aldo_png_write_rgb(int width, int height,
+                        const uint8_t *aldo_noalias rgb,
+                        FILE *f) aldo_nothrow;
+// write width x height palette indices of depth bits (1, 2, 4, or 8) as an
+// indexed-color PNG; each row is packed MSB-first into (width * depth + 7)
+// / 8 bytes, and palette holds colors RGB triples. Returns false and sets
+// errno on I/O or allocation error.
+aldo_export aldo_checkerr
+bool aldo_png_write_indexed(int width, int height, int depth, int colors,
+                            const uint8_t *aldo_noalias palette,
+                            const uint8_t *aldo_noalias pixels,
+                            FILE *f) aldo_nothrow;
+
+//
+// MARK: - Internal
+//
+
+// running CRC-32 (ISO-HDLC, as used by PNG chunks); start with crc = 0
+uint32_t aldo_png_crc(uint32_t crc, size_t len,
+                      const uint8_t buf[aldo_naz(len)]) aldo_nothrow;
+// compress len bytes of src into a zlib stream of one fixed-Huffman block
+// held in a new heap buffer returned in *dst; returns the stream length,
+// or 0 with *dst unmodified on allocation failure.
+size_t aldo_png_deflate(size_t len, const uint8_t src[aldo_naz(len)],
+                        uint8_t **dst) aldo_nothrow;
+// inflate the raw deflate stream in src into exactly dstlen bytes of dst;
+// returns false if the stream is corrupt, truncated, or does not produce
+// exactly dstlen bytes.
+bool aldo_inflate(size_t srclen, const uint8_t src[aldo_naz(srclen)],
+                  size_t dstlen, uint8_t dst[aldo_naz(dstlen)]) aldo_nothrow;
+#include "bridgeclose.h"
+
+#endif
@@ -1362,3 +1362,10 @@ struct aldo_ppu_coord aldo_ppu_screendot(const struct aldo_rp2c02 *self)
 
     return (struct aldo_ppu_coord){self->dot - (dot_pxout + 1), self->line};
 }
+
+uint8_t aldo_ppu_mask(const struct aldo_rp2c02 *self)
+{
+    assert(self != nullptr);
+
+    return get_mask(self);
+}
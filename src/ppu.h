@@ -157,5 +157,6 @@ bool aldo_ppu_dumpram(const struct aldo_rp2c02 *self, FILE *f);
 struct aldo_ppu_coord aldo_ppu_trace(const struct aldo_rp2c02 *self,
                                      int adjustment);
 struct aldo_ppu_coord aldo_ppu_screendot(const struct aldo_rp2c02 *self);
+uint8_t aldo_ppu_mask(const struct aldo_rp2c02 *self);
 
 #endif
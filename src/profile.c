@@ -0,0 +1,161 @@
+//
+//  profile.c
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "profile.h"
+
+#include "bytes.h"
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct profile_counter {
+    uint64_t cycles, execs;
+    uint16_t addr;
+};
+
+struct aldo_profiler_context {
+    struct profile_counter
+        *curr,                                  // Executing instruction
+        *prg,                                   // Counters by PRG offset
+        cpu[ALDO_MEMBLOCK_64KB];                // Counters by CPU address
+    size_t prgsize;
+    uint64_t total;
+};
+
+// grow PRG counters to cover prgaddr; banks are only sized as they are
+// first executed since the profiler does not know the cart layout.
+static bool grow_prg(struct aldo_profiler_context *self, size_t prgaddr)
+{
+    if (prgaddr < self->prgsize) return true;
+
+    // round up to the next 16KB block
+    auto size = (prgaddr | ALDO_ADDRMASK_16KB) + 1;
+    struct profile_counter *prg = realloc(self->prg, size * sizeof *prg);
+    if (!prg) return false;
+
+    memset(prg + self->prgsize, 0, (size - self->prgsize) * sizeof *prg);
+    self->prg = prg;
+    self->prgsize = size;
+    return true;
+}
+
+static struct aldo_hotspot make_hotspot(const struct profile_counter *c,
+                                        ptrdiff_t prgaddr)
+{
+    return (struct aldo_hotspot){c->cycles, c->execs, prgaddr, c->addr};
+}
+
+// insertion into a descending list bounded to n entries
+static void insert_hotspot(struct aldo_hotspot hs[], size_t n,
+                           size_t *count, struct aldo_hotspot h)
+{
+    if (h.cycles == 0) return;
+    if (*count == n && hs[n - 1].cycles >= h.cycles) return;
+
+    auto i = *count < n ? (*count)++ : n - 1;
+    for (; i > 0 && hs[i - 1].cycles < h.cycles; --i) {
+        hs[i] = hs[i - 1];
+    }
+    hs[i] = h;
+}
+
+//
+// MARK: - Public Interface
+//
+
+const ptrdiff_t Aldo_NoPrgAddr = -1;
+
+aldo_profiler *aldo_profile_new()
+{
+    struct aldo_profiler_context *self = calloc(1, sizeof *self);
+    return self;
+}
+
+void aldo_profile_free(aldo_profiler *self)
+{
+    assert(self != nullptr);
+
+    free(self->prg);
+    free(self);
+}
+
+void aldo_profile_reset(aldo_profiler *self)
+{
+    assert(self != nullptr);
+
+    memset(self->cpu, 0, sizeof self->cpu);
+    if (self->prg) {
+        memset(self->prg, 0, self->prgsize * sizeof *self->prg);
+    }
+    self->curr = nullptr;
+    self->total = 0;
+}
+
+uint64_t aldo_profile_total(aldo_profiler *self)
+{
+    assert(self != nullptr);
+
+    return self->total;
+}
+
+struct aldo_hotspot aldo_profile_prg(aldo_profiler *self, size_t prgaddr)
+{
+    assert(self != nullptr);
+
+    if (prgaddr >= self->prgsize) {
+        return (struct aldo_hotspot){.prgaddr = (ptrdiff_t)prgaddr};
+    }
+    return make_hotspot(self->prg + prgaddr, (ptrdiff_t)prgaddr);
+}
+
+size_t aldo_profile_hotspots(aldo_profiler *self, size_t n,
+                             struct aldo_hotspot hs[restrict n])
+{
+    assert(self != nullptr);
+    assert(hs != nullptr);
+
+    if (n == 0) return 0;
+
+    size_t count = 0;
+    for (size_t i = 0; i < self->prgsize; ++i) {
+        insert_hotspot(hs, n, &count,
+                       make_hotspot(self->prg + i, (ptrdiff_t)i));
+    }
+    for (size_t i = 0; i < aldo_arrsz(self->cpu); ++i) {
+        insert_hotspot(hs, n, &count,
+                       make_hotspot(self->cpu + i, Aldo_NoPrgAddr));
+    }
+    return count;
+}
+
+//
+// MARK: - Internal Interface
+//
+
+void aldo_profile_exec(aldo_profiler *self, uint16_t addr, ptrdiff_t prgaddr)
+{
+    assert(self != nullptr);
+
+    // fall back to CPU address if PRG counters cannot grow
+    self->curr = prgaddr >= 0 && grow_prg(self, (size_t)prgaddr)
+                    ? self->prg + prgaddr
+                    : self->cpu + addr;
+    self->curr->addr = addr;
+    ++self->curr->execs;
+}
+
+void aldo_profile_cycles(aldo_profiler *self, int cycles)
+{
+    assert(self != nullptr);
+
+    // cycles before the first instruction fetch (e.g. RESET) are dropped
+    if (!self->curr) return;
+
+    self->curr->cycles += (uint64_t)cycles;
+    self->total += (uint64_t)cycles;
+}
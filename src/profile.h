@@ -0,0 +1,63 @@
+//
+//  profile.h
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_profile_h
+#define Aldo_profile_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Cycles spent on an instruction, keyed by the PRG ROM location it was
+// executed from so each PRG bank is counted separately; instructions
+// outside PRG ROM (e.g. RAM) are keyed by CPU address.
+struct aldo_hotspot {
+    uint64_t cycles, execs;     // Cycles attributed, times executed
+    ptrdiff_t prgaddr;          // PRG ROM offset or Aldo_NoPrgAddr
+    uint16_t addr;              // CPU address of last execution
+};
+
+typedef struct aldo_profiler_context aldo_profiler;
+
+#include "bridgeopen.h"
+//
+// MARK: - Export
+//
+
+aldo_export
+extern const ptrdiff_t Aldo_NoPrgAddr;
+
+// if returns null then errno is set due to failed allocation
+aldo_export aldo_ownresult
+aldo_profiler *aldo_profile_new() aldo_nothrow;
+aldo_export
+void aldo_profile_free(aldo_profiler *self) aldo_nothrow;
+
+aldo_export
+void aldo_profile_reset(aldo_profiler *self) aldo_nothrow;
+aldo_export
+uint64_t aldo_profile_total(aldo_profiler *self) aldo_nothrow;
+// counters for the instruction at PRG ROM offset prgaddr
+aldo_export
+struct aldo_hotspot aldo_profile_prg(aldo_profiler *self,
+                                     size_t prgaddr) aldo_nothrow;
+// fill hs with up to n hottest instructions, sorted by most cycles;
+// returns number of hotspots filled.
+aldo_export
+size_t aldo_profile_hotspots(aldo_profiler *self, size_t n,
+                             struct aldo_hotspot hs[aldo_naz(n)]) aldo_nothrow;
+
+//
+// MARK: - Internal
+//
+
+// start attributing cycles to the instruction fetched at addr
+void aldo_profile_exec(aldo_profiler *self, uint16_t addr,
+                       ptrdiff_t prgaddr) aldo_nothrow;
+void aldo_profile_cycles(aldo_profiler *self, int cycles) aldo_nothrow;
+#include "bridgeclose.h"
+
+#endif
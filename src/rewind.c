@@ -0,0 +1,247 @@
+//
+//  rewind.c
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "rewind.h"
+
+#include "ppu.h"
+
+#include <assert.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct checkpoint {
+    uint64_t pos;
+    void *state;
+    bool pinned;
+};
+
+struct aldo_rewind_context {
+    struct checkpoint *items;
+    size_t budget, capacity, count, size;
+    uint64_t interval, next;
+    double dotsperms, lastms;
+};
+
+// never fewer checkpoints than this regardless of budget
+constexpr size_t MinCheckpoints = 8;
+// replays shorter than this are too noisy to time
+constexpr uint64_t MinSampleDots = 10000;
+// one scanline
+constexpr uint64_t MinInterval = 341;
+
+static uint64_t max_interval()
+{
+    return (uint64_t)Aldo_DotsPerFrame * 60;
+}
+
+static void clear_checkpoints(struct aldo_rewind_context *self)
+{
+    for (size_t i = 0; i < self->count; ++i) {
+        free(self->items[i].state);
+    }
+    self->count = 0;
+    self->next = 0;
+}
+
+static bool init_checkpoints(struct aldo_rewind_context *self, size_t size)
+{
+    if (self->items && self->size == size) return true;
+
+    clear_checkpoints(self);
+    free(self->items);
+    self->size = size;
+    self->capacity = size > 0 ? self->budget / size : MinCheckpoints;
+    if (self->capacity < MinCheckpoints) {
+        self->capacity = MinCheckpoints;
+    }
+    self->items = calloc(self->capacity, sizeof *self->items);
+    return self->items != nullptr;
+}
+
+// drop every other unpinned checkpoint from the older half of history,
+// doubling the spacing of older checkpoints while keeping the oldest.
+static void thin_checkpoints(struct aldo_rewind_context *self)
+{
+    auto half = self->count / 2;
+    size_t w = 0;
+    auto drop = false;
+    for (size_t r = 0; r < self->count; ++r) {
+        auto cp = self->items[r];
+        if (0 < r && r < half && !cp.pinned && (drop = !drop)) {
+            free(cp.state);
+            continue;
+        }
+        self->items[w++] = cp;
+    }
+    // everything is pinned so fall back to dropping the oldest
+    if (w == self->count) {
+        free(self->items[0].state);
+        memmove(self->items, self->items + 1, --w * sizeof *self->items);
+    }
+    self->count = w;
+}
+
+static void schedule_next(struct aldo_rewind_context *self)
+{
+    self->next = self->count > 0
+                    ? self->items[self->count - 1].pos + self->interval
+                    : 0;
+}
+
+//
+// MARK: - Public Interface
+//
+
+const double Aldo_RewindStepMs = 10.0;
+
+aldo_rewind *aldo_rewind_new(size_t budget)
+{
+    struct aldo_rewind_context *self = malloc(sizeof *self);
+    if (!self) return self;
+
+    *self = (typeof(*self)){
+        .budget = budget,
+        .interval = (uint64_t)Aldo_DotsPerFrame,
+    };
+    return self;
+}
+
+void aldo_rewind_free(aldo_rewind *self)
+{
+    assert(self != nullptr);
+
+    clear_checkpoints(self);
+    free(self->items);
+    free(self);
+}
+
+void aldo_rewind_reset(aldo_rewind *self)
+{
+    assert(self != nullptr);
+
+    clear_checkpoints(self);
+    self->lastms = 0;
+}
+
+size_t aldo_rewind_count(aldo_rewind *self)
+{
+    assert(self != nullptr);
+
+    return self->count;
+}
+
+uint64_t aldo_rewind_oldest(aldo_rewind *self)
+{
+    assert(self != nullptr);
+
+    return self->count > 0 ? self->items[0].pos : 0;
+}
+
+uint64_t aldo_rewind_interval(aldo_rewind *self)
+{
+    assert(self != nullptr);
+
+    return self->interval;
+}
+
+double aldo_rewind_last_ms(aldo_rewind *self)
+{
+    assert(self != nullptr);
+
+    return self->lastms;
+}
+
+//
+// MARK: - Internal Interface
+//
+
+bool aldo_rewind_due(aldo_rewind *self, uint64_t pos)
+{
+    assert(self != nullptr);
+
+    return pos >= self->next;
+}
+
+void *aldo_rewind_save(aldo_rewind *self, uint64_t pos, size_t size,
+                       bool pinned)
+{
+    assert(self != nullptr);
+
+    if (!init_checkpoints(self, size)) return nullptr;
+
+    // history is linear so saving over an existing position
+    // discards everything after it.
+    aldo_rewind_truncate(self, pos);
+    if (self->count > 0 && self->items[self->count - 1].pos == pos) {
+        auto last = self->items + self->count - 1;
+        last->pinned |= pinned;
+        schedule_next(self);
+        return last->state;
+    }
+
+    if (self->count == self->capacity) {
+        thin_checkpoints(self);
+    }
+    void *state = malloc(size);
+    if (!state) return state;
+
+    self->items[self->count++] = (struct checkpoint){pos, state, pinned};
+    schedule_next(self);
+    return state;
+}
+
+const void *aldo_rewind_find(aldo_rewind *self, uint64_t pos, uint64_t *at)
+{
+    assert(self != nullptr);
+    assert(at != nullptr);
+
+    if (self->count == 0 || pos < self->items[0].pos) return nullptr;
+
+    // binary search for the last checkpoint at or before pos
+    size_t lo = 0, hi = self->count;
+    while (hi - lo > 1) {
+        auto mid = lo + ((hi - lo) / 2);
+        if (self->items[mid].pos <= pos) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    *at = self->items[lo].pos;
+    return self->items[lo].state;
+}
+
+void aldo_rewind_truncate(aldo_rewind *self, uint64_t pos)
+{
+    assert(self != nullptr);
+
+    while (self->count > 0 && self->items[self->count - 1].pos > pos) {
+        free(self->items[--self->count].state);
+    }
+    schedule_next(self);
+}
+
+void aldo_rewind_replayed(aldo_rewind *self, uint64_t dots, double ms)
+{
+    assert(self != nullptr);
+
+    self->lastms = ms;
+    if (dots < MinSampleDots || !isgreater(ms, 0.0)) return;
+
+    auto rate = (double)dots / ms;
+    self->dotsperms = self->dotsperms > 0 ? (self->dotsperms + rate) / 2 : rate;
+    // a reverse step replays at most one interval, leave half the
+    // step budget as headroom for slower replays.
+    auto interval = (uint64_t)(self->dotsperms * Aldo_RewindStepMs / 2);
+    if (interval < MinInterval) {
+        interval = MinInterval;
+    } else if (interval > max_interval()) {
+        interval = max_interval();
+    }
+    self->interval = interval;
+}
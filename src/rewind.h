@@ -0,0 +1,68 @@
+//
+//  rewind.h
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_rewind_h
+#define Aldo_rewind_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Checkpoint history of console states for reverse execution; positions
+// are PPU dots since powerup and checkpoint contents are opaque.
+typedef struct aldo_rewind_context aldo_rewind;
+
+#include "bridgeopen.h"
+//
+// MARK: - Export
+//
+
+// Replay time a single reverse step should stay under
+aldo_export
+extern const double Aldo_RewindStepMs;
+
+// budget is the total bytes to hold checkpoints in, older history is
+// thinned out once the budget is used; if returns null then errno is set
+// due to failed allocation.
+aldo_export aldo_ownresult
+aldo_rewind *aldo_rewind_new(size_t budget) aldo_nothrow;
+aldo_export
+void aldo_rewind_free(aldo_rewind *self) aldo_nothrow;
+
+aldo_export
+void aldo_rewind_reset(aldo_rewind *self) aldo_nothrow;
+aldo_export
+size_t aldo_rewind_count(aldo_rewind *self) aldo_nothrow;
+// position of the oldest checkpoint, 0 if there is no history
+aldo_export
+uint64_t aldo_rewind_oldest(aldo_rewind *self) aldo_nothrow;
+// current spacing between checkpoints in dots
+aldo_export
+uint64_t aldo_rewind_interval(aldo_rewind *self) aldo_nothrow;
+// duration of the most recent replay in milliseconds
+aldo_export
+double aldo_rewind_last_ms(aldo_rewind *self) aldo_nothrow;
+
+//
+// MARK: - Internal
+//
+
+bool aldo_rewind_due(aldo_rewind *self, uint64_t pos) aldo_nothrow;
+// buffer of size bytes to hold the state at pos, pinned checkpoints are
+// never thinned out; returns null if memory could not be allocated.
+void *aldo_rewind_save(aldo_rewind *self, uint64_t pos, size_t size,
+                       bool pinned) aldo_nothrow;
+// latest checkpoint at or before pos, null if history does not reach pos
+const void *aldo_rewind_find(aldo_rewind *self, uint64_t pos,
+                             uint64_t *at) aldo_nothrow;
+// discard checkpoints after pos
+void aldo_rewind_truncate(aldo_rewind *self, uint64_t pos) aldo_nothrow;
+// record a replay of dots taking ms to adapt checkpoint spacing
+void aldo_rewind_replayed(aldo_rewind *self, uint64_t dots,
+                          double ms) aldo_nothrow;
+#include "bridgeclose.h"
+
+#endif
@@ -0,0 +1,136 @@
+//
+//  romcache.c
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "romcache.h"
+
+#include "bytes.h"
+
+#include <assert.h>
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+struct romentry {
+    struct aldo_romimage img;   // Must be first member
+    struct romentry *next;
+    uint64_t hash;
+    size_t refs;
+    enum aldo_romstorage storage;
+};
+
+constexpr size_t BucketCount = 64;
+
+static struct {
+    pthread_mutex_t lock;
+    struct romentry *buckets[BucketCount];
+    size_t count;
+} Cache = {.lock = PTHREAD_MUTEX_INITIALIZER};
+
+static struct romentry **bucket(uint64_t hash)
+{
+    return Cache.buckets + (hash % BucketCount);
+}
+
+// must be called with the cache locked
+static struct romentry *find(uint64_t hash, const uint8_t *mem, size_t size)
+{
+    for (auto e = *bucket(hash); e; e = e->next) {
+        if (e->hash == hash && e->img.size == size
+            && memcmp(e->img.mem, mem, size) == 0) return e;
+    }
+    return nullptr;
+}
+
+//
+// MARK: - Public Interface
+//
+
+size_t aldo_romcache_count()
+{
+    pthread_mutex_lock(&Cache.lock);
+    auto count = Cache.count;
+    pthread_mutex_unlock(&Cache.lock);
+    return count;
+}
+
+//
+// MARK: - Internal Interface
+//
+
+const struct aldo_romimage *
+aldo_romcache_intern(const uint8_t *mem, size_t size,
+                     enum aldo_romstorage storage)
+{
+    assert(mem != nullptr);
+
+    // hash outside the lock, images can be megabytes
+    auto hash = aldo_bytehash(AldoFnvBasis, size, mem);
+    // allocate up front too so a miss holds the lock only to link it in
+    struct romentry *added = malloc(sizeof *added);
+
+    pthread_mutex_lock(&Cache.lock);
+    auto e = find(hash, mem, size);
+    if (e) {
+        ++e->refs;
+    } else if (added) {
+        *added = (typeof(*added)){
+            .img = {mem, size},
+            .next = *bucket(hash),
+            .hash = hash,
+            .refs = 1,
+            .storage = storage,
+        };
+        *bucket(hash) = e = added;
+        added = nullptr;
+        ++Cache.count;
+    }
+    pthread_mutex_unlock(&Cache.lock);
+
+    free(added);
+    if (!e || e->img.mem != mem) {
+        aldo_romcache_free(mem, size, storage);
+    }
+    return e ? &e->img : nullptr;
+}
+
+void aldo_romcache_free(const uint8_t *mem, size_t size,
+                        enum aldo_romstorage storage)
+{
+    assert(mem != nullptr);
+
+    if (storage == ALDO_ROMS_MAPPED) {
+        munmap((void *)mem, size);
+    } else {
+        free((void *)mem);
+    }
+}
+
+void aldo_romcache_release(const struct aldo_romimage *img)
+{
+    assert(img != nullptr);
+
+    auto e = (struct romentry *)img;
+    pthread_mutex_lock(&Cache.lock);
+    auto last = --e->refs == 0;
+    if (last) {
+        auto link = bucket(e->hash);
+        while (*link != e) {
+            link = &(*link)->next;
+        }
+        *link = e->next;
+        --Cache.count;
+    }
+    pthread_mutex_unlock(&Cache.lock);
+
+    if (last) {
+        aldo_romcache_free(e->img.mem, e->img.size, e->storage);
+        free(e);
+    }
+}
@@ -0,0 +1,53 @@
+//
+//  romcache.h
+//  Aldo
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef Aldo_romcache_h
+#define Aldo_romcache_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Process-wide store of cart images keyed by content; carts loading the
+// same image share one immutable, reference-counted copy. All calls are
+// thread-safe and only happen at cart load and free, never while clocking.
+struct aldo_romimage {
+    const uint8_t *mem;
+    size_t size;
+};
+
+enum aldo_romstorage {
+    ALDO_ROMS_HEAP,     // Allocated with malloc
+    ALDO_ROMS_MAPPED,   // Mapped with mmap
+};
+
+#include "bridgeopen.h"
+//
+// MARK: - Export
+//
+
+// number of distinct images currently shared
+aldo_export
+size_t aldo_romcache_count() aldo_nothrow;
+
+//
+// MARK: - Internal
+//
+
+// take ownership of mem and return the shared image with the same
+// contents, releasing mem right away if one already exists; returns null
+// if memory could not be allocated, with mem released and errno set.
+const struct aldo_romimage *
+aldo_romcache_intern(const uint8_t *mem, size_t size,
+                     enum aldo_romstorage storage) aldo_nothrow;
+// drop a reference to an image, freeing it with the last one
+void aldo_romcache_release(const struct aldo_romimage *img) aldo_nothrow;
+// free mem that will never be interned according to how it was allocated
+void aldo_romcache_free(const uint8_t *mem, size_t size,
+                        enum aldo_romstorage storage) aldo_nothrow;
+#include "bridgeclose.h"
+
+#endif
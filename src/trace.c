@@ -16,10 +16,32 @@
 
 #include <assert.h>
 #include <inttypes.h>
+#include <stdarg.h>
 #include <stddef.h>
+#include <stdio.h>
 
-static int trace_instruction(FILE *tracelog, const struct aldo_mos6502 *cpu,
-                             const struct aldo_snapshot *snp)
+// Trace line buffer with bounds-checked appending
+struct linebuf {
+    char *text;
+    size_t size;
+    int len;
+};
+
+static bool linebuf_print(struct linebuf *self, const char *restrict fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    auto left = self->size - (size_t)self->len;
+    auto written = vsnprintf(self->text + self->len, left, fmt, args);
+    va_end(args);
+    if (written < 0 || (size_t)written >= left) return false;
+    self->len += written;
+    return true;
+}
+
+static bool trace_instruction(struct linebuf *line,
+                              const struct aldo_mos6502 *cpu,
+                              const struct aldo_snapshot *snp)
 {
     uint8_t bytes[3];
     auto instlen = aldo_bus_copy(cpu->mbus,
@@ -32,23 +54,25 @@ static int trace_instruction(FILE *tracelog, const struct aldo_mos6502 *cpu,
         result = aldo_dis_inst(snp->cpu.datapath.current_instruction, &inst,
                                disinst);
     }
-    return fprintf(tracelog, "%s",
-                   result > 0 ? disinst : (result < 0
-                                           ? aldo_dis_errstr(result)
-                                           : "No inst"));
+    return linebuf_print(line, "%s",
+                         result > 0 ? disinst : (result < 0
+                                                 ? aldo_dis_errstr(result)
+                                                 : "No inst"));
 }
 
-static int trace_instruction_peek(FILE *tracelog, struct aldo_mos6502 *cpu,
-                                  struct aldo_rp2c02 *ppu, aldo_debugger *dbg,
-                                  const struct aldo_snapshot *snp)
+static bool trace_instruction_peek(struct linebuf *line,
+                                   struct aldo_mos6502 *cpu,
+                                   struct aldo_rp2c02 *ppu, aldo_debugger *dbg,
+                                   const struct aldo_snapshot *snp)
 {
     char peek[AldoDisPeekSize];
     auto result = aldo_dis_peek(cpu, ppu, dbg, snp, peek);
-    return fprintf(tracelog, " %s",
-                   result < 0 ? aldo_dis_errstr(result) : peek);
+    return linebuf_print(line, " %s",
+                         result < 0 ? aldo_dis_errstr(result) : peek);
 }
 
-static bool trace_registers(FILE *tracelog, const struct aldo_snapshot *snp)
+static bool trace_registers(struct linebuf *line,
+                            const struct aldo_snapshot *snp)
 {
     static constexpr char flags[] = {
         'c', 'C', 'z', 'Z', 'i', 'I', 'd', 'D',
@@ -56,47 +80,45 @@ static bool trace_registers(FILE *tracelog, const struct aldo_snapshot *snp)
     };
 
     auto cpu = &snp->cpu;
-    auto err = fprintf(tracelog, " A:%02X X:%02X Y:%02X P:%02X (",
-                       cpu->accumulator, cpu->xindex, cpu->yindex, cpu->status);
-    if (err < 0) return false;
+    char status[(sizeof cpu->status * 8) + 1];
     for (size_t i = sizeof cpu->status * 8; i > 0; --i) {
         size_t idx = i - 1;
         bool bit = aldo_getbit(cpu->status, idx);
-        if (fputc(flags[(idx * 2) + bit], tracelog) == EOF) return false;
+        status[(sizeof status - 1) - i] = flags[(idx * 2) + bit];
     }
-    return fprintf(tracelog, ") S:%02X", cpu->stack_pointer) > 0;
+    status[sizeof status - 1] = '\0';
+    return linebuf_print(line, " A:%02X X:%02X Y:%02X P:%02X (%s) S:%02X",
+                         cpu->accumulator, cpu->xindex, cpu->yindex,
+                         cpu->status, status, cpu->stack_pointer);
 }
 
 //
 // MARK: - Public Interface
 //
 
-bool aldo_trace_line(FILE *tracelog, int adjustment, uint64_t cycles,
-                     struct aldo_mos6502 *cpu, struct aldo_rp2c02 *ppu,
-                     aldo_debugger *dbg, const struct aldo_snapshot *snp)
+int aldo_trace_format(int adjustment, uint64_t cycles,
+                      struct aldo_mos6502 *cpu, struct aldo_rp2c02 *ppu,
+                      aldo_debugger *dbg, const struct aldo_snapshot *snp,
+                      char buf[static AldoTraceLineSize])
 {
-    assert(tracelog != nullptr);
     assert(cpu != nullptr);
     assert(ppu != nullptr);
     assert(dbg != nullptr);
     assert(snp != nullptr);
+    assert(buf != nullptr);
 
     // does not include leading space in trace_registers
     static constexpr auto instw = 47;
 
-    auto written = trace_instruction(tracelog, cpu, snp);
-    if (written < 0) return false;
-    auto peek = trace_instruction_peek(tracelog, cpu, ppu, dbg, snp);
-    if (peek < 0) {
-        return false;
-    } else {
-        written += peek;
-    }
-    auto width = written <= instw ? instw - written : 0;
-    assert(written <= instw);
-    if (fprintf(tracelog, "%*s", width, "") < 0) return false;
-    if (!trace_registers(tracelog, snp)) return false;
+    struct linebuf line = {.text = buf, .size = AldoTraceLineSize};
+    if (!trace_instruction(&line, cpu, snp)) return -1;
+    if (!trace_instruction_peek(&line, cpu, ppu, dbg, snp)) return -1;
+    auto width = line.len <= instw ? instw - line.len : 0;
+    assert(line.len <= instw);
+    if (!linebuf_print(&line, "%*s", width, "")) return -1;
+    if (!trace_registers(&line, snp)) return -1;
     auto p = aldo_ppu_trace(ppu, adjustment * Aldo_PpuRatio);
-    return fprintf(tracelog, " PPU:%3d,%3d CPU:%" PRIu64 "\n", p.line,
-                   p.dot, cycles + (uint64_t)adjustment) > 0;
+    if (!linebuf_print(&line, " PPU:%3d,%3d CPU:%" PRIu64 "\n", p.line,
+                       p.dot, cycles + (uint64_t)adjustment)) return -1;
+    return line.len;
 }
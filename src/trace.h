@@ -9,16 +9,19 @@
 #define Aldo_trace_h
 
 #include "debug.h"
+#include "nes.h"
 
 #include <stdint.h>
-#include <stdio.h>
 
 struct aldo_mos6502;
 struct aldo_rp2c02;
 struct aldo_snapshot;
 
-bool aldo_trace_line(FILE *tracelog, int adjustment, uint64_t cycles,
-                     struct aldo_mos6502 *cpu, struct aldo_rp2c02 *ppu,
-                     aldo_debugger *dbg, const struct aldo_snapshot *snp);
+// format a single trace line, including trailing newline, into buf;
+// returns length of the formatted line or < 0 if formatting failed
+int aldo_trace_format(int adjustment, uint64_t cycles,
+                      struct aldo_mos6502 *cpu, struct aldo_rp2c02 *ppu,
+                      aldo_debugger *dbg, const struct aldo_snapshot *snp,
+                      char buf[static AldoTraceLineSize]);
 
 #endif
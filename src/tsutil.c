@@ -9,6 +9,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <unistd.h>
 
 extern inline double aldo_timespec_to_ms(const struct timespec *);
 
@@ -44,3 +45,14 @@ void aldo_sleep(struct timespec duration)
         duration = ts_left;
     } while (result == EINTR);
 }
+
+int aldo_cpu_count(int max)
+{
+    assert(max > 0);
+
+#ifdef _SC_NPROCESSORS_ONLN
+    auto cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus > 0) return cpus < max ? (int)cpus : max;
+#endif
+    return 1;
+}
@@ -27,6 +27,10 @@ aldo_export
 struct timespec aldo_elapsed(const struct timespec *from) aldo_nothrow;
 aldo_export
 void aldo_sleep(struct timespec duration) aldo_nothrow;
+// online CPU count clamped to max, or 1 if the platform can't say; for
+// sizing worker pools.
+aldo_export
+int aldo_cpu_count(int max) aldo_nothrow;
 #include "bridgeclose.h"
 
 #endif
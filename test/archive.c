@@ -0,0 +1,287 @@
+//
+//  archive.c
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "archive.h"
+#include "cart.h"
+#include "ciny.h"
+#include "png.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+// fixtures produced by zlib and Python's zipfile module
+static constexpr char Text[] = "Aldo Aldo Aldo Aldo NES";
+static constexpr size_t TextSize = sizeof Text - 1;
+
+static constexpr uint8_t FixedBlock[] = {
+    0x73, 0xcc, 0x49, 0xc9, 0x57, 0x70, 0x44, 0x25, 0xfc, 0x5c, 0x83, 0x01,
+};
+
+// two copies of a 200-byte pattern
+static constexpr uint8_t DynamicBlock[] = {
+    0xdd, 0xcf, 0xd9, 0x0e, 0x43, 0x40, 0x00, 0x46, 0x61, 0x12, 0x8c, 0x08,
+    0x86, 0xa6, 0x0c, 0x62, 0x29, 0x43, 0x82, 0x11, 0xa9, 0x35, 0xf6, 0xf7,
+    0x7f, 0xac, 0xfe, 0xcf, 0xd1, 0xeb, 0xf3, 0xdd, 0x1c, 0x89, 0xd8, 0x5e,
+    0xcc, 0xdb, 0x61, 0x7f, 0x88, 0xe9, 0x45, 0xbc, 0x1e, 0x97, 0x8b, 0xd8,
+    0x6e, 0xc0, 0x45, 0xb7, 0x3c, 0x44, 0x77, 0xa3, 0x12, 0x6d, 0x83, 0x49,
+    0xd0, 0x06, 0x18, 0x1f, 0xad, 0x85, 0xa1, 0x68, 0x1c, 0x46, 0xa7, 0x5a,
+    0xf2, 0x16, 0xc5, 0x3e, 0xac, 0x54, 0x49, 0x5e, 0xe2, 0x73, 0xdc, 0x33,
+    0xd5, 0x42, 0x47, 0xf0, 0xf2, 0x5e, 0xa9, 0x14, 0xbe, 0x3a, 0xb4, 0x2f,
+    0x8c, 0x87, 0xb6, 0xc3, 0xa4, 0x68, 0x05, 0x0c, 0x41, 0x13, 0x30, 0x0e,
+    0x4b, 0x55, 0x73, 0x3a, 0xf2, 0xa6, 0x67, 0xb1, 0x6a, 0x4c, 0x5b, 0x51,
+    0x75, 0x2c, 0x95, 0xf5, 0xe9, 0xbc, 0xaa, 0x9e, 0x05, 0xb2, 0x31, 0xa3,
+    0xd5, 0x30, 0x16, 0x5a, 0x0e, 0xa3, 0xa1, 0x1d, 0x30, 0x19, 0xda, 0x04,
+    0x13, 0x64, 0xbe, 0xa5, 0x9c, 0x63, 0x23, 0xfd, 0xc9, 0xc7, 0x0f,
+};
+
+// Text compressed with a file name in the header
+static constexpr uint8_t Gzip[] = {
+    0x1f, 0x8b, 0x08, 0x08, 0x00, 0x00, 0x00, 0x00, 0x02, 0xff, 0x61, 0x6c,
+    0x64, 0x6f, 0x2e, 0x6e, 0x65, 0x73, 0x00, 0x73, 0xcc, 0x49, 0xc9, 0x57,
+    0x70, 0x44, 0x25, 0xfc, 0x5c, 0x83, 0x01, 0xed, 0x23, 0x4a, 0x41, 0x17,
+    0x00, 0x00, 0x00,
+};
+
+// readme.txt (stored), first.NES (deflated), second.nes (stored)
+static constexpr uint8_t Zip[] = {
+    0x50, 0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x21, 0x00, 0xf1, 0x2a, 0x9b, 0xe6, 0x09, 0x00, 0x00, 0x00, 0x09, 0x00,
+    0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x72, 0x65, 0x61, 0x64, 0x6d, 0x65,
+    0x2e, 0x74, 0x78, 0x74, 0x6e, 0x6f, 0x74, 0x20, 0x61, 0x20, 0x72, 0x6f,
+    0x6d, 0x50, 0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00,
+    0x00, 0x21, 0x00, 0xbd, 0x36, 0x6e, 0x5c, 0x0e, 0x00, 0x00, 0x00, 0x13,
+    0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x66, 0x69, 0x72, 0x73, 0x74,
+    0x2e, 0x4e, 0x45, 0x53, 0x4b, 0xcb, 0x2c, 0x2a, 0x2e, 0x51, 0x28, 0xca,
+    0xcf, 0x55, 0x48, 0x83, 0xb1, 0x00, 0x50, 0x4b, 0x03, 0x04, 0x14, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0x69, 0x11, 0x1f, 0xb6,
+    0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00,
+    0x73, 0x65, 0x63, 0x6f, 0x6e, 0x64, 0x2e, 0x6e, 0x65, 0x73, 0x73, 0x65,
+    0x63, 0x6f, 0x6e, 0x64, 0x50, 0x4b, 0x01, 0x02, 0x14, 0x03, 0x14, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0xf1, 0x2a, 0x9b, 0xe6,
+    0x09, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x72, 0x65, 0x61, 0x64, 0x6d, 0x65, 0x2e, 0x74, 0x78, 0x74,
+    0x50, 0x4b, 0x01, 0x02, 0x14, 0x03, 0x14, 0x00, 0x00, 0x00, 0x08, 0x00,
+    0x00, 0x00, 0x21, 0x00, 0xbd, 0x36, 0x6e, 0x5c, 0x0e, 0x00, 0x00, 0x00,
+    0x13, 0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0x31, 0x00, 0x00, 0x00, 0x66, 0x69,
+    0x72, 0x73, 0x74, 0x2e, 0x4e, 0x45, 0x53, 0x50, 0x4b, 0x01, 0x02, 0x14,
+    0x03, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x21, 0x00, 0x69,
+    0x11, 0x1f, 0xb6, 0x06, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x0a,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80,
+    0x01, 0x66, 0x00, 0x00, 0x00, 0x73, 0x65, 0x63, 0x6f, 0x6e, 0x64, 0x2e,
+    0x6e, 0x65, 0x73, 0x50, 0x4b, 0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x03,
+    0x00, 0x03, 0x00, 0xa7, 0x00, 0x00, 0x00, 0x94, 0x00, 0x00, 0x00, 0x00,
+    0x00,
+};
+
+//
+// MARK: - Inflate
+//
+
+static void inflate_stored(void *ctx)
+{
+    static constexpr uint8_t block[] = {
+        0x1, 0x5, 0x0, 0xfa, 0xff, 'h', 'e', 'l', 'l', 'o',
+    };
+    uint8_t out[5];
+
+    ct_asserttrue(aldo_inflate(sizeof block, block, sizeof out, out));
+
+    ct_assertequal(0, memcmp("hello", out, sizeof out));
+}
+
+static void inflate_fixed(void *ctx)
+{
+    uint8_t out[TextSize];
+
+    ct_asserttrue(aldo_inflate(sizeof FixedBlock, FixedBlock, sizeof out,
+                               out));
+
+    ct_assertequal(0, memcmp(Text, out, sizeof out));
+}
+
+static void inflate_dynamic(void *ctx)
+{
+    uint8_t out[400];
+
+    ct_asserttrue(aldo_inflate(sizeof DynamicBlock, DynamicBlock,
+                               sizeof out, out));
+
+    for (size_t i = 0; i < sizeof out; ++i) {
+        auto j = i % 200;
+        ct_assertequal((j * 7 ^ (j >> 3)) & 0x3f, out[i], "at %zu", i);
+    }
+}
+
+static void inflate_truncated(void *ctx)
+{
+    uint8_t out[TextSize];
+
+    ct_assertfalse(aldo_inflate(sizeof FixedBlock - 1, FixedBlock,
+                                sizeof out, out));
+}
+
+static void inflate_wrong_size(void *ctx)
+{
+    uint8_t out[TextSize + 1];
+
+    ct_assertfalse(aldo_inflate(sizeof FixedBlock, FixedBlock, sizeof out,
+                                out));
+    ct_assertfalse(aldo_inflate(sizeof FixedBlock, FixedBlock,
+                                sizeof out - 2, out));
+}
+
+static void inflate_invalid_block_type(void *ctx)
+{
+    static constexpr uint8_t block[] = {0x7, 0x0};
+    uint8_t out[1];
+
+    ct_assertfalse(aldo_inflate(sizeof block, block, sizeof out, out));
+}
+
+static void inflate_distance_before_start(void *ctx)
+{
+    // fixed block: match of length 3 at distance 1 with no output yet
+    static constexpr uint8_t block[] = {0x03, 0x02, 0x00};
+    uint8_t out[3];
+
+    ct_assertfalse(aldo_inflate(sizeof block, block, sizeof out, out));
+}
+
+//
+// MARK: - Containers
+//
+
+static void detect_signatures(void *ctx)
+{
+    static constexpr uint8_t ines[] = {'N', 'E', 'S', 0x1a};
+
+    ct_asserttrue(aldo_archive_detect(sizeof Gzip, Gzip));
+    ct_asserttrue(aldo_archive_detect(sizeof Zip, Zip));
+    ct_assertfalse(aldo_archive_detect(sizeof ines, ines));
+    ct_assertfalse(aldo_archive_detect(1, Gzip));
+}
+
+static void gzip_extract(void *ctx)
+{
+    uint8_t *img = nullptr;
+    size_t size = 0;
+
+    auto err = aldo_archive_extract(sizeof Gzip, Gzip, nullptr, &img, &size);
+
+    ct_assertequal(0, err);
+    ct_assertequal(TextSize, size);
+    ct_assertequal(0, memcmp(Text, img, size));
+    free(img);
+}
+
+static void gzip_bad_crc(void *ctx)
+{
+    uint8_t gz[sizeof Gzip];
+    memcpy(gz, Gzip, sizeof gz);
+    gz[sizeof gz - 8] ^= 0x1;
+    uint8_t *img = nullptr;
+    size_t size = 0;
+
+    auto err = aldo_archive_extract(sizeof gz, gz, nullptr, &img, &size);
+
+    ct_assertequal(ALDO_CART_ERR_INFLATE, err);
+    ct_assertnull(img);
+}
+
+static void gzip_truncated(void *ctx)
+{
+    uint8_t *img = nullptr;
+    size_t size = 0;
+
+    auto err = aldo_archive_extract(15, Gzip, nullptr, &img, &size);
+
+    ct_assertequal(ALDO_CART_ERR_EOF, err);
+    ct_assertnull(img);
+}
+
+static void zip_first_nes_entry(void *ctx)
+{
+    uint8_t *img = nullptr;
+    size_t size = 0;
+
+    auto err = aldo_archive_extract(sizeof Zip, Zip, nullptr, &img, &size);
+
+    ct_assertequal(0, err);
+    ct_assertequal(19u, size);
+    ct_assertequal(0, memcmp("first rom first rom", img, size));
+    free(img);
+}
+
+static void zip_named_entry(void *ctx)
+{
+    uint8_t *img = nullptr;
+    size_t size = 0;
+
+    auto err = aldo_archive_extract(sizeof Zip, Zip, "second.nes", &img,
+                                    &size);
+
+    ct_assertequal(0, err);
+    ct_assertequal(6u, size);
+    ct_assertequal(0, memcmp("second", img, size));
+    free(img);
+}
+
+static void zip_missing_entry(void *ctx)
+{
+    uint8_t *img = nullptr;
+    size_t size = 0;
+
+    auto err = aldo_archive_extract(sizeof Zip, Zip, "third.nes", &img,
+                                    &size);
+
+    ct_assertequal(ALDO_CART_ERR_ARCHIVE, err);
+    ct_assertnull(img);
+}
+
+static void zip_no_end_record(void *ctx)
+{
+    uint8_t *img = nullptr;
+    size_t size = 0;
+
+    auto err = aldo_archive_extract(sizeof Zip - 22, Zip, nullptr, &img,
+                                    &size);
+
+    ct_assertequal(ALDO_CART_ERR_FORMAT, err);
+    ct_assertnull(img);
+}
+
+//
+// MARK: - Test List
+//
+
+struct ct_testsuite archive_tests()
+{
+    static const struct ct_testcase tests[] = {
+        ct_maketest(inflate_stored),
+        ct_maketest(inflate_fixed),
+        ct_maketest(inflate_dynamic),
+        ct_maketest(inflate_truncated),
+        ct_maketest(inflate_wrong_size),
+        ct_maketest(inflate_invalid_block_type),
+        ct_maketest(inflate_distance_before_start),
+
+        ct_maketest(detect_signatures),
+        ct_maketest(gzip_extract),
+        ct_maketest(gzip_bad_crc),
+        ct_maketest(gzip_truncated),
+        ct_maketest(zip_first_nes_entry),
+        ct_maketest(zip_named_entry),
+        ct_maketest(zip_missing_entry),
+        ct_maketest(zip_no_end_record),
+    };
+
+    return ct_makesuite(tests);
+}
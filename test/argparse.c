@@ -34,19 +34,39 @@ static void init_control_zero_args(void *ctx)
     ct_asserttrue(result);
 
     ct_assertequalstr("aldo", args->me);
+    ct_assertequal(600, args->benchframes);
     ct_assertequal(1, args->chrscale);
+    ct_assertequal(0, args->framefirst);
+    ct_assertequal(-1, args->framelast);
+    ct_assertequal(1, args->framestride);
     ct_assertequal(-1, args->resetvector);
+    ct_assertequal(0, args->testjobs);
     ct_asserttrue(args->help);
 
     ct_assertnull(args->filepath);
     ct_assertnull(argparse_filename(args->filepath));
+    ct_assertnull(args->filelist);
     ct_assertnull(args->chrdecode_prefix);
     ct_assertnull(args->haltlist);
     ct_assertnull(args->dbgfilepath);
+    ct_assertnull(args->callgraphpath);
+    ct_assertnull(args->cdlpath);
+    ct_assertnull(args->framehashpath);
+    ct_assertnull(args->framesoutpath);
+    ct_assertnull(args->indexpath);
+    ct_assertnull(args->profilepath);
+    ct_assertnull(args->servepath);
+    ct_assertnull(args->tracecmppath);
+    ct_assertnull(args->verifyhashpath);
     ct_assertfalse(args->batch);
+    ct_assertfalse(args->bench);
     ct_assertfalse(args->chrdecode);
+    ct_assertfalse(args->chrpng);
     ct_assertfalse(args->disassemble);
+    ct_assertfalse(args->index);
     ct_assertfalse(args->info);
+    ct_assertfalse(args->serve);
+    ct_assertfalse(args->testroms);
     ct_assertfalse(args->tron);
     ct_assertfalse(args->verbose);
     ct_assertfalse(args->version);
@@ -98,6 +118,29 @@ static void full_filepath(void *ctx)
     ct_assertfalse(args->help);
 }
 
+static void multiple_files(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "a.rom", "-v", "b.rom", "c.rom", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertequalstr("c.rom", args->filepath);
+    auto f = args->filelist;
+    ct_assertnotnull(f);
+    ct_assertequalstr("a.rom", f->path);
+    f = f->next;
+    ct_assertnotnull(f);
+    ct_assertequalstr("b.rom", f->path);
+    f = f->next;
+    ct_assertnotnull(f);
+    ct_assertequalstr("c.rom", f->path);
+    ct_assertnull(f->next);
+}
+
 static void flag_short(void *ctx)
 {
     struct cliargs *args = ctx;
@@ -395,6 +438,101 @@ static void chr_decode_long_does_not_overparse(void *ctx)
     ct_assertnull(args->chrdecode_prefix);
 }
 
+static void chr_png_short(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-cP", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_asserttrue(args->chrdecode);
+    ct_asserttrue(args->chrpng);
+}
+
+static void chr_png_long(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--chr-decode=myrom", "--chr-png", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_asserttrue(args->chrdecode);
+    ct_asserttrue(args->chrpng);
+    ct_assertequalstr("myrom", args->chrdecode_prefix);
+}
+
+static void bench_short(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-B", "test.rom", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_asserttrue(args->bench);
+    ct_assertequal(600, args->benchframes);
+    ct_assertequalstr("test.rom", args->filepath);
+}
+
+static void bench_long_no_frames(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--bench", "test.rom", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_asserttrue(args->bench);
+    ct_assertequal(600, args->benchframes);
+    ct_assertequalstr("test.rom", args->filepath);
+}
+
+static void bench_long_with_frames(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--bench=120", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_asserttrue(args->bench);
+    ct_assertequal(120, args->benchframes);
+}
+
+static void bench_long_invalid_frames(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--bench=0", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_assertfalse(result);
+}
+
+static void bench_long_malformed_frames(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--bench=lots", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_assertfalse(result);
+}
+
 static void both_flags_and_values(void *ctx)
 {
     struct cliargs *args = ctx;
@@ -805,6 +943,513 @@ static void debug_file_long_does_not_overparse(void *ctx)
     ct_assertnull(args->dbgfilepath);
 }
 
+static void trace_compare_short(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-T", "my/golden.log", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertnotnull(args->tracecmppath);
+    ct_assertequalstr("my/golden.log", args->tracecmppath);
+    ct_assertfalse(args->tron);
+}
+
+static void trace_compare_long(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--trace-compare", "my/golden.log", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertnotnull(args->tracecmppath);
+    ct_assertequalstr("my/golden.log", args->tracecmppath);
+    ct_assertfalse(args->tron);
+}
+
+static void trace_compare_long_with_equals(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--trace-compare=my/golden.log", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertnotnull(args->tracecmppath);
+    ct_assertequalstr("my/golden.log", args->tracecmppath);
+    ct_assertfalse(args->tron);
+}
+
+static void trace_compare_long_missing(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--trace-compare", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_assertfalse(result);
+
+    ct_assertnull(args->tracecmppath);
+}
+
+static void callgraph_short(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-Gmy/calls.folded", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertnotnull(args->callgraphpath);
+    ct_assertequalstr("my/calls.folded", args->callgraphpath);
+}
+
+static void callgraph_long(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--call-graph=my/calls.json", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertnotnull(args->callgraphpath);
+    ct_assertequalstr("my/calls.json", args->callgraphpath);
+}
+
+static void callgraph_long_missing(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--call-graph", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_assertfalse(result);
+
+    ct_assertnull(args->callgraphpath);
+}
+
+static void cdl_short(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-Lmy/game.cdl", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertnotnull(args->cdlpath);
+    ct_assertequalstr("my/game.cdl", args->cdlpath);
+}
+
+static void cdl_long(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--cdl", "my/game.cdl", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertnotnull(args->cdlpath);
+    ct_assertequalstr("my/game.cdl", args->cdlpath);
+}
+
+static void cdl_long_missing(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--cdl", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_assertfalse(result);
+
+    ct_assertnull(args->cdlpath);
+}
+
+static void profile_short(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-pmy/profile.txt", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertnotnull(args->profilepath);
+    ct_assertequalstr("my/profile.txt", args->profilepath);
+}
+
+static void profile_long(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--profile", "my/profile.txt", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertnotnull(args->profilepath);
+    ct_assertequalstr("my/profile.txt", args->profilepath);
+}
+
+static void profile_long_missing(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--profile", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_assertfalse(result);
+
+    ct_assertnull(args->profilepath);
+}
+
+static void frames_out_short(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-oframes/%04d.png", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertnotnull(args->framesoutpath);
+    ct_assertequalstr("frames/%04d.png", args->framesoutpath);
+    ct_assertequal(0, args->framefirst);
+    ct_assertequal(-1, args->framelast);
+    ct_assertequal(1, args->framestride);
+}
+
+static void frames_out_long(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--frames-out", "-", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertnotnull(args->framesoutpath);
+    ct_assertequalstr("-", args->framesoutpath);
+}
+
+static void frames_out_long_missing(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--frames-out", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_assertfalse(result);
+
+    ct_assertnull(args->framesoutpath);
+}
+
+static void frame_range_first(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-R", "120", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertequal(120, args->framefirst);
+    ct_assertequal(-1, args->framelast);
+    ct_assertequal(1, args->framestride);
+}
+
+static void frame_range_first_last(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-R10:20", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertequal(10, args->framefirst);
+    ct_assertequal(20, args->framelast);
+    ct_assertequal(1, args->framestride);
+}
+
+static void frame_range_full(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--frame-range=10:20:5", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertequal(10, args->framefirst);
+    ct_assertequal(20, args->framelast);
+    ct_assertequal(5, args->framestride);
+}
+
+static void frame_range_no_last(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--frame-range", "30::2", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertequal(30, args->framefirst);
+    ct_assertequal(-1, args->framelast);
+    ct_assertequal(2, args->framestride);
+}
+
+static void frame_range_last_before_first(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-R20:10", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_assertfalse(result);
+}
+
+static void frame_range_zero_stride(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-R0:10:0", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_assertfalse(result);
+}
+
+static void frame_range_malformed(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-R1:2:3:4", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_assertfalse(result);
+}
+
+static void frame_range_missing(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--frame-range", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_assertfalse(result);
+}
+
+static void frame_hashes_short(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-Fhashes.log", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertnotnull(args->framehashpath);
+    ct_assertequalstr("hashes.log", args->framehashpath);
+    ct_assertnull(args->verifyhashpath);
+}
+
+static void frame_hashes_long(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--frame-hashes", "hashes.log", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertnotnull(args->framehashpath);
+    ct_assertequalstr("hashes.log", args->framehashpath);
+}
+
+static void verify_hashes_short(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-Y", "golden.log", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_assertnotnull(args->verifyhashpath);
+    ct_assertequalstr("golden.log", args->verifyhashpath);
+    ct_assertnull(args->framehashpath);
+}
+
+static void verify_hashes_long_missing(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--verify-hashes", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_assertfalse(result);
+
+    ct_assertnull(args->verifyhashpath);
+}
+
+static void test_roms_short(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-u", "a.nes", "b.nes", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_asserttrue(args->testroms);
+    ct_assertequal(0, args->testjobs);
+    ct_assertequalstr("a.nes", args->filelist->path);
+    ct_assertequalstr("b.nes", args->filelist->next->path);
+}
+
+static void test_roms_long_with_jobs(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--test-roms=4", "a.nes", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_asserttrue(args->testroms);
+    ct_assertequal(4, args->testjobs);
+}
+
+static void test_roms_invalid_jobs(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--test-roms=0", "a.nes", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_assertfalse(result);
+}
+
+static void serve_short(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-S", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_asserttrue(args->serve);
+    ct_assertnull(args->servepath);
+}
+
+static void serve_long_with_socket(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--serve=/tmp/aldo.sock", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_asserttrue(args->serve);
+    ct_assertequalstr("/tmp/aldo.sock", args->servepath);
+}
+
+static void serve_long_empty_socket(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--serve=", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_assertfalse(result);
+}
+
+static void index_short(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "-I", "roms", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_asserttrue(args->index);
+    ct_assertnull(args->indexpath);
+    ct_assertequalstr("roms", args->filepath);
+}
+
+static void index_long_with_path(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--index=/tmp/roms.idx", "roms", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_asserttrue(result);
+
+    ct_asserttrue(args->index);
+    ct_assertequalstr("/tmp/roms.idx", args->indexpath);
+    ct_assertequalstr("roms", args->filepath);
+}
+
+static void index_long_empty_path(void *ctx)
+{
+    struct cliargs *args = ctx;
+    char *argv[] = {"testaldo", "--index=", "roms", nullptr};
+    int argc = (sizeof argv / sizeof argv[0]) - 1;
+
+    bool result = argparse_parse(args, argc, argv);
+
+    ct_assertfalse(result);
+}
+
 static void option_does_not_trigger_flag(void *ctx)
 {
     struct cliargs *args = ctx;
@@ -880,6 +1525,7 @@ struct ct_testsuite argparse_tests()
         ct_maketest(cli_zero_args),
         ct_maketest(single_arg),
         ct_maketest(full_filepath),
+        ct_maketest(multiple_files),
 
         ct_maketest(flag_short),
         ct_maketest(flag_long),
@@ -905,6 +1551,14 @@ struct ct_testsuite argparse_tests()
         ct_maketest(chr_decode_long_no_prefix),
         ct_maketest(chr_decode_long_with_prefix),
         ct_maketest(chr_decode_long_does_not_overparse),
+        ct_maketest(chr_png_short),
+        ct_maketest(chr_png_long),
+
+        ct_maketest(bench_short),
+        ct_maketest(bench_long_no_frames),
+        ct_maketest(bench_long_with_frames),
+        ct_maketest(bench_long_invalid_frames),
+        ct_maketest(bench_long_malformed_frames),
 
         ct_maketest(both_flags_and_values),
         ct_maketest(flags_and_values_do_not_combine),
@@ -939,6 +1593,44 @@ struct ct_testsuite argparse_tests()
         ct_maketest(debug_file_long_missing),
         ct_maketest(debug_file_long_does_not_overparse),
 
+        ct_maketest(trace_compare_short),
+        ct_maketest(trace_compare_long),
+        ct_maketest(trace_compare_long_with_equals),
+        ct_maketest(trace_compare_long_missing),
+        ct_maketest(callgraph_short),
+        ct_maketest(callgraph_long),
+        ct_maketest(callgraph_long_missing),
+        ct_maketest(cdl_short),
+        ct_maketest(cdl_long),
+        ct_maketest(cdl_long_missing),
+        ct_maketest(profile_short),
+        ct_maketest(profile_long),
+        ct_maketest(profile_long_missing),
+        ct_maketest(frames_out_short),
+        ct_maketest(frames_out_long),
+        ct_maketest(frames_out_long_missing),
+        ct_maketest(frame_range_first),
+        ct_maketest(frame_range_first_last),
+        ct_maketest(frame_range_full),
+        ct_maketest(frame_range_no_last),
+        ct_maketest(frame_range_last_before_first),
+        ct_maketest(frame_range_zero_stride),
+        ct_maketest(frame_range_malformed),
+        ct_maketest(frame_range_missing),
+        ct_maketest(frame_hashes_short),
+        ct_maketest(frame_hashes_long),
+        ct_maketest(verify_hashes_short),
+        ct_maketest(verify_hashes_long_missing),
+        ct_maketest(test_roms_short),
+        ct_maketest(test_roms_long_with_jobs),
+        ct_maketest(test_roms_invalid_jobs),
+        ct_maketest(serve_short),
+        ct_maketest(serve_long_with_socket),
+        ct_maketest(serve_long_empty_socket),
+        ct_maketest(index_short),
+        ct_maketest(index_long_with_path),
+        ct_maketest(index_long_empty_path),
+
         ct_maketest(option_does_not_trigger_flag),
         ct_maketest(double_dash_ends_option_parsing),
         ct_maketest(double_dash_ends_option_parsing_unordered),
@@ -168,6 +168,34 @@ static void bank_copy_address_beyond_range(void *ctx)
     ct_assertequal(0x55u, dest[4]);
 }
 
+static void hash_empty(void *ctx)
+{
+    auto h = aldo_bytehash(AldoFnvBasis, 0, (const uint8_t[]){0});
+
+    ct_assertequal(AldoFnvBasis, h);
+}
+
+static void hash_known_values(void *ctx)
+{
+    static constexpr uint8_t a[] = {'a'};
+    static constexpr uint8_t foobar[] = {'f', 'o', 'o', 'b', 'a', 'r'};
+
+    ct_assertequal(0xaf63dc4c8601ec8cu,
+                   aldo_bytehash(AldoFnvBasis, sizeof a, a));
+    ct_assertequal(0x85944171f73967e8u,
+                   aldo_bytehash(AldoFnvBasis, sizeof foobar, foobar));
+}
+
+static void hash_continues(void *ctx)
+{
+    static constexpr uint8_t foobar[] = {'f', 'o', 'o', 'b', 'a', 'r'};
+
+    auto h = aldo_bytehash(AldoFnvBasis, 3, foobar);
+    h = aldo_bytehash(h, 3, foobar + 3);
+
+    ct_assertequal(0x85944171f73967e8u, h);
+}
+
 //
 // MARK: - Test List
 //
@@ -188,6 +216,10 @@ struct ct_testsuite bytes_tests()
         ct_maketest(bank_copy_end_of_bank),
         ct_maketest(bank_copy_fit_end_of_bank),
         ct_maketest(bank_copy_address_beyond_range),
+
+        ct_maketest(hash_empty),
+        ct_maketest(hash_known_values),
+        ct_maketest(hash_continues),
     };
 
     return ct_makesuite(tests);
@@ -0,0 +1,361 @@
+//
+//  callgraph.c
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "callgraph.h"
+#include "ciny.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+static void setup(void **ctx)
+{
+    *ctx = aldo_callgraph_new();
+}
+
+static void teardown(void **ctx)
+{
+    aldo_callgraph_free(*ctx);
+}
+
+// run one instruction of the given length in cycles
+static void exec(aldo_callgraph *cg, uint16_t addr, uint8_t s,
+                 enum aldo_cgevent ev, int cycles)
+{
+    aldo_callgraph_exec(cg, addr, s, ev);
+    for (auto i = 0; i < cycles; ++i) {
+        aldo_callgraph_cycles(cg, 1);
+    }
+}
+
+static const struct aldo_cgroutine *find(size_t count,
+                                         const struct aldo_cgroutine rs[count],
+                                         uint16_t entry)
+{
+    for (size_t i = 0; i < count; ++i) {
+        if (rs[i].entry == entry) return rs + i;
+    }
+    return nullptr;
+}
+
+//
+// MARK: - Tests
+//
+
+static void empty_graph(void *ctx)
+{
+    aldo_callgraph *cg = ctx;
+    struct aldo_cgroutine rs[4];
+
+    ct_assertequal(0u, aldo_callgraph_total(cg));
+    ct_assertequal(0u, aldo_callgraph_routines(cg, 4, rs));
+}
+
+static void reset_sequence_dropped(void *ctx)
+{
+    aldo_callgraph *cg = ctx;
+    struct aldo_cgroutine rs[4];
+
+    exec(cg, 0x1234, 0xfd, ALDO_CGE_RESET, 7);
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_NONE, 2);
+
+    ct_assertequal(2u, aldo_callgraph_total(cg));
+    auto count = aldo_callgraph_routines(cg, 4, rs);
+    ct_assertequal(1u, count);
+    ct_assertequal(ALDO_CGK_RESET, rs[0].kind);
+    ct_assertequal(0x8000u, rs[0].entry);
+    ct_assertequal(2u, rs[0].inclusive);
+}
+
+static void inclusive_and_exclusive(void *ctx)
+{
+    aldo_callgraph *cg = ctx;
+    struct aldo_cgroutine rs[4];
+
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_NONE, 2);
+    exec(cg, 0x8002, 0xfd, ALDO_CGE_CALL, 6);
+    exec(cg, 0x9000, 0xfb, ALDO_CGE_NONE, 2);
+    exec(cg, 0x9002, 0xfb, ALDO_CGE_CALL, 6);
+    exec(cg, 0xa000, 0xf9, ALDO_CGE_NONE, 4);
+    exec(cg, 0xa002, 0xf9, ALDO_CGE_RETURN, 6);
+    exec(cg, 0x9005, 0xfb, ALDO_CGE_RETURN, 6);
+    exec(cg, 0x8005, 0xfd, ALDO_CGE_NONE, 3);
+
+    ct_assertequal(35u, aldo_callgraph_total(cg));
+    auto count = aldo_callgraph_routines(cg, 4, rs);
+    ct_assertequal(3u, count);
+
+    ct_assertequal(0x8000u, rs[0].entry);
+    ct_assertequal(35u, rs[0].inclusive);
+    ct_assertequal(11u, rs[0].exclusive);
+
+    ct_assertequal(0x9000u, rs[1].entry);
+    ct_assertequal(ALDO_CGK_CALL, rs[1].kind);
+    ct_assertequal(24u, rs[1].inclusive);
+    ct_assertequal(14u, rs[1].exclusive);
+    ct_assertequal(1u, rs[1].calls);
+    ct_assertequal(24u, rs[1].maxcall);
+
+    ct_assertequal(0xa000u, rs[2].entry);
+    ct_assertequal(10u, rs[2].inclusive);
+    ct_assertequal(10u, rs[2].exclusive);
+}
+
+static void routine_merged_across_call_sites(void *ctx)
+{
+    aldo_callgraph *cg = ctx;
+    struct aldo_cgroutine rs[4];
+
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_CALL, 6);
+    exec(cg, 0x9000, 0xfb, ALDO_CGE_RETURN, 6);
+    exec(cg, 0x8003, 0xfd, ALDO_CGE_CALL, 6);
+    exec(cg, 0xa000, 0xfb, ALDO_CGE_CALL, 6);
+    exec(cg, 0x9000, 0xf9, ALDO_CGE_RETURN, 6);
+    exec(cg, 0xa003, 0xfb, ALDO_CGE_RETURN, 6);
+    exec(cg, 0x8006, 0xfd, ALDO_CGE_NONE, 2);
+
+    auto count = aldo_callgraph_routines(cg, 4, rs);
+    ct_assertequal(3u, count);
+    auto r = find(count, rs, 0x9000);
+    ct_assertnotnull(r);
+    ct_assertequal(2u, r->calls);
+    ct_assertequal(12u, r->inclusive);
+    ct_assertequal(12u, r->exclusive);
+}
+
+static void recursion_not_double_counted(void *ctx)
+{
+    aldo_callgraph *cg = ctx;
+    struct aldo_cgroutine rs[4];
+
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_CALL, 6);
+    exec(cg, 0x9000, 0xfb, ALDO_CGE_CALL, 6);
+    exec(cg, 0x9000, 0xf9, ALDO_CGE_RETURN, 6);
+    exec(cg, 0x9003, 0xfb, ALDO_CGE_RETURN, 6);
+    exec(cg, 0x8003, 0xfd, ALDO_CGE_NONE, 2);
+
+    auto count = aldo_callgraph_routines(cg, 4, rs);
+    ct_assertequal(2u, count);
+    auto r = find(count, rs, 0x9000);
+    ct_assertnotnull(r);
+    ct_assertequal(2u, r->calls);
+    ct_assertequal(18u, r->inclusive);
+    ct_assertequal(18u, r->exclusive);
+}
+
+static void rts_jump_does_not_pop(void *ctx)
+{
+    aldo_callgraph *cg = ctx;
+    struct aldo_cgroutine rs[4];
+
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_CALL, 6);
+    // routine pushes a target address and RTSes to it
+    exec(cg, 0x9000, 0xf9, ALDO_CGE_RETURN, 6);
+    exec(cg, 0x9100, 0xfb, ALDO_CGE_NONE, 2);
+
+    auto count = aldo_callgraph_routines(cg, 4, rs);
+    ct_assertequal(2u, count);
+    ct_assertequal(0x9000u, rs[1].entry);
+    ct_assertequal(8u, rs[1].exclusive);
+}
+
+static void discarded_return_resyncs(void *ctx)
+{
+    aldo_callgraph *cg = ctx;
+    struct aldo_cgroutine rs[4];
+
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_CALL, 6);
+    exec(cg, 0x9000, 0xfb, ALDO_CGE_CALL, 6);
+    // inner routine pulls its return address and returns to outer caller
+    exec(cg, 0xa000, 0xfb, ALDO_CGE_RETURN, 6);
+    exec(cg, 0x8003, 0xfd, ALDO_CGE_NONE, 2);
+
+    auto count = aldo_callgraph_routines(cg, 4, rs);
+    ct_assertequal(3u, count);
+    ct_assertequal(0x8000u, rs[0].entry);
+    ct_assertequal(8u, rs[0].exclusive);
+}
+
+static void interrupts_tracked(void *ctx)
+{
+    aldo_callgraph *cg = ctx;
+    struct aldo_cgroutine rs[4];
+
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_IRQ, 7);
+    exec(cg, 0xe000, 0xfa, ALDO_CGE_RETURN, 6);
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_BRK, 7);
+    exec(cg, 0xe000, 0xfa, ALDO_CGE_RETURN, 6);
+    exec(cg, 0x8002, 0xfd, ALDO_CGE_NONE, 2);
+
+    auto count = aldo_callgraph_routines(cg, 4, rs);
+    ct_assertequal(3u, count);
+    ct_assertequal(ALDO_CGK_RESET, rs[0].kind);
+    ct_assertequal(28u, rs[0].inclusive);
+    ct_assertequal(ALDO_CGK_BRK, rs[1].kind);
+    ct_assertequal(6u, rs[1].inclusive);
+    ct_assertequal(ALDO_CGK_IRQ, rs[2].kind);
+    ct_assertequal(6u, rs[2].inclusive);
+}
+
+static void nmi_overrun(void *ctx)
+{
+    aldo_callgraph *cg = ctx;
+    struct aldo_cgroutine rs[4];
+
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_NMI, 7);
+    exec(cg, 0xc000, 0xfa, ALDO_CGE_RETURN, 6);
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_NMI, 7);
+    exec(cg, 0xc000, 0xfa, ALDO_CGE_NONE, (int)Aldo_VBlankCycles);
+    exec(cg, 0xc002, 0xfa, ALDO_CGE_RETURN, 6);
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_NONE, 2);
+
+    auto count = aldo_callgraph_routines(cg, 4, rs);
+    ct_assertequal(2u, count);
+    auto r = find(count, rs, 0xc000);
+    ct_assertnotnull(r);
+    ct_assertequal(ALDO_CGK_NMI, r->kind);
+    ct_assertequal(2u, r->calls);
+    ct_assertequal(1u, r->overruns);
+    ct_assertequal(Aldo_VBlankCycles + 6, r->maxcall);
+}
+
+static void frame_peak(void *ctx)
+{
+    aldo_callgraph *cg = ctx;
+    struct aldo_cgroutine rs[4];
+
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_NONE, 10);
+    aldo_callgraph_frame(cg);
+    exec(cg, 0x8002, 0xfd, ALDO_CGE_NONE, 30);
+    aldo_callgraph_frame(cg);
+    exec(cg, 0x8004, 0xfd, ALDO_CGE_NONE, 20);
+
+    ct_assertequal(2u, aldo_callgraph_frames(cg));
+    auto count = aldo_callgraph_routines(cg, 4, rs);
+    ct_assertequal(1u, count);
+    ct_assertequal(60u, rs[0].exclusive);
+    ct_assertequal(30u, rs[0].framepeak);
+}
+
+static void routines_bounded(void *ctx)
+{
+    aldo_callgraph *cg = ctx;
+    struct aldo_cgroutine rs[2];
+
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_CALL, 6);
+    exec(cg, 0x9000, 0xfb, ALDO_CGE_RETURN, 6);
+    exec(cg, 0x8003, 0xfd, ALDO_CGE_CALL, 6);
+    exec(cg, 0xa000, 0xfb, ALDO_CGE_RETURN, 6);
+
+    auto count = aldo_callgraph_routines(cg, 2, rs);
+    ct_assertequal(2u, count);
+    ct_assertequal(0x8000u, rs[0].entry);
+}
+
+static void reset_clears_graph(void *ctx)
+{
+    aldo_callgraph *cg = ctx;
+    struct aldo_cgroutine rs[4];
+
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_CALL, 6);
+    exec(cg, 0x9000, 0xfb, ALDO_CGE_RETURN, 6);
+    aldo_callgraph_frame(cg);
+
+    aldo_callgraph_reset(cg);
+
+    ct_assertequal(0u, aldo_callgraph_total(cg));
+    ct_assertequal(0u, aldo_callgraph_frames(cg));
+    ct_assertequal(0u, aldo_callgraph_routines(cg, 4, rs));
+}
+
+static void folded_stacks(void *ctx)
+{
+    aldo_callgraph *cg = ctx;
+    auto f = tmpfile();
+
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_CALL, 6);
+    exec(cg, 0x9000, 0xfb, ALDO_CGE_RETURN, 6);
+    exec(cg, 0x8003, 0xfd, ALDO_CGE_NMI, 7);
+    exec(cg, 0xc000, 0xfa, ALDO_CGE_RETURN, 6);
+
+    ct_asserttrue(aldo_callgraph_write_folded(cg, f));
+
+    rewind(f);
+    char buf[64];
+    ct_assertnotnull(fgets(buf, sizeof buf, f));
+    ct_assertequalstr("RESET:$8000 13\n", buf);
+    ct_assertnotnull(fgets(buf, sizeof buf, f));
+    ct_assertequalstr("RESET:$8000;NMI:$C000 6\n", buf);
+    ct_assertnotnull(fgets(buf, sizeof buf, f));
+    ct_assertequalstr("RESET:$8000;$9000 6\n", buf);
+    ct_assertnull(fgets(buf, sizeof buf, f));
+    fclose(f);
+}
+
+static void json_tree(void *ctx)
+{
+    aldo_callgraph *cg = ctx;
+    auto f = tmpfile();
+
+    exec(cg, 0x8000, 0xfd, ALDO_CGE_CALL, 6);
+    exec(cg, 0x9000, 0xfb, ALDO_CGE_RETURN, 6);
+
+    ct_asserttrue(aldo_callgraph_write_json(cg, f));
+
+    rewind(f);
+    char buf[512];
+    auto len = fread(buf, 1, sizeof buf - 1, f);
+    buf[len] = '\0';
+    ct_assertnotnull(strstr(buf, "\"cycles\": 12, \"frames\": 0"));
+    ct_assertnotnull(strstr(buf, "{\"name\": \"RESET:$8000\", \"kind\": \"RESET\""));
+    ct_assertnotnull(strstr(buf, "{\"name\": \"$9000\", \"kind\": \"JSR\""
+                            ", \"entry\": 36864, \"calls\": 1, "
+                            "\"inclusive\": 6, \"exclusive\": 6"));
+    ct_assertnotnull(strstr(buf, "\"children\": ["));
+    fclose(f);
+}
+
+static void json_empty(void *ctx)
+{
+    aldo_callgraph *cg = ctx;
+    auto f = tmpfile();
+
+    ct_asserttrue(aldo_callgraph_write_json(cg, f));
+
+    rewind(f);
+    char buf[128];
+    ct_assertnotnull(fgets(buf, sizeof buf, f));
+    ct_assertnotnull(strstr(buf, "\"root\": null}"));
+    fclose(f);
+}
+
+//
+// MARK: - Test List
+//
+
+struct ct_testsuite callgraph_tests()
+{
+    static constexpr struct ct_testcase tests[] = {
+        ct_maketest(empty_graph),
+        ct_maketest(reset_sequence_dropped),
+        ct_maketest(inclusive_and_exclusive),
+        ct_maketest(routine_merged_across_call_sites),
+        ct_maketest(recursion_not_double_counted),
+        ct_maketest(rts_jump_does_not_pop),
+        ct_maketest(discarded_return_resyncs),
+        ct_maketest(interrupts_tracked),
+        ct_maketest(nmi_overrun),
+        ct_maketest(frame_peak),
+        ct_maketest(routines_bounded),
+        ct_maketest(reset_clears_graph),
+        ct_maketest(folded_stacks),
+        ct_maketest(json_tree),
+        ct_maketest(json_empty),
+    };
+
+    return ct_makesuite_setup_teardown(tests, setup, teardown);
+}
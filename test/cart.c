@@ -0,0 +1,344 @@
+//
+//  cart.c
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "bytes.h"
+#include "cart.h"
+#include "carthelp.h"
+#include "ciny.h"
+#include "png.h"
+#include "romcache.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+constexpr size_t RawSize = 0x8000;
+
+struct cart_context {
+    aldo_cart *cart;
+    uint8_t image[NromSize];
+};
+
+static void setup(void **ctx)
+{
+    struct cart_context *c = calloc(1, sizeof *c);
+    make_nrom(c->image, 0, nullptr, ALDO_MEMBLOCK_32KB);
+    *ctx = c;
+}
+
+static void teardown(void **ctx)
+{
+    struct cart_context *c = *ctx;
+    if (c->cart) {
+        aldo_cart_free(c->cart);
+    }
+    free(c);
+}
+
+// wrap the image in a single stored deflate block, returning its length
+static size_t deflate_stored(const struct cart_context *c, uint8_t *out)
+{
+    out[0] = 0x1;
+    aldo_wrtoba(sizeof c->image, out + 1);
+    aldo_wrtoba((uint16_t)~sizeof c->image, out + 3);
+    memcpy(out + 5, c->image, sizeof c->image);
+    return 5 + sizeof c->image;
+}
+
+static void write_zip(const struct cart_context *c, const char *name,
+                      FILE *f)
+{
+    uint8_t header[46] = {};
+    auto namelen = (uint16_t)strlen(name);
+    auto crc = aldo_png_crc(0, sizeof c->image, c->image);
+
+    aldo_dwtoba(0x04034b50, header);
+    aldo_dwtoba(crc, header + 14);
+    aldo_dwtoba(sizeof c->image, header + 18);
+    aldo_dwtoba(sizeof c->image, header + 22);
+    aldo_wrtoba(namelen, header + 26);
+    fwrite(header, 1, 30, f);
+    fputs(name, f);
+    fwrite(c->image, sizeof c->image[0], sizeof c->image, f);
+
+    auto central = (uint32_t)ftell(f);
+    memset(header, 0, sizeof header);
+    aldo_dwtoba(0x02014b50, header);
+    aldo_dwtoba(crc, header + 16);
+    aldo_dwtoba(sizeof c->image, header + 20);
+    aldo_dwtoba(sizeof c->image, header + 24);
+    aldo_wrtoba(namelen, header + 28);
+    fwrite(header, 1, sizeof header, f);
+    fputs(name, f);
+
+    uint8_t end[22] = {};
+    aldo_dwtoba(0x06054b50, end);
+    aldo_wrtoba(1, end + 8);
+    aldo_wrtoba(1, end + 10);
+    aldo_dwtoba((uint32_t)(46 + namelen), end + 12);
+    aldo_dwtoba(central, end + 16);
+    fwrite(end, 1, sizeof end, f);
+}
+
+//
+// MARK: - Tests
+//
+
+static void mem_ines_uses_image_in_place(void *ctx)
+{
+    struct cart_context *c = ctx;
+
+    auto err = aldo_cart_create_mem(&c->cart, sizeof c->image, c->image);
+
+    ct_assertequal(0, err);
+    struct aldo_cartinfo info;
+    aldo_cart_getinfo(c->cart, &info);
+    ct_assertequal(ALDO_CRTF_INES, (int)info.format);
+    auto bv = aldo_cart_prgblock(c->cart, 0);
+    ct_assertequal(NromPrgSize, bv.size);
+    ct_assertsame(c->image + NromHeaderSize, bv.mem);
+    bv = aldo_cart_chrblock(c->cart, 0);
+    ct_assertequal(NromChrSize, bv.size);
+    ct_assertsame(c->image + NromHeaderSize + NromPrgSize, bv.mem);
+}
+
+static void mem_ines_chr_ram(void *ctx)
+{
+    struct cart_context *c = ctx;
+    c->image[5] = 0;
+
+    auto err = aldo_cart_create_mem(&c->cart, NromHeaderSize + NromPrgSize,
+                                    c->image);
+
+    ct_assertequal(0, err);
+    ct_assertnull(aldo_cart_chrblock(c->cart, 0).mem);
+    // CHR RAM plus NROM's WRAM bank
+    ct_assertequal(NromChrSize + 0x2000, aldo_cart_ramsize(c->cart));
+}
+
+static void mem_ines_truncated(void *ctx)
+{
+    struct cart_context *c = ctx;
+
+    auto err = aldo_cart_create_mem(&c->cart, sizeof c->image - 1, c->image);
+
+    ct_assertequal(ALDO_CART_ERR_EOF, err);
+    ct_assertnull(c->cart);
+}
+
+static void mem_ines_short_header(void *ctx)
+{
+    struct cart_context *c = ctx;
+
+    auto err = aldo_cart_create_mem(&c->cart, NromHeaderSize - 1, c->image);
+
+    ct_assertequal(ALDO_CART_ERR_EOF, err);
+    ct_assertnull(c->cart);
+}
+
+static void mem_ines_obsolete(void *ctx)
+{
+    struct cart_context *c = ctx;
+    c->image[15] = 0x1;
+
+    auto err = aldo_cart_create_mem(&c->cart, sizeof c->image, c->image);
+
+    ct_assertequal(ALDO_CART_ERR_OBSOLETE, err);
+    ct_assertnull(c->cart);
+}
+
+static void mem_nes20_unsupported(void *ctx)
+{
+    struct cart_context *c = ctx;
+    c->image[7] = 0x8;
+
+    auto err = aldo_cart_create_mem(&c->cart, sizeof c->image, c->image);
+
+    ct_assertequal(ALDO_CART_ERR_FORMAT, err);
+    ct_assertnull(c->cart);
+}
+
+static void mem_empty(void *ctx)
+{
+    struct cart_context *c = ctx;
+
+    auto err = aldo_cart_create_mem(&c->cart, 0, c->image);
+
+    ct_assertequal(ALDO_CART_ERR_EOF, err);
+    ct_assertnull(c->cart);
+}
+
+static void mem_raw_uses_image_in_place(void *ctx)
+{
+    struct cart_context *c = ctx;
+    uint8_t *raw = calloc(RawSize + 1, sizeof *raw);
+
+    auto err = aldo_cart_create_mem(&c->cart, RawSize, raw);
+
+    ct_assertequal(0, err);
+    struct aldo_cartinfo info;
+    aldo_cart_getinfo(c->cart, &info);
+    ct_assertequal(ALDO_CRTF_RAW, (int)info.format);
+    ct_assertsame(raw, aldo_cart_prgblock(c->cart, 0).mem);
+    aldo_cart_free(c->cart);
+    c->cart = nullptr;
+
+    err = aldo_cart_create_mem(&c->cart, RawSize + 1, raw);
+
+    ct_assertequal(ALDO_CART_ERR_IMG_SIZE, err);
+    ct_assertnull(c->cart);
+    free(raw);
+}
+
+static void stream_copies_image(void *ctx)
+{
+    struct cart_context *c = ctx;
+    auto f = nrom_tmpfile(c->image);
+    ct_assertnotnull(f);
+
+    auto err = aldo_cart_create(&c->cart, f);
+    fclose(f);
+
+    ct_assertequal(0, err);
+    auto bv = aldo_cart_chrblock(c->cart, 0);
+    ct_assertnotnull(bv.mem);
+    ct_assertfalse(bv.mem == c->image + NromHeaderSize + NromPrgSize);
+    ct_assertequal(0, memcmp(c->image + NromHeaderSize + NromPrgSize, bv.mem,
+                             NromChrSize));
+}
+
+static void stream_shares_identical_images(void *ctx)
+{
+    struct cart_context *c = ctx;
+    auto start = aldo_romcache_count();
+    auto f = nrom_tmpfile(c->image);
+    ct_assertnotnull(f);
+    aldo_cart *other;
+
+    auto err = aldo_cart_create(&c->cart, f);
+    rewind(f);
+    auto othererr = aldo_cart_create(&other, f);
+    fclose(f);
+
+    ct_assertequal(0, err);
+    ct_assertequal(0, othererr);
+    ct_assertequal(start + 1, aldo_romcache_count());
+    ct_assertsame(aldo_cart_prgblock(c->cart, 0).mem,
+                  aldo_cart_prgblock(other, 0).mem);
+
+    aldo_cart_free(other);
+
+    ct_assertequal(start + 1, aldo_romcache_count());
+}
+
+static void file_maps_image(void *ctx)
+{
+    struct cart_context *c = ctx;
+    char path[NromPathSize];
+    ct_asserttrue(write_nrom(c->image, path));
+
+    auto err = aldo_cart_create_file(&c->cart, path);
+    unlink(path);
+
+    ct_assertequal(0, err);
+    auto bv = aldo_cart_prgblock(c->cart, 0);
+    ct_assertequal(NromPrgSize, bv.size);
+    ct_assertequal(0, memcmp(c->image + NromHeaderSize, bv.mem, NromPrgSize));
+    bv = aldo_cart_chrblock(c->cart, 0);
+    ct_assertequal(0, memcmp(c->image + NromHeaderSize + NromPrgSize, bv.mem,
+                             NromChrSize));
+}
+
+static void file_missing(void *ctx)
+{
+    struct cart_context *c = ctx;
+
+    auto err = aldo_cart_create_file(&c->cart, "/tmp/aldo-no-such-cart.nes");
+
+    ct_assertequal(ALDO_CART_ERR_ERNO, err);
+    ct_assertequal(ENOENT, errno);
+    ct_assertnull(c->cart);
+}
+
+static void mem_gzip_decompresses(void *ctx)
+{
+    struct cart_context *c = ctx;
+    static constexpr uint8_t header[] = {
+        0x1f, 0x8b, 0x8, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0xff,
+    };
+    uint8_t gz[sizeof header + 5 + sizeof c->image + 8];
+    memcpy(gz, header, sizeof header);
+    auto size = sizeof header + deflate_stored(c, gz + sizeof header);
+    aldo_dwtoba(aldo_png_crc(0, sizeof c->image, c->image), gz + size);
+    aldo_dwtoba(sizeof c->image, gz + size + 4);
+
+    auto err = aldo_cart_create_mem(&c->cart, sizeof gz, gz);
+
+    ct_assertequal(0, err);
+    struct aldo_cartinfo info;
+    aldo_cart_getinfo(c->cart, &info);
+    ct_assertequal(ALDO_CRTF_INES, (int)info.format);
+    auto bv = aldo_cart_prgblock(c->cart, 0);
+    ct_assertequal(NromPrgSize, bv.size);
+    ct_assertequal(0, memcmp(c->image + NromHeaderSize, bv.mem, NromPrgSize));
+}
+
+static void file_zip_named_entry(void *ctx)
+{
+    struct cart_context *c = ctx;
+    char path[64], entrypath[96];
+    snprintf(path, sizeof path, "/tmp/aldo-cart-%ld.zip", (long)getpid());
+    snprintf(entrypath, sizeof entrypath, "%s#game.rom", path);
+    auto f = fopen(path, "wb");
+    ct_assertnotnull(f);
+    write_zip(c, "game.rom", f);
+    fclose(f);
+
+    auto err = aldo_cart_create_file(&c->cart, path);
+
+    // no .nes entry so a bare archive path finds nothing
+    ct_assertequal(ALDO_CART_ERR_ARCHIVE, err);
+
+    err = aldo_cart_create_file(&c->cart, entrypath);
+    unlink(path);
+
+    ct_assertequal(0, err);
+    auto bv = aldo_cart_chrblock(c->cart, 0);
+    ct_assertequal(NromChrSize, bv.size);
+    ct_assertequal(0, memcmp(c->image + NromHeaderSize + NromPrgSize, bv.mem,
+                             NromChrSize));
+}
+
+//
+// MARK: - Test List
+//
+
+struct ct_testsuite cart_tests()
+{
+    static const struct ct_testcase tests[] = {
+        ct_maketest(mem_ines_uses_image_in_place),
+        ct_maketest(mem_ines_chr_ram),
+        ct_maketest(mem_ines_truncated),
+        ct_maketest(mem_ines_short_header),
+        ct_maketest(mem_ines_obsolete),
+        ct_maketest(mem_nes20_unsupported),
+        ct_maketest(mem_empty),
+        ct_maketest(mem_raw_uses_image_in_place),
+        ct_maketest(stream_copies_image),
+        ct_maketest(stream_shares_identical_images),
+        ct_maketest(file_maps_image),
+        ct_maketest(file_missing),
+        ct_maketest(mem_gzip_decompresses),
+        ct_maketest(file_zip_named_entry),
+    };
+
+    return ct_makesuite_setup_teardown(tests, setup, teardown);
+}
@@ -0,0 +1,65 @@
+//
+//  carthelp.c
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "carthelp.h"
+
+#include "bytes.h"
+
+#include <assert.h>
+#include <string.h>
+#include <unistd.h>
+
+//
+// MARK: - Public Interface
+//
+
+void make_nrom(uint8_t image[static NromSize], size_t size,
+               const uint8_t code[size], uint16_t intvector)
+{
+    static const uint8_t header[NromHeaderSize] = {
+        'N', 'E', 'S', 0x1a, 0x1, 0x1,
+    };
+
+    assert(size <= NromPrgSize - 6);
+
+    memcpy(image, header, sizeof header);
+    auto prg = image + NromHeaderSize;
+    memset(prg, 0xea, NromPrgSize);
+    if (size > 0) {
+        memcpy(prg, code, size);
+    }
+    // 16KB PRG is mirrored across $8000-$FFFF
+    aldo_wrtoba(intvector, prg + (ALDO_CPU_VECTOR_NMI & ALDO_ADDRMASK_16KB));
+    aldo_wrtoba(ALDO_MEMBLOCK_32KB,
+                prg + (ALDO_CPU_VECTOR_RST & ALDO_ADDRMASK_16KB));
+    aldo_wrtoba(intvector, prg + (ALDO_CPU_VECTOR_IRQ & ALDO_ADDRMASK_16KB));
+    for (size_t i = 0; i < NromChrSize; ++i) {
+        prg[NromPrgSize + i] = (uint8_t)i;
+    }
+}
+
+FILE *nrom_tmpfile(const uint8_t image[static NromSize])
+{
+    auto f = tmpfile();
+    if (!f) return nullptr;
+    if (fwrite(image, sizeof image[0], NromSize, f) != NromSize) {
+        fclose(f);
+        return nullptr;
+    }
+    rewind(f);
+    return f;
+}
+
+bool write_nrom(const uint8_t image[static NromSize],
+                char path[static NromPathSize])
+{
+    snprintf(path, NromPathSize, "/tmp/aldo-nrom-%ld.nes", (long)getpid());
+    auto f = fopen(path, "wb");
+    if (!f) return false;
+    auto written = fwrite(image, sizeof image[0], NromSize, f) == NromSize;
+    return fclose(f) == 0 && written;
+}
@@ -0,0 +1,33 @@
+//
+//  carthelp.h
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#ifndef AldoTests_carthelp_h
+#define AldoTests_carthelp_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+constexpr size_t NromHeaderSize = 16;
+constexpr size_t NromPrgSize = 0x4000;
+constexpr size_t NromChrSize = 0x2000;
+constexpr size_t NromSize = NromHeaderSize + NromPrgSize + NromChrSize;
+constexpr size_t NromPathSize = 64;
+
+// Single-bank NROM image: iNES header, 16KB PRG filled with NOP but for
+// code copied to its start ($8000, the RESET vector) and NMI and IRQ
+// vectors pointing at intvector, 8KB CHR holding a byte ramp.
+void make_nrom(uint8_t image[static NromSize], size_t size,
+               const uint8_t code[size], uint16_t intvector);
+// rewound temp file holding image; returns null if it cannot be created
+FILE *nrom_tmpfile(const uint8_t image[static NromSize]);
+// write image to a per-process .nes file in /tmp, filling in its path;
+// the caller unlinks it.
+bool write_nrom(const uint8_t image[static NromSize],
+                char path[static NromPathSize]);
+
+#endif
@@ -0,0 +1,294 @@
+//
+//  cdl.c
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "bytes.h"
+#include "cart.h"
+#include "carthelp.h"
+#include "cdl.h"
+#include "ciny.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+struct cdl_context {
+    aldo_cart *cart;
+    aldo_cdl *cdl;
+};
+
+static void setup(void **ctx)
+{
+    uint8_t image[NromSize];
+    make_nrom(image, 0, nullptr, ALDO_MEMBLOCK_32KB);
+
+    struct cdl_context *c = calloc(1, sizeof *c);
+    auto f = nrom_tmpfile(image);
+    auto err = f ? aldo_cart_create(&c->cart, f) : ALDO_CART_ERR_ERNO;
+    if (f) {
+        fclose(f);
+    }
+    c->cdl = err == 0 ? aldo_cdl_new(c->cart) : nullptr;
+    *ctx = c;
+}
+
+static void teardown(void **ctx)
+{
+    struct cdl_context *c = *ctx;
+    if (c->cdl) {
+        aldo_cdl_free(c->cdl);
+    }
+    if (c->cart) {
+        aldo_cart_free(c->cart);
+    }
+    free(c);
+}
+
+//
+// MARK: - Tests
+//
+
+static void new_log(void *ctx)
+{
+    aldo_cdl *cdl = ((struct cdl_context *)ctx)->cdl;
+
+    auto cov = aldo_cdl_coverage(cdl);
+
+    ct_assertequal(NromPrgSize, cov.prgsize);
+    ct_assertequal(0u, cov.code);
+    ct_assertequal(0u, cov.data);
+    ct_assertequal(NromChrSize, cov.chrsize);
+    ct_assertequal(0u, cov.rendered);
+    ct_assertequal(0u, cov.read);
+}
+
+static void opcode_marks_code_and_bank(void *ctx)
+{
+    aldo_cdl *cdl = ((struct cdl_context *)ctx)->cdl;
+
+    aldo_cdl_opcode(cdl, 0xc010, 0x10, false);
+
+    ct_assertequal(ALDO_CDL_CODE | ALDO_CDL_OPCODE | 0x8,
+                   aldo_cdl_prg(cdl, 0x10));
+}
+
+static void indirect_jump_marks_target(void *ctx)
+{
+    aldo_cdl *cdl = ((struct cdl_context *)ctx)->cdl;
+
+    aldo_cdl_opcode(cdl, 0x8000, 0x0, true);
+    aldo_cdl_opcode(cdl, 0x9000, 0x1000, false);
+    aldo_cdl_opcode(cdl, 0x9003, 0x1003, false);
+
+    ct_assertequal(ALDO_CDL_CODE | ALDO_CDL_OPCODE, aldo_cdl_prg(cdl, 0x0));
+    ct_assertequal(ALDO_CDL_CODE | ALDO_CDL_OPCODE | ALDO_CDL_INDCODE,
+                   aldo_cdl_prg(cdl, 0x1000));
+    ct_assertequal(ALDO_CDL_CODE | ALDO_CDL_OPCODE, aldo_cdl_prg(cdl, 0x1003));
+}
+
+static void cpuread_accumulates_flags(void *ctx)
+{
+    aldo_cdl *cdl = ((struct cdl_context *)ctx)->cdl;
+
+    aldo_cdl_cpuread(cdl, 0xe000, 0x2000, ALDO_CDL_DATA);
+    aldo_cdl_cpuread(cdl, 0xe000, 0x2000, ALDO_CDL_DATA | ALDO_CDL_INDDATA);
+
+    ct_assertequal(ALDO_CDL_DATA | ALDO_CDL_INDDATA | 0xc,
+                   aldo_cdl_prg(cdl, 0x2000));
+    auto cov = aldo_cdl_coverage(cdl);
+    ct_assertequal(0u, cov.code);
+    ct_assertequal(1u, cov.data);
+}
+
+static void low_address_has_no_bank(void *ctx)
+{
+    aldo_cdl *cdl = ((struct cdl_context *)ctx)->cdl;
+
+    aldo_cdl_cpuread(cdl, 0x6000, 0x0, ALDO_CDL_DATA);
+
+    ct_assertequal(ALDO_CDL_DATA, aldo_cdl_prg(cdl, 0x0));
+}
+
+static void out_of_range_ignored(void *ctx)
+{
+    aldo_cdl *cdl = ((struct cdl_context *)ctx)->cdl;
+
+    aldo_cdl_opcode(cdl, 0x0200, -1, false);
+    aldo_cdl_cpuread(cdl, 0x8000, NromPrgSize, ALDO_CDL_DATA);
+    aldo_cdl_ppuread(cdl, -1, ALDO_CDL_RENDERED);
+    aldo_cdl_ppuread(cdl, NromChrSize, ALDO_CDL_RENDERED);
+
+    auto cov = aldo_cdl_coverage(cdl);
+    ct_assertequal(0u, cov.code);
+    ct_assertequal(0u, cov.data);
+    ct_assertequal(0u, cov.rendered);
+    ct_assertequal(0u, aldo_cdl_prg(cdl, NromPrgSize));
+    ct_assertequal(0u, aldo_cdl_chr(cdl, NromChrSize));
+}
+
+static void ppuread_marks_chr(void *ctx)
+{
+    aldo_cdl *cdl = ((struct cdl_context *)ctx)->cdl;
+
+    aldo_cdl_ppuread(cdl, 0x10, ALDO_CDL_RENDERED);
+    aldo_cdl_ppuread(cdl, 0x10, ALDO_CDL_READ);
+    aldo_cdl_ppuread(cdl, 0x1fff, ALDO_CDL_READ);
+
+    ct_assertequal(ALDO_CDL_RENDERED | ALDO_CDL_READ, aldo_cdl_chr(cdl, 0x10));
+    ct_assertequal(ALDO_CDL_READ, aldo_cdl_chr(cdl, 0x1fff));
+    auto cov = aldo_cdl_coverage(cdl);
+    ct_assertequal(1u, cov.rendered);
+    ct_assertequal(2u, cov.read);
+}
+
+static void datarun_stops_at_code(void *ctx)
+{
+    aldo_cdl *cdl = ((struct cdl_context *)ctx)->cdl;
+
+    for (uint16_t i = 0x10; i < 0x18; ++i) {
+        aldo_cdl_cpuread(cdl, 0x8000 + i, i, ALDO_CDL_DATA);
+    }
+    aldo_cdl_cpuread(cdl, 0x8014, 0x14, ALDO_CDL_CODE);
+
+    ct_assertequal(4u, aldo_cdl_datarun(cdl, 0x10, 0x100));
+    ct_assertequal(2u, aldo_cdl_datarun(cdl, 0x10, 2));
+    ct_assertequal(0u, aldo_cdl_datarun(cdl, 0x14, 0x100));
+    ct_assertequal(3u, aldo_cdl_datarun(cdl, 0x15, 0x100));
+    ct_assertequal(0u, aldo_cdl_datarun(cdl, 0x18, 0x100));
+}
+
+static void datarun_stops_at_end(void *ctx)
+{
+    aldo_cdl *cdl = ((struct cdl_context *)ctx)->cdl;
+
+    aldo_cdl_cpuread(cdl, 0xfffe, NromPrgSize - 2, ALDO_CDL_DATA);
+    aldo_cdl_cpuread(cdl, 0xffff, NromPrgSize - 1, ALDO_CDL_DATA);
+
+    ct_assertequal(2u, aldo_cdl_datarun(cdl, NromPrgSize - 2, 0x100));
+    ct_assertequal(0u, aldo_cdl_datarun(cdl, NromPrgSize, 0x100));
+}
+
+static void reset_clears_log(void *ctx)
+{
+    aldo_cdl *cdl = ((struct cdl_context *)ctx)->cdl;
+    aldo_cdl_opcode(cdl, 0x8000, 0x0, true);
+    aldo_cdl_ppuread(cdl, 0x0, ALDO_CDL_RENDERED);
+
+    aldo_cdl_reset(cdl);
+    aldo_cdl_opcode(cdl, 0x8010, 0x10, false);
+
+    ct_assertequal(0u, aldo_cdl_prg(cdl, 0x0));
+    ct_assertequal(0u, aldo_cdl_chr(cdl, 0x0));
+    ct_assertequal(ALDO_CDL_CODE | ALDO_CDL_OPCODE, aldo_cdl_prg(cdl, 0x10));
+}
+
+static void write_strips_opcode(void *ctx)
+{
+    aldo_cdl *cdl = ((struct cdl_context *)ctx)->cdl;
+    aldo_cdl_opcode(cdl, 0x8000, 0x0, false);
+    aldo_cdl_cpuread(cdl, 0x8001, 0x1, ALDO_CDL_CODE);
+    aldo_cdl_cpuread(cdl, 0xfffc, NromPrgSize - 4, ALDO_CDL_DATA);
+    aldo_cdl_ppuread(cdl, 0x20, ALDO_CDL_RENDERED);
+    auto f = tmpfile();
+
+    auto result = aldo_cdl_write(cdl, f);
+
+    ct_asserttrue(result);
+    ct_assertequal((long)(NromPrgSize + NromChrSize), ftell(f));
+    rewind(f);
+    uint8_t buf[NromPrgSize + NromChrSize];
+    ct_assertequal(sizeof buf, fread(buf, sizeof buf[0], sizeof buf, f));
+    ct_assertequal(ALDO_CDL_CODE, buf[0]);
+    ct_assertequal(ALDO_CDL_CODE, buf[1]);
+    ct_assertequal(0u, buf[2]);
+    ct_assertequal(ALDO_CDL_DATA | 0xc, buf[NromPrgSize - 4]);
+    ct_assertequal(ALDO_CDL_RENDERED, buf[NromPrgSize + 0x20]);
+    fclose(f);
+}
+
+static void read_merges_log(void *ctx)
+{
+    aldo_cdl *cdl = ((struct cdl_context *)ctx)->cdl;
+    aldo_cdl_cpuread(cdl, 0x8000, 0x0, ALDO_CDL_CODE);
+    auto f = tmpfile();
+    for (size_t i = 0; i < NromPrgSize + NromChrSize; ++i) {
+        uint8_t b = 0;
+        if (i == 0x0 || i == 0x10) {
+            b = ALDO_CDL_DATA;
+        } else if (i == NromPrgSize + 0x5) {
+            b = ALDO_CDL_READ;
+        }
+        fputc(b, f);
+    }
+    rewind(f);
+
+    auto result = aldo_cdl_read(cdl, f);
+
+    ct_asserttrue(result);
+    ct_assertequal(ALDO_CDL_CODE | ALDO_CDL_DATA, aldo_cdl_prg(cdl, 0x0));
+    ct_assertequal(ALDO_CDL_DATA, aldo_cdl_prg(cdl, 0x10));
+    ct_assertequal(ALDO_CDL_READ, aldo_cdl_chr(cdl, 0x5));
+    fclose(f);
+}
+
+static void read_too_short(void *ctx)
+{
+    aldo_cdl *cdl = ((struct cdl_context *)ctx)->cdl;
+    auto f = tmpfile();
+    for (size_t i = 0; i < NromPrgSize; ++i) {
+        fputc(ALDO_CDL_DATA, f);
+    }
+    rewind(f);
+
+    auto result = aldo_cdl_read(cdl, f);
+
+    ct_assertfalse(result);
+    ct_assertequal(0u, aldo_cdl_coverage(cdl).data);
+    fclose(f);
+}
+
+static void read_too_long(void *ctx)
+{
+    aldo_cdl *cdl = ((struct cdl_context *)ctx)->cdl;
+    auto f = tmpfile();
+    for (size_t i = 0; i < NromPrgSize + NromChrSize + 1; ++i) {
+        fputc(ALDO_CDL_DATA, f);
+    }
+    rewind(f);
+
+    auto result = aldo_cdl_read(cdl, f);
+
+    ct_assertfalse(result);
+    ct_assertequal(0u, aldo_cdl_coverage(cdl).data);
+    fclose(f);
+}
+
+//
+// MARK: - Test List
+//
+
+struct ct_testsuite cdl_tests()
+{
+    static const struct ct_testcase tests[] = {
+        ct_maketest(new_log),
+        ct_maketest(opcode_marks_code_and_bank),
+        ct_maketest(indirect_jump_marks_target),
+        ct_maketest(cpuread_accumulates_flags),
+        ct_maketest(low_address_has_no_bank),
+        ct_maketest(out_of_range_ignored),
+        ct_maketest(ppuread_marks_chr),
+        ct_maketest(datarun_stops_at_code),
+        ct_maketest(datarun_stops_at_end),
+        ct_maketest(reset_clears_log),
+        ct_maketest(write_strips_opcode),
+        ct_maketest(read_merges_log),
+        ct_maketest(read_too_short),
+        ct_maketest(read_too_long),
+    };
+
+    return ct_makesuite_setup_teardown(tests, setup, teardown);
+}
@@ -5,11 +5,18 @@
 //  Created by Brandon Stansbury on 2/18/23.
 //
 
+#include "bus.h"
+#include "bytes.h"
 #include "ciny.h"
+#include "cpu.h"
+#include "cycleclock.h"
 #include "debug.h"
 #include "haltexpr.h"
+#include "ppu.h"
 
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
 static void setup(void **ctx)
 {
@@ -21,6 +28,25 @@ static void teardown(void **ctx)
     aldo_debug_free(*ctx);
 }
 
+static size_t test_copy(const void *restrict ctx, uint16_t addr, size_t count,
+                        uint8_t dest[restrict count])
+{
+    memcpy(dest, (const uint8_t *)ctx + addr, count);
+    return count;
+}
+
+static bool test_read(void *restrict ctx, uint16_t addr, uint8_t *restrict d)
+{
+    *d = ((uint8_t *)ctx)[addr];
+    return true;
+}
+
+static bool test_write(void *ctx, uint16_t addr, uint8_t d)
+{
+    ((uint8_t *)ctx)[addr] = d;
+    return true;
+}
+
 static void verify_haltexpr(const struct aldo_haltexpr *expr,
                             const struct aldo_breakpoint *bp)
 {
@@ -202,6 +228,507 @@ static void halt_no_breakpoint(void *ctx)
     ct_assertequal(Aldo_NoBreakpoint, aldo_debug_halted_at(dbg));
 }
 
+static void not_armed_without_breakpoints(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    struct aldo_mos6502 cpu = {};
+
+    ct_assertfalse(aldo_debug_armed(dbg));
+
+    aldo_debug_cpu_connect(dbg, &cpu);
+
+    ct_assertfalse(aldo_debug_armed(dbg));
+}
+
+static void not_armed_without_cpu(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    struct aldo_haltexpr expr = {.cond = ALDO_HLT_ADDR, .address = 0x4321};
+
+    (void)aldo_debug_bp_add(dbg, expr);
+
+    ct_assertfalse(aldo_debug_armed(dbg));
+}
+
+static void not_armed_with_disabled_breakpoints(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    struct aldo_mos6502 cpu = {};
+    struct aldo_haltexpr expr = {.cond = ALDO_HLT_ADDR, .address = 0x4321};
+    aldo_debug_cpu_connect(dbg, &cpu);
+    (void)aldo_debug_bp_add(dbg, expr);
+
+    ct_asserttrue(aldo_debug_armed(dbg));
+
+    aldo_debug_bp_enable(dbg, 0, false);
+
+    ct_assertfalse(aldo_debug_armed(dbg));
+}
+
+static void halt_on_address(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    struct aldo_mos6502 cpu = {.addrinst = 0x8000, .signal.sync = true};
+    struct aldo_clock clk = {};
+    aldo_debug_cpu_connect(dbg, &cpu);
+    for (auto addr = 0x1000; addr < 0x1100; ++addr) {
+        struct aldo_haltexpr expr = {
+            .cond = ALDO_HLT_ADDR,
+            .address = (uint16_t)addr,
+        };
+        (void)aldo_debug_bp_add(dbg, expr);
+    }
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    cpu.addrinst = 0x1080;
+
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+    ct_assertequal(0x80, aldo_debug_halted_at(dbg));
+
+    // resume clears halt state
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+    ct_assertequal(Aldo_NoBreakpoint, aldo_debug_halted_at(dbg));
+
+    cpu.signal.sync = false;
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+}
+
+static void halt_on_first_matching_breakpoint(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    struct aldo_mos6502 cpu = {.addrinst = 0x4321, .signal.sync = true};
+    struct aldo_clock clk = {.cycles = 20};
+    struct aldo_haltexpr exprs[] = {
+        {.cond = ALDO_HLT_ADDR, .address = 0x1234},
+        {.cond = ALDO_HLT_CYCLES, .cycles = 20},
+        {.cond = ALDO_HLT_ADDR, .address = 0x4321},
+    };
+    aldo_debug_cpu_connect(dbg, &cpu);
+    for (size_t i = 0; i < sizeof exprs / sizeof exprs[0]; ++i) {
+        (void)aldo_debug_bp_add(dbg, exprs[i]);
+    }
+
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+    ct_assertequal(1, aldo_debug_halted_at(dbg));
+}
+
+static void halt_skips_disabled_address(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    struct aldo_mos6502 cpu = {.addrinst = 0x4321, .signal.sync = true};
+    struct aldo_clock clk = {};
+    struct aldo_haltexpr expr = {.cond = ALDO_HLT_ADDR, .address = 0x4321};
+    aldo_debug_cpu_connect(dbg, &cpu);
+    (void)aldo_debug_bp_add(dbg, expr);
+    (void)aldo_debug_bp_add(dbg, expr);
+    aldo_debug_bp_enable(dbg, 0, false);
+
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+    ct_assertequal(1, aldo_debug_halted_at(dbg));
+
+    aldo_debug_bp_remove(dbg, 1);
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+}
+
+static void halt_on_pending_cycles(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    struct aldo_mos6502 cpu = {};
+    struct aldo_clock clk = {};
+    struct aldo_haltexpr exprs[] = {
+        {.cond = ALDO_HLT_CYCLES, .cycles = 10},
+        {.cond = ALDO_HLT_CYCLES, .cycles = 5},
+    };
+    aldo_debug_cpu_connect(dbg, &cpu);
+    for (size_t i = 0; i < sizeof exprs / sizeof exprs[0]; ++i) {
+        (void)aldo_debug_bp_add(dbg, exprs[i]);
+    }
+
+    ptrdiff_t halts[12];
+    for (size_t i = 0; i < sizeof halts / sizeof halts[0]; ++i) {
+        clk.cycles = i;
+        aldo_debug_break(dbg, &clk);
+        halts[i] = aldo_debug_halted_at(dbg);
+    }
+
+    for (size_t i = 0; i < sizeof halts / sizeof halts[0]; ++i) {
+        ct_assertequal(i == 5 ? 1 : (i == 10 ? 0 : Aldo_NoBreakpoint),
+                       halts[i], "Unexpected halt at cycle %zu", i);
+    }
+
+    // clock reset makes earlier targets pending again
+    clk.cycles = 4;
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+    clk.cycles = 5;
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+    ct_assertequal(1, aldo_debug_halted_at(dbg));
+}
+
+static void halt_on_pending_frames(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    struct aldo_mos6502 cpu = {};
+    struct aldo_clock clk = {};
+    struct aldo_haltexpr expr = {.cond = ALDO_HLT_FRAMES, .frames = 3};
+    aldo_debug_cpu_connect(dbg, &cpu);
+    (void)aldo_debug_bp_add(dbg, expr);
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    clk.frames = 3;
+
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+
+    clk.frames = 4;
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+}
+
+static void halt_on_runtime(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    struct aldo_mos6502 cpu = {};
+    struct aldo_clock clk = {.emutime = 1.0};
+    struct aldo_haltexpr expr = {.cond = ALDO_HLT_TIME, .runtime = 2.5};
+    aldo_debug_cpu_connect(dbg, &cpu);
+    (void)aldo_debug_bp_add(dbg, expr);
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    clk.emutime = 2.6;
+
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+    ct_assertequal(0, aldo_debug_halted_at(dbg));
+}
+
+static void halt_on_address_predicate(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    struct aldo_mos6502 cpu = {.addrinst = 0xc000, .signal.sync = true};
+    struct aldo_clock clk = {};
+    struct aldo_haltexpr expr;
+    auto err = aldo_haltexpr_parse("@c000 && A==$10", &expr);
+    ct_assertequal(0, err);
+    aldo_debug_cpu_connect(dbg, &cpu);
+    (void)aldo_debug_bp_add(dbg, expr);
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    cpu.a = 0x10;
+
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+    ct_assertequal(0, aldo_debug_halted_at(dbg));
+    ct_assertequal(2u, aldo_debug_bp_at(dbg, 0)->hits);
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    cpu.addrinst = 0xc001;
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+    ct_assertequal(2u, aldo_debug_bp_at(dbg, 0)->hits);
+}
+
+static void halt_on_hit_count(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    struct aldo_mos6502 cpu = {.addrinst = 0x8000, .signal.sync = true};
+    struct aldo_clock clk = {};
+    struct aldo_haltexpr exprs[2];
+    auto err = aldo_haltexpr_parse("@8000 && hits>=3", exprs);
+    ct_assertequal(0, err);
+    err = aldo_haltexpr_parse("@8000", exprs + 1);
+    ct_assertequal(0, err);
+    aldo_debug_cpu_connect(dbg, &cpu);
+    (void)aldo_debug_bp_add(dbg, exprs[0]);
+    (void)aldo_debug_bp_add(dbg, exprs[1]);
+    aldo_debug_bp_enable(dbg, 1, false);
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+    ct_assertequal(0, aldo_debug_halted_at(dbg));
+    ct_assertequal(3u, aldo_debug_bp_at(dbg, 0)->hits);
+    ct_assertequal(0u, aldo_debug_bp_at(dbg, 1)->hits);
+}
+
+static void halt_on_predicate_hit_count(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    struct aldo_mos6502 cpu = {.signal.sync = true};
+    struct aldo_clock clk = {};
+    struct aldo_haltexpr expr;
+    auto err = aldo_haltexpr_parse("A==5 && hits>2", &expr);
+    ct_assertequal(0, err);
+    aldo_debug_cpu_connect(dbg, &cpu);
+    (void)aldo_debug_bp_add(dbg, expr);
+
+    // with no halt condition hits counts instructions, not predicate passes
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+    ct_assertequal(2u, aldo_debug_bp_at(dbg, 0)->hits);
+
+    cpu.a = 5;
+
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+    ct_assertequal(0, aldo_debug_halted_at(dbg));
+    ct_assertequal(3u, aldo_debug_bp_at(dbg, 0)->hits);
+
+    // mid-instruction cycles are not counted
+    cpu.signal.sync = false;
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+    ct_assertequal(3u, aldo_debug_bp_at(dbg, 0)->hits);
+}
+
+static void halt_counts_hits_past_first_match(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    struct aldo_mos6502 cpu = {.addrinst = 0x8000, .signal.sync = true};
+    struct aldo_clock clk = {};
+    struct aldo_haltexpr expr = {.cond = ALDO_HLT_ADDR, .address = 0x8000};
+    aldo_debug_cpu_connect(dbg, &cpu);
+    (void)aldo_debug_bp_add(dbg, expr);
+    (void)aldo_debug_bp_add(dbg, expr);
+
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+    ct_assertequal(0, aldo_debug_halted_at(dbg));
+    ct_assertequal(1u, aldo_debug_bp_at(dbg, 0)->hits);
+    ct_assertequal(1u, aldo_debug_bp_at(dbg, 1)->hits);
+}
+
+static void halt_on_memory_predicate(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    uint8_t mem[] = {[0x300] = 0x7f};
+    struct aldo_mos6502 cpu = {
+        .mbus = aldo_bus_new(ALDO_BITWIDTH_64KB, 1),
+        .signal.sync = true,
+    };
+    ct_assertnotnull(cpu.mbus);
+    ct_asserttrue(aldo_bus_set(cpu.mbus, 0x0, (struct aldo_busdevice){
+        .copy = test_copy, .ctx = mem,
+    }));
+    struct aldo_clock clk = {};
+    struct aldo_haltexpr expr;
+    auto err = aldo_haltexpr_parse("[$0300]>$80", &expr);
+    ct_assertequal(0, err);
+    aldo_debug_cpu_connect(dbg, &cpu);
+    (void)aldo_debug_bp_add(dbg, expr);
+
+    ct_asserttrue(aldo_debug_armed(dbg));
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    mem[0x300] = 0x81;
+
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    // predicate-only breakpoints are checked on instruction fetch
+    cpu.signal.sync = false;
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    aldo_debug_cpu_disconnect(dbg);
+    aldo_bus_free(cpu.mbus);
+}
+
+static void halt_on_ppu_predicate(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    struct aldo_mos6502 cpu = {.signal.sync = true};
+    struct aldo_rp2c02 ppu = {.line = 240, .dot = 5};
+    struct aldo_clock clk = {};
+    struct aldo_haltexpr expr;
+    auto err = aldo_haltexpr_parse("scanline==241 && dot<10", &expr);
+    ct_assertequal(0, err);
+    aldo_debug_cpu_connect(dbg, &cpu);
+    aldo_debug_ppu_connect(dbg, &ppu);
+    (void)aldo_debug_bp_add(dbg, expr);
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    ppu.line = 241;
+
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    ppu.dot = 10;
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+}
+
+static void halt_skips_malformed_predicate(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    struct aldo_mos6502 cpu = {.addrinst = 0x8000, .signal.sync = true};
+    struct aldo_clock clk = {};
+    struct aldo_haltexpr expr = {
+        .cond = ALDO_HLT_ADDR,
+        .address = 0x8000,
+        .predicate = {ALDO_HOP_VAR, ALDO_HVAR_A, ALDO_HOP_EQ},
+    };
+    aldo_debug_cpu_connect(dbg, &cpu);
+    (void)aldo_debug_bp_add(dbg, expr);
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+    ct_assertequal(1u, aldo_debug_bp_at(dbg, 0)->hits);
+}
+
+static void halt_on_write_watch(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    uint8_t mem[0x800] = {};
+    struct aldo_mos6502 cpu = {
+        .mbus = aldo_bus_new(ALDO_BITWIDTH_64KB, 2, 0x0, 0x8000),
+    };
+    ct_assertnotnull(cpu.mbus);
+    ct_asserttrue(aldo_bus_set(cpu.mbus, 0x0, (struct aldo_busdevice){
+        test_read, test_write, test_copy, mem,
+    }));
+    struct aldo_clock clk = {};
+    struct aldo_haltexpr expr;
+    auto err = aldo_haltexpr_parse("w@0300-030F", &expr);
+    ct_assertequal(0, err);
+    aldo_debug_cpu_connect(dbg, &cpu);
+    (void)aldo_debug_bp_add(dbg, expr);
+
+    ct_asserttrue(aldo_debug_armed(dbg));
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    uint8_t d;
+    ct_asserttrue(aldo_bus_read(cpu.mbus, 0x305, &d));
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    ct_asserttrue(aldo_bus_write(cpu.mbus, 0x310, 0x10));
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    ct_asserttrue(aldo_bus_write(cpu.mbus, 0x30f, 0x20));
+
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+    ct_assertequal(0, aldo_debug_halted_at(dbg));
+    ct_assertequal(0x20u, mem[0x30f]);
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    aldo_debug_cpu_disconnect(dbg);
+    aldo_bus_free(cpu.mbus);
+}
+
+static void halt_on_read_watch_ignores_peek(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    uint8_t mem[0x800] = {[0x42] = 0x55};
+    struct aldo_mos6502 cpu = {
+        .mbus = aldo_bus_new(ALDO_BITWIDTH_64KB, 2, 0x0, 0x8000),
+        .detached = true,
+    };
+    ct_assertnotnull(cpu.mbus);
+    ct_asserttrue(aldo_bus_set(cpu.mbus, 0x0, (struct aldo_busdevice){
+        test_read, test_write, test_copy, mem,
+    }));
+    struct aldo_clock clk = {};
+    struct aldo_haltexpr expr;
+    auto err = aldo_haltexpr_parse("r@0042", &expr);
+    ct_assertequal(0, err);
+    aldo_debug_cpu_connect(dbg, &cpu);
+    (void)aldo_debug_bp_add(dbg, expr);
+
+    uint8_t d;
+    ct_asserttrue(aldo_bus_read(cpu.mbus, 0x42, &d));
+
+    ct_assertequal(0x55u, d);
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    cpu.detached = false;
+    ct_asserttrue(aldo_bus_read(cpu.mbus, 0x42, &d));
+
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+    ct_assertequal(1u, aldo_debug_bp_at(dbg, 0)->hits);
+
+    aldo_debug_cpu_disconnect(dbg);
+    aldo_bus_free(cpu.mbus);
+}
+
+static void halt_on_vram_access_watch(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    uint8_t vram[ALDO_MEMBLOCK_16KB] = {};
+    struct aldo_mos6502 cpu = {};
+    struct aldo_rp2c02 ppu = {
+        .vbus = aldo_bus_new(ALDO_BITWIDTH_16KB, 2, 0x0, 0x2000),
+    };
+    ct_assertnotnull(ppu.vbus);
+    ct_asserttrue(aldo_bus_set(ppu.vbus, 0x2000, (struct aldo_busdevice){
+        test_read, test_write, test_copy, vram,
+    }));
+    struct aldo_clock clk = {};
+    struct aldo_haltexpr expr;
+    auto err = aldo_haltexpr_parse("vrw@23C0-23FF", &expr);
+    ct_assertequal(0, err);
+    aldo_debug_cpu_connect(dbg, &cpu);
+    aldo_debug_ppu_connect(dbg, &ppu);
+    (void)aldo_debug_bp_add(dbg, expr);
+
+    uint8_t d;
+    ct_asserttrue(aldo_bus_read(ppu.vbus, 0x2000, &d));
+
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    ct_asserttrue(aldo_bus_read(ppu.vbus, 0x23c0, &d));
+
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+
+    ct_asserttrue(aldo_bus_write(ppu.vbus, 0x23ff, 0x1));
+
+    ct_asserttrue(aldo_debug_break(dbg, &clk));
+
+    aldo_debug_ppu_disconnect(dbg);
+    aldo_debug_cpu_disconnect(dbg);
+    aldo_bus_free(ppu.vbus);
+}
+
+static void remove_watch_restores_bus(void *ctx)
+{
+    aldo_debugger *dbg = ctx;
+    uint8_t mem[0x800] = {};
+    struct aldo_mos6502 cpu = {
+        .mbus = aldo_bus_new(ALDO_BITWIDTH_64KB, 2, 0x0, 0x8000),
+    };
+    ct_assertnotnull(cpu.mbus);
+    struct aldo_busdevice ram = {test_read, test_write, test_copy, mem};
+    ct_asserttrue(aldo_bus_set(cpu.mbus, 0x0, ram));
+    struct aldo_clock clk = {};
+    struct aldo_haltexpr expr;
+    auto err = aldo_haltexpr_parse("rw@0000-00FF", &expr);
+    ct_assertequal(0, err);
+    aldo_debug_cpu_connect(dbg, &cpu);
+    (void)aldo_debug_bp_add(dbg, expr);
+    (void)aldo_debug_bp_add(dbg, expr);
+    struct aldo_busdevice dev;
+
+    ct_asserttrue(aldo_bus_swap(cpu.mbus, 0x0, ram, &dev));
+    ct_assertfalse(dev.ctx == mem);
+    ct_asserttrue(aldo_bus_set(cpu.mbus, 0x0, dev));
+
+    aldo_debug_bp_remove(dbg, 0);
+    aldo_debug_bp_enable(dbg, 0, false);
+
+    ct_asserttrue(aldo_bus_write(cpu.mbus, 0x10, 0x1));
+    ct_assertfalse(aldo_debug_armed(dbg));
+    ct_assertfalse(aldo_debug_break(dbg, &clk));
+    ct_asserttrue(aldo_bus_swap(cpu.mbus, 0x0, ram, &dev));
+    ct_assertsame(mem, dev.ctx);
+
+    aldo_debug_cpu_disconnect(dbg);
+    aldo_bus_free(cpu.mbus);
+}
+
 static void reset_debugger(void *ctx)
 {
     aldo_debugger *dbg = ctx;
@@ -245,6 +772,27 @@ struct ct_testsuite debug_tests()
         ct_maketest(clear_breakpoints),
         ct_maketest(halt_no_breakpoint),
 
+        ct_maketest(not_armed_without_breakpoints),
+        ct_maketest(not_armed_without_cpu),
+        ct_maketest(not_armed_with_disabled_breakpoints),
+        ct_maketest(halt_on_address),
+        ct_maketest(halt_on_first_matching_breakpoint),
+        ct_maketest(halt_skips_disabled_address),
+        ct_maketest(halt_on_pending_cycles),
+        ct_maketest(halt_on_pending_frames),
+        ct_maketest(halt_on_runtime),
+        ct_maketest(halt_on_address_predicate),
+        ct_maketest(halt_on_hit_count),
+        ct_maketest(halt_on_predicate_hit_count),
+        ct_maketest(halt_counts_hits_past_first_match),
+        ct_maketest(halt_on_memory_predicate),
+        ct_maketest(halt_on_ppu_predicate),
+        ct_maketest(halt_skips_malformed_predicate),
+        ct_maketest(halt_on_write_watch),
+        ct_maketest(halt_on_read_watch_ignores_peek),
+        ct_maketest(halt_on_vram_access_watch),
+        ct_maketest(remove_watch_restores_bus),
+
         ct_maketest(reset_debugger),
     };
 
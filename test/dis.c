@@ -5,6 +5,8 @@
 //  Created by Brandon Stansbury on 2/24/21.
 //
 
+#include "bytes.h"
+#include "cart.h"
 #include "ciny.h"
 #include "cpu.h"
 #include "cpuhelp.h"
@@ -18,6 +20,7 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -797,6 +800,20 @@ static void inst_disassembles_branch_zero(void *ctx)
     ct_assertequalstrn(exp, buf, sizeof exp);
 }
 
+static void inst_disassembles_branch_min(void *ctx)
+{
+    uint16_t a = 0x1234;
+    uint8_t bytes[] = {0x90, 0x80};
+    auto inst = makeinst(bytes);
+    char buf[AldoDisInstSize];
+
+    auto length = aldo_dis_inst(a, &inst, buf);
+
+    const char *exp = "1234: 90 80     BCC -128";
+    ct_assertequal((int)strlen(exp), length);
+    ct_assertequalstrn(exp, buf, sizeof exp);
+}
+
 static void inst_disassembles_push(void *ctx)
 {
     uint16_t a = 0x1234;
@@ -881,6 +898,125 @@ static void inst_disassembles_unofficial(void *ctx)
     ct_assertequalstrn(exp, buf, sizeof exp);
 }
 
+//
+// MARK: - Disassemble Cart PRG
+//
+
+// MMC1 cart whose PRG blocks each start with LDA #<block number> followed
+// by NOPs; the block listed in eofblock ends with a truncated JSR.
+constexpr size_t CartBlocks = 20;
+constexpr size_t CartHeaderSize = 16;
+
+static uint8_t *create_cart_image(size_t eofblock)
+{
+    uint8_t *img = calloc(CartHeaderSize + (CartBlocks * ALDO_MEMBLOCK_16KB),
+                          1);
+    memcpy(img, (uint8_t[]){'N', 'E', 'S', 0x1a, CartBlocks, 0, 0x10}, 7);
+    for (size_t i = 0; i < CartBlocks; ++i) {
+        auto block = img + CartHeaderSize + (i * ALDO_MEMBLOCK_16KB);
+        memset(block, 0xea, ALDO_MEMBLOCK_16KB);
+        block[0] = 0xa9;
+        block[1] = (uint8_t)i;
+        if (i == eofblock) {
+            block[ALDO_MEMBLOCK_16KB - 1] = 0x20;
+        }
+    }
+    return img;
+}
+
+static char *dis_cart_prg(const uint8_t *img)
+{
+    aldo_cart *cart;
+    auto err = aldo_cart_create_mem(&cart, CartHeaderSize
+                                    + (CartBlocks * ALDO_MEMBLOCK_16KB), img);
+    ct_assertequal(0, err);
+
+    auto f = tmpfile();
+    ct_assertnotnull(f);
+    err = aldo_dis_cart_prg(cart, "test", false, true, f);
+    ct_assertequal(0, err);
+
+    auto size = ftell(f);
+    ct_asserttrue(size > 0);
+    char *text = calloc((size_t)size + 1, 1);
+    rewind(f);
+    ct_assertequal((size_t)size, fread(text, 1, (size_t)size, f));
+    fclose(f);
+    aldo_cart_free(cart);
+    return text;
+}
+
+static void cart_prg_blocks_in_order(void *ctx)
+{
+    auto img = create_cart_image(CartBlocks);
+    auto text = dis_cart_prg(img);
+
+    auto listing = strstr(text, "\nBlock 0 ");
+    ct_assertnotnull(listing);
+    for (size_t i = 0; i < CartBlocks; ++i) {
+        char exp[128];
+        auto len = sprintf(exp, "\nBlock %zu (16KB)\n--------\n"
+                           "C000: A9 %02zX     LDA #$%02zX\n"
+                           "C002: EA        NOP\n*\n"
+                           "FFFF: EA        NOP\n", i, i, i);
+        ct_assertequalstrn(exp, listing, (size_t)len, "block %zu", i);
+        listing += len;
+    }
+    ct_assertequal('\0', listing[0]);
+
+    free(text);
+    free(img);
+}
+
+static void cart_prg_block_error_follows_block(void *ctx)
+{
+    size_t eofblock = 17;
+    auto img = create_cart_image(eofblock);
+    auto text = dis_cart_prg(img);
+
+    char exp[128];
+    sprintf(exp, "\nBlock %zu (16KB)\n--------\n"
+            "C000: A9 11     LDA #$11\n"
+            "C002: EA        NOP\n*\n"
+            "Dis err (-2): UNEXPECTED EOF\n"
+            "\nBlock %zu (16KB)\n", eofblock, eofblock + 1);
+    ct_assertnotnull(strstr(text, exp));
+
+    free(text);
+    free(img);
+}
+
+//
+// MARK: - Decode CHR
+//
+
+static void chrblock_scales_pixels_and_rows(void *ctx)
+{
+    // 1KB block is 8 x 8 tiles; top-left pixel of the first tile is color 3
+    uint8_t chr[ALDO_MEMBLOCK_1KB] = {};
+    chr[0] = chr[AldoChrTileDim] = 0x80;
+    struct aldo_blockview bv = {.mem = chr, .size = sizeof chr};
+    auto f = tmpfile();
+    ct_assertnotnull(f);
+
+    auto err = aldo_dis_cart_chrblock(&bv, 2, f);
+
+    ct_assertequal(0, err);
+    // 128 x 128 pixels at 4 bpp, after 54 header and 16 palette bytes
+    constexpr size_t rowsize = 64;
+    constexpr size_t pixelstart = 70;
+    ct_assertequal((long)(pixelstart + (rowsize * 128)), ftell(f));
+    uint8_t rows[rowsize * 3];
+    // BMP rows go bottom-up so the top row is last
+    fseek(f, -(long)sizeof rows, SEEK_END);
+    ct_assertequal(sizeof rows, fread(rows, 1, sizeof rows, f));
+    fclose(f);
+    for (size_t i = 0; i < sizeof rows; ++i) {
+        uint8_t exp = i == rowsize || i == rowsize * 2 ? 0x33 : 0x0;
+        ct_assertequal(exp, rows[i], "at byte %zu", i);
+    }
+}
+
 //
 // MARK: - Disassemble Datapath
 //
@@ -2811,6 +2947,7 @@ struct ct_testsuite dis_tests()
         ct_maketest(inst_disassembles_branch_positive),
         ct_maketest(inst_disassembles_branch_negative),
         ct_maketest(inst_disassembles_branch_zero),
+        ct_maketest(inst_disassembles_branch_min),
         ct_maketest(inst_disassembles_push),
         ct_maketest(inst_disassembles_pull),
         ct_maketest(inst_disassembles_jsr),
@@ -2818,6 +2955,11 @@ struct ct_testsuite dis_tests()
         ct_maketest(inst_disassembles_brk),
         ct_maketest(inst_disassembles_unofficial),
 
+        ct_maketest(cart_prg_blocks_in_order),
+        ct_maketest(cart_prg_block_error_follows_block),
+
+        ct_maketest(chrblock_scales_pixels_and_rows),
+
         ct_maketest(datapath_end_of_rom),
         ct_maketest(datapath_unexpected_end_of_rom),
 
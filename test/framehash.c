@@ -0,0 +1,236 @@
+//
+//  framehash.c
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "bytes.h"
+#include "ciny.h"
+#include "debug.h"
+#include "framehash.h"
+#include "nes.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+struct framehash_ctx {
+    struct framehash hashes;
+    struct aldo_framehashes expected;
+    aldo_debugger *dbg;
+    aldo_nes *console;
+    FILE *log, *reference, *report;
+};
+
+static void setup(void **ctx)
+{
+    struct framehash_ctx *c = malloc(sizeof *c);
+    c->dbg = aldo_debug_new();
+    c->console = aldo_nes_new(c->dbg, false, nullptr);
+    aldo_nes_powerup(c->console, nullptr, true);
+    aldo_nes_framehashes(c->console, &c->expected);
+    c->log = tmpfile();
+    c->reference = tmpfile();
+    c->report = tmpfile();
+    *ctx = c;
+}
+
+static void teardown(void **ctx)
+{
+    struct framehash_ctx *c = *ctx;
+    fclose(c->report);
+    fclose(c->reference);
+    fclose(c->log);
+    aldo_nes_free(c->console);
+    aldo_debug_free(c->dbg);
+    free(c);
+}
+
+static void write_line(FILE *f, uint64_t frame,
+                       const struct aldo_framehashes *h)
+{
+    fprintf(f, "%" PRIu64 " %016" PRIx64 " %016" PRIx64 " %016" PRIx64 "\n",
+            frame, h->screen, h->ram, h->vram);
+}
+
+static struct framehash *init_reference(void *ctx, int frames,
+                                        const struct aldo_framehashes *h)
+{
+    struct framehash_ctx *c = ctx;
+    for (auto i = 0; i < frames; ++i) {
+        write_line(c->reference, (uint64_t)i, h);
+    }
+    rewind(c->reference);
+    framehash_init(&c->hashes, c->console, nullptr, c->reference);
+    return &c->hashes;
+}
+
+static bool frame(struct framehash *hashes)
+{
+    static constexpr uint8_t screen[] = {0x0};
+    return framehash_frame(hashes, screen);
+}
+
+//
+// MARK: - Tests
+//
+
+static void hashes_reset_console(void *ctx)
+{
+    struct framehash_ctx *c = ctx;
+    uint8_t zeros[256 * 240] = {};
+
+    ct_assertequal(aldo_bytehash(AldoFnvBasis, sizeof zeros, zeros),
+                   c->expected.screen);
+    ct_assertequal(aldo_bytehash(AldoFnvBasis, 2048, zeros),
+                   c->expected.ram);
+    ct_assertequal(aldo_bytehash(AldoFnvBasis, 2048, zeros),
+                   c->expected.vram);
+}
+
+static void writes_log(void *ctx)
+{
+    struct framehash_ctx *c = ctx;
+    framehash_init(&c->hashes, c->console, c->log, nullptr);
+
+    ct_asserttrue(frame(&c->hashes));
+    ct_asserttrue(frame(&c->hashes));
+
+    char expected[128], actual[128];
+    auto f = tmpfile();
+    write_line(f, 0, &c->expected);
+    write_line(f, 1, &c->expected);
+    rewind(f);
+    rewind(c->log);
+    for (auto i = 0; i < 2; ++i) {
+        ct_assertnotnull(fgets(expected, sizeof expected, f));
+        ct_assertnotnull(fgets(actual, sizeof actual, c->log));
+        ct_assertequalstr(expected, actual);
+    }
+    ct_assertnull(fgets(actual, sizeof actual, c->log));
+    fclose(f);
+    ct_asserttrue(framehash_finish(&c->hashes, c->report));
+    ct_assertequal(2u, c->hashes.frame);
+}
+
+static void digest_is_repeatable(void *ctx)
+{
+    struct framehash_ctx *c = ctx;
+    framehash_init(&c->hashes, c->console, nullptr, nullptr);
+
+    frame(&c->hashes);
+    auto first = c->hashes.digest;
+    frame(&c->hashes);
+    auto second = c->hashes.digest;
+    framehash_init(&c->hashes, c->console, nullptr, nullptr);
+    frame(&c->hashes);
+
+    ct_assertequal(first, c->hashes.digest);
+    ct_asserttrue(first != second);
+    ct_asserttrue(first != AldoFnvBasis);
+}
+
+static void matches_reference(void *ctx)
+{
+    struct framehash_ctx *c = ctx;
+    auto hashes = init_reference(ctx, 2, &c->expected);
+
+    ct_asserttrue(frame(hashes));
+    ct_asserttrue(frame(hashes));
+    ct_assertfalse(frame(hashes));
+
+    ct_assertequal(FRAMEHASH_END, (int)hashes->state);
+    ct_assertequal(2u, hashes->frame);
+    ct_asserttrue(framehash_finish(hashes, c->report));
+}
+
+static void stopped_before_end(void *ctx)
+{
+    struct framehash_ctx *c = ctx;
+    auto hashes = init_reference(ctx, 3, &c->expected);
+
+    ct_asserttrue(frame(hashes));
+
+    ct_assertequal(FRAMEHASH_MATCH, (int)hashes->state);
+    ct_asserttrue(framehash_finish(hashes, c->report));
+}
+
+static void ram_divergence(void *ctx)
+{
+    struct framehash_ctx *c = ctx;
+    auto bad = c->expected;
+    ++bad.ram;
+    auto hashes = init_reference(ctx, 2, &bad);
+
+    ct_assertfalse(frame(hashes));
+
+    ct_assertequal(FRAMEHASH_DIVERGED, (int)hashes->state);
+    ct_assertequal(0u, hashes->frame);
+    ct_assertequal(bad.ram, hashes->expected.ram);
+    ct_assertequal(c->expected.ram, hashes->actual.ram);
+    ct_assertfalse(framehash_finish(hashes, c->report));
+    ct_assertfalse(frame(hashes));
+}
+
+static void frame_number_mismatch(void *ctx)
+{
+    struct framehash_ctx *c = ctx;
+    write_line(c->reference, 5, &c->expected);
+    rewind(c->reference);
+    framehash_init(&c->hashes, c->console, nullptr, c->reference);
+
+    ct_assertfalse(frame(&c->hashes));
+
+    ct_assertequal(FRAMEHASH_OUTOFSYNC, (int)c->hashes.state);
+    ct_assertequal(5u, c->hashes.refframe);
+    ct_assertfalse(framehash_finish(&c->hashes, c->report));
+
+    char line[128];
+    rewind(c->report);
+    ct_assertnotnull(fgets(line, sizeof line, c->report));
+    ct_assertequalstr("Reference frame hash log out of sync: expected frame 0,"
+                      " found frame 5\n", line);
+}
+
+static void malformed_reference_line(void *ctx)
+{
+    struct framehash_ctx *c = ctx;
+    write_line(c->reference, 0, &c->expected);
+    fputs("1 not-a-hash\n", c->reference);
+    rewind(c->reference);
+    framehash_init(&c->hashes, c->console, nullptr, c->reference);
+
+    ct_asserttrue(frame(&c->hashes));
+    ct_assertfalse(frame(&c->hashes));
+
+    ct_assertequal(FRAMEHASH_BADLINE, (int)c->hashes.state);
+    ct_assertfalse(framehash_finish(&c->hashes, c->report));
+
+    char line[128];
+    rewind(c->report);
+    ct_assertnotnull(fgets(line, sizeof line, c->report));
+    ct_assertequalstr("Malformed reference frame hash log line for frame 1\n",
+                      line);
+}
+
+//
+// MARK: - Test List
+//
+
+struct ct_testsuite framehash_tests()
+{
+    static constexpr struct ct_testcase tests[] = {
+        ct_maketest(hashes_reset_console),
+        ct_maketest(writes_log),
+        ct_maketest(digest_is_repeatable),
+        ct_maketest(matches_reference),
+        ct_maketest(stopped_before_end),
+        ct_maketest(ram_divergence),
+        ct_maketest(frame_number_mismatch),
+        ct_maketest(malformed_reference_line),
+    };
+
+    return ct_makesuite_setup_teardown(tests, setup, teardown);
+}
@@ -8,6 +8,8 @@
 #include "ciny.h"
 #include "haltexpr.h"
 
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 //
@@ -523,6 +525,304 @@ static void expr_missing_unit(void *ctx)
     ct_assertequal(ALDO_HEXPR_ERR_SCAN, result);
 }
 
+//
+// MARK: - Predicate Parse
+//
+
+static void verify_predicate(const uint8_t code[], size_t size,
+                             const struct aldo_haltexpr *expr)
+{
+    for (size_t i = 0; i < size; ++i) {
+        ct_assertequal(code[i], expr->predicate[i], "at %zu", i);
+    }
+}
+
+static void read_watch_condition(void *ctx)
+{
+    const char *str = "r@0300";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(0, result);
+    ct_assertequal(ALDO_HLT_READ, (int)expr.cond);
+    ct_assertequal(0x300u, expr.watch.low);
+    ct_assertequal(0x300u, expr.watch.high);
+    ct_assertfalse(expr.watch.vram);
+}
+
+static void write_watch_range_condition(void *ctx)
+{
+    const char *str = " W@0200-02ff ";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(0, result);
+    ct_assertequal(ALDO_HLT_WRITE, (int)expr.cond);
+    ct_assertequal(0x200u, expr.watch.low);
+    ct_assertequal(0x2ffu, expr.watch.high);
+    ct_assertfalse(expr.watch.vram);
+}
+
+static void vram_access_watch_condition(void *ctx)
+{
+    const char *str = "vrw@2000-23bf";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(0, result);
+    ct_assertequal(ALDO_HLT_ACCESS, (int)expr.cond);
+    ct_assertequal(0x2000u, expr.watch.low);
+    ct_assertequal(0x23bfu, expr.watch.high);
+    ct_asserttrue(expr.watch.vram);
+}
+
+static void watch_condition_with_predicate(void *ctx)
+{
+    const char *str = "w@4014 && A==$2";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(0, result);
+    ct_assertequal(ALDO_HLT_WRITE, (int)expr.cond);
+    ct_assertequal(0x4014u, expr.watch.low);
+    ct_assertequal(0x4014u, expr.watch.high);
+    const uint8_t code[] = {
+        ALDO_HOP_VAR, ALDO_HVAR_A,
+        ALDO_HOP_IMM, 0x2, 0x0, 0x0, 0x0,
+        ALDO_HOP_EQ,
+        ALDO_HOP_END,
+    };
+    verify_predicate(code, sizeof code, &expr);
+}
+
+static void watch_condition_inverted_range(void *ctx)
+{
+    const char *str = "r@0300-0200";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(ALDO_HEXPR_ERR_VALUE, result);
+}
+
+static void vram_watch_condition_too_large(void *ctx)
+{
+    const char *str = "vw@4000";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(ALDO_HEXPR_ERR_VALUE, result);
+}
+
+static void watch_condition_unknown_kind(void *ctx)
+{
+    const char *str = "wr@0300";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(ALDO_HEXPR_ERR_SCAN, result);
+}
+
+static void address_condition_with_predicate(void *ctx)
+{
+    const char *str = "@c000 && A==$10";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(0, result);
+    ct_assertequal(ALDO_HLT_ADDR, (int)expr.cond);
+    ct_assertequal(0xc000u, expr.address);
+    const uint8_t code[] = {
+        ALDO_HOP_VAR, ALDO_HVAR_A,
+        ALDO_HOP_IMM, 0x10, 0x0, 0x0, 0x0,
+        ALDO_HOP_EQ,
+        ALDO_HOP_END,
+    };
+    verify_predicate(code, sizeof code, &expr);
+}
+
+static void memory_predicate(void *ctx)
+{
+    const char *str = "[$0300]>$80";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(0, result);
+    ct_assertequal(ALDO_HLT_EXPR, (int)expr.cond);
+    const uint8_t code[] = {
+        ALDO_HOP_MEM, 0x0, 0x3,
+        ALDO_HOP_IMM, 0x80, 0x0, 0x0, 0x0,
+        ALDO_HOP_GT,
+        ALDO_HOP_END,
+    };
+    verify_predicate(code, sizeof code, &expr);
+}
+
+static void decimal_predicate(void *ctx)
+{
+    const char *str = "scanline==241";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(0, result);
+    ct_assertequal(ALDO_HLT_EXPR, (int)expr.cond);
+    const uint8_t code[] = {
+        ALDO_HOP_VAR, ALDO_HVAR_SCANLINE,
+        ALDO_HOP_IMM, 241, 0x0, 0x0, 0x0,
+        ALDO_HOP_EQ,
+        ALDO_HOP_END,
+    };
+    verify_predicate(code, sizeof code, &expr);
+}
+
+static void predicate_case_insensitive(void *ctx)
+{
+    const char *str = "  HITS >= 0x5  ";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(0, result);
+    ct_assertequal(ALDO_HLT_EXPR, (int)expr.cond);
+    const uint8_t code[] = {
+        ALDO_HOP_VAR, ALDO_HVAR_HITS,
+        ALDO_HOP_IMM, 0x5, 0x0, 0x0, 0x0,
+        ALDO_HOP_GE,
+        ALDO_HOP_END,
+    };
+    verify_predicate(code, sizeof code, &expr);
+}
+
+static void predicate_and_binds_tighter_than_or(void *ctx)
+{
+    const char *str = "jam && X==1 || Y!=2 && S<3";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(0, result);
+    ct_assertequal(ALDO_HLT_JAM, (int)expr.cond);
+    const uint8_t code[] = {
+        ALDO_HOP_VAR, ALDO_HVAR_X,
+        ALDO_HOP_IMM, 0x1, 0x0, 0x0, 0x0,
+        ALDO_HOP_EQ,
+        ALDO_HOP_VAR, ALDO_HVAR_Y,
+        ALDO_HOP_IMM, 0x2, 0x0, 0x0, 0x0,
+        ALDO_HOP_NE,
+        ALDO_HOP_VAR, ALDO_HVAR_S,
+        ALDO_HOP_IMM, 0x3, 0x0, 0x0, 0x0,
+        ALDO_HOP_LT,
+        ALDO_HOP_AND,
+        ALDO_HOP_OR,
+        ALDO_HOP_END,
+    };
+    verify_predicate(code, sizeof code, &expr);
+}
+
+static void condition_without_predicate_is_empty(void *ctx)
+{
+    const char *str = "42c";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(0, result);
+    ct_assertequal(ALDO_HOP_END, expr.predicate[0]);
+}
+
+static void predicate_missing_comparison(void *ctx)
+{
+    const char *str = "@c000 && A";
+    struct aldo_haltexpr expr = {.cond = ALDO_HLT_JAM};
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(ALDO_HEXPR_ERR_PRED, result);
+    ct_assertequal(ALDO_HLT_JAM, (int)expr.cond);
+}
+
+static void predicate_unknown_variable(void *ctx)
+{
+    const char *str = "Q==1";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(ALDO_HEXPR_ERR_PRED, result);
+}
+
+static void predicate_trailing_input(void *ctx)
+{
+    const char *str = "A==1 X";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(ALDO_HEXPR_ERR_PRED, result);
+}
+
+static void predicate_or_after_condition(void *ctx)
+{
+    const char *str = "@c000 || A==1";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(ALDO_HEXPR_ERR_PRED, result);
+}
+
+static void predicate_empty(void *ctx)
+{
+    const char *str = "@c000 &&  ";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(ALDO_HEXPR_ERR_PRED, result);
+}
+
+static void predicate_memory_too_large(void *ctx)
+{
+    const char *str = "[$10000]==1";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(ALDO_HEXPR_ERR_VALUE, result);
+}
+
+static void predicate_too_long(void *ctx)
+{
+    const char *str = "A==$1000 && X==$1000 && Y==$1000 && S==$1000"
+                      " && P==$1000 && A==$1000 && X==$1000";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(ALDO_HEXPR_ERR_PREDSIZE, result);
+}
+
+static void predicate_too_long_to_format(void *ctx)
+{
+    const char *str = "scanline<=scanline && scanline<=scanline"
+                      " && scanline<=scanline && scanline<=scanline"
+                      " && scanline<=scanline";
+    struct aldo_haltexpr expr;
+
+    auto result = aldo_haltexpr_parse(str, &expr);
+
+    ct_assertequal(ALDO_HEXPR_ERR_PREDSIZE, result);
+}
+
 //
 // MARK: - Reset Vector Parse
 //
@@ -661,6 +961,16 @@ static void resetvector_malformed(void *ctx)
     ct_assertequal(ALDO_HEXPR_ERR_SCAN, result);
 }
 
+static void dbgexpr_reports_predicate_error(void *ctx)
+{
+    const char *str = "@ab12 || A==1";
+    struct aldo_debugexpr expr;
+
+    auto result = aldo_haltexpr_parse_dbg(str, &expr);
+
+    ct_assertequal(ALDO_HEXPR_ERR_PRED, result);
+}
+
 static void dbgexpr_parses_halt_condition(void *ctx)
 {
     const char *str = "@ab12";
@@ -777,6 +1087,75 @@ static void print_jam(void *ctx)
     ct_assertequalstrn(expected, buf, sizeof expected);
 }
 
+static void print_read_watch(void *ctx)
+{
+    struct aldo_haltexpr expr = {
+        .cond = ALDO_HLT_READ, .watch = {0x300, 0x300, false},
+    };
+    char buf[AldoHexprFmtSize];
+
+    auto result = aldo_haltexpr_desc(&expr, buf);
+
+    const char *expected = "Read $0300";
+    ct_assertequal((int)strlen(expected), result);
+    ct_assertequalstr(expected, buf);
+}
+
+static void print_vram_access_watch(void *ctx)
+{
+    struct aldo_haltexpr expr = {
+        .cond = ALDO_HLT_ACCESS, .watch = {0x2000, 0x23bf, true},
+    };
+    char buf[AldoHexprFmtSize];
+
+    auto result = aldo_haltexpr_desc(&expr, buf);
+
+    const char *expected = "VRAM Access $2000-$23BF";
+    ct_assertequal((int)strlen(expected), result);
+    ct_assertequalstr(expected, buf);
+}
+
+static void print_predicate(void *ctx)
+{
+    struct aldo_haltexpr expr;
+    auto err = aldo_haltexpr_parse("@c000 && [$300]>$80 || dot<=$10", &expr);
+    ct_assertequal(0, err);
+    char buf[AldoHexprFmtSize];
+
+    auto result = aldo_haltexpr_desc(&expr, buf);
+
+    const char *expected = "PC @ $C000 && [$0300]>$80 || dot<=16";
+    ct_assertequal((int)strlen(expected), result);
+    ct_assertequalstr(expected, buf);
+}
+
+static void print_predicate_only(void *ctx)
+{
+    struct aldo_haltexpr expr;
+    auto err = aldo_haltexpr_parse("pc==$8000&&hits>10", &expr);
+    ct_assertequal(0, err);
+    char buf[AldoHexprFmtSize];
+
+    auto result = aldo_haltexpr_desc(&expr, buf);
+
+    const char *expected = "PC==$8000 && hits>10";
+    ct_assertequal((int)strlen(expected), result);
+    ct_assertequalstr(expected, buf);
+}
+
+static void print_malformed_predicate(void *ctx)
+{
+    struct aldo_haltexpr expr = {
+        .cond = ALDO_HLT_ADDR,
+        .predicate = {ALDO_HOP_VAR, ALDO_HVAR_A, ALDO_HOP_EQ},
+    };
+    char buf[AldoHexprFmtSize];
+
+    auto result = aldo_haltexpr_desc(&expr, buf);
+
+    ct_assertequal(ALDO_HEXPR_ERR_PRED, result);
+}
+
 //
 // MARK: - Debug Expression Serialization
 //
@@ -884,6 +1263,80 @@ static void format_jam(void *ctx)
     ct_assertequalstrn(expected, buf, sizeof expected);
 }
 
+static void format_write_watch(void *ctx)
+{
+    struct aldo_debugexpr expr = {
+        .type = ALDO_DBG_EXPR_HALT,
+        .hexpr = {.cond = ALDO_HLT_WRITE, .watch = {0x200, 0x2ff, false}},
+    };
+    char buf[AldoHexprFmtSize];
+
+    auto result = aldo_haltexpr_fmtdbg(&expr, buf);
+
+    const char *expected = "w@0200-02FF";
+    ct_assertequal((int)strlen(expected), result);
+    ct_assertequalstr(expected, buf);
+}
+
+static void format_vram_watch_roundtrip(void *ctx)
+{
+    struct aldo_debugexpr expr = {
+        .type = ALDO_DBG_EXPR_HALT,
+        .hexpr = {.cond = ALDO_HLT_READ, .watch = {0x3f00, 0x3f00, true}},
+    };
+    char buf[AldoHexprFmtSize];
+
+    auto result = aldo_haltexpr_fmtdbg(&expr, buf);
+
+    const char *expected = "vr@3F00";
+    ct_assertequal((int)strlen(expected), result);
+    ct_assertequalstr(expected, buf);
+
+    struct aldo_debugexpr parsed;
+    auto err = aldo_haltexpr_parse_dbg(buf, &parsed);
+
+    ct_assertequal(0, err);
+    ct_assertequal(ALDO_HLT_READ, (int)parsed.hexpr.cond);
+    ct_assertequal(0x3f00u, parsed.hexpr.watch.low);
+    ct_assertequal(0x3f00u, parsed.hexpr.watch.high);
+    ct_asserttrue(parsed.hexpr.watch.vram);
+}
+
+static void format_predicate(void *ctx)
+{
+    struct aldo_debugexpr expr;
+    auto err = aldo_haltexpr_parse_dbg("42f && Y<$10", &expr);
+    ct_assertequal(0, err);
+    char buf[AldoHexprFmtSize];
+
+    auto result = aldo_haltexpr_fmtdbg(&expr, buf);
+
+    const char *expected = "42f && Y<$10";
+    ct_assertequal((int)strlen(expected), result);
+    ct_assertequalstr(expected, buf);
+}
+
+static void format_predicate_roundtrip(void *ctx)
+{
+    const char *str = "a!=x&&[$10]>=1000 || scanline<10";
+    struct aldo_debugexpr expr, roundtrip;
+    auto err = aldo_haltexpr_parse_dbg(str, &expr);
+    ct_assertequal(0, err);
+    char buf[AldoHexprFmtSize];
+
+    auto result = aldo_haltexpr_fmtdbg(&expr, buf);
+
+    const char *expected = "A!=X && [$0010]>=$03E8 || scanline<10";
+    ct_assertequal((int)strlen(expected), result);
+    ct_assertequalstr(expected, buf);
+
+    err = aldo_haltexpr_parse_dbg(buf, &roundtrip);
+    ct_assertequal(0, err);
+    ct_assertequal(ALDO_HLT_EXPR, (int)roundtrip.hexpr.cond);
+    verify_predicate(expr.hexpr.predicate, AldoHexprCodeSize,
+                     &roundtrip.hexpr);
+}
+
 //
 // MARK: - Test List
 //
@@ -944,6 +1397,29 @@ struct ct_testsuite haltexpr_tests()
 
         ct_maketest(expr_missing_unit),
 
+        ct_maketest(read_watch_condition),
+        ct_maketest(write_watch_range_condition),
+        ct_maketest(vram_access_watch_condition),
+        ct_maketest(watch_condition_with_predicate),
+        ct_maketest(watch_condition_inverted_range),
+        ct_maketest(vram_watch_condition_too_large),
+        ct_maketest(watch_condition_unknown_kind),
+
+        ct_maketest(address_condition_with_predicate),
+        ct_maketest(memory_predicate),
+        ct_maketest(decimal_predicate),
+        ct_maketest(predicate_case_insensitive),
+        ct_maketest(predicate_and_binds_tighter_than_or),
+        ct_maketest(condition_without_predicate_is_empty),
+        ct_maketest(predicate_missing_comparison),
+        ct_maketest(predicate_unknown_variable),
+        ct_maketest(predicate_trailing_input),
+        ct_maketest(predicate_or_after_condition),
+        ct_maketest(predicate_empty),
+        ct_maketest(predicate_memory_too_large),
+        ct_maketest(predicate_too_long),
+        ct_maketest(predicate_too_long_to_format),
+
         ct_maketest(null_resetvector_string),
         ct_maketest(empty_resetvector_string),
         ct_maketest(resetvector),
@@ -958,6 +1434,7 @@ struct ct_testsuite haltexpr_tests()
         ct_maketest(resetvector_malformed),
         ct_maketest(dbgexpr_parses_halt_condition),
         ct_maketest(dbgexpr_malformed),
+        ct_maketest(dbgexpr_reports_predicate_error),
 
         ct_maketest(print_none),
         ct_maketest(print_addr),
@@ -966,6 +1443,11 @@ struct ct_testsuite haltexpr_tests()
         ct_maketest(print_cycles),
         ct_maketest(print_frames),
         ct_maketest(print_jam),
+        ct_maketest(print_read_watch),
+        ct_maketest(print_vram_access_watch),
+        ct_maketest(print_predicate),
+        ct_maketest(print_predicate_only),
+        ct_maketest(print_malformed_predicate),
 
         ct_maketest(format_reset),
         ct_maketest(format_addr),
@@ -974,6 +1456,10 @@ struct ct_testsuite haltexpr_tests()
         ct_maketest(format_cycles),
         ct_maketest(format_frames),
         ct_maketest(format_jam),
+        ct_maketest(format_write_watch),
+        ct_maketest(format_vram_watch_roundtrip),
+        ct_maketest(format_predicate),
+        ct_maketest(format_predicate_roundtrip),
     };
 
     return ct_makesuite(tests);
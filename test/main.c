@@ -17,9 +17,13 @@ void
     setup_testbus(),
     teardown_testbus();
 
-struct ct_testsuite argparse_tests(),
+struct ct_testsuite archive_tests(),
+                    argparse_tests(),
                     bus_tests(),
                     bytes_tests(),
+                    callgraph_tests(),
+                    cart_tests(),
+                    cdl_tests(),
                     apu_tests(),
                     cpu_tests(),
                     cpu_absolute_tests(),
@@ -37,17 +41,31 @@ struct ct_testsuite argparse_tests(),
                     debug_tests(),
                     dis_tests(),
                     dis_peek_tests(),
+                    framehash_tests(),
                     haltexpr_tests(),
+                    nes_tests(),
+                    png_tests(),
                     ppu_tests(),
                     ppu_register_tests(),
-                    ppu_render_tests();
+                    ppu_render_tests(),
+                    profile_tests(),
+                    rewind_tests(),
+                    romcache_tests(),
+                    romindex_tests(),
+                    server_tests(),
+                    testrom_tests(),
+                    tracecmp_tests();
 
 static size_t testrunner(int argc, char *argv[argc+1])
 {
     struct ct_testsuite suites[] = {
+        archive_tests(),
         argparse_tests(),
         bus_tests(),
         bytes_tests(),
+        callgraph_tests(),
+        cart_tests(),
+        cdl_tests(),
         apu_tests(),
         cpu_tests(),
         cpu_absolute_tests(),
@@ -65,10 +83,20 @@ static size_t testrunner(int argc, char *argv[argc+1])
         debug_tests(),
         dis_tests(),
         dis_peek_tests(),
+        framehash_tests(),
         haltexpr_tests(),
+        nes_tests(),
+        png_tests(),
         ppu_tests(),
         ppu_register_tests(),
         ppu_render_tests(),
+        profile_tests(),
+        rewind_tests(),
+        romcache_tests(),
+        romindex_tests(),
+        server_tests(),
+        testrom_tests(),
+        tracecmp_tests(),
     };
     setup_testbus();
     auto result = ct_run_withargs(suites, argc, argv);
@@ -0,0 +1,384 @@
+//
+//  nes.c
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "cart.h"
+#include "carthelp.h"
+#include "ciny.h"
+#include "cycleclock.h"
+#include "debug.h"
+#include "nes.h"
+#include "ppu.h"
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+constexpr uint16_t Counter = 0x300;
+
+struct nes_context {
+    aldo_debugger *dbg;
+    aldo_nes *console;
+    aldo_cart *cart;
+    struct aldo_clock clock;
+    int framecalls;
+    uint8_t image[NromSize];
+};
+
+static void setup(void **ctx)
+{
+    // keep NMI enabled and bump a counter in RAM forever; NMI and IRQ
+    // return immediately.
+    static const uint8_t prg[] = {
+        0xa9, 0x80,         // $8000 LDA #$80
+        0x8d, 0x0, 0x20,    // $8002 STA $2000
+        0xee, 0x0, 0x3,     // $8005 INC $0300
+        0x4c, 0x2, 0x80,    // $8008 JMP $8002
+        0x40,               // $800B RTI
+    };
+
+    struct nes_context *c = calloc(1, sizeof *c);
+    make_nrom(c->image, sizeof prg, prg, 0x800b);
+    [[maybe_unused]] auto err = aldo_cart_create_mem(&c->cart,
+                                                     sizeof c->image,
+                                                     c->image);
+    assert(err == 0);
+    c->dbg = aldo_debug_new();
+    c->console = aldo_nes_new(c->dbg, false, nullptr);
+    aldo_nes_powerup(c->console, c->cart, true);
+    aldo_nes_halt(c->console, false);
+    *ctx = c;
+}
+
+static void teardown(void **ctx)
+{
+    struct nes_context *c = *ctx;
+    aldo_nes_powerdown(c->console);
+    aldo_nes_free(c->console);
+    aldo_debug_free(c->dbg);
+    aldo_cart_free(c->cart);
+    free(c);
+}
+
+static bool halt_on_frame(void *ctx, const uint8_t *)
+{
+    struct nes_context *c = ctx;
+    ++c->framecalls;
+    return false;
+}
+
+//
+// MARK: - Counts
+//
+
+static void run_frames(void *ctx)
+{
+    struct nes_context *c = ctx;
+
+    auto stop = aldo_nes_run_frames(c->console, &c->clock, 2);
+
+    ct_assertequal(ALDO_RUN_NONE, (int)stop.event);
+    ct_assertequal(2u, stop.frames);
+    ct_asserttrue(stop.cycles > 0);
+    ct_assertequal(stop.frames, c->clock.frames);
+    ct_assertequal(stop.cycles, c->clock.cycles);
+    ct_asserttrue(c->clock.subcycle < Aldo_PpuRatio);
+}
+
+static void run_frames_consecutive(void *ctx)
+{
+    struct nes_context *c = ctx;
+
+    auto first = aldo_nes_run_frames(c->console, &c->clock, 1);
+    auto second = aldo_nes_run_frames(c->console, &c->clock, 3);
+
+    ct_assertequal(ALDO_RUN_NONE, (int)first.event);
+    ct_assertequal(1u, first.frames);
+    ct_assertequal(ALDO_RUN_NONE, (int)second.event);
+    ct_assertequal(3u, second.frames);
+    // counts are per run while the clock accumulates across runs
+    ct_assertequal(4u, c->clock.frames);
+    ct_assertequal(first.cycles + second.cycles, c->clock.cycles);
+    // a full NTSC frame is 29780.67 CPU cycles
+    ct_asserttrue(29780 * 3 <= second.cycles && second.cycles <= 29781 * 3);
+    ct_asserttrue(c->clock.subcycle < Aldo_PpuRatio);
+}
+
+static void run_cycles(void *ctx)
+{
+    struct nes_context *c = ctx;
+
+    auto stop = aldo_nes_run_cycles(c->console, &c->clock, 100);
+
+    ct_assertequal(ALDO_RUN_NONE, (int)stop.event);
+    ct_assertequal(100u, stop.cycles);
+    ct_assertequal(0u, stop.frames);
+    ct_assertequal(100u, c->clock.cycles);
+    ct_assertequal(0u, c->clock.subcycle);
+}
+
+static void run_cycles_consecutive(void *ctx)
+{
+    struct nes_context *c = ctx;
+
+    auto first = aldo_nes_run_cycles(c->console, &c->clock, 30000);
+    auto second = aldo_nes_run_cycles(c->console, &c->clock, 7);
+
+    ct_assertequal(30000u, first.cycles);
+    ct_assertequal(1u, first.frames);
+    ct_assertequal(7u, second.cycles);
+    ct_assertequal(0u, second.frames);
+    ct_assertequal(30007u, c->clock.cycles);
+    ct_assertequal(1u, c->clock.frames);
+    ct_assertequal(0u, c->clock.subcycle);
+}
+
+static void run_zero_count(void *ctx)
+{
+    struct nes_context *c = ctx;
+
+    auto frames = aldo_nes_run_frames(c->console, &c->clock, 0);
+    auto cycles = aldo_nes_run_cycles(c->console, &c->clock, 0);
+
+    ct_assertequal(ALDO_RUN_NONE, (int)frames.event);
+    ct_assertequal(0u, frames.frames);
+    ct_assertequal(0u, frames.cycles);
+    ct_assertequal(ALDO_RUN_NONE, (int)cycles.event);
+    ct_assertequal(0u, cycles.frames);
+    ct_assertequal(0u, cycles.cycles);
+    ct_assertequal(0u, c->clock.cycles);
+    ct_assertequal(0u, c->clock.frames);
+}
+
+static void run_until_no_events(void *ctx)
+{
+    struct nes_context *c = ctx;
+
+    auto stop = aldo_nes_run_until(c->console, &c->clock, 0, 0);
+
+    ct_assertequal(ALDO_RUN_NONE, (int)stop.event);
+    ct_assertequal(0u, stop.frames);
+    ct_assertequal(0u, stop.cycles);
+    ct_assertequal(0u, c->clock.cycles);
+    ct_assertequal(0u, c->clock.frames);
+}
+
+//
+// MARK: - Events
+//
+
+static void run_until_vblank(void *ctx)
+{
+    struct nes_context *c = ctx;
+
+    auto first = aldo_nes_run_until(c->console, &c->clock, ALDO_RUN_VBLANK,
+                                    0);
+    auto second = aldo_nes_run_until(c->console, &c->clock, ALDO_RUN_VBLANK,
+                                     0);
+
+    ct_assertequal(ALDO_RUN_VBLANK, (int)first.event);
+    // vblank starts before the frame finishes
+    ct_assertequal(0u, first.frames);
+    ct_asserttrue(first.cycles > 0);
+    ct_assertequal(ALDO_RUN_VBLANK, (int)second.event);
+    ct_assertequal(1u, second.frames);
+    ct_asserttrue(29780 <= second.cycles && second.cycles <= 29781);
+    ct_assertequal(first.cycles + second.cycles, c->clock.cycles);
+    ct_assertequal(1u, c->clock.frames);
+    ct_asserttrue(c->clock.subcycle < Aldo_PpuRatio);
+}
+
+static void run_until_nmi(void *ctx)
+{
+    struct nes_context *c = ctx;
+
+    auto first = aldo_nes_run_until(c->console, &c->clock, ALDO_RUN_NMI, 0);
+    auto second = aldo_nes_run_until(c->console, &c->clock, ALDO_RUN_NMI, 0);
+
+    // PPUCTRL writes are ignored until the PPU finishes its reset
+    // sequence, so the first vblank raises no NMI.
+    ct_assertequal(ALDO_RUN_NMI, (int)first.event);
+    ct_assertequal(1u, first.frames);
+    ct_assertequal(ALDO_RUN_NMI, (int)second.event);
+    ct_assertequal(1u, second.frames);
+    ct_asserttrue(29780 <= second.cycles && second.cycles <= 29781);
+    ct_assertequal(0u, c->clock.subcycle);
+}
+
+static void run_until_write(void *ctx)
+{
+    struct nes_context *c = ctx;
+    uint8_t counter;
+
+    auto stop = aldo_nes_run_until(c->console, &c->clock, ALDO_RUN_WRITE,
+                                   Counter);
+
+    ct_assertequal(ALDO_RUN_WRITE, (int)stop.event);
+    ct_assertequal(0u, stop.frames);
+    // reset sequence plus LDA, STA, and the INC up to its first write
+    ct_asserttrue(0 < stop.cycles && stop.cycles < 20);
+    ct_assertequal(0u, c->clock.subcycle);
+
+    stop = aldo_nes_run_until(c->console, &c->clock, ALDO_RUN_WRITE,
+                              Counter);
+
+    ct_assertequal(ALDO_RUN_WRITE, (int)stop.event);
+    // INC writes the unmodified value back before the result
+    ct_assertequal(1u, stop.cycles);
+    ct_assertequal(1u, aldo_nes_copymem(c->console, Counter, 1, &counter));
+    ct_assertequal(1u, counter);
+}
+
+static void run_until_any_event(void *ctx)
+{
+    struct nes_context *c = ctx;
+    auto warmup = aldo_nes_run_frames(c->console, &c->clock, 1);
+
+    auto vblank = aldo_nes_run_until(c->console, &c->clock,
+                                     ALDO_RUN_VBLANK | ALDO_RUN_NMI, 0);
+    auto nmi = aldo_nes_run_until(c->console, &c->clock,
+                                  ALDO_RUN_VBLANK | ALDO_RUN_NMI, 0);
+
+    ct_assertequal(ALDO_RUN_NONE, (int)warmup.event);
+    ct_assertequal(ALDO_RUN_VBLANK, (int)vblank.event);
+    ct_assertequal(0u, vblank.frames);
+    ct_assertequal(ALDO_RUN_NMI, (int)nmi.event);
+    ct_assertequal(0u, nmi.frames);
+    ct_asserttrue(0 < nmi.cycles && nmi.cycles < 10);
+}
+
+// stops carry the dot phase between the PPU and CPU across calls, so a
+// run split at frame and event boundaries matches one unbroken run.
+static void split_runs_match_single_run(void *ctx)
+{
+    struct nes_context *c = ctx;
+    aldo_cart *cart;
+    [[maybe_unused]] auto err = aldo_cart_create_mem(&cart, sizeof c->image,
+                                                     c->image);
+    assert(err == 0);
+    auto dbg = aldo_debug_new();
+    auto console = aldo_nes_new(dbg, false, nullptr);
+    aldo_nes_powerup(console, cart, true);
+    aldo_nes_halt(console, false);
+    struct aldo_clock clock = {};
+
+    aldo_nes_run_frames(c->console, &c->clock, 1);
+    // the first frame ends two dots into a CPU cycle
+    ct_assertequal(2u, c->clock.subcycle);
+    aldo_nes_run_until(c->console, &c->clock, ALDO_RUN_VBLANK, 0);
+    aldo_nes_run_until(c->console, &c->clock, ALDO_RUN_NMI, 0);
+    aldo_nes_run_frames(c->console, &c->clock, 2);
+    aldo_nes_run_cycles(c->console, &c->clock, 1000);
+    auto single = aldo_nes_run_cycles(console, &clock, c->clock.cycles);
+
+    ct_assertequal(ALDO_RUN_NONE, (int)single.event);
+    ct_assertequal(c->clock.cycles, clock.cycles);
+    ct_assertequal(c->clock.frames, clock.frames);
+    ct_assertequal(c->clock.subcycle, clock.subcycle);
+    struct aldo_framehashes split, whole;
+    aldo_nes_framehashes(c->console, &split);
+    aldo_nes_framehashes(console, &whole);
+    ct_assertequal(split.screen, whole.screen);
+    ct_assertequal(split.ram, whole.ram);
+    ct_assertequal(split.vram, whole.vram);
+
+    aldo_nes_powerdown(console);
+    aldo_nes_free(console);
+    aldo_debug_free(dbg);
+    aldo_cart_free(cart);
+}
+
+//
+// MARK: - Halting
+//
+
+static void run_already_halted(void *ctx)
+{
+    struct nes_context *c = ctx;
+    aldo_nes_halt(c->console, true);
+
+    auto frames = aldo_nes_run_frames(c->console, &c->clock, 1);
+    auto cycles = aldo_nes_run_cycles(c->console, &c->clock, 1);
+    auto until = aldo_nes_run_until(c->console, &c->clock, ALDO_RUN_VBLANK,
+                                    0);
+
+    ct_assertequal(ALDO_RUN_HALT, (int)frames.event);
+    ct_assertequal(0u, frames.cycles);
+    ct_assertequal(ALDO_RUN_HALT, (int)cycles.event);
+    ct_assertequal(0u, cycles.cycles);
+    ct_assertequal(ALDO_RUN_HALT, (int)until.event);
+    ct_assertequal(0u, until.cycles);
+    ct_assertequal(0u, c->clock.cycles);
+    ct_assertequal(0u, c->clock.frames);
+}
+
+static void run_halts_on_hook(void *ctx)
+{
+    struct nes_context *c = ctx;
+    aldo_nes_set_framehook(c->console, halt_on_frame, c);
+
+    auto stop = aldo_nes_run_frames(c->console, &c->clock, 5);
+
+    ct_assertequal(ALDO_RUN_HALT, (int)stop.event);
+    ct_assertequal(1u, stop.frames);
+    ct_assertequal(1, c->framecalls);
+    ct_asserttrue(aldo_nes_halted(c->console));
+    ct_asserttrue(c->clock.subcycle < Aldo_PpuRatio);
+
+    aldo_nes_halt(c->console, false);
+    aldo_nes_set_framehook(c->console, nullptr, nullptr);
+    stop = aldo_nes_run_frames(c->console, &c->clock, 1);
+
+    ct_assertequal(ALDO_RUN_NONE, (int)stop.event);
+    ct_assertequal(1u, stop.frames);
+    ct_assertequal(2u, c->clock.frames);
+}
+
+static void run_halts_on_break(void *ctx)
+{
+    struct nes_context *c = ctx;
+    ct_asserttrue(aldo_debug_bp_add(c->dbg, (struct aldo_haltexpr){
+        .cond = ALDO_HLT_CYCLES,
+        .cycles = 50,
+    }));
+
+    auto stop = aldo_nes_run_cycles(c->console, &c->clock, 100);
+
+    ct_assertequal(ALDO_RUN_HALT, (int)stop.event);
+    ct_assertequal(50u, stop.cycles);
+    ct_assertequal(50u, c->clock.cycles);
+    ct_asserttrue(aldo_nes_halted(c->console));
+    ct_assertequal(0u, c->clock.subcycle);
+}
+
+//
+// MARK: - Test List
+//
+
+struct ct_testsuite nes_tests()
+{
+    static const struct ct_testcase tests[] = {
+        ct_maketest(run_frames),
+        ct_maketest(run_frames_consecutive),
+        ct_maketest(run_cycles),
+        ct_maketest(run_cycles_consecutive),
+        ct_maketest(run_zero_count),
+        ct_maketest(run_until_no_events),
+
+        ct_maketest(run_until_vblank),
+        ct_maketest(run_until_nmi),
+        ct_maketest(run_until_write),
+        ct_maketest(run_until_any_event),
+        ct_maketest(split_runs_match_single_run),
+
+        ct_maketest(run_already_halted),
+        ct_maketest(run_halts_on_hook),
+        ct_maketest(run_halts_on_break),
+    };
+
+    return ct_makesuite_setup_teardown(tests, setup, teardown);
+}
@@ -0,0 +1,309 @@
+//
+//  png.c
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "ciny.h"
+#include "png.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+constexpr size_t SignatureSize = 8;
+constexpr size_t ChunkOverhead = 12;
+constexpr size_t IhdrSize = 13;
+
+static uint32_t be32(const uint8_t *b)
+{
+    return (uint32_t)b[0] << 24 | (uint32_t)b[1] << 16 | (uint32_t)b[2] << 8
+            | b[3];
+}
+
+// write the image and read the encoded file back into a new buffer
+static uint8_t *encode(int width, int height, const uint8_t *rgb,
+                       size_t *size)
+{
+    auto f = tmpfile();
+    if (!f) return nullptr;
+    auto ok = aldo_png_write_rgb(width, height, rgb, f);
+    auto len = ftell(f);
+    uint8_t *buf = ok && len > 0 ? malloc((size_t)len) : nullptr;
+    if (buf) {
+        rewind(f);
+        *size = fread(buf, 1, (size_t)len, f);
+    }
+    fclose(f);
+    return buf;
+}
+
+// verify every chunk's CRC and return the offset of the IDAT chunk
+static size_t check_chunks(size_t size, const uint8_t png[static size])
+{
+    size_t idat = 0;
+    for (size_t at = SignatureSize; at < size;) {
+        auto len = be32(png + at);
+        auto crc = aldo_png_crc(0, len + 4, png + at + 4);
+        ct_assertequal(crc, be32(png + at + 8 + len));
+        if (memcmp(png + at + 4, "IDAT", 4) == 0) {
+            idat = at;
+        }
+        at += ChunkOverhead + len;
+    }
+    return idat;
+}
+
+// unwrap stored deflate blocks into data, checking block headers and the
+// adler32 trailer; returns unwrapped length.
+static size_t unstore(const uint8_t *zdata, size_t zlen, uint8_t *data)
+{
+    ct_assertequal(0x78u, zdata[0]);
+    ct_assertequal(0u, (zdata[0] * 256u + zdata[1]) % 31);
+    size_t at = 2, len = 0;
+    auto final = false;
+    while (!final) {
+        final = zdata[at] & 0x1;
+        ct_assertequal(0u, zdata[at] & 0x6u);
+        size_t blocklen = zdata[at + 1] | zdata[at + 2] << 8;
+        ct_assertequal(blocklen ^ 0xffff,
+                       (size_t)(zdata[at + 3] | zdata[at + 4] << 8));
+        memcpy(data + len, zdata + at + 5, blocklen);
+        len += blocklen;
+        at += 5 + blocklen;
+    }
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < len; ++i) {
+        a = (a + data[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    ct_assertequal(b << 16 | a, be32(zdata + at));
+    ct_assertequal(zlen, at + 4);
+    return len;
+}
+
+// inflate a zlib stream made by aldo_png_deflate, checking the header and
+// adler32 trailer.
+static void check_deflate(size_t zlen, const uint8_t *zdata, size_t len,
+                          const uint8_t *data)
+{
+    ct_assertequal(0x78u, zdata[0]);
+    ct_assertequal(0u, (zdata[0] * 256u + zdata[1]) % 31);
+    uint8_t *out = malloc(len + 1);
+    ct_asserttrue(aldo_inflate(zlen - 6, zdata + 2, len, out));
+    ct_assertequal(0, memcmp(data, out, len));
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < len; ++i) {
+        a = (a + data[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    ct_assertequal(b << 16 | a, be32(zdata + zlen - 4));
+    free(out);
+}
+
+//
+// MARK: - Tests
+//
+
+static void crc_check_value(void *ctx)
+{
+    static const uint8_t check[] = "123456789";
+
+    ct_assertequal(0xcbf43926u, aldo_png_crc(0, sizeof check - 1, check));
+}
+
+static void crc_empty(void *ctx)
+{
+    ct_assertequal(0u, aldo_png_crc(0, 0, (const uint8_t[]){0}));
+}
+
+static void crc_running(void *ctx)
+{
+    static const uint8_t check[] = "123456789";
+
+    auto crc = aldo_png_crc(0, 4, check);
+    crc = aldo_png_crc(crc, 5, check + 4);
+
+    ct_assertequal(0xcbf43926u, crc);
+}
+
+static void small_image(void *ctx)
+{
+    static const uint8_t rgb[] = {
+        0xff, 0x0, 0x0,     0x0, 0xff, 0x0,
+        0x0, 0x0, 0xff,     0x10, 0x20, 0x30,
+    };
+    size_t size = 0;
+
+    uint8_t *png = encode(2, 2, rgb, &size);
+
+    ct_assertnotnull(png);
+    ct_assertequal(0, memcmp(png, "\x89PNG\r\n\x1a\n", SignatureSize));
+    ct_assertequal(IhdrSize, be32(png + SignatureSize));
+    ct_assertequal(0, memcmp(png + SignatureSize + 4, "IHDR", 4));
+    auto ihdr = png + SignatureSize + 8;
+    ct_assertequal(2u, be32(ihdr));
+    ct_assertequal(2u, be32(ihdr + 4));
+    ct_assertequal(8u, ihdr[8]);
+    ct_assertequal(2u, ihdr[9]);
+    ct_assertequal(0u, ihdr[10]);
+    ct_assertequal(0u, ihdr[11]);
+    ct_assertequal(0u, ihdr[12]);
+
+    auto idat = check_chunks(size, png);
+    ct_assertequal(SignatureSize + ChunkOverhead + IhdrSize, idat);
+    uint8_t data[16];
+    auto len = unstore(png + idat + 8, be32(png + idat), data);
+    ct_assertequal(14u, len);
+    ct_assertequal(0u, data[0]);
+    ct_assertequal(0, memcmp(data + 1, rgb, 6));
+    ct_assertequal(0u, data[7]);
+    ct_assertequal(0, memcmp(data + 8, rgb + 6, 6));
+
+    ct_assertequal(0, memcmp(png + size - ChunkOverhead + 4, "IEND", 4));
+    free(png);
+}
+
+static void multiple_stored_blocks(void *ctx)
+{
+    static constexpr int width = 256;
+    static constexpr int height = 240;
+    static constexpr size_t rowlen = width * 3;
+
+    uint8_t *rgb = malloc(rowlen * height);
+    for (size_t i = 0; i < rowlen * height; ++i) {
+        rgb[i] = (uint8_t)(i * 7);
+    }
+    size_t size = 0;
+
+    uint8_t *png = encode(width, height, rgb, &size);
+
+    ct_assertnotnull(png);
+    auto idat = check_chunks(size, png);
+    ct_asserttrue(idat > 0);
+    uint8_t *data = malloc((rowlen + 1) * height);
+    auto len = unstore(png + idat + 8, be32(png + idat), data);
+    ct_assertequal((rowlen + 1) * height, len);
+    for (auto row = 0; row < height; ++row) {
+        auto line = data + ((rowlen + 1) * (size_t)row);
+        ct_assertequal(0u, line[0]);
+        ct_assertequal(0, memcmp(line + 1, rgb + (rowlen * (size_t)row),
+                                 rowlen));
+    }
+    free(data);
+    free(png);
+    free(rgb);
+}
+
+static void deflate_empty(void *ctx)
+{
+    uint8_t *zdata = nullptr;
+
+    auto zlen = aldo_png_deflate(0, (const uint8_t[]){0}, &zdata);
+
+    ct_assertnotnull(zdata);
+    ct_asserttrue(zlen > 6);
+    check_deflate(zlen, zdata, 0, (const uint8_t[]){0});
+    free(zdata);
+}
+
+static void deflate_round_trip(void *ctx)
+{
+    // noise, runs, and repeats at both near and far distances
+    static constexpr size_t len = 100000;
+    uint8_t *data = malloc(len);
+    uint32_t seed = 1;
+    for (size_t i = 0; i < len; ++i) {
+        seed = seed * 1103515245 + 12345;
+        if (i < 20000) {
+            data[i] = (uint8_t)(seed >> 16);
+        } else if (i < 40000) {
+            data[i] = (uint8_t)(i / 1000);
+        } else {
+            data[i] = data[i - (i < 70000 ? 301 : 30000)];
+        }
+    }
+    uint8_t *zdata = nullptr;
+
+    auto zlen = aldo_png_deflate(len, data, &zdata);
+
+    ct_assertnotnull(zdata);
+    ct_asserttrue(zlen < len / 2);
+    check_deflate(zlen, zdata, len, data);
+    free(zdata);
+    free(data);
+}
+
+static void indexed_image(void *ctx)
+{
+    // 10 x 3 pixels at 2 bpp pack into 3 bytes per row
+    static const uint8_t pixels[] = {
+        0x1b, 0xe4, 0x40,
+        0x1b, 0xe4, 0x40,
+        0xff, 0x00, 0x80,
+    };
+    static const uint8_t palette[] = {
+        0x0, 0x0, 0x0,  0x55, 0x55, 0x55,  0xaa, 0xaa, 0xaa,  0xff, 0xff, 0xff,
+    };
+    size_t size = 0;
+    uint8_t *png = nullptr;
+    auto f = tmpfile();
+    ct_assertnotnull(f);
+
+    auto ok = aldo_png_write_indexed(10, 3, 2, 4, palette, pixels, f);
+
+    ct_asserttrue(ok);
+    auto len = ftell(f);
+    png = malloc((size_t)len);
+    rewind(f);
+    size = fread(png, 1, (size_t)len, f);
+    fclose(f);
+    ct_assertequal((size_t)len, size);
+
+    auto ihdr = png + SignatureSize + 8;
+    ct_assertequal(10u, be32(ihdr));
+    ct_assertequal(3u, be32(ihdr + 4));
+    ct_assertequal(2u, ihdr[8]);
+    ct_assertequal(3u, ihdr[9]);
+
+    auto plte = png + SignatureSize + ChunkOverhead + IhdrSize;
+    ct_assertequal(sizeof palette, be32(plte));
+    ct_assertequal(0, memcmp(plte + 4, "PLTE", 4));
+    ct_assertequal(0, memcmp(plte + 8, palette, sizeof palette));
+
+    auto idat = check_chunks(size, png);
+    ct_assertequal(SignatureSize + (ChunkOverhead * 2) + IhdrSize
+                   + sizeof palette, idat);
+    uint8_t rows[12];
+    for (size_t row = 0; row < 3; ++row) {
+        rows[row * 4] = 0;
+        memcpy(rows + (row * 4) + 1, pixels + (row * 3), 3);
+    }
+    check_deflate(be32(png + idat), png + idat + 8, sizeof rows, rows);
+
+    ct_assertequal(0, memcmp(png + size - ChunkOverhead + 4, "IEND", 4));
+    free(png);
+}
+
+//
+// MARK: - Test List
+//
+
+struct ct_testsuite png_tests()
+{
+    static const struct ct_testcase tests[] = {
+        ct_maketest(crc_check_value),
+        ct_maketest(crc_empty),
+        ct_maketest(crc_running),
+        ct_maketest(small_image),
+        ct_maketest(multiple_stored_blocks),
+        ct_maketest(deflate_empty),
+        ct_maketest(deflate_round_trip),
+        ct_maketest(indexed_image),
+    };
+
+    return ct_makesuite(tests);
+}
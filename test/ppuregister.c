@@ -164,6 +164,21 @@ static void ppumask_read(void *ctx)
     ct_assertequal(0x5au, d);
 }
 
+static void ppumask_emphasis_and_grayscale(void *ctx)
+{
+    auto ppu = ppt_get_ppu(ctx);
+
+    ct_assertequal(0u, aldo_ppu_mask(ppu));
+
+    aldo_bus_write(ppt_get_mbus(ctx), 0x2001, 0xa1);
+
+    ct_assertequal(0xa1u, aldo_ppu_mask(ppu));
+    ct_asserttrue(ppu->mask.g);
+    ct_asserttrue(ppu->mask.re);
+    ct_assertfalse(ppu->mask.ge);
+    ct_asserttrue(ppu->mask.be);
+}
+
 //
 // MARK: - PPUSTATUS
 //
@@ -3333,6 +3348,7 @@ struct ct_testsuite ppu_register_tests()
         ct_maketest(ppumask_write_mirrored),
         ct_maketest(ppumask_write_during_reset),
         ct_maketest(ppumask_read),
+        ct_maketest(ppumask_emphasis_and_grayscale),
 
         ct_maketest(ppustatus_read_when_clear),
         ct_maketest(ppustatus_read_when_set),
@@ -0,0 +1,190 @@
+//
+//  profile.c
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "ciny.h"
+#include "profile.h"
+
+#include <stddef.h>
+
+static void setup(void **ctx)
+{
+    *ctx = aldo_profile_new();
+}
+
+static void teardown(void **ctx)
+{
+    aldo_profile_free(*ctx);
+}
+
+//
+// MARK: - Tests
+//
+
+static void empty_profile(void *ctx)
+{
+    aldo_profiler *prof = ctx;
+    struct aldo_hotspot hs[4];
+
+    ct_assertequal(0u, aldo_profile_total(prof));
+    ct_assertequal(0u, aldo_profile_hotspots(prof, 4, hs));
+}
+
+static void cycles_before_first_exec(void *ctx)
+{
+    aldo_profiler *prof = ctx;
+    struct aldo_hotspot hs[4];
+
+    aldo_profile_cycles(prof, 7);
+
+    ct_assertequal(0u, aldo_profile_total(prof));
+    ct_assertequal(0u, aldo_profile_hotspots(prof, 4, hs));
+}
+
+static void cycles_attributed_to_prg(void *ctx)
+{
+    aldo_profiler *prof = ctx;
+
+    aldo_profile_exec(prof, 0x8010, 0x10);
+    aldo_profile_cycles(prof, 1);
+    aldo_profile_cycles(prof, 1);
+    aldo_profile_exec(prof, 0x8012, 0x12);
+    aldo_profile_cycles(prof, 1);
+    aldo_profile_exec(prof, 0x8010, 0x10);
+    aldo_profile_cycles(prof, 1);
+
+    ct_assertequal(4u, aldo_profile_total(prof));
+    auto h = aldo_profile_prg(prof, 0x10);
+    ct_assertequal(3u, h.cycles);
+    ct_assertequal(2u, h.execs);
+    ct_assertequal(0x10, h.prgaddr);
+    ct_assertequal(0x8010u, h.addr);
+    h = aldo_profile_prg(prof, 0x12);
+    ct_assertequal(1u, h.cycles);
+    ct_assertequal(1u, h.execs);
+}
+
+static void prg_banks_counted_separately(void *ctx)
+{
+    aldo_profiler *prof = ctx;
+
+    aldo_profile_exec(prof, 0x8000, 0x0);
+    aldo_profile_cycles(prof, 2);
+    aldo_profile_exec(prof, 0x8000, 0x4000);
+    aldo_profile_cycles(prof, 5);
+
+    ct_assertequal(2u, aldo_profile_prg(prof, 0x0).cycles);
+    ct_assertequal(5u, aldo_profile_prg(prof, 0x4000).cycles);
+}
+
+static void unprofiled_prg(void *ctx)
+{
+    aldo_profiler *prof = ctx;
+
+    auto h = aldo_profile_prg(prof, 0x4000);
+
+    ct_assertequal(0u, h.cycles);
+    ct_assertequal(0u, h.execs);
+    ct_assertequal(0x4000, h.prgaddr);
+}
+
+static void non_prg_uses_cpu_address(void *ctx)
+{
+    aldo_profiler *prof = ctx;
+    struct aldo_hotspot hs[4];
+
+    aldo_profile_exec(prof, 0x200, Aldo_NoPrgAddr);
+    aldo_profile_cycles(prof, 3);
+
+    auto count = aldo_profile_hotspots(prof, 4, hs);
+
+    ct_assertequal(1u, count);
+    ct_assertequal(3u, hs[0].cycles);
+    ct_assertequal(1u, hs[0].execs);
+    ct_assertequal(Aldo_NoPrgAddr, hs[0].prgaddr);
+    ct_assertequal(0x200u, hs[0].addr);
+}
+
+static void hotspots_sorted_by_cycles(void *ctx)
+{
+    aldo_profiler *prof = ctx;
+    struct aldo_hotspot hs[4];
+
+    aldo_profile_exec(prof, 0x8000, 0x0);
+    aldo_profile_cycles(prof, 2);
+    aldo_profile_exec(prof, 0x300, Aldo_NoPrgAddr);
+    aldo_profile_cycles(prof, 6);
+    aldo_profile_exec(prof, 0x8002, 0x2);
+    aldo_profile_cycles(prof, 4);
+
+    auto count = aldo_profile_hotspots(prof, 4, hs);
+
+    ct_assertequal(3u, count);
+    ct_assertequal(6u, hs[0].cycles);
+    ct_assertequal(0x300u, hs[0].addr);
+    ct_assertequal(4u, hs[1].cycles);
+    ct_assertequal(0x2, hs[1].prgaddr);
+    ct_assertequal(2u, hs[2].cycles);
+    ct_assertequal(0x0, hs[2].prgaddr);
+}
+
+static void hotspots_bounded(void *ctx)
+{
+    aldo_profiler *prof = ctx;
+    struct aldo_hotspot hs[2];
+
+    for (auto i = 0; i < 5; ++i) {
+        aldo_profile_exec(prof, (uint16_t)(0x8000 + i), i);
+        aldo_profile_cycles(prof, i + 1);
+    }
+
+    auto count = aldo_profile_hotspots(prof, 2, hs);
+
+    ct_assertequal(2u, count);
+    ct_assertequal(5u, hs[0].cycles);
+    ct_assertequal(4, hs[0].prgaddr);
+    ct_assertequal(4u, hs[1].cycles);
+    ct_assertequal(3, hs[1].prgaddr);
+}
+
+static void reset_clears_counters(void *ctx)
+{
+    aldo_profiler *prof = ctx;
+    struct aldo_hotspot hs[4];
+
+    aldo_profile_exec(prof, 0x8000, 0x0);
+    aldo_profile_cycles(prof, 2);
+    aldo_profile_exec(prof, 0x200, Aldo_NoPrgAddr);
+    aldo_profile_cycles(prof, 2);
+
+    aldo_profile_reset(prof);
+    aldo_profile_cycles(prof, 3);
+
+    ct_assertequal(0u, aldo_profile_total(prof));
+    ct_assertequal(0u, aldo_profile_hotspots(prof, 4, hs));
+    ct_assertequal(0u, aldo_profile_prg(prof, 0x0).execs);
+}
+
+//
+// MARK: - Test List
+//
+
+struct ct_testsuite profile_tests()
+{
+    static constexpr struct ct_testcase tests[] = {
+        ct_maketest(empty_profile),
+        ct_maketest(cycles_before_first_exec),
+        ct_maketest(cycles_attributed_to_prg),
+        ct_maketest(prg_banks_counted_separately),
+        ct_maketest(unprofiled_prg),
+        ct_maketest(non_prg_uses_cpu_address),
+        ct_maketest(hotspots_sorted_by_cycles),
+        ct_maketest(hotspots_bounded),
+        ct_maketest(reset_clears_counters),
+    };
+
+    return ct_makesuite_setup_teardown(tests, setup, teardown);
+}
@@ -0,0 +1,252 @@
+//
+//  rewind.c
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "ciny.h"
+#include "rewind.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+static constexpr size_t StateSize = sizeof(uint64_t);
+static constexpr size_t Capacity = 8;
+
+static void setup(void **ctx)
+{
+    *ctx = aldo_rewind_new(StateSize * Capacity);
+}
+
+static void teardown(void **ctx)
+{
+    if (!*ctx) return;
+    aldo_rewind_free(*ctx);
+}
+
+// save a checkpoint whose state is its own position
+static void save(aldo_rewind *rw, uint64_t pos, bool pinned)
+{
+    uint64_t *state = aldo_rewind_save(rw, pos, StateSize, pinned);
+    ct_assertnotnull(state);
+    *state = pos;
+}
+
+static uint64_t find(aldo_rewind *rw, uint64_t pos)
+{
+    uint64_t at;
+    const uint64_t *state = aldo_rewind_find(rw, pos, &at);
+    ct_assertnotnull(state);
+    ct_assertequal(at, *state);
+    return at;
+}
+
+//
+// MARK: - Tests
+//
+
+static void empty_history(void *ctx)
+{
+    aldo_rewind *rw = ctx;
+    uint64_t at;
+
+    ct_assertequal(0u, aldo_rewind_count(rw));
+    ct_assertequal(0u, aldo_rewind_oldest(rw));
+    ct_assertnull(aldo_rewind_find(rw, 100, &at));
+    ct_asserttrue(aldo_rewind_due(rw, 0));
+}
+
+static void find_latest_at_or_before(void *ctx)
+{
+    aldo_rewind *rw = ctx;
+
+    save(rw, 10, false);
+    save(rw, 100, false);
+    save(rw, 200, false);
+
+    ct_assertequal(3u, aldo_rewind_count(rw));
+    ct_assertequal(10u, aldo_rewind_oldest(rw));
+    ct_assertequal(10u, find(rw, 10));
+    ct_assertequal(10u, find(rw, 99));
+    ct_assertequal(100u, find(rw, 100));
+    ct_assertequal(100u, find(rw, 150));
+    ct_assertequal(200u, find(rw, 5000));
+}
+
+static void find_before_history(void *ctx)
+{
+    aldo_rewind *rw = ctx;
+    uint64_t at = 0;
+
+    save(rw, 10, false);
+
+    ct_assertnull(aldo_rewind_find(rw, 9, &at));
+    ct_assertequal(0u, at);
+}
+
+static void due_after_interval(void *ctx)
+{
+    aldo_rewind *rw = ctx;
+
+    save(rw, 100, false);
+    auto interval = aldo_rewind_interval(rw);
+
+    ct_assertfalse(aldo_rewind_due(rw, 100));
+    ct_assertfalse(aldo_rewind_due(rw, 100 + interval - 1));
+    ct_asserttrue(aldo_rewind_due(rw, 100 + interval));
+}
+
+static void save_same_position_reuses_state(void *ctx)
+{
+    aldo_rewind *rw = ctx;
+
+    auto first = aldo_rewind_save(rw, 100, StateSize, false);
+    auto second = aldo_rewind_save(rw, 100, StateSize, true);
+
+    ct_assertsame(first, second);
+    ct_assertequal(1u, aldo_rewind_count(rw));
+}
+
+static void save_earlier_position_discards_later(void *ctx)
+{
+    aldo_rewind *rw = ctx;
+
+    save(rw, 10, false);
+    save(rw, 100, false);
+    save(rw, 200, false);
+    save(rw, 50, false);
+
+    ct_assertequal(2u, aldo_rewind_count(rw));
+    ct_assertequal(50u, find(rw, 5000));
+}
+
+static void truncate_discards_later(void *ctx)
+{
+    aldo_rewind *rw = ctx;
+
+    save(rw, 10, false);
+    save(rw, 100, false);
+    save(rw, 200, false);
+    aldo_rewind_truncate(rw, 150);
+
+    ct_assertequal(2u, aldo_rewind_count(rw));
+    ct_assertequal(100u, find(rw, 5000));
+    ct_asserttrue(aldo_rewind_due(rw, 100 + aldo_rewind_interval(rw)));
+}
+
+static void full_history_thins_older_half(void *ctx)
+{
+    aldo_rewind *rw = ctx;
+
+    for (uint64_t i = 0; i < Capacity; ++i) {
+        save(rw, i * 10, false);
+    }
+    save(rw, Capacity * 10, false);
+
+    // 10 and 30 are thinned out, the oldest is always kept
+    ct_assertequal(Capacity - 1, aldo_rewind_count(rw));
+    ct_assertequal(0u, aldo_rewind_oldest(rw));
+    ct_assertequal(0u, find(rw, 15));
+    ct_assertequal(20u, find(rw, 35));
+    ct_assertequal(40u, find(rw, 45));
+    ct_assertequal(Capacity * 10, find(rw, 5000));
+}
+
+static void thinning_skips_pinned(void *ctx)
+{
+    aldo_rewind *rw = ctx;
+
+    for (uint64_t i = 0; i < Capacity; ++i) {
+        save(rw, i * 10, i == 1);
+    }
+    save(rw, Capacity * 10, false);
+
+    ct_assertequal(Capacity, aldo_rewind_count(rw));
+    ct_assertequal(10u, find(rw, 15));
+    ct_assertequal(10u, find(rw, 25));
+    ct_assertequal(30u, find(rw, 35));
+}
+
+static void all_pinned_drops_oldest(void *ctx)
+{
+    aldo_rewind *rw = ctx;
+
+    for (uint64_t i = 0; i < Capacity; ++i) {
+        save(rw, i * 10, true);
+    }
+    save(rw, Capacity * 10, true);
+
+    ct_assertequal(Capacity, aldo_rewind_count(rw));
+    ct_assertequal(10u, aldo_rewind_oldest(rw));
+}
+
+static void replay_adapts_interval(void *ctx)
+{
+    aldo_rewind *rw = ctx;
+
+    // 10,000 dots/ms leaves half the step time as headroom
+    aldo_rewind_replayed(rw, 100000, 10.0);
+
+    ct_assertequal((uint64_t)(10000 * Aldo_RewindStepMs / 2),
+                   aldo_rewind_interval(rw));
+    ct_assertaboutequal(10.0, aldo_rewind_last_ms(rw), 0.001);
+}
+
+static void short_replay_does_not_adapt(void *ctx)
+{
+    aldo_rewind *rw = ctx;
+    auto interval = aldo_rewind_interval(rw);
+
+    aldo_rewind_replayed(rw, 100, 1.0);
+
+    ct_assertequal(interval, aldo_rewind_interval(rw));
+    ct_assertaboutequal(1.0, aldo_rewind_last_ms(rw), 0.001);
+}
+
+static void slow_replay_clamps_interval(void *ctx)
+{
+    aldo_rewind *rw = ctx;
+
+    aldo_rewind_replayed(rw, 10000, 10000.0);
+
+    ct_assertequal(341u, aldo_rewind_interval(rw));
+}
+
+static void reset_clears_history(void *ctx)
+{
+    aldo_rewind *rw = ctx;
+
+    save(rw, 10, false);
+    save(rw, 100, false);
+    aldo_rewind_reset(rw);
+
+    ct_assertequal(0u, aldo_rewind_count(rw));
+    ct_asserttrue(aldo_rewind_due(rw, 0));
+}
+
+//
+// MARK: - Test List
+//
+
+struct ct_testsuite rewind_tests()
+{
+    static constexpr struct ct_testcase tests[] = {
+        ct_maketest(empty_history),
+        ct_maketest(find_latest_at_or_before),
+        ct_maketest(find_before_history),
+        ct_maketest(due_after_interval),
+        ct_maketest(save_same_position_reuses_state),
+        ct_maketest(save_earlier_position_discards_later),
+        ct_maketest(truncate_discards_later),
+        ct_maketest(full_history_thins_older_half),
+        ct_maketest(thinning_skips_pinned),
+        ct_maketest(all_pinned_drops_oldest),
+        ct_maketest(replay_adapts_interval),
+        ct_maketest(short_replay_does_not_adapt),
+        ct_maketest(slow_replay_clamps_interval),
+        ct_maketest(reset_clears_history),
+    };
+
+    return ct_makesuite_setup_teardown(tests, setup, teardown);
+}
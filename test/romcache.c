@@ -0,0 +1,141 @@
+//
+//  romcache.c
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "ciny.h"
+#include "romcache.h"
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+constexpr size_t ImageSize = 64;
+
+static const uint8_t *image(uint8_t fill)
+{
+    uint8_t *mem = malloc(ImageSize);
+    memset(mem, fill, ImageSize);
+    return mem;
+}
+
+static void intern_new_image(void *ctx)
+{
+    auto start = aldo_romcache_count();
+    auto mem = image(0xa);
+
+    auto img = aldo_romcache_intern(mem, ImageSize, ALDO_ROMS_HEAP);
+
+    ct_assertnotnull(img);
+    ct_assertsame(mem, img->mem);
+    ct_assertequal(ImageSize, img->size);
+    ct_assertequal(start + 1, aldo_romcache_count());
+
+    aldo_romcache_release(img);
+
+    ct_assertequal(start, aldo_romcache_count());
+}
+
+static void intern_same_contents_shares_image(void *ctx)
+{
+    auto start = aldo_romcache_count();
+
+    auto a = aldo_romcache_intern(image(0xb), ImageSize, ALDO_ROMS_HEAP);
+    auto b = aldo_romcache_intern(image(0xb), ImageSize, ALDO_ROMS_HEAP);
+
+    ct_assertsame(a, b);
+    ct_assertequal(start + 1, aldo_romcache_count());
+
+    aldo_romcache_release(a);
+
+    ct_assertequal(start + 1, aldo_romcache_count());
+    ct_assertequal(0xb, b->mem[ImageSize - 1]);
+
+    aldo_romcache_release(b);
+
+    ct_assertequal(start, aldo_romcache_count());
+}
+
+static void intern_different_contents(void *ctx)
+{
+    auto start = aldo_romcache_count();
+
+    auto a = aldo_romcache_intern(image(0xc), ImageSize, ALDO_ROMS_HEAP);
+    auto b = aldo_romcache_intern(image(0xd), ImageSize, ALDO_ROMS_HEAP);
+
+    ct_assertfalse(a == b);
+    ct_assertequal(start + 2, aldo_romcache_count());
+
+    aldo_romcache_release(a);
+    aldo_romcache_release(b);
+
+    ct_assertequal(start, aldo_romcache_count());
+}
+
+static void intern_different_sizes(void *ctx)
+{
+    auto start = aldo_romcache_count();
+
+    auto a = aldo_romcache_intern(image(0xe), ImageSize, ALDO_ROMS_HEAP);
+    auto b = aldo_romcache_intern(image(0xe), ImageSize / 2, ALDO_ROMS_HEAP);
+
+    ct_assertfalse(a == b);
+    ct_assertequal(ImageSize / 2, b->size);
+    ct_assertequal(start + 2, aldo_romcache_count());
+
+    aldo_romcache_release(b);
+    aldo_romcache_release(a);
+
+    ct_assertequal(start, aldo_romcache_count());
+}
+
+// returns failure if an intern fails or hands back the wrong contents
+static void *churn(void *failure)
+{
+    for (int i = 0; i < 500; ++i) {
+        auto img = aldo_romcache_intern(image(0xf), ImageSize,
+                                        ALDO_ROMS_HEAP);
+        if (!img || img->mem[0] != 0xf) return failure;
+        aldo_romcache_release(img);
+    }
+    return nullptr;
+}
+
+static void concurrent_intern_and_release(void *ctx)
+{
+    auto start = aldo_romcache_count();
+    pthread_t threads[4];
+
+    for (size_t i = 0; i < sizeof threads / sizeof threads[0]; ++i) {
+        ct_assertequal(0, pthread_create(threads + i, nullptr, churn,
+                                         &start));
+    }
+    for (size_t i = 0; i < sizeof threads / sizeof threads[0]; ++i) {
+        void *result;
+        pthread_join(threads[i], &result);
+        ct_assertnull(result);
+    }
+
+    ct_assertequal(start, aldo_romcache_count());
+}
+
+//
+// MARK: - Test List
+//
+
+struct ct_testsuite romcache_tests()
+{
+    static const struct ct_testcase tests[] = {
+        ct_maketest(intern_new_image),
+        ct_maketest(intern_same_contents_shares_image),
+        ct_maketest(intern_different_contents),
+        ct_maketest(intern_different_sizes),
+        ct_maketest(concurrent_intern_and_release),
+    };
+
+    return ct_makesuite(tests);
+}
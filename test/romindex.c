@@ -0,0 +1,273 @@
+//
+//  romindex.c
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "cart.h"
+#include "ciny.h"
+#include "romindex.h"
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+constexpr size_t RawSize = 0x8000;
+
+struct index_context {
+    struct romindex idx;
+    struct romindex_stats stats;
+    char dir[64];
+};
+
+static void write_file(const struct index_context *c, const char *name,
+                       size_t size, const uint8_t *data)
+{
+    char path[128];
+    snprintf(path, sizeof path, "%s/%s", c->dir, name);
+    auto f = fopen(path, "wb");
+    if (size > 0) {
+        fwrite(data, 1, size, f);
+    }
+    fclose(f);
+}
+
+static void remove_file(const struct index_context *c, const char *name)
+{
+    char path[128];
+    snprintf(path, sizeof path, "%s/%s", c->dir, name);
+    remove(path);
+}
+
+static void setup(void **ctx)
+{
+    struct index_context *c = calloc(1, sizeof *c);
+    snprintf(c->dir, sizeof c->dir, "/tmp/aldo-index-%ld", (long)getpid());
+    mkdir(c->dir, 0700);
+    *ctx = c;
+}
+
+static void teardown(void **ctx)
+{
+    struct index_context *c = *ctx;
+    static const char *const names[] = {
+        "a.nes", "b.NES", "notes.txt", ".hidden.nes", "sub/c.nes", "sub",
+    };
+    for (size_t i = 0; i < sizeof names / sizeof names[0]; ++i) {
+        remove_file(c, names[i]);
+    }
+    rmdir(c->dir);
+    romindex_cleanup(&c->idx);
+    free(c);
+}
+
+// raw 32KB image, a one-bank iNES image, an unreadable image, and files
+// that are not indexed
+static void write_library(struct index_context *c)
+{
+    uint8_t *image = calloc(RawSize, sizeof *image);
+    write_file(c, "a.nes", RawSize, image);
+    static const uint8_t header[] = {'N', 'E', 'S', 0x1a, 0x1, 0x1, 0x1};
+    memcpy(image, header, sizeof header);
+    write_file(c, "b.NES", 16 + 0x4000 + 0x2000, image);
+    write_file(c, "notes.txt", 4, image);
+    write_file(c, ".hidden.nes", RawSize, image);
+    char sub[96];
+    snprintf(sub, sizeof sub, "%s/sub", c->dir);
+    mkdir(sub, 0700);
+    write_file(c, "sub/c.nes", 4, image);
+    free(image);
+}
+
+static void index_library(struct index_context *c)
+{
+    c->stats = (typeof(c->stats)){};
+    ct_asserttrue(romindex_scan(&c->idx, c->dir, &c->stats));
+    ct_asserttrue(romindex_update(&c->idx, c->dir, 4, &c->stats));
+}
+
+//
+// MARK: - Tests
+//
+
+static void index_new_library(void *ctx)
+{
+    struct index_context *c = ctx;
+    write_library(c);
+
+    index_library(c);
+
+    ct_assertequal(3u, c->idx.count);
+    ct_assertequal(3u, c->stats.read);
+    ct_assertequal(0u, c->stats.unchanged);
+    ct_assertequal(1u, c->stats.errors);
+
+    auto r = c->idx.records;
+    ct_assertequalstr("a.nes", r->path);
+    ct_assertequal(0, r->err);
+    ct_assertequal(ALDO_CRTF_RAW, (int)r->format);
+    ct_assertequal(RawSize, (size_t)r->prgsize);
+    ct_assertequal(0u, r->chrsize);
+    ct_assertequal(0u, r->chrhash);
+    ct_assertequal(RawSize, (size_t)r->size);
+
+    ++r;
+    ct_assertequalstr("b.NES", r->path);
+    ct_assertequal(0, r->err);
+    ct_assertequal(ALDO_CRTF_INES, (int)r->format);
+    ct_assertequal(0u, r->mapper_id);
+    ct_assertequal(ALDO_NTM_VERTICAL, (int)r->mirror);
+    ct_asserttrue(r->mapper_implemented);
+    ct_assertequal(0x4000u, r->prgsize);
+    ct_assertequal(0x2000u, r->chrsize);
+    ct_asserttrue(r->prghash != 0);
+    ct_asserttrue(r->chrhash != 0);
+
+    ++r;
+    ct_assertequalstr("sub/c.nes", r->path);
+    ct_assertequal(ALDO_CART_ERR_EOF, r->err);
+}
+
+static void reindex_unchanged_library(void *ctx)
+{
+    struct index_context *c = ctx;
+    write_library(c);
+    index_library(c);
+    auto hash = c->idx.records[1].prghash;
+
+    index_library(c);
+
+    ct_assertequal(3u, c->idx.count);
+    ct_assertequal(0u, c->stats.read);
+    ct_assertequal(3u, c->stats.unchanged);
+    ct_assertequal(0u, c->stats.removed);
+    ct_assertequal(1u, c->stats.errors);
+    ct_assertequal(hash, c->idx.records[1].prghash);
+}
+
+static void reindex_changed_library(void *ctx)
+{
+    struct index_context *c = ctx;
+    write_library(c);
+    index_library(c);
+    remove_file(c, "sub/c.nes");
+    static const uint8_t short_image[] = {0xea};
+    write_file(c, "a.nes", sizeof short_image, short_image);
+
+    index_library(c);
+
+    ct_assertequal(2u, c->idx.count);
+    ct_assertequal(1u, c->stats.read);
+    ct_assertequal(1u, c->stats.unchanged);
+    ct_assertequal(1u, c->stats.removed);
+    ct_assertequal(1u, c->stats.errors);
+    ct_assertequal(ALDO_CART_ERR_EOF, c->idx.records[0].err);
+}
+
+static void scan_missing_directory(void *ctx)
+{
+    struct index_context *c = ctx;
+
+    ct_assertfalse(romindex_scan(&c->idx, "/tmp/aldo-no-such-dir",
+                                 &c->stats));
+}
+
+static void write_read_round_trip(void *ctx)
+{
+    struct index_context *c = ctx;
+    write_library(c);
+    index_library(c);
+    auto f = tmpfile();
+
+    ct_asserttrue(romindex_write(&c->idx, f));
+    rewind(f);
+    struct romindex other = {};
+    auto result = romindex_read(&other, f);
+    fclose(f);
+
+    ct_asserttrue(result);
+    ct_assertequal(c->idx.count, other.count);
+    for (size_t i = 0; i < other.count; ++i) {
+        auto a = c->idx.records + i;
+        auto b = other.records + i;
+        ct_assertequalstr(a->path, b->path);
+        ct_assertequal(a->mtime, b->mtime);
+        ct_assertequal(a->size, b->size);
+        ct_assertequal(a->prghash, b->prghash);
+        ct_assertequal(a->chrhash, b->chrhash);
+        ct_assertequal(a->prgsize, b->prgsize);
+        ct_assertequal(a->chrsize, b->chrsize);
+        ct_assertequal(a->err, b->err);
+        ct_assertequal(a->format, b->format);
+        ct_assertequal(a->mapper_id, b->mapper_id);
+        ct_assertequal(a->mirror, b->mirror);
+        ct_assertequal(a->mapper_implemented, b->mapper_implemented);
+        ct_assertfalse(b->stale);
+    }
+    romindex_cleanup(&other);
+}
+
+static void read_invalid_index(void *ctx)
+{
+    struct index_context *c = ctx;
+    auto f = tmpfile();
+    fputs("NOTANINDEX!!", f);
+    rewind(f);
+
+    auto result = romindex_read(&c->idx, f);
+    fclose(f);
+
+    ct_assertfalse(result);
+    ct_assertequal(EILSEQ, errno);
+}
+
+static void read_truncated_index(void *ctx)
+{
+    struct index_context *c = ctx;
+    write_library(c);
+    index_library(c);
+    auto f = tmpfile();
+    ct_asserttrue(romindex_write(&c->idx, f));
+    auto size = ftell(f);
+    rewind(f);
+    uint8_t *buf = malloc((size_t)size);
+    fread(buf, 1, (size_t)size, f);
+    fclose(f);
+    f = tmpfile();
+    fwrite(buf, 1, (size_t)size - 1, f);
+    free(buf);
+    rewind(f);
+    struct romindex other = {};
+
+    auto result = romindex_read(&other, f);
+    fclose(f);
+
+    ct_assertfalse(result);
+    ct_assertequal(EILSEQ, errno);
+    ct_assertnull(other.records);
+}
+
+//
+// MARK: - Test List
+//
+
+struct ct_testsuite romindex_tests()
+{
+    static const struct ct_testcase tests[] = {
+        ct_maketest(index_new_library),
+        ct_maketest(reindex_unchanged_library),
+        ct_maketest(reindex_changed_library),
+        ct_maketest(scan_missing_directory),
+        ct_maketest(write_read_round_trip),
+        ct_maketest(read_invalid_index),
+        ct_maketest(read_truncated_index),
+    };
+
+    return ct_makesuite_setup_teardown(tests, setup, teardown);
+}
@@ -0,0 +1,389 @@
+//
+//  server.c
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "bytes.h"
+#include "carthelp.h"
+#include "ciny.h"
+#include "server.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+struct server_context {
+    char cartpath[NromPathSize], replies[1024];
+};
+
+static void setup(void **ctx)
+{
+    // JMP $8000 spin loop with every vector pointing at it
+    static const uint8_t spin[] = {0x4c, 0x0, 0x80};
+
+    struct server_context *c = calloc(1, sizeof *c);
+    uint8_t image[NromSize];
+    make_nrom(image, sizeof spin, spin, 0x8000);
+    write_nrom(image, c->cartpath);
+    *ctx = c;
+}
+
+static void teardown(void **ctx)
+{
+    struct server_context *c = *ctx;
+    unlink(c->cartpath);
+    free(c);
+}
+
+// run one session over script, collecting its replies into the context
+static bool run_script(struct server_context *c, const char *script)
+{
+    static const struct server_opts opts = {.workers = 1, .zeroram = true};
+
+    auto in = tmpfile();
+    auto out = tmpfile();
+    fputs(script, in);
+    rewind(in);
+
+    auto ok = server_session(in, out, &opts);
+
+    rewind(out);
+    auto len = fread(c->replies, sizeof c->replies[0],
+                     sizeof c->replies - 1, out);
+    c->replies[len] = '\0';
+    fclose(out);
+    fclose(in);
+    return ok;
+}
+
+// run script after loading the test cart
+static bool run_cart_script(struct server_context *c, const char *script)
+{
+    char buf[512];
+    snprintf(buf, sizeof buf, "load %s\n%s", c->cartpath, script);
+    return run_script(c, buf);
+}
+
+//
+// MARK: - Protocol
+//
+
+static void empty_input(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_script(c, ""));
+
+    ct_assertequalstr("", c->replies);
+}
+
+static void empty_and_unknown_commands(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_script(c, "\n  \t\nfoo bar\n"));
+
+    ct_assertequalstr("err empty command\n"
+                      "err empty command\n"
+                      "err unknown command: foo\n", c->replies);
+}
+
+static void crlf_and_extra_whitespace(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_script(c, "  poke\t10   ab  \r\npeek 10\r\n"));
+
+    ct_assertequalstr("ok 1\nok ab\n", c->replies);
+}
+
+static void line_too_long(void *ctx)
+{
+    struct server_context *c = ctx;
+    char script[1200];
+    memset(script, 'x', sizeof script);
+    strcpy(script + sizeof script - 12, "\npoke 0 1\n");
+
+    ct_asserttrue(run_script(c, script));
+
+    ct_assertequalstr("err line too long\nerr expected up to 256 hex bytes\n",
+                      c->replies);
+}
+
+static void quit_ends_session(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_script(c, "quit\npeek 0\n"));
+
+    ct_assertequalstr("ok\n", c->replies);
+}
+
+//
+// MARK: - Run
+//
+
+static void run_without_cart(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_script(c, "run frames 1\npower\n"));
+
+    ct_assertequalstr("err no cart loaded\nerr no cart loaded\n", c->replies);
+}
+
+static void run_bad_arguments(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_cart_script(c, "run\n"
+                                     "run frames\n"
+                                     "run frames 0\n"
+                                     "run frames -1\n"
+                                     "run cycles 1x\n"
+                                     "run seconds 1\n"
+                                     "run until vblank bogus\n"
+                                     "run until write\n"
+                                     "run until write 10000\n"
+                                     "run until\n"));
+
+    ct_assertequalstr("ok iNES (000)\n"
+                      "err expected frames|cycles N or until [EVENTS]\n"
+                      "err expected frames|cycles N\n"
+                      "err expected frames|cycles N\n"
+                      "err expected frames|cycles N\n"
+                      "err expected frames|cycles N\n"
+                      "err expected frames|cycles N or until [EVENTS]\n"
+                      "err expected events vblank|nmi|write ADDR\n"
+                      "err expected events vblank|nmi|write ADDR\n"
+                      "err expected events vblank|nmi|write ADDR\n"
+                      "err no halt conditions\n", c->replies);
+}
+
+static void run_frames_and_cycles(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_cart_script(c, "run frames 2\nrun cycles 10\n"));
+
+    ct_assertequalstr("ok iNES (000)\n"
+                      "ok done frames=2 cycles=59561\n"
+                      "ok done frames=0 cycles=10\n", c->replies);
+}
+
+static void run_stops_at_break(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_cart_script(c, "break 100c\n"
+                                     "run frames 1\n"
+                                     "clear\n"
+                                     "run cycles 1\n"));
+
+    ct_assertequalstr("ok iNES (000)\n"
+                      "ok 0\n"
+                      "ok break 0 frames=0 cycles=100\n"
+                      "ok\n"
+                      "ok done frames=0 cycles=1\n", c->replies);
+}
+
+static void run_until_events(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_cart_script(c, "run until vblank\n"
+                                     "run until nmi vblank\n"
+                                     "poke 10 00\n"
+                                     "run until write 10 vblank\n"));
+
+    // the spin loop never enables NMI or writes to memory
+    ct_assertequalstr("ok iNES (000)\n"
+                      "ok vblank frames=0 cycles=27394\n"
+                      "ok vblank frames=1 cycles=29780\n"
+                      "ok 1\n"
+                      "ok vblank frames=1 cycles=29781\n", c->replies);
+}
+
+static void run_until_halted(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_cart_script(c, "run cycles 10\n"
+                                     "break 100000c\n"
+                                     "run until\n"));
+
+    ct_assertequalstr("ok iNES (000)\n"
+                      "ok done frames=0 cycles=10\n"
+                      "ok 0\n"
+                      "ok break 0 frames=3 cycles=99990\n", c->replies);
+}
+
+static void load_missing_cart(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_script(c, "load\nload /tmp/aldo-no-such-cart.nes\n"));
+
+    ct_assertequalstr("err expected cart path\n"
+                      "err No such file or directory\n", c->replies);
+}
+
+//
+// MARK: - Memory
+//
+
+static void peek_poke_arguments(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_script(c, "peek\n"
+                                "peek 10000\n"
+                                "peek zz\n"
+                                "peek 0 0\n"
+                                "peek 0 257\n"
+                                "poke 0\n"
+                                "poke 0 abc\n"
+                                "poke 0 zz\n"
+                                "poke g 00\n"));
+
+    ct_assertequalstr("err expected hex address\n"
+                      "err expected hex address\n"
+                      "err expected hex address\n"
+                      "err expected byte count [1, 256]\n"
+                      "err expected byte count [1, 256]\n"
+                      "err expected up to 256 hex bytes\n"
+                      "err expected up to 256 hex bytes\n"
+                      "err invalid hex bytes\n"
+                      "err expected hex address\n", c->replies);
+}
+
+static void poke_then_peek(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_script(c, "poke 7fe DEadBEef\npeek 7fe 4\npeek 800\n"));
+
+    // RAM mirrors every 2KB
+    ct_assertequalstr("ok 4\nok deadbeef\nok be\n", c->replies);
+}
+
+//
+// MARK: - States
+//
+
+static void save_restore_slots(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_cart_script(c, "save\n"
+                                     "save 8\n"
+                                     "restore -1\n"
+                                     "restore 3\n"));
+
+    ct_assertequalstr("ok iNES (000)\n"
+                      "err expected slot [0, 7]\n"
+                      "err expected slot [0, 7]\n"
+                      "err expected slot [0, 7]\n"
+                      "err empty slot\n", c->replies);
+}
+
+static void save_restore_round_trip(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_cart_script(c, "poke 10 42\n"
+                                     "save 2\n"
+                                     "poke 10 99\n"
+                                     "run cycles 50\n"
+                                     "restore 2\n"
+                                     "peek 10\n"
+                                     "run cycles 50\n"));
+
+    // restore rolls back both memory and the session clock
+    ct_assertequalstr("ok iNES (000)\n"
+                      "ok 1\n"
+                      "ok\n"
+                      "ok 1\n"
+                      "ok done frames=0 cycles=50\n"
+                      "ok\n"
+                      "ok 42\n"
+                      "ok done frames=0 cycles=50\n", c->replies);
+}
+
+static void load_clears_slots(void *ctx)
+{
+    struct server_context *c = ctx;
+    char script[256];
+    snprintf(script, sizeof script, "save 0\nload %s\nrestore 0\n",
+             c->cartpath);
+
+    ct_asserttrue(run_cart_script(c, script));
+
+    ct_assertequalstr("ok iNES (000)\n"
+                      "ok\n"
+                      "ok iNES (000)\n"
+                      "err empty slot\n", c->replies);
+}
+
+static void hash_matches_restored_state(void *ctx)
+{
+    struct server_context *c = ctx;
+
+    ct_asserttrue(run_cart_script(c, "save 0\n"
+                                     "hash\n"
+                                     "poke 10 ff\n"
+                                     "hash\n"
+                                     "restore 0\n"
+                                     "hash\n"));
+
+    char *lines[7];
+    size_t count = 0;
+    for (auto line = strtok(c->replies, "\n");
+         line && count < aldo_arrsz(lines);
+         line = strtok(nullptr, "\n")) {
+        lines[count++] = line;
+    }
+    ct_assertequal(aldo_arrsz(lines), count);
+    ct_assertequal(strlen("ok ") + (16 * 3) + 2, strlen(lines[2]));
+    ct_assertequalstr("ok 1", lines[3]);
+    ct_assertfalse(strcmp(lines[2], lines[4]) == 0);
+    ct_assertequalstr(lines[2], lines[6]);
+}
+
+//
+// MARK: - Test List
+//
+
+struct ct_testsuite server_tests()
+{
+    static const struct ct_testcase tests[] = {
+        ct_maketest(empty_input),
+        ct_maketest(empty_and_unknown_commands),
+        ct_maketest(crlf_and_extra_whitespace),
+        ct_maketest(line_too_long),
+        ct_maketest(quit_ends_session),
+
+        ct_maketest(run_without_cart),
+        ct_maketest(run_bad_arguments),
+        ct_maketest(run_frames_and_cycles),
+        ct_maketest(run_stops_at_break),
+        ct_maketest(run_until_events),
+        ct_maketest(run_until_halted),
+        ct_maketest(load_missing_cart),
+
+        ct_maketest(peek_poke_arguments),
+        ct_maketest(poke_then_peek),
+
+        ct_maketest(save_restore_slots),
+        ct_maketest(save_restore_round_trip),
+        ct_maketest(load_clears_slots),
+        ct_maketest(hash_matches_restored_state),
+    };
+
+    return ct_makesuite_setup_teardown(tests, setup, teardown);
+}
@@ -0,0 +1,156 @@
+//
+//  testrom.c
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "ciny.h"
+#include "testrom.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+static void status_no_signature(void *ctx)
+{
+    uint8_t header[] = {0x0, 0x0, 0x0, 0x0};
+
+    ct_assertequal(-1, testrom_status(header));
+}
+
+static void status_partial_signature(void *ctx)
+{
+    uint8_t header[] = {0x0, 0xde, 0xb0, 0x0};
+
+    ct_assertequal(-1, testrom_status(header));
+}
+
+static void status_running(void *ctx)
+{
+    uint8_t header[] = {0x80, 0xde, 0xb0, 0x61};
+
+    ct_assertequal(TestRomRunning, testrom_status(header));
+}
+
+static void status_reset(void *ctx)
+{
+    uint8_t header[] = {0x81, 0xde, 0xb0, 0x61};
+
+    ct_assertequal(TestRomReset, testrom_status(header));
+}
+
+static void status_result(void *ctx)
+{
+    uint8_t header[] = {0x3, 0xde, 0xb0, 0x61};
+
+    ct_assertequal(3, testrom_status(header));
+}
+
+static void message_collapses_whitespace(void *ctx)
+{
+    static const uint8_t text[] = "\n01-basics\n\n  Failed #3\n";
+    char message[TestRomMessageSize];
+
+    testrom_message(sizeof text, text, message);
+
+    ct_assertequalstr("01-basics Failed #3", message);
+}
+
+static void message_stops_at_terminator(void *ctx)
+{
+    static const uint8_t text[] = {'o', 'k', '\0', 'x', 'y'};
+    char message[TestRomMessageSize];
+
+    testrom_message(sizeof text, text, message);
+
+    ct_assertequalstr("ok", message);
+}
+
+static void message_unterminated(void *ctx)
+{
+    static const uint8_t text[] = {'o', 'k', '\t', 0x7, '!'};
+    char message[TestRomMessageSize];
+
+    testrom_message(sizeof text, text, message);
+
+    ct_assertequalstr("ok ?!", message);
+}
+
+static void message_empty(void *ctx)
+{
+    static const uint8_t text[] = {'\0'};
+    char message[TestRomMessageSize];
+
+    testrom_message(sizeof text, text, message);
+
+    ct_assertequalstr("", message);
+}
+
+static void message_truncated(void *ctx)
+{
+    uint8_t text[TestRomMessageSize * 2];
+    memset(text, 'a', sizeof text);
+    char message[TestRomMessageSize];
+
+    testrom_message(sizeof text, text, message);
+
+    ct_assertequal(TestRomMessageSize - 1, strlen(message));
+}
+
+static void table_counts_failures(void *ctx)
+{
+    static const struct testrom roms[] = {
+        {.path = "a.nes", .frames = 10, .status = TESTROM_PASS},
+        {
+            .path = "b.nes",
+            .frames = 20,
+            .status = TESTROM_FAIL,
+            .code = 2,
+            .message = "Failed #2",
+        },
+        {.path = "c.nes", .frames = 600, .status = TESTROM_NOSTATUS},
+    };
+    char output[512];
+    auto f = tmpfile();
+    size_t failed;
+
+    auto result = testrom_write_table(sizeof roms / sizeof roms[0], roms,
+                                      &failed, f);
+
+    ct_asserttrue(result);
+    ct_assertequal(2u, failed);
+    rewind(f);
+    auto len = fread(output, 1, sizeof output - 1, f);
+    output[len] = '\0';
+    fclose(f);
+    ct_assertnotnull(strstr(output, "PASS        10    0  a.nes\n"));
+    ct_assertnotnull(strstr(output,
+                            "FAIL        20    2  b.nes: Failed #2\n"));
+    ct_assertnotnull(strstr(output, "NOSTAT     600    -  c.nes\n"));
+    ct_assertnotnull(strstr(output, "1 of 3 passed\n"));
+}
+
+//
+// MARK: - Test List
+//
+
+struct ct_testsuite testrom_tests()
+{
+    static const struct ct_testcase tests[] = {
+        ct_maketest(status_no_signature),
+        ct_maketest(status_partial_signature),
+        ct_maketest(status_running),
+        ct_maketest(status_reset),
+        ct_maketest(status_result),
+        ct_maketest(message_collapses_whitespace),
+        ct_maketest(message_stops_at_terminator),
+        ct_maketest(message_unterminated),
+        ct_maketest(message_empty),
+        ct_maketest(message_truncated),
+        ct_maketest(table_counts_failures),
+    };
+
+    return ct_makesuite(tests);
+}
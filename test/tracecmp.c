@@ -0,0 +1,262 @@
+//
+//  tracecmp.c
+//  Aldo-Tests
+//
+//  Created by Brandon Stansbury on 10/19/26.
+//
+
+#include "ciny.h"
+#include "tracecmp.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+struct tracecmp_ctx {
+    struct tracecmp cmp;
+    FILE *golden, *report;
+};
+
+static const char
+    *const restrict NestestStart =
+        "C000  4C F5 C5  JMP $C5F5                       A:00 X:00 Y:00 P:24"
+        " SP:FD PPU:  0, 21 CYC:7\n",
+    *const restrict NestestNext =
+        "C5F5  A2 00     LDX #$00                        A:00 X:00 Y:00 P:24"
+        " SP:FD PPU:  0, 30 CYC:10\n",
+    *const restrict AldoReset =
+        "FFFC: 00        BRK (RST)                       A:00 X:00 Y:00 P:34"
+        " (nvUBdIzc) S:FD PPU:  0,  0 CPU:0\n",
+    *const restrict AldoStart =
+        "C000: 4C F5 C5  JMP $C5F5                       A:00 X:00 Y:00 P:34"
+        " (nvUBdIzc) S:FD PPU:  0, 21 CPU:7\n",
+    *const restrict AldoNext =
+        "C5F5: A2 00     LDX #$00                        A:00 X:00 Y:00 P:34"
+        " (nvUBdIzc) S:FD PPU:  0, 30 CPU:10\n",
+    *const restrict AldoNextBadX =
+        "C5F5: A2 00     LDX #$00                        A:00 X:01 Y:00 P:34"
+        " (nvUBdIzc) S:FD PPU:  0, 30 CPU:10\n";
+
+static void setup(void **ctx)
+{
+    struct tracecmp_ctx *c = malloc(sizeof *c);
+    c->golden = tmpfile();
+    c->report = tmpfile();
+    *ctx = c;
+}
+
+static void teardown(void **ctx)
+{
+    struct tracecmp_ctx *c = *ctx;
+    fclose(c->report);
+    fclose(c->golden);
+    free(c);
+}
+
+static struct tracecmp *init_golden(void *ctx, const char *const lines[])
+{
+    struct tracecmp_ctx *c = ctx;
+    for (auto line = lines; *line; ++line) {
+        fputs(*line, c->golden);
+    }
+    rewind(c->golden);
+    tracecmp_init(&c->cmp, c->golden);
+    return &c->cmp;
+}
+
+static FILE *report(void *ctx)
+{
+    struct tracecmp_ctx *c = ctx;
+    return c->report;
+}
+
+//
+// MARK: - Tests
+//
+
+static void empty_golden_log(void *ctx)
+{
+    auto cmp = init_golden(ctx, (const char *[]){nullptr});
+
+    ct_assertfalse(tracecmp_line(cmp, AldoStart));
+    ct_assertequal(TRACECMP_END, cmp->state);
+    ct_assertequal(0u, cmp->matched);
+}
+
+static void skips_lines_until_golden_start(void *ctx)
+{
+    auto cmp = init_golden(ctx, (const char *[]){NestestStart, nullptr});
+
+    ct_asserttrue(tracecmp_line(cmp, AldoReset));
+    ct_assertequal(TRACECMP_SYNC, cmp->state);
+    ct_assertequal(0u, cmp->matched);
+
+    ct_asserttrue(tracecmp_line(cmp, AldoStart));
+    ct_assertequal(TRACECMP_MATCH, cmp->state);
+    ct_assertequal(1u, cmp->matched);
+}
+
+static void never_synced(void *ctx)
+{
+    auto cmp = init_golden(ctx, (const char *[]){NestestStart, nullptr});
+
+    ct_asserttrue(tracecmp_line(cmp, AldoReset));
+
+    ct_assertfalse(tracecmp_finish(cmp, report(ctx)));
+}
+
+static void matches_nestest_format(void *ctx)
+{
+    auto cmp = init_golden(ctx, (const char *[]){
+        NestestStart, NestestNext, nullptr,
+    });
+
+    ct_asserttrue(tracecmp_line(cmp, AldoReset));
+    ct_asserttrue(tracecmp_line(cmp, AldoStart));
+    ct_asserttrue(tracecmp_line(cmp, AldoNext));
+    ct_assertfalse(tracecmp_line(cmp, AldoNext));
+
+    ct_assertequal(TRACECMP_END, cmp->state);
+    ct_assertequal(2u, cmp->matched);
+    ct_asserttrue(tracecmp_finish(cmp, report(ctx)));
+}
+
+static void matches_aldo_format(void *ctx)
+{
+    auto cmp = init_golden(ctx, (const char *[]){
+        AldoStart, AldoNext, nullptr,
+    });
+
+    ct_asserttrue(tracecmp_line(cmp, AldoStart));
+    ct_asserttrue(tracecmp_line(cmp, AldoNext));
+
+    ct_assertequal(TRACECMP_MATCH, cmp->state);
+    ct_assertequal(2u, cmp->matched);
+    ct_asserttrue(tracecmp_finish(cmp, report(ctx)));
+    ct_assertequal(TRACECMP_END, cmp->state);
+}
+
+static void skips_blank_golden_lines(void *ctx)
+{
+    auto cmp = init_golden(ctx, (const char *[]){
+        NestestStart, "\n", "\n", NestestNext, nullptr,
+    });
+
+    ct_asserttrue(tracecmp_line(cmp, AldoStart));
+    ct_asserttrue(tracecmp_line(cmp, AldoNext));
+
+    ct_assertequal(2u, cmp->matched);
+    ct_assertequal(4u, cmp->goldenline);
+}
+
+static void register_divergence(void *ctx)
+{
+    auto cmp = init_golden(ctx, (const char *[]){
+        NestestStart, NestestNext, nullptr,
+    });
+
+    ct_asserttrue(tracecmp_line(cmp, AldoStart));
+    ct_assertfalse(tracecmp_line(cmp, AldoNextBadX));
+
+    ct_assertequal(TRACECMP_DIVERGED, cmp->state);
+    ct_assertequal(1u, cmp->matched);
+    ct_assertequal(2u, cmp->goldenline);
+    ct_assertfalse(tracecmp_line(cmp, AldoNext));
+    ct_assertfalse(tracecmp_finish(cmp, report(ctx)));
+}
+
+static void ppu_divergence(void *ctx)
+{
+    auto cmp = init_golden(ctx, (const char *[]){
+        NestestStart, NestestNext, nullptr,
+    });
+
+    ct_asserttrue(tracecmp_line(cmp, AldoStart));
+    ct_assertfalse(tracecmp_line(cmp,
+        "C5F5: A2 00     LDX #$00                        A:00 X:00 Y:00 P:34"
+        " (nvUBdIzc) S:FD PPU:  0, 31 CPU:10\n"));
+
+    ct_assertequal(TRACECMP_DIVERGED, cmp->state);
+}
+
+static void cycle_divergence(void *ctx)
+{
+    auto cmp = init_golden(ctx, (const char *[]){
+        NestestStart, NestestNext, nullptr,
+    });
+
+    ct_asserttrue(tracecmp_line(cmp, AldoStart));
+    ct_assertfalse(tracecmp_line(cmp,
+        "C5F5: A2 00     LDX #$00                        A:00 X:00 Y:00 P:34"
+        " (nvUBdIzc) S:FD PPU:  0, 30 CPU:11\n"));
+
+    ct_assertequal(TRACECMP_DIVERGED, cmp->state);
+}
+
+static void ignores_break_flag(void *ctx)
+{
+    auto cmp = init_golden(ctx, (const char *[]){
+        NestestStart, NestestNext, nullptr,
+    });
+
+    ct_asserttrue(tracecmp_line(cmp, AldoStart));
+    ct_asserttrue(tracecmp_line(cmp,
+        "C5F5: A2 00     LDX #$00                        A:00 X:00 Y:00 P:24"
+        " (nvUbdIzc) S:FD PPU:  0, 30 CPU:10\n"));
+
+    ct_assertequal(TRACECMP_MATCH, cmp->state);
+}
+
+static void ignores_missing_fields(void *ctx)
+{
+    auto cmp = init_golden(ctx, (const char *[]){
+        "C000  4C F5 C5  JMP $C5F5     A:00 X:00 Y:00 P:24 SP:FD\n",
+        nullptr,
+    });
+
+    ct_asserttrue(tracecmp_line(cmp, AldoStart));
+
+    ct_assertequal(TRACECMP_MATCH, cmp->state);
+    ct_assertequal(1u, cmp->matched);
+}
+
+static void keeps_preceding_context(void *ctx)
+{
+    auto cmp = init_golden(ctx, (const char *[]){
+        AldoStart, AldoStart, AldoStart, AldoStart, AldoStart, AldoStart,
+        AldoStart, AldoStart, AldoStart, AldoStart, AldoNext, nullptr,
+    });
+
+    for (auto i = 0; i < 10; ++i) {
+        ct_asserttrue(tracecmp_line(cmp, AldoStart));
+    }
+    ct_assertfalse(tracecmp_line(cmp, AldoNextBadX));
+
+    ct_assertequal(10u, cmp->matched);
+    ct_assertequal(2u, cmp->history);
+    ct_assertequalstrn(AldoStart, cmp->context[1], 20);
+    ct_assertequalstrn(AldoNextBadX, cmp->actual, 20);
+}
+
+//
+// MARK: - Test List
+//
+
+struct ct_testsuite tracecmp_tests()
+{
+    static constexpr struct ct_testcase tests[] = {
+        ct_maketest(empty_golden_log),
+        ct_maketest(skips_lines_until_golden_start),
+        ct_maketest(never_synced),
+        ct_maketest(matches_nestest_format),
+        ct_maketest(matches_aldo_format),
+        ct_maketest(skips_blank_golden_lines),
+        ct_maketest(register_divergence),
+        ct_maketest(ppu_divergence),
+        ct_maketest(cycle_divergence),
+        ct_maketest(ignores_break_flag),
+        ct_maketest(ignores_missing_fields),
+        ct_maketest(keeps_preceding_context),
+    };
+
+    return ct_makesuite_setup_teardown(tests, setup, teardown);
+}